@@ -0,0 +1,392 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <hardware.h>
+#include <config.h>
+#include <drivers/sdcard.h>
+#include <native.h>
+#include <sys/time.h>
+#include <ftw.h>
+#include "../native/src/us2066.h"
+#include "bench.h"
+
+
+/* FILE is redefined as the avr-libc stream by the native Arduino.h */
+typedef decltype( stdout ) HostFile;
+
+/* Maximum number of results in a baseline file */
+#define BENCH_MAX_RESULTS           64
+
+struct BenchResult {
+    char name[ BENCH_MAX_NAME_LENGTH + 1 ];
+    double nsPerOp;
+};
+
+volatile uint32_t g_benchSink = 0;
+uint32_t g_benchBytes = 0;
+char g_benchNote[ BENCH_MAX_NOTE_LENGTH ] = "";
+bool g_benchFailed = false;
+
+static BenchResult _baseline[ BENCH_MAX_RESULTS ];
+static uint8_t _baselineCount = 0;
+static char _root[] = "/tmp/clock-bench.XXXXXX";
+static NativeUS2066 _lcd( I2C_ADDR_OLED );
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the host time. <time.h> is the firmware's own header in this 
+ *          build, so clock_gettime() is not available. The microsecond 
+ *          resolution is plenty for runs of at least BENCH_MIN_TIME.
+ *
+ * @return  Time in nanoseconds.
+ *
+ */
+static uint64_t benchNow() {
+    struct timeval now;
+    gettimeofday( &now, NULL );
+
+    return ( uint64_t )now.tv_sec * 1000000000ULL + ( uint64_t )now.tv_usec * 1000ULL;
+}
+
+
+static int removeEntry( const char* path, const struct stat* st, int type, struct FTW* ftw ) {
+    ( void )st;
+    ( void )type;
+    ( void )ftw;
+
+    return remove( path );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Delete the temporary directory on exit.
+ *
+ */
+static void benchCleanup() {
+    nftw( _root, removeEntry, 8, FTW_DEPTH | FTW_PHYS );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Prepare the emulated board for the benchmark cases : SD card 
+ *          and EEPROM in a temporary directory, default configuration.
+ *
+ */
+void benchBegin() {
+    if( mkdtemp( _root ) == nullptr ) {
+        fprintf( stderr, "bench: cannot create temporary directory\n" );
+        exit( 1 );
+    }
+
+    atexit( benchCleanup );
+
+    char eeprom[ sizeof( _root ) + 16 ];
+    snprintf( eeprom, sizeof( eeprom ), "%s/eeprom.bin", _root );
+
+    setenv( "NATIVE_SDCARD", _root, 1 );
+    setenv( "NATIVE_EEPROM", eeprom, 1 );
+
+    nativeBegin();
+    nativeSetPinLevel( PIN_ON_BATTERY, LOW );
+    nativeSetPinLevel( PIN_SD_DETECT, LOW );
+    nativeRegisterI2CDevice( &_lcd );
+
+    g_config.reset();
+
+    /* Wait for the card detect debounce delay */
+    unsigned long start = millis();
+    while( g_sdcard.detectCardPresence() == false ) {
+
+        if( millis() - start > 2000 ) {
+            fprintf( stderr, "bench: SD card emulation failed (%s)\n", _root );
+            exit( 1 );
+        }
+
+        delay( 10 );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stands for the rest of the main loop pass : busy wait for 
+ *          BENCH_LOOP_PASS_US.
+ *
+ */
+void benchLoopPass() {
+    unsigned long start = micros();
+
+    while( micros() - start < BENCH_LOOP_PASS_US ) {
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Measure a benchmark case. The number of iterations is doubled 
+ *          until a run lasts at least BENCH_MIN_TIME.
+ *
+ * @param   bench    Benchmark case
+ *
+ * @return  Best time per operation (ns).
+ *
+ */
+static double benchMeasure( const BenchCase* bench ) {
+    uint32_t iterations = 1;
+    uint64_t elapsed;
+
+    while( true ) {
+        if( bench->prepare != nullptr ) {
+            bench->prepare( iterations );
+        }
+
+        uint64_t start = benchNow();
+        bench->run( iterations );
+        elapsed = benchNow() - start;
+
+        if( elapsed >= BENCH_MIN_TIME ) {
+            break;
+        }
+
+        if( bench->maxIterations != 0 && iterations * 2 > bench->maxIterations ) {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    double best = ( double )elapsed / iterations;
+
+    for( uint8_t i = 1; i < BENCH_REPEAT; i++ ) {
+        if( bench->prepare != nullptr ) {
+            bench->prepare( iterations );
+        }
+
+        uint64_t start = benchNow();
+        bench->run( iterations );
+        elapsed = benchNow() - start;
+
+        if(( double )elapsed / iterations < best ) {
+            best = ( double )elapsed / iterations;
+        }
+    }
+
+    return best;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Load a baseline file. Each line contains the time per operation
+ *          followed by the case name.
+ *
+ * @param   filename    File to read
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+static bool benchLoadBaseline( const char* filename ) {
+    HostFile file = fopen( filename, "r" );
+    if( file == nullptr ) {
+        return false;
+    }
+
+    char line[ BENCH_MAX_NAME_LENGTH + 32 ];
+    while( _baselineCount < BENCH_MAX_RESULTS && fgets( line, sizeof( line ), file ) != nullptr ) {
+
+        char* name;
+        double value = strtod( line, &name );
+
+        if( name == line || *name != '\t' ) {
+            continue;
+        }
+
+        name++;
+        name[ strcspn( name, "\r\n" ) ] = 0;
+
+        strncpy( _baseline[ _baselineCount ].name, name, BENCH_MAX_NAME_LENGTH );
+        _baseline[ _baselineCount ].name[ BENCH_MAX_NAME_LENGTH ] = 0;
+        _baseline[ _baselineCount ].nsPerOp = value;
+        _baselineCount++;
+    }
+
+    fclose( file );
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Find a case in the baseline.
+ *
+ * @param   name    Case name
+ *
+ * @return  Pointer to the result or nullptr if not found.
+ *
+ */
+static const BenchResult* benchFindBaseline( const char* name ) {
+    for( uint8_t i = 0; i < _baselineCount; i++ ) {
+        if( strcmp( _baseline[ i ].name, name ) == 0 ) {
+            return &_baseline[ i ];
+        }
+    }
+
+    return nullptr;
+}
+
+
+static void usage( const char* program ) {
+    fprintf( stderr, "Usage: %s [--save file] [--compare file] [--tolerance %%] [filter]\n", program );
+    exit( 2 );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Benchmark program entry point.
+ *
+ */
+int main( int argc, char** argv ) {
+    const char* saveFile = nullptr;
+    const char* compareFile = nullptr;
+    const char* filter = nullptr;
+    int tolerance = BENCH_DEFAULT_TOLERANCE;
+
+    for( int i = 1; i < argc; i++ ) {
+        if( strcmp( argv[ i ], "--save" ) == 0 && i + 1 < argc ) {
+            saveFile = argv[ ++i ];
+
+        } else if( strcmp( argv[ i ], "--compare" ) == 0 && i + 1 < argc ) {
+            compareFile = argv[ ++i ];
+
+        } else if( strcmp( argv[ i ], "--tolerance" ) == 0 && i + 1 < argc ) {
+            tolerance = atoi( argv[ ++i ] );
+
+        } else if( argv[ i ][ 0 ] == '-' || filter != nullptr ) {
+            usage( argv[ 0 ] );
+
+        } else {
+            filter = argv[ i ];
+        }
+    }
+
+    if( compareFile != nullptr && benchLoadBaseline( compareFile ) == false ) {
+        fprintf( stderr, "bench: cannot read baseline '%s'\n", compareFile );
+        return 2;
+    }
+
+    HostFile save = nullptr;
+    if( saveFile != nullptr && ( save = fopen( saveFile, "w" )) == nullptr ) {
+        fprintf( stderr, "bench: cannot write baseline '%s'\n", saveFile );
+        return 2;
+    }
+
+    benchBegin();
+
+    void ( *groups[] )( const BenchCase**, uint8_t* ) = {
+        benchTimeCases,
+        benchConfigCases,
+        benchMqttCases,
+        benchFtpCases,
+        benchLcdCases,
+        benchNeoPixelCases,
+        benchUiCases,
+        benchConsoleCases,
+        benchAudioCases,
+        benchEnvelopeCases,
+    };
+
+    uint8_t regressions = 0;
+    uint8_t failures = 0;
+
+    printf( "%-*s %12s %12s %8s\n", BENCH_MAX_NAME_LENGTH, "Case", "ns/op", "baseline", "delta" );
+
+    for( uint8_t g = 0; g < sizeof( groups ) / sizeof( groups[ 0 ] ); g++ ) {
+        const BenchCase* cases;
+        uint8_t count;
+
+        groups[ g ]( &cases, &count );
+
+        for( uint8_t i = 0; i < count; i++ ) {
+            if( filter != nullptr && strstr( cases[ i ].name, filter ) == nullptr ) {
+                continue;
+            }
+
+            g_benchBytes = 0;
+            g_benchNote[ 0 ] = 0;
+            g_benchFailed = false;
+
+            double result = benchMeasure( &cases[ i ] );
+            printf( "%-*s %12.1f", BENCH_MAX_NAME_LENGTH, cases[ i ].name, result );
+
+            const BenchResult* baseline = benchFindBaseline( cases[ i ].name );
+            if( baseline != nullptr && baseline->nsPerOp > 0 ) {
+
+                double delta = ( result - baseline->nsPerOp ) * 100.0 / baseline->nsPerOp;
+                bool regression = ( delta > tolerance );
+
+                printf( " %12.1f %+7.1f%%%s", baseline->nsPerOp, delta, regression ? "  REGRESSION" : "" );
+
+                if( regression == true ) {
+                    regressions++;
+                }
+
+            } else if( g_benchBytes > 0 ) {
+                printf( " %21s", "" );
+            }
+
+            if( g_benchBytes > 0 ) {
+                printf( " %9.2f MB/s", g_benchBytes * 1000.0 / result );
+            }
+
+            if( g_benchFailed == true ) {
+                printf( "  FAILED" );
+                failures++;
+            }
+
+            if( g_benchNote[ 0 ] != 0 ) {
+                printf( "  %s", g_benchNote );
+            }
+
+            printf( "\n" );
+            fflush( stdout );
+
+            if( save != nullptr ) {
+                fprintf( save, "%.1f\t%s\n", result, cases[ i ].name );
+            }
+        }
+    }
+
+    if( save != nullptr ) {
+        fclose( save );
+    }
+
+    if( regressions > 0 ) {
+        printf( "\n%d case(s) slower than the baseline by more than %d%%\n", regressions, tolerance );
+    }
+
+    if( failures > 0 ) {
+        printf( "\n%d case(s) failed\n", failures );
+    }
+
+    return ( regressions > 0 || failures > 0 ) ? 1 : 0;
+}
\ No newline at end of file
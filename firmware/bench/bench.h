@@ -0,0 +1,137 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef BENCH_H
+#define BENCH_H
+
+/* Host micro-benchmarks of the firmware hot paths, built by the 'bench'
+   environment (pio run -e bench -t exec). Each case is run with an 
+   increasing number of iterations until it lasts at least BENCH_MIN_TIME,
+   the best of BENCH_REPEAT runs is reported in nanoseconds per operation.
+   Cases which set g_benchBytes also report their throughput.
+
+   Usage : program [--save file] [--compare file] [--tolerance %] [filter]
+
+   --save writes the results to a baseline file, --compare reports the 
+   cases slower than the baseline by more than the tolerance and exits 
+   with a non-zero code if any. The program also exits with a non-zero
+   code if a case reports a failure. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <IPAddress.h>
+
+class ConsoleBase;
+class TCPClient;
+class FsFile;
+class Envelope;
+
+
+
+/* Minimum duration of a measurement (ns) */
+#define BENCH_MIN_TIME              20000000ULL
+
+/* Number of measurements, the fastest is kept */
+#define BENCH_REPEAT                5
+
+/* Default regression tolerance (%) */
+#define BENCH_DEFAULT_TOLERANCE     20
+
+/* Maximum length of a case name */
+#define BENCH_MAX_NAME_LENGTH       40
+
+/* Time taken by the other services of loop() between two dispatches of the
+   task under test (us). The cases which run a task to completion wait this 
+   long after each dispatch. The default is an estimate for the ATmega2560, 
+   the 'perf' console command gives the actual loop pass time. */
+#ifndef BENCH_LOOP_PASS_US
+#define BENCH_LOOP_PASS_US          1000
+#endif
+
+
+/* Benchmark case */
+struct BenchCase {
+    const char* name;
+    void ( *prepare )( uint32_t iterations );   /* Untimed setup, may be NULL */
+    void ( *run )( uint32_t iterations );       /* Runs the operation 'iterations' times */
+    uint32_t maxIterations;                     /* 0 if unlimited */
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Access to the private members of the classes under test.
+ *
+ *******************************************************************************/
+class BenchAccess {
+
+  public:
+    static void configOpen( const char* filename );
+    static void configClose();
+    static bool configReadNextLine();
+    static uint8_t configParseLine( char* name, char* value );
+    static bool configEof();
+
+    static size_t mqttEncodePublish( char* topic, char* payload );
+    static void mqttConnect( IPAddress ip, uint16_t port );
+    static bool mqttConnected();
+    static void mqttPoll();
+    static void mqttAttach();
+    static void hassSendConfig();
+
+    static void ftpSendDirectoryEntry( TCPClient* client, FsFile* file, uint8_t listType );
+
+    static void consoleRunCommand( ConsoleBase* console, const char* command );
+
+    static void alarmOpenFile( const char* filename );
+    static void alarmFeed();
+    static void alarmAttachDataRequest( bool attach );
+    static void alarmSnooze( uint16_t elapsed );
+    static void alarmStop();
+
+    static uint16_t envelopeLevel( Envelope* envelope, uint16_t position );
+};
+
+
+void benchBegin();
+void benchLoopPass();
+void benchTimeCases( const BenchCase** cases, uint8_t* count );
+void benchConfigCases( const BenchCase** cases, uint8_t* count );
+void benchMqttCases( const BenchCase** cases, uint8_t* count );
+void benchFtpCases( const BenchCase** cases, uint8_t* count );
+void benchLcdCases( const BenchCase** cases, uint8_t* count );
+void benchNeoPixelCases( const BenchCase** cases, uint8_t* count );
+void benchUiCases( const BenchCase** cases, uint8_t* count );
+void benchConsoleCases( const BenchCase** cases, uint8_t* count );
+void benchAudioCases( const BenchCase** cases, uint8_t* count );
+void benchEnvelopeCases( const BenchCase** cases, uint8_t* count );
+
+/* Keeps the compiler from optimizing away a result */
+extern volatile uint32_t g_benchSink;
+
+/* Bytes produced by one operation, set by the cases reporting a throughput */
+extern uint32_t g_benchBytes;
+
+/* Additional result printed after the time (eg. a buffer level) */
+#define BENCH_MAX_NOTE_LENGTH       64
+extern char g_benchNote[ BENCH_MAX_NOTE_LENGTH ];
+
+/* Set by the cases whose output is wrong, g_benchNote gives the reason */
+extern bool g_benchFailed;
+
+#endif /* BENCH_H */
\ No newline at end of file
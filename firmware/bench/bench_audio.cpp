@@ -0,0 +1,239 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_audio.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <hardware.h>
+#include <native.h>
+#include <alarm.h>
+#include "../native/src/vs1053.h"
+#include "bench.h"
+
+
+/* Alarm sound file played from the SD card */
+#define BENCH_AUDIO_FILE        "bench.mp3"
+#define BENCH_AUDIO_FILE_SIZE   65536UL
+
+/* Stream byte rate of the emulated codec (128 kbit/s) */
+#define BENCH_AUDIO_BYTE_RATE   16000UL
+
+/* Playback before and after the main loop stall (ms) */
+#define BENCH_AUDIO_PLAY_TIME   250
+
+
+static NativeVS1053 _codec( PIN_VS1053_XDCS, PIN_VS1053_DREQ );
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Open the alarm sound file.
+ *
+ * @param   filename    File to open
+ *
+ */
+void BenchAccess::alarmOpenFile( const char* filename ) {
+
+    /* Initialize the codec outside of the measurement */
+    g_alarm.readyForData();
+
+    g_alarm.openFile( ( char* )filename );
+    g_alarm.currentFile.rewind();
+    g_alarm.resetRing();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send the next blocks of audio data to the codec.
+ *
+ */
+void BenchAccess::alarmFeed() {
+    g_alarm.feedBuffer();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Feed the codec from the DREQ interrupt, like the alarm playback 
+ *          does when ALARM_FEED_INTERRUPT is enabled.
+ *
+ * @param   attach    TRUE to attach the interrupt, FALSE to detach it.
+ *
+ */
+void BenchAccess::alarmAttachDataRequest( bool attach ) {
+#if ALARM_FEED_INTERRUPT == 1
+    if( attach == true ) {
+        g_alarm.attachDataInterrupt( isr_vs1053_dreq );
+    } else {
+        g_alarm.detachDataInterrupt();
+    }
+#else
+    ( void )attach;
+#endif
+}
+
+
+static void prepareFeed( uint32_t iterations ) {
+    ( void )iterations;
+    static bool created = false;
+
+    if( created == false ) {
+        FsFile file;
+        uint8_t buffer[ 256 ];
+
+        file.open( BENCH_AUDIO_FILE, O_CREAT | O_WRITE | O_TRUNC );
+
+        for( uint32_t i = 0; i < BENCH_AUDIO_FILE_SIZE; i += sizeof( buffer )) {
+            memset( buffer, i >> 8, sizeof( buffer ));
+            file.write( buffer, sizeof( buffer ));
+        }
+
+        file.close();
+        created = true;
+    }
+
+    BenchAccess::alarmOpenFile( BENCH_AUDIO_FILE );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stream the alarm sound file to the codec, which always requests
+ *          data on the host.
+ *
+ */
+static void runFeed( uint32_t iterations ) {
+    uint32_t sent = g_alarm.getBytesSent();
+
+    for( uint32_t i = 0; i < iterations; i++ ) {
+        BenchAccess::alarmFeed();
+    }
+
+    g_benchBytes = ( g_alarm.getBytesSent() - sent ) / iterations;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Let the emulated codec play and service the interrupts for the 
+ *          given time, like a blocking call with interrupts enabled.
+ *
+ * @param   us    Duration in microseconds
+ *
+ */
+static void serviceInterrupts( uint32_t us ) {
+    unsigned long start = micros();
+
+    do {
+        _codec.poll();
+        nativePollInterrupts();
+
+    } while( micros() - start < us );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Feed the codec from the main loop, each pass followed by the rest
+ *          of the loop pass (BENCH_LOOP_PASS_US).
+ *
+ * @param   ms    Duration in milliseconds
+ *
+ */
+static void playFor( uint32_t ms ) {
+    unsigned long start = millis();
+
+    while( millis() - start < ms ) {
+        BenchAccess::alarmFeed();
+        serviceInterrupts( BENCH_LOOP_PASS_US );
+    }
+}
+
+
+static void prepareStall( uint32_t iterations ) {
+    static bool registered = false;
+
+    if( registered == false ) {
+        nativeRegisterSPIDevice( &_codec );
+        registered = true;
+    }
+
+    prepareFeed( iterations );
+
+    _codec.start( BENCH_AUDIO_BYTE_RATE );
+    g_alarm.clearAudioStats();
+
+    BenchAccess::alarmAttachDataRequest( true );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Play the alarm sound with a main loop stall in the middle and 
+ *          report the lowest codec FIFO level.
+ *
+ * @param   iterations    Number of stalls
+ * @param   stall         Stall duration (ms)
+ *
+ */
+static void runStall( uint32_t iterations, uint32_t stall ) {
+    while( iterations-- ) {
+        playFor( BENCH_AUDIO_PLAY_TIME );
+        serviceInterrupts( stall * 1000UL );
+        playFor( BENCH_AUDIO_PLAY_TIME );
+    }
+
+    BenchAccess::alarmAttachDataRequest( false );
+    _codec.stop();
+
+    snprintf( g_benchNote, sizeof( g_benchNote ), "FIFO min %u B, ring empty %lu, codec min %u B, dry %lu",
+              g_alarm.getFifoMinLevel(), ( unsigned long )g_alarm.getUnderruns(), 
+              _codec.getMinLevel(), ( unsigned long )_codec.getUnderruns() );
+}
+
+
+/* WiFiSocket::write retrying on a full WINC buffer */
+static void runStallSocketWrite( uint32_t iterations ) {
+    runStall( iterations, 100 );
+}
+
+
+/* TCPClient::connect( host ) waiting for the DNS response */
+static void runStallDnsWait( uint32_t iterations ) {
+    runStall( iterations, 5000 );
+}
+
+
+static const BenchCase _cases[] = {
+    { "Alarm audio feed (SD file)",             prepareFeed,        runFeed,                    0 },
+    { "Audio FIFO, 100 ms loop stall",          prepareStall,       runStallSocketWrite,        1 },
+    { "Audio FIFO, 5 s loop stall (DNS)",       prepareStall,       runStallDnsWait,            1 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the audio playback benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchAudioCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_config.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <config.h>
+#include <drivers/sdcard.h>
+#include "bench.h"
+
+
+#define BENCH_CONFIG_BACKUP         "bench_backup.txt"
+#define BENCH_CONFIG_FILE           "bench_config.txt"
+
+/* Number of copies of the backup file in the benchmark file */
+#define BENCH_CONFIG_COPIES         16
+
+/* Size of the backup file (bytes) */
+static uint32_t _backupSize = 0;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Open the configuration file for reading, like startRestore() 
+ *          does without starting the restore task.
+ *
+ * @param   filename    File to open
+ *
+ */
+void BenchAccess::configOpen( const char* filename ) {
+    g_config._sd_file.openRoot( g_sdcard.vol() );
+    g_config._sd_file.open( filename, O_READ );
+
+    g_config._currentSectionID = SECTION_ID_UNKNOWN;
+    g_config._currentSettingID = 0;
+    g_config._currentAlarmID = -1;
+}
+
+
+void BenchAccess::configClose() {
+    g_config._sd_file.close();
+}
+
+
+bool BenchAccess::configReadNextLine() {
+    return g_config.readNextLine();
+}
+
+
+uint8_t BenchAccess::configParseLine( char* name, char* value ) {
+    return g_config.parseConfigLine( name, value );
+}
+
+
+bool BenchAccess::configEof() {
+    return g_config._sd_file.peek() == -1;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Create the benchmark file : the output of the configuration 
+ *          backup task, repeated BENCH_CONFIG_COPIES times.
+ *
+ */
+static void prepareConfigFile( uint32_t iterations ) {
+    ( void )iterations;
+
+    static bool created = false;
+    if( created == true ) {
+        return;
+    }
+
+    g_config.startBackup( BENCH_CONFIG_BACKUP );
+    while( g_config.isBusy() == true ) {
+        g_config.runTasks();
+    }
+
+    FsFile src;
+    FsFile dst;
+    char buffer[ 256 ];
+
+    dst.open( BENCH_CONFIG_FILE, O_CREAT | O_WRITE | O_TRUNC );
+
+    for( uint8_t i = 0; i < BENCH_CONFIG_COPIES; i++ ) {
+        src.open( BENCH_CONFIG_BACKUP, O_READ );
+
+        int length;
+        while(( length = src.read( buffer, sizeof( buffer ))) > 0 ) {
+            dst.write( buffer, length );
+        }
+
+        src.close();
+    }
+
+    dst.close();
+
+    src.open( BENCH_CONFIG_BACKUP, O_READ );
+    _backupSize = src.fileSize();
+    src.close();
+
+    created = true;
+}
+
+
+static void runReadNextLine( uint32_t iterations ) {
+    uint32_t lines = 0;
+
+    while( iterations-- ) {
+        BenchAccess::configOpen( BENCH_CONFIG_FILE );
+
+        while( BenchAccess::configReadNextLine() == true ) {
+            lines++;
+        }
+
+        BenchAccess::configClose();
+    }
+
+    g_benchSink = lines;
+}
+
+
+static void runParseConfigLine( uint32_t iterations ) {
+    char name[ MAX_LENGTH_SETTING_NAME + 1 ];
+    char value[ MAX_LENGTH_SETTING_VALUE + 1 ];
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        BenchAccess::configOpen( BENCH_CONFIG_FILE );
+
+        while( BenchAccess::configEof() == false ) {
+            sum += BenchAccess::configParseLine( name, value );
+        }
+
+        BenchAccess::configClose();
+    }
+
+    g_benchSink = sum;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Run the backup task to completion, dispatched like the main loop
+ *          does with the given time slice. Each dispatch is followed by the
+ *          rest of the loop pass (BENCH_LOOP_PASS_US).
+ *
+ * @param   iterations    Number of backups
+ * @param   slice         Time slice of the task (us)
+ *
+ */
+static void runBackup( uint32_t iterations, uint16_t slice ) {
+    uint32_t dispatches = 0;
+
+    g_config.setTimeSlice( slice );
+
+    while( iterations-- ) {
+        g_config.startBackup( BENCH_CONFIG_BACKUP );
+
+        while( g_config.isBusy() == true ) {
+            g_config.dispatch( millis() );
+            dispatches++;
+
+            benchLoopPass();
+        }
+    }
+
+    g_config.setTimeSlice( TASK_DEFAULT_TIME_SLICE );
+
+    g_benchSink = dispatches;
+    g_benchBytes = _backupSize;
+}
+
+
+/* The whole backup in a single dispatch */
+static void runBackupUnsliced( uint32_t iterations ) {
+    runBackup( iterations, UINT16_MAX );
+}
+
+
+/* Default time slice */
+static void runBackupSliced( uint32_t iterations ) {
+    runBackup( iterations, TASK_DEFAULT_TIME_SLICE );
+}
+
+
+/* A single line per dispatch, the slicing overhead on the ATmega2560 where
+   a line takes a large part of the default slice. */
+static void runBackupPerLine( uint32_t iterations ) {
+    runBackup( iterations, 0 );
+}
+
+
+static const BenchCase _cases[] = {
+    { "ConfigManager::readNextLine (file)",     prepareConfigFile,  runReadNextLine,            0 },
+    { "ConfigManager::parseConfigLine (file)",  prepareConfigFile,  runParseConfigLine,         0 },
+    { "Config backup (unsliced)",               prepareConfigFile,  runBackupUnsliced,          0 },
+    { "Config backup (2 ms slices)",            prepareConfigFile,  runBackupSliced,            0 },
+    { "Config backup (1 line per dispatch)",    prepareConfigFile,  runBackupPerLine,           0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the configuration benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchConfigCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_console.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <console/console_base.h>
+#include <services/logger.h>
+#include "bench.h"
+
+
+#define BENCH_CONSOLE_OUTPUT_SIZE   256
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Console writing its output to a memory buffer, as the serial
+ *          port transmit buffer would.
+ *
+ *******************************************************************************/
+class BenchConsole : public ConsoleBase {
+
+  public:
+    void runTasks() { ConsoleBase::runTasks(); }
+    uint32_t getBytes() { return _bytes; }
+
+  protected:
+    int _read() { return -1; }
+    int _peek() { return -1; }
+    int _available() { return 0; }
+    void exitConsole( bool timeout ) { ( void )timeout; }
+    void resetConsole() {}
+
+  private:
+    size_t _print( char c ) {
+        _output[ _bytes++ % BENCH_CONSOLE_OUTPUT_SIZE ] = c;
+        return 1;
+    }
+
+    size_t _write( const char *buffer, size_t length ) {
+        for( size_t i = 0; i < length; i++ ) {
+            _output[ _bytes++ % BENCH_CONSOLE_OUTPUT_SIZE ] = buffer[ i ];
+        }
+
+        return length;
+    }
+
+    char _output[ BENCH_CONSOLE_OUTPUT_SIZE ];
+    uint32_t _bytes = 0;
+};
+
+
+static BenchConsole _console;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Run a console command until its task ends.
+ *
+ * @param   console    Console instance
+ * @param   command    Command line
+ *
+ */
+void BenchAccess::consoleRunCommand( ConsoleBase* console, const char* command ) {
+    strncpy( console->_inputBuffer, command, INPUT_BUFFER_LENGTH );
+    console->parseCommand();
+
+    while( console->isBusy() == true ) {
+        console->runTasks();
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Run a command 'iterations' times and report the bytes written 
+ *          by each run.
+ *
+ * @param   command       Command line
+ * @param   iterations    Number of runs
+ *
+ */
+static void runCommand( const char* command, uint32_t iterations ) {
+    uint32_t start = _console.getBytes();
+    uint32_t count = iterations;
+
+    while( count-- ) {
+        BenchAccess::consoleRunCommand( &_console, command );
+    }
+
+    g_benchBytes = ( _console.getBytes() - start ) / iterations;
+    g_benchSink = _console.getBytes();
+}
+
+
+static void prepareLogs( uint32_t iterations ) {
+    ( void )iterations;
+
+    static bool initialized = false;
+    if( initialized == true ) {
+        return;
+    }
+
+    /* Fill the log with a typical mix of events */
+    for( uint8_t i = 0; i < MAX_LOG_ENTRIES; i++ ) {
+        switch( i % 4 ) {
+            case 0: g_log.add( EVENT_WIFI_CONNECTED ); break;
+            case 1: g_log.add( EVENT_NTP_ADJUST_CLOCK, i * 1000L ); break;
+            case 2: g_log.add( EVENT_MQTT_CONNECTED ); break;
+            default: g_log.add( EVENT_TELNET_SESSION_START ); break;
+        }
+    }
+
+    initialized = true;
+}
+
+
+static void runHelp( uint32_t iterations ) {
+    runCommand( "help", iterations );
+}
+
+
+static void runLogs( uint32_t iterations ) {
+    runCommand( "logs", iterations );
+}
+
+
+static void runNetStatus( uint32_t iterations ) {
+    runCommand( "net status", iterations );
+}
+
+
+static const BenchCase _cases[] = {
+    { "Console 'help'",                         nullptr,            runHelp,                    0 },
+    { "Console 'logs'",                         prepareLogs,        runLogs,                    0 },
+    { "Console 'net status'",                   nullptr,            runNetStatus,               0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the console output benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchConsoleCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_envelope.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <drivers/envelope.h>
+#include "bench.h"
+
+
+/* Custom curve with a rise, a dip and a plateau, covers the interpolation
+   between increasing, decreasing and equal points. */
+static const uint8_t _table[ ENVELOPE_TABLE_POINTS ] PROGMEM = {
+    0, 2, 8, 18, 32, 50, 72, 98, 128, 110, 90, 90, 90, 140, 200, 240, 255
+};
+
+static Envelope _envelope( 0 );
+
+
+
+uint16_t BenchAccess::envelopeLevel( Envelope* envelope, uint16_t position ) {
+    return envelope->getLevel( position );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Check the level of the custom curve at and between its points.
+ *
+ * @return  TRUE if the curve is valid, FALSE otherwise.
+ *
+ */
+static bool checkTableCurve() {
+    _envelope.start( 0, 255, 1000, ENVELOPE_CURVE_TABLE, _table );
+
+    for( uint32_t position = 0; position <= 0xFFFF; position++ ) {
+        uint8_t index = position >> 12;
+        uint16_t level = BenchAccess::envelopeLevel( &_envelope, position );
+
+        /* Points are 8 bits levels, 255 is the end value (0xFFFF) */
+        uint16_t a = pgm_read_byte( &_table[ index ] ) * 257;
+        uint16_t b = pgm_read_byte( &_table[ index + 1 ] ) * 257;
+
+        if(( position & 0x0FFF ) == 0 && level != a ) {
+            snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "table point %u is %u instead of %u",
+                      index, level, a );
+            return false;
+        }
+
+        if( level < min( a, b ) || level > max( a, b )) {
+            snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "table level %u at 0x%04X, outside %u-%u",
+                      level, ( unsigned int )position, min( a, b ), max( a, b ));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Check the perceptual curve follows the square of the position.
+ *
+ * @return  TRUE if the curve is valid, FALSE otherwise.
+ *
+ */
+static bool checkPerceptualCurve() {
+    _envelope.start( 0, 255, 1000, ENVELOPE_CURVE_PERCEPTUAL );
+
+    uint16_t last = 0;
+
+    for( uint32_t position = 0; position <= 0xFFFF; position++ ) {
+        uint16_t level = BenchAccess::envelopeLevel( &_envelope, position );
+        double expected = ( double )position * position / 0xFFFF;
+
+        if( level < last || level < expected - 2 || level > expected + 2 ) {
+            snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "perceptual level %u at 0x%04X, expected %.0f",
+                      level, ( unsigned int )position, expected );
+            return false;
+        }
+
+        last = level;
+    }
+
+    /* A decreasing ramp starts on the start value and is one step from the
+       end value at the last position, update() writes the end value. */
+    _envelope.start( 100, 10, 1000, ENVELOPE_CURVE_PERCEPTUAL );
+
+    if( _envelope.getValue( 0 ) != 100 || _envelope.getValue( 0xFFFF ) > 11 ) {
+        snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "ramp 100 to 10 goes from %u to %u",
+                  _envelope.getValue( 0 ), _envelope.getValue( 0xFFFF ));
+        return false;
+    }
+
+    return true;
+}
+
+
+static void prepareCurves( uint32_t iterations ) {
+    ( void )iterations;
+
+    static bool checked = false;
+    if( checked == true ) {
+        return;
+    }
+
+    checked = true;
+
+    if( checkTableCurve() == false || checkPerceptualCurve() == false ) {
+        g_benchFailed = true;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Calculate the output value of a ramp at evenly spaced positions.
+ *
+ * @param   iterations    Number of values
+ * @param   curve         Envelope curve (ENVELOPE_CURVE_*)
+ *
+ */
+static void runCurve( uint32_t iterations, uint8_t curve ) {
+    uint32_t sum = 0;
+
+    _envelope.start( 0, 100, 1000, curve, _table );
+
+    while( iterations-- ) {
+        sum += _envelope.getValue( iterations * 0x9E37 );
+    }
+
+    g_benchSink = sum;
+}
+
+
+static void runLinear( uint32_t iterations ) {
+    runCurve( iterations, ENVELOPE_CURVE_LINEAR );
+}
+
+
+static void runPerceptual( uint32_t iterations ) {
+    runCurve( iterations, ENVELOPE_CURVE_PERCEPTUAL );
+}
+
+
+static void runTable( uint32_t iterations ) {
+    runCurve( iterations, ENVELOPE_CURVE_TABLE );
+}
+
+
+static const BenchCase _cases[] = {
+    { "Envelope value (linear)",                prepareCurves,      runLinear,                  0 },
+    { "Envelope value (perceptual)",            prepareCurves,      runPerceptual,              0 },
+    { "Envelope value (table)",                 prepareCurves,      runTable,                   0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the envelope engine benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchEnvelopeCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_ftp.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <drivers/sdcard.h>
+#include <services/ftpserver.h>
+#include "../native/src/hostnet.h"
+#include "bench.h"
+
+
+/* Local port of the emulated FTP client data connection */
+#define BENCH_FTP_PORT              18200
+
+#define BENCH_FTP_DIR               "bench_ftp"
+
+/* Number of files in the listed directory */
+#define BENCH_FTP_FILES             32
+
+
+static TCPClient _data;
+static int _listenFd = -1;
+static int _clientFd = -1;
+
+
+
+void BenchAccess::ftpSendDirectoryEntry( TCPClient* client, FsFile* file, uint8_t listType ) {
+    g_ftpServer.sendDirectoryEntry( client, file, nullptr, listType );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Connect the data connection to a loopback socket acting as the
+ *          FTP client.
+ *
+ */
+static void connectLoopback() {
+    IPAddress localhost( 127, 0, 0, 1 );
+
+    _listenFd = hostnetSocket( true );
+    if( _listenFd < 0 || hostnetBind( _listenFd, localhost, _htons( BENCH_FTP_PORT )) < 0
+                      || hostnetListen( _listenFd, 1 ) < 0 ) {
+
+        fprintf( stderr, "bench: cannot listen on port %d\n", BENCH_FTP_PORT );
+        exit( 1 );
+    }
+
+    _data.connect( localhost, BENCH_FTP_PORT );
+
+    unsigned long start = millis();
+    while( _clientFd < 0 || _data.connected() == 0 ) {
+
+        if( _clientFd < 0 ) {
+            uint32_t addr;
+            uint16_t port;
+            _clientFd = hostnetAccept( _listenFd, &addr, &port );
+        }
+
+        if( millis() - start > 2000 ) {
+            fprintf( stderr, "bench: FTP loopback connection failed\n" );
+            exit( 1 );
+        }
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Create the listed directory and open the data connection.
+ *
+ */
+static void prepareListing( uint32_t iterations ) {
+    ( void )iterations;
+
+    if( _clientFd >= 0 ) {
+        return;
+    }
+
+    g_sdcard.mkdir( BENCH_FTP_DIR );
+
+    for( uint8_t i = 0; i < BENCH_FTP_FILES; i++ ) {
+        char name[ 64 ];
+        snprintf( name, sizeof( name ), BENCH_FTP_DIR "/Alarm sound %02d - long file name.mp3", i );
+
+        FsFile file;
+        file.open( name, O_CREAT | O_WRITE | O_TRUNC );
+        file.write( name, strlen( name ));
+        file.close();
+    }
+
+    connectLoopback();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send the listing of the directory on the data connection, one
+ *          entry at a time like the FTP server listing task does.
+ *
+ * @param   iterations    Number of listings
+ * @param   listType      Type of listing (FTP_LIST_TYPE_xxx)
+ *
+ */
+static void runListing( uint32_t iterations, uint8_t listType ) {
+    uint8_t buffer[ 1024 ];
+    uint32_t bytes = 0;
+    uint32_t count = iterations;
+
+    while( iterations-- ) {
+        FsFile dir;
+        dir.open( BENCH_FTP_DIR, O_READ );
+
+        while( true ) {
+            FsFile file;
+            file.openNext( &dir, O_READ );
+
+            if( file.isOpen() == false ) {
+                break;
+            }
+
+            BenchAccess::ftpSendDirectoryEntry( &_data, &file, listType );
+        }
+
+        dir.close();
+
+        /* Drain the client side so the socket buffer never fills */
+        int length;
+        while(( length = hostnetRecv( _clientFd, buffer, sizeof( buffer ))) > 0 ) {
+            bytes += length;
+        }
+    }
+
+    if( _data.connected() == 0 ) {
+        fprintf( stderr, "bench: FTP loopback connection lost\n" );
+        exit( 1 );
+    }
+
+    g_benchSink = bytes;
+    g_benchBytes = bytes / count;
+}
+
+
+static void runListingUnix( uint32_t iterations ) {
+    runListing( iterations, FTP_LIST_TYPE_UNIX );
+}
+
+
+static void runListingMachine( uint32_t iterations ) {
+    runListing( iterations, FTP_LIST_TYPE_MACHINE );
+}
+
+
+static const BenchCase _cases[] = {
+    { "FTP LIST (32 files)",                    prepareListing,     runListingUnix,             0 },
+    { "FTP MLSD (32 files)",                    prepareListing,     runListingMachine,          0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the FTP server benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchFtpCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
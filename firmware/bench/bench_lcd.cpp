@@ -0,0 +1,99 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_lcd.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <drivers/us2066.h>
+#include "bench.h"
+
+
+/* Typical payload received from Home Assistant (weather / sensor display) */
+#define BENCH_LCD_SAMPLE    "Ext\xC3\xA9rieur : -12.5\xC2\xB0""C \xC2\xAB Nuageux \xC2\xBB \xE2\x89\xA5 80% \xCE\xBC"
+
+static char _buffer[ sizeof( BENCH_LCD_SAMPLE ) ];
+
+
+
+static void runUtf8ToLcdCharset( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        memcpy( _buffer, BENCH_LCD_SAMPLE, sizeof( _buffer ));
+        utf8ToLcdCharset( _buffer, sizeof( _buffer ) - 1 );
+
+        sum += ( uint8_t )_buffer[ 3 ];
+    }
+
+    g_benchSink = sum;
+}
+
+
+static void prepareFlush( uint32_t iterations ) {
+    ( void )iterations;
+
+    g_lcd.begin();
+    g_lcd.clear();
+    g_lcd.print_P( PSTR( "  12:34:56 PM   " ));
+    g_lcd.setPosition( 1, 0 );
+    g_lcd.print_P( PSTR( "Sat Oct 17  21\xDF""C" ));
+    g_lcd.flush();
+    g_twi.processEvents();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Redraw the clock screen where only the seconds changed, then 
+ *          queue the frame and complete the transfers like the main 
+ *          loop does.
+ *
+ */
+static void runFlushSeconds( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        g_lcd.setPosition( 0, 0 );
+        g_lcd.printf_P( PSTR( "  12:34:%02u PM   " ), iterations % 60 );
+        g_lcd.setPosition( 1, 0 );
+        g_lcd.print_P( PSTR( "Sat Oct 17  21\xDF""C" ));
+        g_lcd.flush();
+        g_twi.processEvents();
+
+        sum += g_lcd.getLastFrameTransactions();
+    }
+
+    g_benchSink = sum;
+}
+
+
+static const BenchCase _cases[] = {
+    { "utf8ToLcdCharset",                       nullptr,            runUtf8ToLcdCharset,        0 },
+    { "US2066 frame flush (seconds changed)",   prepareFlush,       runFlushSeconds,            0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the LCD driver benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchLcdCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
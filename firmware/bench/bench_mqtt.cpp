@@ -0,0 +1,360 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_mqtt.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <services/mqtt.h>
+#include <services/homeassistant.h>
+#include "../native/src/hostnet.h"
+#include "bench.h"
+
+
+/* Local port of the emulated broker */
+#define BENCH_MQTT_PORT             18830
+
+/* Maximum number of packets queued on the loopback connection */
+#define BENCH_MQTT_MAX_PACKETS      1000
+
+#define BENCH_MQTT_TOPIC            "homeassistant/light/clock-v3/lamp/set"
+#define BENCH_MQTT_PAYLOAD          "{\"state\":\"ON\",\"brightness\":128}"
+
+/* Size of the emulated broker receive buffer */
+#define BENCH_BROKER_BUFFER_SIZE    2048
+
+
+static int _listenFd = -1;
+static int _brokerFd = -1;
+static uint32_t _received = 0;
+
+static uint8_t _brokerBuffer[ BENCH_BROKER_BUFFER_SIZE ];
+static size_t _brokerLength = 0;
+static uint32_t _brokerBytes = 0;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Encode a PUBLISH packet in the client buffer, like publish()
+ *          does without sending it.
+ *
+ * @param   topic      Message topic
+ * @param   payload    Message payload
+ *
+ * @return  Encoded packet length
+ *
+ */
+size_t BenchAccess::mqttEncodePublish( char* topic, char* payload ) {
+    size_t remainingLength = strlen( topic ) + 2 + 2 + strlen( payload );
+
+    g_mqtt.allocBuffer( MQTT_MAX_FIXED_HEADER_LENGTH + remainingLength );
+
+    g_mqtt.writeFixedHeader( MQTT_PACKET_PUBLISH, MQTT_PUB_FLAGS_QOS_1, remainingLength );
+    g_mqtt.writeString( topic, true );
+    g_mqtt.writeInt16( 1 );
+    g_mqtt.writeString( payload, false );
+
+    size_t length = g_mqtt._bufferPos;
+    g_mqtt.freeBuffer();
+
+    return length;
+}
+
+
+void BenchAccess::mqttConnect( IPAddress ip, uint16_t port ) {
+    g_mqtt._tcp.connect( ip, port );
+}
+
+
+bool BenchAccess::mqttConnected() {
+    return g_mqtt._tcp.connected() != 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Mark the client connected to the broker, without the CONNECT
+ *          handshake.
+ *
+ */
+void BenchAccess::mqttAttach() {
+    g_mqtt._init = true;
+    g_mqtt._connected = true;
+}
+
+
+void BenchAccess::hassSendConfig() {
+    g_homeassistant.beginSendSensorConfig();
+}
+
+
+void BenchAccess::mqttPoll() {
+    g_mqtt.poll();
+
+    if( g_mqtt._tcp.connected() == 0 ) {
+        fprintf( stderr, "bench: MQTT loopback connection lost\n" );
+        exit( 1 );
+    }
+}
+
+
+static void onPublishReceived( char* topic, size_t topicLength, char* payload, size_t payloadLength, bool retain ) {
+    ( void )topic;
+    ( void )topicLength;
+    ( void )payload;
+    ( void )payloadLength;
+    ( void )retain;
+
+    _received++;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Connect the MQTT client to a loopback socket acting as the 
+ *          broker.
+ *
+ */
+static void connectLoopback() {
+    IPAddress localhost( 127, 0, 0, 1 );
+
+    _listenFd = hostnetSocket( true );
+    if( _listenFd < 0 || hostnetBind( _listenFd, localhost, _htons( BENCH_MQTT_PORT )) < 0 
+                      || hostnetListen( _listenFd, 1 ) < 0 ) {
+
+        fprintf( stderr, "bench: cannot listen on port %d\n", BENCH_MQTT_PORT );
+        exit( 1 );
+    }
+
+    BenchAccess::mqttConnect( localhost, BENCH_MQTT_PORT );
+    g_mqtt.setPublishReceiveCallback( onPublishReceived );
+
+    unsigned long start = millis();
+    while( _brokerFd < 0 || BenchAccess::mqttConnected() == false ) {
+
+        if( _brokerFd < 0 ) {
+            uint32_t addr;
+            uint16_t port;
+            _brokerFd = hostnetAccept( _listenFd, &addr, &port );
+        }
+
+        if( millis() - start > 2000 ) {
+            fprintf( stderr, "bench: MQTT loopback connection failed\n" );
+            exit( 1 );
+        }
+    }
+}
+
+
+static void runEncodePublish( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        sum += BenchAccess::mqttEncodePublish(( char* )BENCH_MQTT_TOPIC, ( char* )BENCH_MQTT_PAYLOAD );
+    }
+
+    g_benchSink = sum;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Queue QoS 0 PUBLISH packets on the broker side of the 
+ *          connection.
+ *
+ */
+static void preparePoll( uint32_t iterations ) {
+    uint8_t packet[ 128 ];
+    size_t topicLength = strlen( BENCH_MQTT_TOPIC );
+    size_t payloadLength = strlen( BENCH_MQTT_PAYLOAD );
+
+    if( _brokerFd < 0 ) {
+        connectLoopback();
+    }
+
+    packet[ 0 ] = ( MQTT_PACKET_PUBLISH << 4 ) | MQTT_PUB_FLAGS_QOS_0;
+    packet[ 1 ] = 2 + topicLength + payloadLength;
+    packet[ 2 ] = 0;
+    packet[ 3 ] = topicLength;
+    memcpy( packet + 4, BENCH_MQTT_TOPIC, topicLength );
+    memcpy( packet + 4 + topicLength, BENCH_MQTT_PAYLOAD, payloadLength );
+
+    size_t length = 4 + topicLength + payloadLength;
+
+    while( iterations-- ) {
+        if( hostnetSend( _brokerFd, packet, length ) != ( int )length ) {
+            fprintf( stderr, "bench: MQTT loopback send failed\n" );
+            exit( 1 );
+        }
+    }
+
+    _received = 0;
+}
+
+
+static void runPoll( uint32_t iterations ) {
+    while( _received < iterations ) {
+        BenchAccess::mqttPoll();
+    }
+
+    g_benchSink = _received;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Emulated broker : read the packets sent by the client and 
+ *          acknowledge the QoS 1 PUBLISH and the SUBSCRIBE packets.
+ *
+ */
+static void brokerPump() {
+    int length = hostnetRecv( _brokerFd, _brokerBuffer + _brokerLength, sizeof( _brokerBuffer ) - _brokerLength );
+    if( length > 0 ) {
+        _brokerLength += length;
+        _brokerBytes += length;
+    }
+
+    while( _brokerLength >= 2 ) {
+
+        /* Decode the remaining length */
+        size_t remaining = 0;
+        size_t pos = 1;
+        uint8_t shift = 0;
+        uint8_t encoded;
+
+        do {
+            if( pos >= _brokerLength ) {
+                return;
+            }
+
+            encoded = _brokerBuffer[ pos++ ];
+            remaining |= ( size_t )( encoded & 0x7F ) << shift;
+            shift += 7;
+
+        } while(( encoded & 0x80 ) != 0 );
+
+        if( pos + remaining > _brokerLength ) {
+            if( pos + remaining > sizeof( _brokerBuffer )) {
+                fprintf( stderr, "bench: MQTT packet too large for the emulated broker\n" );
+                exit( 1 );
+            }
+
+            return;
+        }
+
+        uint8_t type = _brokerBuffer[ 0 ] >> 4;
+        uint8_t* data = _brokerBuffer + pos;
+        uint8_t ack[ 5 ];
+        size_t ackLength = 0;
+
+        if( type == MQTT_PACKET_PUBLISH && ( _brokerBuffer[ 0 ] & MQTT_PUB_FLAGS_QOS_1 ) != 0 ) {
+            size_t topicLength = ( data[ 0 ] << 8 ) | data[ 1 ];
+
+            ack[ 0 ] = MQTT_PACKET_PUBACK << 4;
+            ack[ 1 ] = 2;
+            ack[ 2 ] = data[ 2 + topicLength ];
+            ack[ 3 ] = data[ 3 + topicLength ];
+            ackLength = 4;
+
+        } else if( type == MQTT_PACKET_SUBSCRIBE ) {
+            ack[ 0 ] = MQTT_PACKET_SUBACK << 4;
+            ack[ 1 ] = 3;
+            ack[ 2 ] = data[ 0 ];
+            ack[ 3 ] = data[ 1 ];
+            ack[ 4 ] = MQTT_QOS_0;
+            ackLength = 5;
+        }
+
+        if( ackLength > 0 && hostnetSend( _brokerFd, ack, ackLength ) != ( int )ackLength ) {
+            fprintf( stderr, "bench: MQTT loopback send failed\n" );
+            exit( 1 );
+        }
+
+        _brokerLength -= pos + remaining;
+        memmove( _brokerBuffer, _brokerBuffer + pos + remaining, _brokerLength );
+    }
+}
+
+
+static void prepareDiscovery( uint32_t iterations ) {
+    ( void )iterations;
+
+    if( _brokerFd < 0 ) {
+        connectLoopback();
+    }
+
+    BenchAccess::mqttAttach();
+    g_homeassistant.begin();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Publish the Home Assistant discovery configuration of all the 
+ *          sensors. The Home Assistant and MQTT services are dispatched like
+ *          the main loop does, each pass followed by the rest of the loop 
+ *          pass (BENCH_LOOP_PASS_US).
+ *
+ */
+static void runDiscovery( uint32_t iterations ) {
+    uint32_t passes = 0;
+    uint32_t bytes = _brokerBytes;
+    uint32_t count = iterations;
+
+    while( iterations-- ) {
+        BenchAccess::hassSendConfig();
+
+        while( g_homeassistant.getCurrentTask() == TASK_HOMEASSISTANT_SEND_SENSOR_CONFIG ) {
+            unsigned long now = millis();
+
+            if( g_mqtt.isRunnable( now ) == true ) {
+                g_mqtt.dispatch( now );
+            }
+
+            if( g_homeassistant.isRunnable( now ) == true ) {
+                g_homeassistant.dispatch( now );
+            }
+
+            brokerPump();
+            benchLoopPass();
+
+            passes++;
+        }
+    }
+
+    g_benchSink = passes;
+    g_benchBytes = ( _brokerBytes - bytes ) / count;
+}
+
+
+static const BenchCase _cases[] = {
+    { "MQTT encode PUBLISH",                    nullptr,            runEncodePublish,           0 },
+    { "MqttClient::poll (PUBLISH)",             preparePoll,        runPoll,                    BENCH_MQTT_MAX_PACKETS },
+    { "Home Assistant discovery",               prepareDiscovery,   runDiscovery,               0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the MQTT benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchMqttCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
@@ -0,0 +1,229 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_neopixel.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <native.h>
+#include <drivers/neopixel.h>
+#include "bench.h"
+
+
+/* Duration of a SPI bit at 2.67 MHz (ns) */
+#define BENCH_SPI_BIT_TIME      375
+
+/* WS2812 timings (ns), datasheet value +/- 150 ns */
+#define BENCH_WS2812_T0H        400
+#define BENCH_WS2812_T1H        800
+#define BENCH_WS2812_T0L        850
+#define BENCH_WS2812_T1L        450
+#define BENCH_WS2812_TOLERANCE  150
+
+/* Encoded frame of the clock display */
+#define BENCH_NEOPIXEL_PIXELS   34
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Pixels on the USART output, exposes the frame output.
+ *
+ *******************************************************************************/
+class BenchNeoPixel : public NeoPixel {
+
+  public:
+    BenchNeoPixel() : NeoPixel( -1, -1, NEOPIXEL_OUTPUT_USART1 ) {}
+
+    void update() {}
+
+    void send( const uint8_t *pixmap, uint8_t num_pixels, const volatile uint8_t *color ) {
+        this->showUSART( pixmap, num_pixels, color );
+    }
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Receives the SPI bitstream sent to the pixels.
+ *
+ *******************************************************************************/
+class BenchUSARTCapture : public NativeUSARTDevice {
+
+  public:
+    void onTransmit( uint8_t data ) {
+        if( length < sizeof( frame )) {
+            frame[ length++ ] = data;
+        }
+    }
+
+    uint8_t frame[ BENCH_NEOPIXEL_PIXELS * 3 * NEOPIXEL_SPI_COMP_SIZE ];
+    uint16_t length = 0;
+};
+
+
+static BenchNeoPixel _pixels;
+static BenchUSARTCapture _capture;
+
+
+
+static bool checkTiming( uint16_t time, uint16_t expected ) {
+    return time >= expected - BENCH_WS2812_TOLERANCE && time <= expected + BENCH_WS2812_TOLERANCE;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Decode a WS2812 byte from the captured SPI bitstream and check
+ *          the high/low time of each bit against the datasheet.
+ *
+ * @param   offset    Position of the byte in the bitstream (WS2812 bytes)
+ * @param   value     Receives the decoded byte
+ *
+ * @return  TRUE if every bit is within the specifications, FALSE otherwise.
+ *
+ */
+static bool decodeCapture( uint8_t offset, uint8_t *value ) {
+    const uint8_t *buffer = &_capture.frame[ offset * NEOPIXEL_SPI_COMP_SIZE ];
+
+    *value = 0;
+
+    for( uint8_t i_bit = 0; i_bit < 8; i_bit++ ) {
+        uint16_t high = 0;
+        uint16_t low = 0;
+
+        for( uint8_t i = 0; i < NEOPIXEL_SPI_BITS; i++ ) {
+            uint8_t pos = i_bit * NEOPIXEL_SPI_BITS + i;
+            bool level = ( buffer[ pos / 8 ] >> ( 7 - pos % 8 )) & 0x01;
+
+            if( level == true && low > 0 ) {
+                high = 0;
+                break;
+            }
+
+            if( level == true ) {
+                high += BENCH_SPI_BIT_TIME;
+            } else {
+                low += BENCH_SPI_BIT_TIME;
+            }
+        }
+
+        bool one = checkTiming( high, BENCH_WS2812_T1H ) && checkTiming( low, BENCH_WS2812_T1L );
+        bool zero = checkTiming( high, BENCH_WS2812_T0H ) && checkTiming( low, BENCH_WS2812_T0L );
+
+        if( one == false && zero == false ) {
+            snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "bit %u out of spec, %u ns high, %u ns low",
+                      7 - i_bit, high, low );
+            return false;
+        }
+
+        *value = ( *value << 1 ) | ( one ? 1 : 0 );
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a lit and an unlit pixel for every color component value 
+ *          and check that the output decodes to the same frame.
+ *
+ */
+static void prepareEncodeSPI( uint32_t iterations ) {
+    ( void )iterations;
+
+    static bool checked = false;
+    if( checked == true ) {
+        return;
+    }
+
+    checked = true;
+    nativeRegisterUSARTDevice( NEOPIXEL_OUTPUT_USART1, &_capture );
+
+    const uint8_t pixmap[] = { 0x01 };
+
+    for( uint16_t value = 0; value < 256; value++ ) {
+        volatile uint8_t color[] = { ( uint8_t )value, ( uint8_t )~value, ( uint8_t )( value * 7 ) };
+
+        _capture.length = 0;
+        _pixels.send( pixmap, 2, color );
+
+        if( _capture.length != 2 * 3 * NEOPIXEL_SPI_COMP_SIZE ) {
+            snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "%u bytes sent instead of %u",
+                      _capture.length, 2 * 3 * NEOPIXEL_SPI_COMP_SIZE );
+            g_benchFailed = true;
+            return;
+        }
+
+        for( uint8_t i = 0; i < 6; i++ ) {
+            uint8_t expected = ( i < 3 ) ? color[ i ] : 0;
+            uint8_t decoded;
+
+            if( decodeCapture( i, &decoded ) == false ) {
+                g_benchFailed = true;
+                return;
+            }
+
+            if( decoded != expected ) {
+                snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "value %u decoded as %u", expected, decoded );
+                g_benchFailed = true;
+                return;
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a clock display frame through the USART output.
+ *
+ */
+static void runEncodeSPI( uint32_t iterations ) {
+    static const uint8_t pixmap[] = { 0xB6, 0x6D, 0xDB, 0xB6, 0x03 };
+    volatile uint8_t color[] = { 0x20, 0x80, 0x10 };
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        color[ 0 ] = iterations;
+
+        _capture.length = 0;
+        _pixels.send( pixmap, BENCH_NEOPIXEL_PIXELS, color );
+
+        sum += _capture.frame[ iterations % sizeof( _capture.frame ) ];
+    }
+
+    g_benchSink = sum;
+    g_benchBytes = sizeof( _capture.frame );
+}
+
+
+static const BenchCase _cases[] = {
+    { "WS2812 SPI encode (34 pixels frame)",    prepareEncodeSPI,   runEncodeSPI,               0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the NeoPixel driver benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchNeoPixelCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
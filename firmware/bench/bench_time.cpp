@@ -0,0 +1,188 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_time.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <time.h>
+#include <timezone.h>
+#include <tzdata.h>
+#include <config.h>
+#include "bench.h"
+
+
+#define NUM_SAMPLE_DATES            16
+
+static DateTime _dates[ NUM_SAMPLE_DATES ];
+static TimeZone _tz;
+static char _zoneNames[ MAX_TIMEZONE_ID ][ MAX_TZ_NAME_LENGTH + 1 ];
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Fill the sample dates, spread over several years and around the
+ *          DST transitions.
+ *
+ */
+static void prepareDates( uint32_t iterations ) {
+    ( void )iterations;
+
+    for( uint8_t i = 0; i < NUM_SAMPLE_DATES; i++ ) {
+        _dates[ i ].set( 2000 + i * 3, ( i % 12 ) + 1, ( i * 7 ) % 28 + 1, i % 24, ( i * 13 ) % 60, i );
+    }
+
+    _tz.setTimezoneByName(( char* )"America/Toronto" );
+}
+
+
+static void runDateTimeAdd( uint32_t iterations ) {
+    DateTime dt( 2023, 3, 12, 1, 0, 0 );
+
+    while( iterations-- ) {
+        dt += 61;
+    }
+
+    g_benchSink = dt.minute();
+}
+
+
+static void runDateTimeSub( uint32_t iterations ) {
+    DateTime dt( 2023, 11, 5, 3, 0, 0 );
+
+    while( iterations-- ) {
+        dt -= 61;
+    }
+
+    g_benchSink = dt.minute();
+}
+
+
+static void runDateTimeGetEpoch( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        sum += _dates[ iterations % NUM_SAMPLE_DATES ].getEpoch();
+    }
+
+    g_benchSink = sum;
+}
+
+
+static void runGetDayOfWeek( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        sum += getDayOfWeek( 1970 + iterations % 100, iterations % 12 + 1, iterations % 28 + 1 );
+    }
+
+    g_benchSink = sum;
+}
+
+
+static void runTimeZoneToLocal( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        DateTime dt( &_dates[ iterations % NUM_SAMPLE_DATES ] );
+
+        _tz.toLocal( &dt );
+        sum += dt.hour();
+    }
+
+    g_benchSink = sum;
+}
+
+
+static void runTimeZoneIsDST( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        sum += _tz.isDST( &_dates[ iterations % NUM_SAMPLE_DATES ] );
+    }
+
+    g_benchSink = sum;
+}
+
+
+static void runTimeZoneGetTransition( uint32_t iterations ) {
+    uint32_t sum = 0;
+    DateTime dt;
+
+    while( iterations-- ) {
+        _tz.getTransition( 2000 + iterations % 50, iterations & 1, &dt );
+        sum += dt.day();
+    }
+
+    g_benchSink = sum;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Copy the name of every timezone to RAM, findTimezoneByName 
+ *          expects a name in SRAM.
+ *
+ */
+static void prepareZoneNames( uint32_t iterations ) {
+    ( void )iterations;
+
+    TimeZone tz;
+
+    for( uint16_t i = 0; i < MAX_TIMEZONE_ID; i++ ) {
+        tz.setTimezoneByID( i );
+        strncpy_P( _zoneNames[ i ], tz.getName(), MAX_TZ_NAME_LENGTH );
+        _zoneNames[ i ][ MAX_TZ_NAME_LENGTH ] = '\0';
+    }
+}
+
+
+static void runFindTimezoneByName( uint32_t iterations ) {
+    uint32_t sum = 0;
+
+    while( iterations-- ) {
+        for( uint16_t i = 0; i < MAX_TIMEZONE_ID; i++ ) {
+            sum += findTimezoneByName( _zoneNames[ i ] );
+        }
+    }
+
+    g_benchSink = sum;
+}
+
+
+static const BenchCase _cases[] = {
+    { "DateTime::operator+=",                   nullptr,            runDateTimeAdd,             0 },
+    { "DateTime::operator-=",                   nullptr,            runDateTimeSub,             0 },
+    { "DateTime::getEpoch",                     prepareDates,       runDateTimeGetEpoch,        0 },
+    { "getDayOfWeek",                           nullptr,            runGetDayOfWeek,            0 },
+    { "TimeZone::toLocal",                      prepareDates,       runTimeZoneToLocal,         0 },
+    { "TimeZone::isDST",                        prepareDates,       runTimeZoneIsDST,           0 },
+    { "TimeZone::getTransition",                prepareDates,       runTimeZoneGetTransition,   0 },
+    { "findTimezoneByName (all zones)",         prepareZoneNames,   runFindTimezoneByName,      0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the time and timezone benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchTimeCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
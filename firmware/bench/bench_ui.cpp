@@ -0,0 +1,278 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : bench/bench_ui.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <hardware.h>
+#include <native.h>
+#include <drivers/qt1070.h>
+#include <alarm.h>
+#include <ui/ui.h>
+#include "../native/src/qt1070.h"
+#include "bench.h"
+
+
+static NativeQT1070 _keypad( I2C_ADDR_AT42QT1070, PIN_INT_KEYPAD );
+
+/* Main loop interrupt event dispatcher (src/main.cpp) */
+void dispatchInterruptEvents();
+
+
+
+void BenchAccess::alarmSnooze( uint16_t elapsed ) {
+    g_alarm._playMode = ALARM_MODE_SCREEN | ALARM_MODE_SNOOZE;
+    g_alarm._snoozeStart = g_rtc.getEpoch() - elapsed;
+}
+
+
+void BenchAccess::alarmStop() {
+    g_alarm._playMode = ALARM_MODE_OFF;
+    g_alarm._snoozeStart = 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Run the keypad and screen services like the main loop does.
+ *
+ */
+static void runScreenServices() {
+    nativePollInterrupts();
+
+    g_twi.processEvents();
+    dispatchInterruptEvents();
+    g_screen.processEvents();
+    g_screen.update();
+}
+
+
+static void prepareMenu( uint32_t iterations ) {
+    ( void )iterations;
+
+    static bool initialized = false;
+    if( initialized == true ) {
+        return;
+    }
+
+    nativeRegisterI2CDevice( &_keypad );
+    g_keypad.begin();
+
+    g_screen.activate( &screen_main_menu );
+    g_screen.update();
+
+    initialized = true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Touch and release the 'next' key, from the change interrupt 
+ *          to the end of the screen update.
+ *
+ */
+static void runMenuKeypress( uint32_t iterations ) {
+    while( iterations-- ) {
+        _keypad.setKeys( KEY_NEXT );
+        runScreenServices();
+
+        _keypad.setKeys( KEY_NONE );
+        runScreenServices();
+    }
+
+    g_benchSink = g_screen.getSelectedItemIndex();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Enter the root screen from the main menu and go back, the
+ *          screens use different custom character sets.
+ *
+ */
+static void runScreenSwitch( uint32_t iterations ) {
+    while( iterations-- ) {
+        g_screen.activate( &screen_root );
+        g_screen.activate( NULL );
+    }
+
+    g_benchSink = g_screen.getId();
+}
+
+
+static void prepareRoot( uint32_t iterations ) {
+    prepareMenu( iterations );
+
+    if( g_screen.getId() != SCREEN_ID_ROOT ) {
+        g_screen.activate( &screen_root );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Refresh the active screen once per iteration, each iteration 
+ *          being one second, and report the I2C bytes sent to the display
+ *          per second.
+ *
+ * @param   iterations    Number of seconds
+ * @param   regions       Regions to invalidate or 0 to request a full update.
+ * @param   tick          Function called before each refresh to advance the 
+ *                        screen contents by one second or NULL.
+ *
+ */
+static void runScreenRefresh( uint32_t iterations, uint8_t regions, void ( *tick )( uint32_t )) {
+    uint32_t count = iterations;
+    uint32_t bytes = g_twi.getByteCount();
+
+    for( uint32_t second = 0; second < count; second++ ) {
+        if( tick != NULL ) {
+            tick( second );
+        }
+
+        if( regions != 0 ) {
+            g_screen.invalidateRegion( regions );
+
+        } else {
+            g_screen.requestScreenUpdate( false );
+        }
+
+        g_screen.update();
+        g_twi.processEvents();
+    }
+
+    bytes = g_twi.getByteCount() - bytes;
+
+    snprintf( g_benchNote, BENCH_MAX_NOTE_LENGTH, "I2C %.1f B/s", ( float )bytes / count );
+
+    g_benchSink = bytes;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Root screen refresh of the clock tick, only the date and the
+ *          status icons are redrawn.
+ *
+ */
+static void runRootClockTick( uint32_t iterations ) {
+    runScreenRefresh( iterations, ROOT_REGION_DATE | ROOT_REGION_STATUS, NULL );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Root screen clock tick redrawing the whole screen, like it did
+ *          before the screen regions.
+ *
+ */
+static void runRootFullUpdate( uint32_t iterations ) {
+    runScreenRefresh( iterations, 0, NULL );
+}
+
+
+static void prepareAlarm( uint32_t iterations ) {
+    prepareMenu( iterations );
+
+    g_alarm.profile.snoozeDelay = 10;
+    BenchAccess::alarmSnooze( 0 );
+
+    if( g_screen.getId() != SCREEN_ID_ALARM ) {
+        g_screen.activate( &screen_alarm );
+        g_screen.update();
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Advance the snooze by one second, the countdown shown changes
+ *          once per minute.
+ *
+ * @param   second    Seconds since the start of the run
+ *
+ */
+static void tickSnooze( uint32_t second ) {
+    BenchAccess::alarmSnooze( second % ( g_alarm.profile.snoozeDelay * 60 ));
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Alarm screen refresh of the snooze countdown, only the time 
+ *          remaining is redrawn.
+ *
+ */
+static void runAlarmCountdown( uint32_t iterations ) {
+    runScreenRefresh( iterations, ALARM_REGION_COUNTDOWN, tickSnooze );
+
+    BenchAccess::alarmStop();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Alarm screen snooze countdown redrawing the whole screen, like 
+ *          it did before the screen regions.
+ *
+ */
+static void runAlarmFullUpdate( uint32_t iterations ) {
+    runScreenRefresh( iterations, 0, tickSnooze );
+
+    BenchAccess::alarmStop();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Draw every entry of the largest region of the timezone 
+ *          selection list.
+ *
+ */
+static void runTimezoneList( uint32_t iterations ) {
+    while( iterations-- ) {
+        for( uint16_t id = TZ_REGION_ASIA_INDEX; id < TZ_REGION_ASIA_INDEX + TZ_REGION_ASIA_SIZE; id++ ) {
+            g_lcd.setPosition( 0, 0 );
+            selectTimezone_onDrawItem( &g_screen, NULL, id, true, 0, 0 );
+        }
+    }
+
+    g_benchSink = g_lcd.getFrameCount();
+}
+
+
+static const BenchCase _cases[] = {
+    { "Keypress to screen update (menu)",       prepareMenu,        runMenuKeypress,            0 },
+    { "Screen switch (menu <-> root)",          prepareMenu,        runScreenSwitch,            0 },
+    { "Root screen clock tick",                 prepareRoot,        runRootClockTick,           0 },
+    { "Root screen clock tick (full update)",   prepareRoot,        runRootFullUpdate,          0 },
+    { "Alarm screen snooze countdown",          prepareAlarm,       runAlarmCountdown,          0 },
+    { "Alarm snooze countdown (full update)",   prepareAlarm,       runAlarmFullUpdate,         0 },
+    { "Timezone list draw (Asia, 64 entries)",  prepareMenu,        runTimezoneList,            0 },
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the user interface benchmark cases.
+ *
+ * @param   cases    Receives the pointer to the cases table.
+ * @param   count    Receives the number of cases.
+ *
+ */
+void benchUiCases( const BenchCase** cases, uint8_t* count ) {
+    *cases = _cases;
+    *count = sizeof( _cases ) / sizeof( _cases[ 0 ] );
+}
\ No newline at end of file
@@ -21,7 +21,7 @@
 
 #include <Arduino.h>
 #include <SPI.h>
-#include <Wire.h>
+#include "drivers/twi.h"
 #include <avr/wdt.h>
 #include <avr/pgmspace.h>
 #include "drivers/tpa2016.h"
@@ -66,6 +66,14 @@
 #define PIN_SYSOFF          A8
 
 
+// ----------------------------------------
+// NeoPixel outputs (NEOPIXEL_OUTPUT_USARTn
+// requires the data line on TXDn)
+// ----------------------------------------
+#define NEOCLOCK_OUTPUT     NEOPIXEL_OUTPUT_BITBANG
+#define LAMP_OUTPUT         NEOPIXEL_OUTPUT_BITBANG
+
+
 // ----------------------------------------
 // Devices I2C addresses
 // ----------------------------------------
@@ -0,0 +1,64 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : include/heap_sites.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef HEAP_SITES_H
+#define HEAP_SITES_H
+
+
+#include <Arduino.h>
+#include <heapstat.h>
+#include <mempool.h>
+#include "resources.h"
+
+
+
+/* Tracked heap allocation call sites */
+enum HeapSiteIDs {
+    HEAP_SITE_OTHER = HEAPSTAT_SITE_OTHER,
+    HEAP_SITE_MQTT_BUFFER,
+    HEAP_SITE_FTP_RESPONSE,
+    HEAP_SITE_FTP_LISTING,
+    HEAP_SITE_FTP_TRANSFER,
+    HEAP_SITE_SOCKET_BUFFER,
+    HEAP_SITE_HASS,
+    HEAP_SITE_SOUND_INDEX,
+
+    HEAP_SITE_COUNT
+};
+
+/* Call site names */
+PROG_STR( S_HEAP_SITE_OTHER,            "other" );
+PROG_STR( S_HEAP_SITE_MQTT_BUFFER,      "mqtt buffer" );
+PROG_STR( S_HEAP_SITE_FTP_RESPONSE,     "ftp reply" );
+PROG_STR( S_HEAP_SITE_FTP_LISTING,      "ftp listing" );
+PROG_STR( S_HEAP_SITE_FTP_TRANSFER,     "ftp transfer" );
+PROG_STR( S_HEAP_SITE_SOCKET_BUFFER,    "socket buffer" );
+PROG_STR( S_HEAP_SITE_HASS,             "hass" );
+PROG_STR( S_HEAP_SITE_SOUND_INDEX,      "sound index" );
+
+const char* const S_HEAP_SITE_NAMES[] PROGMEM = {
+    S_HEAP_SITE_OTHER,
+    S_HEAP_SITE_MQTT_BUFFER,
+    S_HEAP_SITE_FTP_RESPONSE,
+    S_HEAP_SITE_FTP_LISTING,
+    S_HEAP_SITE_FTP_TRANSFER,
+    S_HEAP_SITE_SOCKET_BUFFER,
+    S_HEAP_SITE_HASS,
+    S_HEAP_SITE_SOUND_INDEX,
+};
+
+#endif /* HEAP_SITES_H */
\ No newline at end of file
@@ -0,0 +1,52 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : include/isr_events.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef ISR_EVENTS_H
+#define ISR_EVENTS_H
+
+
+#include <eventqueue.h>
+
+
+
+/* Sources of the events queued by the interrupt handlers and dispatched
+   by the main loop (see g_events). */
+#define ISR_EVENT_RTC               0
+#define ISR_EVENT_KEYPAD            1
+#define ISR_EVENT_WIFI              2
+
+#define ISR_EVENT_SOURCE_COUNT      3
+
+
+#ifdef __cplusplus
+
+#include "resources.h"
+
+/* Source names */
+PROG_STR( S_ISR_EVENT_RTC,              "rtc" );
+PROG_STR( S_ISR_EVENT_KEYPAD,           "keypad" );
+PROG_STR( S_ISR_EVENT_WIFI,             "wifi" );
+
+const char* const S_ISR_EVENT_NAMES[] PROGMEM = {
+    S_ISR_EVENT_RTC,
+    S_ISR_EVENT_KEYPAD,
+    S_ISR_EVENT_WIFI,
+};
+
+#endif /* __cplusplus */
+
+#endif /* ISR_EVENTS_H */
\ No newline at end of file
@@ -0,0 +1,102 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : include/profiler_slots.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef PROFILER_SLOTS_H
+#define PROFILER_SLOTS_H
+
+
+#include <Arduino.h>
+#include <profiler.h>
+#include <scheduler.h>
+#include "resources.h"
+
+
+
+/* Main loop time budget (us) */
+#define LOOP_TIME_BUDGET            10000
+
+/* Profiled services in the main loop, in call order */
+enum ProfilerSlotIDs {
+    PROF_SLOT_POWER = 0,
+    PROF_SLOT_SDCARD,
+    PROF_SLOT_RTC,
+    PROF_SLOT_CLOCK,
+    PROF_SLOT_ALARM,
+    PROF_SLOT_SCREEN_EVENTS,
+    PROF_SLOT_SCREEN_UPDATE,
+    PROF_SLOT_LAMP,
+    PROF_SLOT_CONFIG,
+    PROF_SLOT_ALS,
+    PROF_SLOT_WIFI,
+    PROF_SLOT_CONSOLE,
+    PROF_SLOT_NTP,
+    PROF_SLOT_TELNET,
+    PROF_SLOT_FTP,
+    PROF_SLOT_MQTT,
+    PROF_SLOT_HOMEASSISTANT,
+    PROF_SLOT_STATUS_ICONS,
+
+    PROF_SLOT_COUNT
+};
+
+/* Slot names */
+PROG_STR( S_PROF_SLOT_POWER,            "power" );
+PROG_STR( S_PROF_SLOT_SDCARD,           "sdcard" );
+PROG_STR( S_PROF_SLOT_RTC,              "rtc" );
+PROG_STR( S_PROF_SLOT_CLOCK,            "clock" );
+PROG_STR( S_PROF_SLOT_ALARM,            "alarm" );
+PROG_STR( S_PROF_SLOT_SCREEN_EVENTS,    "screen evt" );
+PROG_STR( S_PROF_SLOT_SCREEN_UPDATE,    "screen upd" );
+PROG_STR( S_PROF_SLOT_LAMP,             "lamp" );
+PROG_STR( S_PROF_SLOT_CONFIG,           "config" );
+PROG_STR( S_PROF_SLOT_ALS,              "als" );
+PROG_STR( S_PROF_SLOT_WIFI,             "wifi" );
+PROG_STR( S_PROF_SLOT_CONSOLE,          "console" );
+PROG_STR( S_PROF_SLOT_NTP,              "ntp" );
+PROG_STR( S_PROF_SLOT_TELNET,           "telnet" );
+PROG_STR( S_PROF_SLOT_FTP,              "ftp" );
+PROG_STR( S_PROF_SLOT_MQTT,             "mqtt" );
+PROG_STR( S_PROF_SLOT_HOMEASSISTANT,    "hass" );
+PROG_STR( S_PROF_SLOT_STATUS_ICONS,     "icons" );
+PROG_STR( S_PROF_SLOT_LOOP,             "loop" );
+
+const char* const S_PROF_SLOT_NAMES[] PROGMEM = {
+    S_PROF_SLOT_POWER,
+    S_PROF_SLOT_SDCARD,
+    S_PROF_SLOT_RTC,
+    S_PROF_SLOT_CLOCK,
+    S_PROF_SLOT_ALARM,
+    S_PROF_SLOT_SCREEN_EVENTS,
+    S_PROF_SLOT_SCREEN_UPDATE,
+    S_PROF_SLOT_LAMP,
+    S_PROF_SLOT_CONFIG,
+    S_PROF_SLOT_ALS,
+    S_PROF_SLOT_WIFI,
+    S_PROF_SLOT_CONSOLE,
+    S_PROF_SLOT_NTP,
+    S_PROF_SLOT_TELNET,
+    S_PROF_SLOT_FTP,
+    S_PROF_SLOT_MQTT,
+    S_PROF_SLOT_HOMEASSISTANT,
+    S_PROF_SLOT_STATUS_ICONS,
+};
+
+
+extern LoopProfiler g_profiler;
+extern TaskScheduler g_scheduler;
+
+#endif /* PROFILER_SLOTS_H */
\ No newline at end of file
@@ -145,6 +145,7 @@ PROG_STR( S_EDIT_PROFILE_FILENAME,      "Sound file" );
 PROG_STR( S_EDIT_PROFILE_SNOOZE,        "Snooze delay" );
 PROG_STR( S_EDIT_PROFILE_VOLUME,        "Volume" );
 PROG_STR( S_EDIT_PROFILE_GRADUAL,       "Gradual" );
+PROG_STR( S_EDIT_PROFILE_GRADUAL_TIME,  "Gradual time" );
 PROG_STR( S_EDIT_PROFILE_VISUAL,        "Visual effect" );
 PROG_STR( S_EDIT_PROFILE_LAMP,          "Alarm lamp" );
 PROG_STR( S_EDIT_PROFILE_MESSAGE,       "Message" );
@@ -227,6 +228,18 @@ PROG_STR( S_CONSOLE_SUCCESS,            "Success" );
 PROG_STR( S_CONSOLE_NONE,               "None" );
 PROG_STR( S_CONSOLE_FREEMEM,            "Free SRAM  : %hd bytes" );
 PROG_STR( S_CONSOLE_TOTALMEM,           "Total SRAM : %hd bytes" );
+PROG_STR( S_CONSOLE_STACKMIN,           "Min free   : %hd bytes (heap + stack, since reset)" );
+PROG_STR( S_CONSOLE_HEAP_USED,          "Heap used  : %u bytes (peak: %u bytes)" );
+PROG_STR( S_CONSOLE_HEAP_ALLOCS,        "Allocs     : %lu (freed: %lu, failed: %lu)" );
+PROG_STR( S_CONSOLE_HEAP_FREE_LIST,     "Free list  : %u chunks, %u bytes (largest: %u bytes)" );
+PROG_STR( S_CONSOLE_HEAP_LARGEST,       "Largest    : %u bytes (fragmentation: %u%%)" );
+PROG_STR( S_CONSOLE_HEAP_HEADER,        "Call site       allocs      bytes  largest  failed" );
+PROG_STR( S_CONSOLE_HEAP_ROW,           "%8lu %10lu %8u %7u" );
+PROG_STR( S_CONSOLE_POOL_HEADER,        "Pool block  blocks  used  peak  fallback  failed" );
+PROG_STR( S_CONSOLE_POOL_ROW,           "%10u %7u %5u %5u %9u %7u" );
+PROG_STR( S_CONSOLE_HEAP_MAP_HEADER,    "Chunk     Size" );
+PROG_STR( S_CONSOLE_HEAP_MAP_ROW,       "0x%04x %7u" );
+PROG_STR( S_CONSOLE_HEAP_MAP_TOP,       "Top    %7u" );
 PROG_STR( S_CONSOLE_INVALID_COMMAND,    "Invalid command!" );
 PROG_STR( S_CONSOLE_INVALID_INPUT_BOOL, "Invalid input! Enter 'Y' or 'N'" );
 PROG_STR( S_CONSOLE_INVALID_INPUT_IP,   "Invalid IP address" );
@@ -368,6 +381,42 @@ PROG_STR( S_CONSOLE_FTP_DISABLED,       "FTP server disabled");
 PROG_STR( S_CONSOLE_FTP_SESS_ACTIVE,    "Client connected from %d.%d.%d.%d on port %hu" );
 PROG_STR( S_CONSOLE_FTP_NO_SESS,        "No connected client" );
 
+PROG_STR( S_CONSOLE_PERF_HEADER,        "Service      min(us) mean(us)  max(us)  <128  <512   <2k   <8k  <32k  >32k" );
+PROG_STR( S_CONSOLE_PERF_ROW,           "%8lu %8lu %8lu %5u %5u %5u %5u %5u %5u" );
+PROG_STR( S_CONSOLE_PERF_LOOPS,         "Loops       : %lu" );
+PROG_STR( S_CONSOLE_PERF_BUDGET,        "Over budget : %lu (budget: %lu us)" );
+PROG_STR( S_CONSOLE_PERF_IDLE,          "Idle        : %lu us/s (%u%%)" );
+PROG_STR( S_CONSOLE_PERF_DISPATCH,      "Dispatched  : %lu/s, skipped : %lu/s" );
+PROG_STR( S_CONSOLE_PERF_RESET,         "Loop statistics cleared" );
+PROG_STR( S_CONSOLE_PERF_ISR_HEADER,    "Interrupt       count  overflow mean(us)  max(us)" );
+PROG_STR( S_CONSOLE_PERF_ISR_ROW,       "%10lu %9u %8lu %8lu" );
+PROG_STR( S_CONSOLE_PERF_UI_HEADER,     "Screen  count  min(us) mean(us)  max(us)  <1ms  <4ms <16ms <64ms <256ms >256ms" );
+PROG_STR( S_CONSOLE_PERF_UI_ROW,        "%5u %8lu %8lu %8lu %5u %5u %5u %5u %6u %6u" );
+PROG_STR( S_CONSOLE_PERF_UI_ID,         "%-8u" );
+PROG_STR( S_CONSOLE_PERF_UI_OTHER,      "other   " );
+PROG_STR( S_CONSOLE_PERF_UI_EMPTY,      "No keypress recorded" );
+PROG_STR( S_CONSOLE_PERF_QUEUE,         "Event queue : %u pending, peak %u/%u" );
+PROG_STR( S_CONSOLE_PERF_LCD,           "LCD frames  : %lu, %u I2C transfers last frame (max %u)" );
+PROG_STR( S_CONSOLE_PERF_CGRAM,         "LCD glyphs  : %lu uploaded, %lu already loaded" );
+PROG_STR( S_CONSOLE_PERF_I2C,           "I2C         : %lu transfers, %u errors, peak %u/%u queued, %lu us blocking" );
+PROG_STR( S_CONSOLE_PERF_I2C_BYTES,     "I2C traffic : %lu bytes, %lu bytes/s" );
+PROG_STR( S_CONSOLE_PERF_AUDIO,         "Audio       : %lu sectors read, %lu underruns" );
+PROG_STR( S_CONSOLE_PERF_AUDIO_FIFO,    "Audio FIFO  : %u bytes min level, %lu interrupt feeds" );
+PROG_STR( S_CONSOLE_PERF_GRADUAL,       "Gradual     : %lu writes, %lu coalesced" );
+PROG_STR( S_CONSOLE_PERF_FX_CLOCK,      "Clock fx    : %lu frames, %lu late, jitter %lu us mean, %lu us max" );
+PROG_STR( S_CONSOLE_PERF_FX_LAMP,       "Lamp fx     : %lu frames, %lu late, jitter %lu us mean, %lu us max" );
+PROG_STR( S_CONSOLE_PERF_NEOPIXEL,      "NeoPixel    : clock %lu sent, %lu skipped, lamp %lu sent, %lu skipped" );
+PROG_STR( S_CONSOLE_AUDIO_NONE,         "No alarm played since boot" );
+PROG_STR( S_CONSOLE_AUDIO_COUNT,        "Alarms played : %lu" );
+PROG_STR( S_CONSOLE_AUDIO_LATENCY,      "Start latency : %u ms" );
+PROG_STR( S_CONSOLE_AUDIO_NO_LATENCY,   "Start latency : no frame decoded" );
+PROG_STR( S_CONSOLE_AUDIO_PLAY_TIME,    "Play time     : %lu.%03lu s, decode time %u s" );
+PROG_STR( S_CONSOLE_AUDIO_DATA,         "Data sent     : %lu bytes, %lu bytes/s" );
+PROG_STR( S_CONSOLE_AUDIO_UNDERRUNS,    "Underruns     : %lu" );
+PROG_STR( S_CONSOLE_AUDIO_STREAM,       "Stream        : %S, %u kbit/s (HDAT0 0x%04x, HDAT1 0x%04x)" );
+PROG_STR( S_CONSOLE_TRACE_STATUS,       "Trace buffer : %u/%u events (%lu overwritten)" );
+PROG_STR( S_CONSOLE_TRACE_CLEARED,      "Trace buffer cleared" );
+
 /* Log item descriptions */
 PROG_STR( S_LOG_REPEAT,                         " <- Occured %d times" );
 PROG_STR( S_LOG_REPEAT_LIMIT,                   " <- Occured more than 250 times!" );
@@ -415,6 +464,19 @@ PROG_STR( S_LOGMSG_FTP_SERVICE_DISABLED,        "FTP server disabled" );
 PROG_STR( S_LOGMSG_SD_INIT_FAIL,                "SD card init failed (error %d)" );
 PROG_STR( S_LOGMSG_SD_READY,                    "SD card ready" );
 PROG_STR( S_LOGMSG_SD_REMOVED,                  "SD card removed" );
+PROG_STR( S_LOGMSG_ALARM_AUDIO_START,           "Alarm sound started %u ms after trigger" );
+PROG_STR( S_LOGMSG_ALARM_AUDIO_END,             "Alarm sound ended, %u bytes/s, %u underruns" );
+
+/* Audio stream formats */
+PROG_STR( S_AUDIO_FORMAT_NONE,                  "none" );
+PROG_STR( S_AUDIO_FORMAT_MPEG,                  "MPEG" );
+PROG_STR( S_AUDIO_FORMAT_WAV,                   "WAV" );
+PROG_STR( S_AUDIO_FORMAT_AAC,                   "AAC" );
+PROG_STR( S_AUDIO_FORMAT_WMA,                   "WMA" );
+PROG_STR( S_AUDIO_FORMAT_OGG,                   "Ogg Vorbis" );
+PROG_STR( S_AUDIO_FORMAT_FLAC,                  "FLAC" );
+PROG_STR( S_AUDIO_FORMAT_MIDI,                  "MIDI" );
+PROG_STR( S_AUDIO_FORMAT_UNKNOWN,               "unknown" );
 
 
 
@@ -0,0 +1,33 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : include/trace_events.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+
+#include <tracer.h>
+
+
+
+/* Application trace events. Must be kept in sync with the decoder 
+   (tools/trace/trace2json.py). Services use their profiler slot ID
+   (see profiler_slots.h) as trace ID. */
+#define TRACE_EVENT_ISR_RTC         ( TRACE_EVENT_USER + 0 )
+#define TRACE_EVENT_ISR_KEYPAD      ( TRACE_EVENT_USER + 1 )
+#define TRACE_EVENT_ISR_WIFI        ( TRACE_EVENT_USER + 2 )
+
+#endif /* TRACE_EVENTS_H */
\ No newline at end of file
@@ -0,0 +1,179 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/eventqueue/eventqueue.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include "eventqueue.h"
+
+
+EventQueue g_events;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Queue an event. Can be called from C interrupt handlers.
+ *
+ * @param   source    Event source ID
+ * @param   arg       Event argument
+ * 
+ */
+void event_queue_push( uint8_t source, uint8_t arg ) {
+    g_events.push( source, arg );
+}
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Queue an event. Must only be called from interrupt context.
+ *
+ * @param   source    Event source ID
+ * @param   arg       Event argument
+ * 
+ * @return  TRUE if successful, FALSE if the queue is full.
+ * 
+ */
+bool EventQueue::push( uint8_t source, uint8_t arg ) {
+    uint8_t head = _head;
+    uint8_t next = ( head + 1 ) & ( EVENT_QUEUE_SIZE - 1 );
+
+    if( next == _tail ) {
+        if( source < EVENT_QUEUE_MAX_SOURCES ) {
+            _stats[ source ].overflows++;
+        }
+
+        return false;
+    }
+
+    QueuedEvent* event = &_ring[ head ];
+    event->time = micros();
+    event->source = source;
+    event->arg = arg;
+
+    /* Publish the event once it is complete */
+    _head = next;
+
+    uint8_t pending = ( uint8_t )( next - _tail ) & ( EVENT_QUEUE_SIZE - 1 );
+    if( pending > _peak ) {
+        _peak = pending;
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Remove the oldest event from the queue and update the latency
+ *          statistics of its source.
+ *
+ * @param   event    Receives the event
+ * 
+ * @return  TRUE if successful, FALSE if the queue is empty.
+ * 
+ */
+bool EventQueue::pop( QueuedEvent* event ) {
+    uint8_t tail = _tail;
+
+    if( tail == _head ) {
+        return false;
+    }
+
+    *event = _ring[ tail ];
+
+    /* Release the slot once the event is copied */
+    _tail = ( tail + 1 ) & ( EVENT_QUEUE_SIZE - 1 );
+
+    if( event->source < EVENT_QUEUE_MAX_SOURCES ) {
+        EventSourceStats* stats = &_stats[ event->source ];
+        uint32_t latency = micros() - event->time;
+
+        stats->count++;
+        stats->latencySum += latency;
+
+        if( latency > stats->latencyMax ) {
+            stats->latencyMax = latency;
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get a copy of the statistics of an event source.
+ *
+ * @param   source    Event source ID
+ * @param   stats     Receives the statistics
+ * 
+ */
+void EventQueue::getStats( uint8_t source, EventSourceStats* stats ) {
+    if( source >= EVENT_QUEUE_MAX_SOURCES ) {
+        memset( stats, 0, sizeof( EventSourceStats ));
+        return;
+    }
+
+#if defined( __AVR__ )
+    uint8_t sreg = SREG;
+    cli();
+#endif
+
+    *stats = _stats[ source ];
+
+#if defined( __AVR__ )
+    SREG = sreg;
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the mean queue latency of an event source.
+ *
+ * @param   source    Event source ID
+ * 
+ * @return  Mean latency (us)
+ * 
+ */
+uint32_t EventQueue::getMeanLatency( uint8_t source ) {
+    EventSourceStats stats;
+    this->getStats( source, &stats );
+
+    return ( stats.count > 0 ) ? stats.latencySum / stats.count : 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Reset the statistics of all event sources.
+ *
+ */
+void EventQueue::clearStats() {
+
+#if defined( __AVR__ )
+    uint8_t sreg = SREG;
+    cli();
+#endif
+
+    memset( _stats, 0, sizeof( _stats ));
+    _peak = 0;
+
+#if defined( __AVR__ )
+    SREG = sreg;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/eventqueue/eventqueue.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <stdint.h>
+
+
+
+/* Size of the ring buffer, must be a power of 2. One slot is kept empty 
+   to tell a full queue from an empty one. */
+#ifndef EVENT_QUEUE_SIZE
+#define EVENT_QUEUE_SIZE            16
+#endif
+
+/* Number of event sources for which statistics are kept */
+#ifndef EVENT_QUEUE_MAX_SOURCES
+#define EVENT_QUEUE_MAX_SOURCES     4
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void event_queue_push( uint8_t source, uint8_t arg );
+
+#ifdef __cplusplus
+}
+
+
+/* Queued interrupt event */
+struct QueuedEvent {
+    uint32_t time;                          /* Time the interrupt occured (us) */
+    uint8_t source;                         /* Event source ID */
+    uint8_t arg;                            /* Event argument */
+};
+
+/* Statistics of an event source */
+struct EventSourceStats {
+    uint32_t count;                         /* Number of events serviced */
+    uint32_t latencySum;                    /* Sum of the queue latencies (us) */
+    uint32_t latencyMax;                    /* Longest queue latency (us) */
+    uint16_t overflows;                     /* Events lost because the queue was full */
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Interrupt event queue
+ *
+ * @details Lock-free single producer, single consumer queue. Interrupt 
+ *          handlers don't nest, so together they are the single producer
+ *          and push() must only be called from interrupt context. The 
+ *          main loop is the consumer.
+ *
+ *          The class has no constructor so events can be queued before 
+ *          the global constructors are run.
+ *
+ *******************************************************************************/
+class EventQueue {
+
+  public:
+    bool push( uint8_t source, uint8_t arg );
+    bool pop( QueuedEvent* event );
+    uint8_t getPending() { return ( uint8_t )( _head - _tail ) & ( EVENT_QUEUE_SIZE - 1 ); }
+    uint8_t getPeak() { return _peak; }
+    void getStats( uint8_t source, EventSourceStats* stats );
+    uint32_t getMeanLatency( uint8_t source );
+    void clearStats();
+
+
+  private:
+    QueuedEvent _ring[ EVENT_QUEUE_SIZE ];  /* Event ring buffer */
+    volatile uint8_t _head;                 /* Position of the next event, written by the producer */
+    volatile uint8_t _tail;                 /* Position of the oldest event, written by the consumer */
+    volatile uint8_t _peak;                 /* Highest number of pending events */
+    EventSourceStats _stats[ EVENT_QUEUE_MAX_SOURCES ];
+};
+
+
+extern EventQueue g_events;
+
+#endif /* __cplusplus */
+
+#endif /* EVENTQUEUE_H */
\ No newline at end of file
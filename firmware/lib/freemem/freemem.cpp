@@ -36,3 +36,53 @@ int freeMemory() {
   return __brkval ? &top - __brkval : &top - __malloc_heap_start;
 }
 
+
+/*******************************************************************************
+ *
+ * @brief   Fill the free space between the heap and the stack with the 
+ *          canary value. Called once at startup.
+ * 
+ */
+void paintStack() {
+    char top;
+    char *p = __brkval ? __brkval : __malloc_heap_start;
+    int count = ( &top - STACK_PAINT_MARGIN ) - p;
+
+    while( count-- > 0 ) {
+        *p++ = STACK_CANARY;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Find the largest untouched area between the heap and the stack
+ *          since paintStack() was called. This is the lowest amount of free 
+ *          memory reached so far by the heap and the stack together.
+ * 
+ * @return  Size of the area in bytes
+ */
+int getStackMinFree() {
+    char top;
+    char *p = __brkval ? __brkval : __malloc_heap_start;
+    int count = &top - p;
+    int length = 0;
+    int largest = 0;
+
+    /* Memory released at the top of the heap isn't painted again, look for
+       the longest run of canary values instead of the first one. */
+    for( ; count > 0; count--, p++ ) {
+        if( *p == ( char )STACK_CANARY ) {
+            length++;
+
+            if( length > largest ) {
+                largest = length;
+            }
+        } else {
+            length = 0;
+        }
+    }
+
+    return largest;
+}
+
@@ -21,9 +21,17 @@
 #include <Arduino.h>
 
 
+/* Value written in the unused stack space at startup */
+#define STACK_CANARY            0xC5
+
+/* Space left unpainted below the caller of paintStack() */
+#define STACK_PAINT_MARGIN      128
+
 
 extern int g_freeMemory;
 
 int freeMemory();
+void paintStack();
+int getStackMinFree();
 
 #endif /* FREEMEM_H */
\ No newline at end of file
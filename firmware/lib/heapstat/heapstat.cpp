@@ -0,0 +1,276 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/heapstat/heapstat.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "heapstat.h"
+
+#if defined( __AVR__ )
+#include <avr/io.h>
+
+/* avr-libc allocator internals (stdlib_private.h) */
+struct __freelist {
+    size_t sz;
+    struct __freelist *nx;
+};
+
+extern struct __freelist *__flp;
+
+#else
+#include <malloc.h>
+
+extern char *__malloc_heap_start;
+#endif
+
+extern char *__brkval;
+
+
+HeapStats g_heap;
+
+
+extern "C" {
+    void* __real_malloc( size_t size );
+    void __real_free( void* ptr );
+
+
+    /***************************************************************************
+     *
+     * @brief   malloc() wrapper, records the allocation.
+     *
+     */
+    void* __wrap_malloc( size_t size ) {
+        void* ptr = __real_malloc( size );
+
+        g_heap.onAlloc( ptr, size );
+        return ptr;
+    }
+
+
+    /***************************************************************************
+     *
+     * @brief   free() wrapper, records the release of the block.
+     *
+     */
+    void __wrap_free( void* ptr ) {
+        if( ptr != nullptr ) {
+            g_heap.onFree( ptr );
+        }
+
+        __real_free( ptr );
+    }
+}
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the size of an allocated block as seen by the allocator.
+ *
+ * @param   ptr    Pointer returned by malloc()
+ *
+ * @return  Block size in bytes
+ * 
+ */
+size_t HeapStats::getBlockSize( void* ptr ) {
+
+#if defined( __AVR__ )
+    /* The chunk size is stored right before the block */
+    return *(( size_t* )ptr - 1 );
+#else
+    return malloc_usable_size( ptr );
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Records an allocation
+ *
+ * @param   ptr     Pointer returned by malloc(), NULL if it failed
+ * @param   size    Requested size
+ * 
+ */
+void HeapStats::onAlloc( void* ptr, size_t size ) {
+
+#if HEAPSTAT_SITE_STATS == 1
+    uint8_t site = ( _site < HEAPSTAT_MAX_SITES ) ? _site : HEAPSTAT_SITE_OTHER;
+#endif
+    _site = HEAPSTAT_SITE_OTHER;
+
+    if( ptr == nullptr ) {
+        _failCount++;
+#if HEAPSTAT_SITE_STATS == 1
+        _sites[ site ].failures++;
+#endif
+        return;
+    }
+
+    _allocCount++;
+
+#if HEAPSTAT_SITE_STATS == 1
+    _sites[ site ].allocs++;
+    _sites[ site ].bytes += size;
+
+    if( size > _sites[ site ].largest ) {
+        _sites[ site ].largest = ( size > UINT16_MAX ) ? UINT16_MAX : size;
+    }
+#endif
+
+    _liveBytes += getBlockSize( ptr );
+
+    if( _liveBytes > _peakBytes ) {
+        _peakBytes = _liveBytes;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Records the release of a block
+ *
+ * @param   ptr    Pointer to the block about to be released
+ * 
+ */
+void HeapStats::onFree( void* ptr ) {
+    size_t size = getBlockSize( ptr );
+
+    _freeCount++;
+
+    /* Blocks allocated before the wrapper was linked in (eg. by the host 
+       C library on native builds) are not accounted for */
+    _liveBytes = ( size > _liveBytes ) ? 0 : _liveBytes - size;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Clear the counters. Live bytes are kept since the blocks are 
+ *          still allocated.
+ * 
+ */
+void HeapStats::reset() {
+#if HEAPSTAT_SITE_STATS == 1
+    memset( _sites, 0, sizeof( _sites ));
+#endif
+
+    _peakBytes = _liveBytes;
+    _allocCount = 0;
+    _freeCount = 0;
+    _failCount = 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the statistics of a call site
+ *
+ * @param   site    Call site ID
+ *
+ * @return  Pointer to the site statistics or NULL if the ID is invalid
+ *          or the call sites are not tracked (HEAPSTAT_SITE_STATS).
+ * 
+ */
+const HeapSiteStats* HeapStats::getSite( uint8_t site ) {
+#if HEAPSTAT_SITE_STATS == 1
+    if( site >= HEAPSTAT_MAX_SITES ) {
+        return nullptr;
+    }
+
+    return &_sites[ site ];
+#else
+    return nullptr;
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Walks the allocator free list and measure the free memory
+ *          between the heap and the stack.
+ *
+ * @param   info    Structure receiving the results
+ * 
+ */
+void HeapStats::getFreeInfo( HeapFreeInfo* info ) {
+
+    memset( info, 0, sizeof( HeapFreeInfo ));
+
+    char* heapTop = ( __brkval != nullptr ) ? __brkval : __malloc_heap_start;
+
+#if defined( __AVR__ )
+    for( struct __freelist* fp = __flp; fp != nullptr; fp = fp->nx ) {
+        info->chunks++;
+        info->freeListBytes += fp->sz + sizeof( size_t );
+
+        if( fp->sz > info->largestChunk ) {
+            info->largestChunk = fp->sz;
+        }
+    }
+
+    /* Same limit as malloc() when extending the heap */
+    char* limit = ( __malloc_heap_end != nullptr ) ? __malloc_heap_end : ( char* )SP - __malloc_margin;
+#else
+    char top;
+    char* limit = &top;
+#endif
+
+    if( limit > heapTop ) {
+        info->topBytes = limit - heapTop;
+    }
+
+    info->largestAllocatable = info->largestChunk;
+
+    if( info->topBytes > sizeof( size_t ) && info->topBytes - sizeof( size_t ) > info->largestAllocatable ) {
+        info->largestAllocatable = info->topBytes - sizeof( size_t );
+    }
+
+    size_t total = info->freeListBytes + info->topBytes;
+    if( total > 0 ) {
+        info->fragmentation = 100 - ( uint8_t )(( uint32_t )info->largestAllocatable * 100 / total );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the location and size of the chunks in the free list.
+ *
+ * @param   addr    Array receiving the address of each chunk
+ * @param   size    Array receiving the size of each chunk
+ * @param   max     Size of the arrays
+ *
+ * @return  Number of chunks returned
+ * 
+ */
+uint8_t HeapStats::getFreeMap( void** addr, size_t* size, uint8_t max ) {
+    uint8_t count = 0;
+
+#if defined( __AVR__ )
+    for( struct __freelist* fp = __flp; fp != nullptr && count < max; fp = fp->nx ) {
+        addr[ count ] = fp;
+        size[ count ] = fp->sz;
+        count++;
+    }
+#else
+    ( void )addr;
+    ( void )size;
+    ( void )max;
+#endif
+
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/heapstat/heapstat.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef HEAPSTAT_H
+#define HEAPSTAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+
+/* Keep the allocation statistics of each call site */
+#ifndef HEAPSTAT_SITE_STATS
+#define HEAPSTAT_SITE_STATS         1
+#endif
+
+/* Maximum number of tracked allocation call sites */
+#ifndef HEAPSTAT_MAX_SITES
+#define HEAPSTAT_MAX_SITES          8
+#endif
+
+/* Call site used when none was selected before the allocation */
+#define HEAPSTAT_SITE_OTHER         0
+
+/* Maximum number of free list chunks reported by the fragmentation map */
+#define HEAPSTAT_MAX_MAP_CHUNKS     16
+
+
+/* Allocation statistics of a single call site */
+struct HeapSiteStats {
+    uint32_t allocs;                        /* Number of successful allocations */
+    uint32_t bytes;                         /* Total of requested bytes */
+    uint16_t failures;                      /* Number of failed allocations */
+    uint16_t largest;                       /* Largest requested block */
+};
+
+
+/* Free memory layout */
+struct HeapFreeInfo {
+    uint16_t chunks;                        /* Number of chunks in the free list */
+    size_t freeListBytes;                   /* Bytes held in the free list */
+    size_t largestChunk;                    /* Largest chunk in the free list */
+    size_t topBytes;                        /* Unallocated bytes between the heap and the stack */
+    size_t largestAllocatable;              /* Largest block malloc() can return */
+    uint8_t fragmentation;                  /* 0 (none) to 100 (% of free memory not in the largest block) */
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Heap allocation statistics
+ *
+ * @details Updated by the malloc()/free() wrappers (linked with
+ *          -Wl,--wrap=malloc -Wl,--wrap=free). Allocations are attributed
+ *          to the call site selected with setSite() right before the call,
+ *          the site is reset to HEAPSTAT_SITE_OTHER after each allocation.
+ *          realloc() is not tracked.
+ *
+ *          The class has no constructor so the statistics are valid for
+ *          allocations made by global constructors.
+ *
+ *******************************************************************************/
+class HeapStats {
+
+  public:
+    void setSite( uint8_t site ) { _site = site; }
+    void onAlloc( void* ptr, size_t size );
+    void onFree( void* ptr );
+    void reset();
+
+    size_t getLiveBytes() { return _liveBytes; }
+    size_t getPeakBytes() { return _peakBytes; }
+    uint32_t getAllocCount() { return _allocCount; }
+    uint32_t getFreeCount() { return _freeCount; }
+    uint32_t getFailCount() { return _failCount; }
+    const HeapSiteStats* getSite( uint8_t site );
+
+    void getFreeInfo( HeapFreeInfo* info );
+    uint8_t getFreeMap( void** addr, size_t* size, uint8_t max );
+
+    static size_t getBlockSize( void* ptr );
+
+
+  private:
+#if HEAPSTAT_SITE_STATS == 1
+    HeapSiteStats _sites[ HEAPSTAT_MAX_SITES ];   /* Per call site statistics */
+#endif
+    size_t _liveBytes;                      /* Bytes currently allocated */
+    size_t _peakBytes;                      /* Highest value of _liveBytes */
+    uint32_t _allocCount;                   /* Number of successful allocations */
+    uint32_t _freeCount;                    /* Number of blocks released */
+    uint32_t _failCount;                    /* Number of failed allocations */
+    uint8_t _site;                          /* Call site of the next allocation */
+};
+
+
+extern HeapStats g_heap;
+
+#endif /* HEAPSTAT_H */
\ No newline at end of file
@@ -36,6 +36,17 @@ int IPrint::_cb_putchar( char c, FILE *stream ) {
     /* Get the pointer to the IPrint class */
     IPrint *obj;
     obj = ( IPrint* )fdev_get_udata( stream );
+
+    /* Collect the formatted output in the staging buffer */
+    if( obj->_staging != NULL ) {
+        obj->_staging[ obj->_stagingLength++ ] = c;
+
+        if( obj->_stagingLength >= IPRINT_STAGING_SIZE ) {
+            obj->_flushStaging();
+        }
+
+        return 1;
+    }
     
     return obj->print( c );
 }
@@ -43,58 +54,192 @@ int IPrint::_cb_putchar( char c, FILE *stream ) {
 
 /*******************************************************************************
  *
- * @brief   Initialize the IPrint interface.
+ * @brief   Send the content of the staging buffer to the output.
  * 
  */
-void IPrint::_initPrint() {
+void IPrint::_flushStaging() {
+    if( _stagingLength == 0 ) {
+        return;
+    }
 
-    fdev_setup_stream( &_stream, this->_cb_putchar, NULL, _FDEV_SETUP_WRITE );
+    this->_write( _staging, _stagingLength );
+    _stagingLength = 0;
+}
 
-    /* Store the pointer to this class */
-    fdev_set_udata( &_stream, ( void * )this );
+
+/*******************************************************************************
+ *
+ * @brief   Writes a block of characters. Calls _print() for each character
+ *          unless the parent class implements a bulk write.
+ *
+ * @param   buffer    Characters to write (SRAM)
+ * @param   length    Number of characters
+ *
+ * @return  Number of characters written.
+ * 
+ */
+size_t IPrint::_write( const char *buffer, size_t length ) {
+    size_t num = 0;
+
+    while( num < length ) {
+        if( this->_print( buffer[ num ] ) == 0 ) {
+            break;
+        }
+
+        num++;
+    }
+
+    return num;
 }
 
 
 /*******************************************************************************
  *
- * @brief   Prints a character array.
+ * @brief   Writes a block of characters from SRAM or program memory. 
+ *          Program memory is copied in blocks to a buffer on the stack.
  *
- * @param   str              Pointer to the string to print.
+ * @param   str              Pointer to the characters to write.
+ * @param   length           Number of characters
  * @param   ptr_pgm_space    TRUE if 'str' points to a program memory 
  *                           location, FALSE otherwise.
  *
  * @return  Number of characters written.
  * 
  */
-size_t IPrint::_print( const char *str, bool ptr_pgm_space ) {
-    uint8_t num = 0;
+size_t IPrint::_copy( const char *str, size_t length, bool ptr_pgm_space ) {
 
-    while( true ) {
+    if( ptr_pgm_space == false ) {
+        return this->_write( str, length );
+    }
 
-        char c;
+    char buffer[ IPRINT_STAGING_SIZE ];
+    size_t num = 0;
 
-        if( ptr_pgm_space == true ) {
-            c = pgm_read_byte( str++ );
+    while( num < length ) {
+        size_t count = length - num;
 
-        } else {
-            c = *str++;
+        if( count > sizeof( buffer )) {
+            count = sizeof( buffer );
         }
 
-        if( c == 0x00 ) {
+        memcpy_P( buffer, str + num, count );
+
+        size_t written = this->_write( buffer, count );
+        num += written;
+
+        if( written < count ) {
             break;
         }
+    }
+
+    return num;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Writes the same character multiple times.
+ *
+ * @param   c         Character to write
+ * @param   length    Number of characters
+ *
+ * @return  Number of characters written.
+ * 
+ */
+size_t IPrint::_fill( char c, uint8_t length ) {
+    char buffer[ IPRINT_STAGING_SIZE ];
+    size_t num = 0;
+
+    memset( buffer, c, ( length < sizeof( buffer )) ? length : sizeof( buffer ));
+
+    while( num < length ) {
+        size_t count = length - num;
 
-        if( this->_print( c ) == 0 ) {
-            return num;
+        if( count > sizeof( buffer )) {
+            count = sizeof( buffer );
         }
 
-        num++;
+        size_t written = this->_write( buffer, count );
+        num += written;
+
+        if( written < count ) {
+            break;
+        }
     }
 
     return num;
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Prints a formated string. The output is sent to _write() in 
+ *          blocks of up to IPRINT_STAGING_SIZE characters.
+ *
+ * @param   format           Pointer to the format string.
+ * @param   args             Additional arguments.
+ * @param   ptr_pgm_space    TRUE if 'format' points to a program memory 
+ *                           location, FALSE otherwise.
+ *
+ * @return  Number of characters printed.
+ * 
+ */
+size_t IPrint::_vprintf( const char *format, va_list args, bool ptr_pgm_space ) {
+    char buffer[ IPRINT_STAGING_SIZE ];
+
+    _staging = buffer;
+    _stagingLength = 0;
+
+    uint8_t length;
+
+    if( ptr_pgm_space == true ) {
+        length = vfprintf_P( &_stream, format, args );
+
+    } else {
+        length = vfprintf( &_stream, format, args );
+    }
+
+    this->_flushStaging();
+    _staging = NULL;
+
+    return length;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Initialize the IPrint interface.
+ * 
+ */
+void IPrint::_initPrint() {
+
+    fdev_setup_stream( &_stream, this->_cb_putchar, NULL, _FDEV_SETUP_WRITE );
+
+    /* Store the pointer to this class */
+    fdev_set_udata( &_stream, ( void * )this );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Prints a character array.
+ *
+ * @param   str              Pointer to the string to print.
+ * @param   ptr_pgm_space    TRUE if 'str' points to a program memory 
+ *                           location, FALSE otherwise.
+ *
+ * @return  Number of characters written.
+ * 
+ */
+size_t IPrint::_print( const char *str, bool ptr_pgm_space ) {
+    size_t length;
+
+    length = ( ptr_pgm_space == true ? strlen_P( str ) : strlen( str ));
+
+    return this->_copy( str, length, ptr_pgm_space );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Prints a character array within a fixed length. Adds padding before 
@@ -112,9 +257,9 @@ size_t IPrint::_print( const char *str, bool ptr_pgm_space ) {
  * 
  */
 size_t IPrint::_print( const char *str, uint8_t length, uint8_t align, bool ptr_pgm_space ) {
-    uint8_t res;
-    uint8_t num = 0;
-    uint8_t slen;
+    size_t res;
+    size_t num;
+    size_t slen;
     uint8_t pre_padding;
     uint8_t post_padding;
 
@@ -142,53 +287,23 @@ size_t IPrint::_print( const char *str, uint8_t length, uint8_t align, bool ptr_
     } else {
         pre_padding = 0;
         post_padding = 0;
+        slen = length;
     }
 
+    num = this->_fill( 0x20, pre_padding );
+    if( num < pre_padding ) {
+        return num;
+    }
 
-    uint8_t i;
-
-    for( i = 0; i < length; i++ ) {
-
-        if( pre_padding > 0 ) {
-            if( this->_print( 0x20 ) == 0 ) {
-                return num;
-            }
-
-            pre_padding--;
-            num++;
-            continue;
-        }
-
-        if( slen > 0 ) {
-
-            if( ptr_pgm_space == true ) {
-                res = this->_print( pgm_read_byte( str++ ) );
-
-            } else {
-                res = this->_print( *str++ );
-            }
-
-
-            if( res == 0 ) {
-                return num;
-            }
-
-            slen--;
-            num++;
-            continue;
-        }
-
-        if( post_padding > 0 ) {
-            if( this->_print( 0x20 ) == 0 ) {
-                return num;
-            }
+    res = this->_copy( str, slen, ptr_pgm_space );
+    num += res;
 
-            post_padding--;
-            num++;
-            continue;
-        }
+    if( res < slen ) {
+        return num;
     }
 
+    num += this->_fill( 0x20, post_padding );
+
     return num;
 }
 
@@ -315,7 +430,7 @@ size_t IPrint::printf( const char *format, ... ) {
     va_start( args, format );
 
     uint8_t length;
-    length = vfprintf( &_stream, format, args );
+    length = this->_vprintf( format, args, false );
 
     va_end( args );
 
@@ -339,7 +454,7 @@ size_t IPrint::printfln( const char *format, ... ) {
     va_start( args, format );
 
     uint8_t length;
-    length = vfprintf( &_stream, format, args );
+    length = this->_vprintf( format, args, false );
 
     va_end( args );
 
@@ -446,7 +561,7 @@ size_t IPrint::printf_P( const char *format, ... ) {
     va_start( args, format );
 
     uint8_t length;
-    length = vfprintf_P( &_stream, format, args );
+    length = this->_vprintf( format, args, true );
 
     va_end( args );
 
@@ -470,7 +585,7 @@ size_t IPrint::printfln_P( const char *format, ... ) {
     va_start( args, format );
 
     uint8_t length;
-    length = vfprintf_P( &_stream, format, args );
+    length = this->_vprintf( format, args, true );
 
     va_end( args );
 
@@ -29,6 +29,12 @@
 #define TEXT_ALIGN_CENTER   1
 #define TEXT_ALIGN_RIGHT    2
 
+/* Size of the stack buffers used to send formatted output and strings 
+   from program memory to _write() in blocks. */
+#ifndef IPRINT_STAGING_SIZE
+    #define IPRINT_STAGING_SIZE     32
+#endif
+
 /* Date/time formatting */
 const char S_DATETIME_DHM[] PROGMEM = { "%dd, %dh. %d min." };
 const char S_DATETIME_HM[] PROGMEM = { "%dh. %d min." };
@@ -83,10 +89,18 @@ class IPrint {
 
   private:
     FILE _stream = {0};
+    char *_staging = NULL;
+    uint8_t _stagingLength = 0;
+
     static int _cb_putchar( char ch, FILE *stream );
     virtual size_t _print( char c ) = 0;
+    virtual size_t _write( const char *buffer, size_t length );
     size_t _print( const char *str, bool ptr_pgm_space = false );
     size_t _print( const char *str, uint8_t length, uint8_t align, bool ptr_pgm_space = false );
+    size_t _copy( const char *str, size_t length, bool ptr_pgm_space );
+    size_t _fill( char c, uint8_t length );
+    size_t _vprintf( const char *format, va_list args, bool ptr_pgm_space );
+    void _flushStaging();
 
 
   protected:
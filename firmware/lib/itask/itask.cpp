@@ -32,6 +32,104 @@ bool ITask::isBusy() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if the service has work to do on this pass, regardless of
+ *          its wake deadline. Services which only need to run when a task
+ *          is running or on a timer override this. By default, the service
+ *          is polled on every pass.
+ *
+ * @return  TRUE if the service needs to run, FALSE otherwise.
+ * 
+ */
+bool ITask::hasPendingWork() {
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Checks if the service should be dispatched by the scheduler.
+ *
+ * @param   now    Current timestamp (millis)
+ *
+ * @return  TRUE if the service has pending work or it's wake deadline 
+ *          is reached, FALSE otherwise.
+ * 
+ */
+bool ITask::isRunnable( unsigned long now ) {
+
+    if( _wakeScheduled == true && ( long )( now - _nextWake ) >= 0 ) {
+        return true;
+    }
+
+    return this->hasPendingWork();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Runs the service tasks. The wake deadline is cleared if it
+ *          was reached.
+ *
+ * @param   now    Current timestamp (millis)
+ * 
+ */
+void ITask::dispatch( unsigned long now ) {
+
+    if( _wakeScheduled == true && ( long )( now - _nextWake ) >= 0 ) {
+        _wakeScheduled = false;
+    }
+
+    trace_record( TRACE_EVENT_DISPATCH_BEGIN, _traceId );
+
+    _sliceStart = micros();
+    this->runTasks();
+
+    trace_record( TRACE_EVENT_DISPATCH_END, _traceId );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Schedule the next time the service will be dispatched even 
+ *          if it has no pending work.
+ *
+ * @param   delay    Delay in milliseconds from now.
+ * 
+ */
+void ITask::setNextWake( unsigned long delay ) {
+    _nextWake = millis() + delay;
+    _wakeScheduled = true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Request the service to be dispatched on the next pass.
+ * 
+ */
+void ITask::wakeUp() {
+    _nextWake = millis();
+    _wakeScheduled = true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Checks if the current dispatch has time left to process another
+ *          unit of work. Bulk tasks loop on it so they do as much work as
+ *          fits in the time slice. At least one unit should be processed
+ *          before checking it.
+ *
+ * @return  TRUE if time is left in the slice, FALSE otherwise.
+ * 
+ */
+bool ITask::budgetRemaining() {
+    return ( micros() - _sliceStart ) < _timeSlice;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Get the current running task ID
@@ -102,6 +200,8 @@ uint8_t ITask::startTask( uint8_t task, bool force ) {
     _timerTaskStart = millis();
     _currentTask = task;
     _taskError = TASK_SUCCESS;
+
+    trace_record( TRACE_EVENT_TASK_START, ( _traceId << 8 ) | task );
     return task;
 }
 
@@ -115,6 +215,8 @@ uint8_t ITask::startTask( uint8_t task, bool force ) {
  */
 void ITask::endTask( int error ) {
     
+    trace_record( TRACE_EVENT_TASK_END, ( _traceId << 8 ) | ( uint8_t )error );
+
     _currentTask = TASK_NONE;
     _timerTaskStart = 0;
 
@@ -19,6 +19,7 @@
 #define I_TASK_H
 
 #include <Arduino.h>
+#include <tracer.h>
 
 
 
@@ -27,6 +28,11 @@
 #define ERR_TASK_FAIL     (-1)
 #define ERR_TASK_TIMEOUT  (-2)
 
+/* Default time a task can spend in a single dispatch (us) */
+#ifndef TASK_DEFAULT_TIME_SLICE
+#define TASK_DEFAULT_TIME_SLICE     2000
+#endif
+
 
 /*******************************************************************************
  *
@@ -38,6 +44,15 @@ class ITask {
   public:
     bool isBusy();
     virtual void runTasks();
+    virtual bool hasPendingWork();
+    bool isRunnable( unsigned long now );
+    bool isWakeScheduled() { return _wakeScheduled; }
+    unsigned long getNextWake() { return _nextWake; }
+    void dispatch( unsigned long now );
+    void setTimeSlice( uint16_t slice ) { _timeSlice = slice; }
+    uint16_t getTimeSlice() { return _timeSlice; }
+    void setTraceId( uint8_t id ) { _traceId = id; }
+    uint8_t getTraceId() { return _traceId; }
     uint8_t getCurrentTask();
     int getTaskError();
     void clearTaskError();
@@ -49,12 +64,20 @@ class ITask {
     uint8_t _currentTask = TASK_NONE;   /* Current running task ID */
     unsigned long _timerTaskStart = 0;  /* Timestamp when current task started */
     int _taskError = 0;                 /* Last running task error */
+    unsigned long _nextWake = 0;        /* Timestamp of the next scheduled wake up */
+    bool _wakeScheduled = true;         /* Run on the first pass after boot */
+    unsigned long _sliceStart = 0;      /* Timestamp (us) when the current dispatch started */
+    uint16_t _timeSlice = TASK_DEFAULT_TIME_SLICE;  /* Time slice (us) */
+    uint8_t _traceId = TRACE_ID_NONE;   /* ID of the service in the event trace */
 
 
   protected:
     uint8_t startTask( uint8_t task, bool force = true );
     void endTask( int error = TASK_SUCCESS );
     void setTaskError( int error );
+    void setNextWake( unsigned long delay );
+    void wakeUp();
+    bool budgetRemaining();
 };
 
 #endif /* I_TASK_H */
\ No newline at end of file
@@ -0,0 +1,135 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/itask/scheduler.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include "scheduler.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts a new pass of the main loop.
+ * 
+ */
+void TaskScheduler::beginPass() {
+    _passStart = millis();
+    _dispatched = false;
+    _wakeScheduled = false;
+
+    this->updateStats( _passStart );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Runs the service tasks if it is runnable.
+ *
+ * @param   task    Service to dispatch
+ *
+ * @return  TRUE if the service was dispatched, FALSE if it was skipped.
+ * 
+ */
+bool TaskScheduler::dispatch( ITask *task ) {
+
+    if( task->isRunnable( _passStart ) == false ) {
+        _skipCount++;
+
+        /* Keep track of the earliest deadline to limit the idle time */
+        if( task->isWakeScheduled() == true ) {
+            if( _wakeScheduled == false || ( long )( task->getNextWake() - _nextWake ) < 0 ) {
+                _nextWake = task->getNextWake();
+                _wakeScheduled = true;
+            }
+        }
+
+        return false;
+    }
+
+    task->dispatch( _passStart );
+
+    _dispatchCount++;
+    _dispatched = true;
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Ends the current pass. If no service was dispatched, the CPU is
+ *          put in idle mode until the next interrupt.
+ *
+ * @param   allowIdle    FALSE if a driver outside the scheduler needs to be
+ *                       polled continuously (eg. audio playback)
+ * 
+ */
+void TaskScheduler::endPass( bool allowIdle ) {
+
+    if( _dispatched == true || allowIdle == false ) {
+        return;
+    }
+
+    if( _wakeScheduled == true && ( long )( millis() - _nextWake ) >= 0 ) {
+        return;
+    }
+
+    unsigned long start = micros();
+
+    /* Any interrupt (timer 0, UART, keypad, RTC, WiFi) wakes up the CPU */
+    set_sleep_mode( SLEEP_MODE_IDLE );
+    sleep_enable();
+    sleep_mode();
+    sleep_disable();
+
+    _idleTime += micros() - start;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the percentage of time the CPU was idle during the last
+ *          measurement window.
+ *
+ * @return  Idle time (%)
+ * 
+ */
+uint8_t TaskScheduler::getIdlePercent() {
+    return ( _idleLastPeriod / 10 ) / SCHEDULER_STATS_PERIOD;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Rolls the measurement window.
+ *
+ * @param   now    Current timestamp (millis)
+ * 
+ */
+void TaskScheduler::updateStats( unsigned long now ) {
+
+    if( now - _periodStart < SCHEDULER_STATS_PERIOD ) {
+        return;
+    }
+
+    _periodStart = now;
+
+    _idleLastPeriod = _idleTime;
+    _dispatchLastPeriod = _dispatchCount;
+    _skipLastPeriod = _skipCount;
+
+    _idleTime = 0;
+    _dispatchCount = 0;
+    _skipCount = 0;
+}
\ No newline at end of file
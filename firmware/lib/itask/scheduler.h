@@ -0,0 +1,69 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/itask/scheduler.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "itask.h"
+
+
+
+/* Length of the idle time measurement window (ms) */
+#define SCHEDULER_STATS_PERIOD      1000
+
+
+/*******************************************************************************
+ *
+ * @brief   Cooperative scheduler
+ *
+ * @details Dispatches the ITask services which are runnable (pending work or
+ *          wake deadline reached) and puts the CPU in idle sleep when none 
+ *          of them were on the last pass.
+ *
+ *******************************************************************************/
+class TaskScheduler {
+
+  public:
+    void beginPass();
+    bool dispatch( ITask *task );
+    void endPass( bool allowIdle );
+    unsigned long getIdleTime() { return _idleLastPeriod; }
+    uint8_t getIdlePercent();
+    uint32_t getDispatchCount() { return _dispatchLastPeriod; }
+    uint32_t getSkipCount() { return _skipLastPeriod; }
+
+
+  private:
+    void updateStats( unsigned long now );
+
+    unsigned long _passStart = 0;           /* Timestamp (millis) of the current pass */
+    unsigned long _nextWake = 0;            /* Earliest wake deadline of the skipped services */
+    bool _wakeScheduled = false;            /* A skipped service has a wake deadline */
+    bool _dispatched = false;               /* A service was dispatched on the current pass */
+
+    unsigned long _periodStart = 0;         /* Start of the current measurement window */
+    unsigned long _idleTime = 0;            /* Idle time in the current window (us) */
+    uint32_t _dispatchCount = 0;            /* Services dispatched in the current window */
+    uint32_t _skipCount = 0;                /* Services skipped in the current window */
+    unsigned long _idleLastPeriod = 0;      /* Idle time in the previous window (us) */
+    uint32_t _dispatchLastPeriod = 0;       /* Services dispatched in the previous window */
+    uint32_t _skipLastPeriod = 0;           /* Services skipped in the previous window */
+};
+
+#endif /* TASK_SCHEDULER_H */
\ No newline at end of file
@@ -0,0 +1,265 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/mempool/mempool.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <stdlib.h>
+#include <stdio.h>
+#include <heapstat.h>
+#include "mempool.h"
+
+#if defined( __AVR__ )
+#include <avr/pgmspace.h>
+#else
+#include <Arduino.h>
+#endif
+
+
+static uint8_t s_storage[ MEMPOOL_STORAGE_SIZE ];
+
+static const uint16_t s_blockSizes[ MEMPOOL_CLASS_COUNT ] = {
+    MEMPOOL_CLASS_0_SIZE,
+    MEMPOOL_CLASS_1_SIZE,
+    MEMPOOL_CLASS_2_SIZE,
+    MEMPOOL_CLASS_3_SIZE,
+};
+
+static const uint8_t s_blockCounts[ MEMPOOL_CLASS_COUNT ] = {
+    MEMPOOL_CLASS_0_BLOCKS,
+    MEMPOOL_CLASS_1_BLOCKS,
+    MEMPOOL_CLASS_2_BLOCKS,
+    MEMPOOL_CLASS_3_BLOCKS,
+};
+
+
+MemPool g_pool;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Class constructor. Splits the storage in size classes and links 
+ *          the blocks of each class in its free list.
+ * 
+ */
+MemPool::MemPool() {
+    uint8_t* block = s_storage;
+
+    for( uint8_t i = 0; i < MEMPOOL_CLASS_COUNT; i++ ) {
+        MemPoolClass* cls = &_classes[ i ];
+
+        cls->base = block;
+        cls->freeList = nullptr;
+        cls->blockSize = s_blockSizes[ i ];
+        cls->blocks = s_blockCounts[ i ];
+        cls->used = 0;
+        cls->peak = 0;
+        cls->fallbacks = 0;
+        cls->failures = 0;
+
+        /* Link the blocks, the first block ends up at the head of the list */
+        for( uint8_t n = cls->blocks; n > 0; n-- ) {
+            void** item = ( void** )( block + ( n - 1 ) * cls->blockSize );
+
+            *item = cls->freeList;
+            cls->freeList = item;
+        }
+
+        block += cls->blocks * cls->blockSize;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Allocate a block
+ * 
+ * @param   size    Requested size
+ * @param   site    Heap statistics call site used if the request falls back
+ *                  to the heap.
+ *
+ * @return  Pointer to the block or nullptr if the allocation failed.
+ * 
+ */
+void* MemPool::alloc( size_t size, uint8_t site ) {
+    MemPoolClass* fit = nullptr;
+
+    for( uint8_t i = 0; i < MEMPOOL_CLASS_COUNT; i++ ) {
+        MemPoolClass* cls = &_classes[ i ];
+
+        if( size > cls->blockSize ) {
+            continue;
+        }
+
+        /* Remember the smallest class able to hold the request for the 
+           statistics in case every class is full. */
+        if( fit == nullptr ) {
+            fit = cls;
+        }
+
+        if( cls->freeList != nullptr ) {
+            void** item = ( void** )cls->freeList;
+            cls->freeList = *item;
+
+            cls->used++;
+            if( cls->used > cls->peak ) {
+                cls->peak = cls->used;
+            }
+
+            return item;
+        }
+    }
+
+    /* Larger than the largest class, charged to it */
+    if( fit == nullptr ) {
+        fit = &_classes[ MEMPOOL_CLASS_COUNT - 1 ];
+    }
+
+    g_heap.setSite( site );
+    void* ptr = malloc( size );
+
+    if( ptr == nullptr ) {
+        fit->failures++;
+    } else {
+        fit->fallbacks++;
+    }
+
+    return ptr;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Release a block allocated with alloc()
+ * 
+ * @param   ptr    Pointer to the block
+ * 
+ */
+void MemPool::release( void* ptr ) {
+    if( ptr == nullptr ) {
+        return;
+    }
+
+    uint8_t* addr = ( uint8_t* )ptr;
+
+    if( addr < s_storage || addr >= s_storage + MEMPOOL_STORAGE_SIZE ) {
+        free( ptr );
+        return;
+    }
+
+    for( uint8_t i = 0; i < MEMPOOL_CLASS_COUNT; i++ ) {
+        MemPoolClass* cls = &_classes[ i ];
+
+        if( addr >= cls->base + cls->blocks * cls->blockSize ) {
+            continue;
+        }
+
+        void** item = ( void** )ptr;
+        *item = cls->freeList;
+        cls->freeList = item;
+        cls->used--;
+
+        return;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Allocate a block and write a formatted string into it.
+ * 
+ * @param   buffer  Receives the pointer to the block, must be released 
+ *                  with release().
+ * @param   site    Heap statistics call site
+ * @param   format  Format string in program memory
+ * @param   args    Arguments
+ *
+ * @return  Length of the string or -1 if an error occured.
+ * 
+ */
+int MemPool::vformat_P( char** buffer, uint8_t site, const char* format, va_list args ) {
+
+    /* Duplicate list of arguments for length measuring */   
+    va_list args_cpy;
+    va_copy( args_cpy, args );
+
+    int length;
+    length = vsnprintf_P( NULL, 0, format, args_cpy );
+    va_end( args_cpy );
+
+    if( length < 0 ) {
+        return length;
+    }
+
+    char* tempbuf;
+    tempbuf = ( char* )this->alloc( length + 1, site );
+
+    if( tempbuf == nullptr ) {
+        return -1;
+    }
+
+    length = vsnprintf_P( tempbuf, length + 1, format, args );
+
+    if( length < 0 ) {
+        this->release( tempbuf );
+    } else {
+        *buffer = tempbuf;
+    }
+
+    return length;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Allocate a block and write a formatted string into it.
+ * 
+ * @param   buffer  Receives the pointer to the block, must be released 
+ *                  with release().
+ * @param   site    Heap statistics call site
+ * @param   format  Format string in program memory
+ * @param   ...     Arguments
+ *
+ * @return  Length of the string or -1 if an error occured.
+ * 
+ */
+int MemPool::format_P( char** buffer, uint8_t site, const char* format, ... ) {
+    int length;
+    va_list args;
+
+    va_start( args, format );
+    length = this->vformat_P( buffer, site, format, args );
+    va_end( args );
+
+    return length;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the statistics of a size class
+ * 
+ * @param   index   Class index, 0 being the smallest block size.
+ *
+ * @return  Pointer to the class or nullptr if the index is invalid.
+ * 
+ */
+const MemPoolClass* MemPool::getClass( uint8_t index ) {
+    if( index >= MEMPOOL_CLASS_COUNT ) {
+        return nullptr;
+    }
+
+    return &_classes[ index ];
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/mempool/mempool.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+
+
+/* Size classes, smallest first. The block sizes must be a multiple of the
+   pointer size, the free list is stored in the unused blocks. The block
+   counts match the peaks reported by 'free' with the telnet console, an FTP
+   transfer and the MQTT client active at once. The largest class has one 
+   block for the MQTT packet buffer and one for the FTP transfer buffer, 
+   both can be up to 1024 bytes. */
+#ifndef MEMPOOL_CLASS_COUNT
+#define MEMPOOL_CLASS_COUNT         4
+
+#define MEMPOOL_CLASS_0_SIZE        32
+#define MEMPOOL_CLASS_0_BLOCKS      4
+#define MEMPOOL_CLASS_1_SIZE        128
+#define MEMPOOL_CLASS_1_BLOCKS      5
+#define MEMPOOL_CLASS_2_SIZE        256
+#define MEMPOOL_CLASS_2_BLOCKS      1
+#define MEMPOOL_CLASS_3_SIZE        1024
+#define MEMPOOL_CLASS_3_BLOCKS      2
+#endif
+
+#define MEMPOOL_STORAGE_SIZE        ( MEMPOOL_CLASS_0_SIZE * MEMPOOL_CLASS_0_BLOCKS + \
+                                      MEMPOOL_CLASS_1_SIZE * MEMPOOL_CLASS_1_BLOCKS + \
+                                      MEMPOOL_CLASS_2_SIZE * MEMPOOL_CLASS_2_BLOCKS + \
+                                      MEMPOOL_CLASS_3_SIZE * MEMPOOL_CLASS_3_BLOCKS )
+
+
+/* Block size class */
+struct MemPoolClass {
+    uint8_t* base;                          /* First block of the class */
+    void* freeList;                         /* First unused block */
+    uint16_t blockSize;                     /* Size of each block */
+    uint8_t blocks;                         /* Number of blocks */
+    uint8_t used;                           /* Blocks currently allocated */
+    uint8_t peak;                           /* Highest value of used */
+    uint16_t fallbacks;                     /* Requests served by the heap because the class was full */
+    uint16_t failures;                      /* Requests the heap could not serve either */
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Fixed block pool allocator
+ *
+ * @details Blocks are reserved statically and grouped in size classes. A 
+ *          request is served by the smallest class having a free block, in
+ *          constant time. When every suitable class is full, or the request 
+ *          is larger than the largest class, the block is allocated on the 
+ *          heap and the fallback is counted.
+ *
+ *          Blocks must be released with release(), which hands heap blocks
+ *          back to free().
+ *
+ *******************************************************************************/
+class MemPool {
+
+  public:
+    MemPool();
+
+    void* alloc( size_t size, uint8_t site );
+    void release( void* ptr );
+    int vformat_P( char** buffer, uint8_t site, const char* format, va_list args );
+    int format_P( char** buffer, uint8_t site, const char* format, ... );
+
+    uint8_t getClassCount() { return MEMPOOL_CLASS_COUNT; }
+    const MemPoolClass* getClass( uint8_t index );
+
+
+  private:
+    MemPoolClass _classes[ MEMPOOL_CLASS_COUNT ];
+};
+
+
+extern MemPool g_pool;
+
+#endif /* MEMPOOL_H */
\ No newline at end of file
@@ -0,0 +1,228 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/profiler/profiler.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include "profiler.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Class constructor
+ *
+ * @param   budget    Loop time budget in microseconds
+ *
+ */
+LoopProfiler::LoopProfiler( uint32_t budget ) {
+    _budget = budget;
+
+    this->reset();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Clear all recorded statistics
+ *
+ */
+void LoopProfiler::reset() {
+
+    memset( _slots, 0, sizeof( _slots ));
+    memset( &_loop, 0, sizeof( _loop ));
+
+    for( uint8_t i = 0; i < PROFILER_MAX_SLOTS; i++ ) {
+        _slots[ i ].min = UINT32_MAX;
+    }
+    _loop.min = UINT32_MAX;
+
+    _loopStart = 0;
+    _lastMark = 0;
+    _overBudget = 0;
+    _loopCount = 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Start profiling a new loop pass
+ *
+ * @param   now    Current timestamp (us)
+ *
+ */
+void LoopProfiler::beginLoop( uint32_t now ) {
+    _loopStart = now;
+    _lastMark = now;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Record the time elapsed since the previous mark into a slot
+ *
+ * @details Must be called right after each profiled service returns.
+ *
+ * @param   slot   Slot ID
+ * @param   now    Current timestamp (us)
+ *
+ */
+void LoopProfiler::mark( uint8_t slot, uint32_t now ) {
+
+    if( slot < PROFILER_MAX_SLOTS ) {
+        this->record( &_slots[ slot ], now - _lastMark );
+    }
+
+    _lastMark = now;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   End the current loop pass and check it against the budget
+ *
+ * @param   now    Current timestamp (us)
+ *
+ */
+void LoopProfiler::endLoop( uint32_t now ) {
+
+    uint32_t elapsed = now - _loopStart;
+
+    this->record( &_loop, elapsed );
+
+    _loopCount++;
+
+    if( elapsed > _budget ) {
+        _overBudget++;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the statistics of a given slot.
+ *
+ * @param   slot    Slot ID
+ *
+ * @return  Pointer to the slot statistics or nullptr if the ID is invalid.
+ *
+ */
+const ProfilerSlot* LoopProfiler::getSlot( uint8_t slot ) {
+
+    if( slot >= PROFILER_MAX_SLOTS ) {
+        return nullptr;
+    }
+
+    return &_slots[ slot ];
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Calculate the mean time of a slot.
+ *
+ * @param   slot    Pointer to the slot statistics
+ *
+ * @return  Mean time in microseconds.
+ *
+ */
+uint32_t LoopProfiler::getMean( const ProfilerSlot* slot ) {
+
+    if( slot == nullptr || slot->count == 0 ) {
+        return 0;
+    }
+
+    return slot->total / slot->count;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the histogram bucket for a given time.
+ *
+ * @param   elapsed    Time in microseconds
+ * @param   shift      Width of the first bucket (2^shift microseconds)
+ *
+ * @return  Bucket index.
+ *
+ */
+uint8_t LoopProfiler::getBucket( uint32_t elapsed, uint8_t shift ) {
+    uint8_t bucket = 0;
+
+    elapsed >>= shift;
+
+    while( elapsed > 0 && bucket < PROFILER_HIST_BUCKETS - 1 ) {
+        elapsed >>= 2;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the upper limit of a histogram bucket
+ *
+ * @param   bucket    Bucket index
+ * @param   shift     Width of the first bucket (2^shift microseconds)
+ *
+ * @return  Upper limit (exclusive) in microseconds or 0 for the last bucket.
+ *
+ */
+uint32_t LoopProfiler::getBucketLimit( uint8_t bucket, uint8_t shift ) {
+
+    if( bucket >= PROFILER_HIST_BUCKETS - 1 ) {
+        return 0;
+    }
+
+    return (uint32_t)1 << ( shift + ( bucket * 2 ));
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Add a sample to a slot.
+ *
+ * @param   slot       Pointer to the slot statistics
+ * @param   elapsed    Time in microseconds
+ * @param   shift      Width of the first histogram bucket (2^shift microseconds)
+ *
+ */
+void LoopProfiler::record( ProfilerSlot* slot, uint32_t elapsed, uint8_t shift ) {
+
+    /* Halve the accumulators before they overflow, the mean is then weighted
+       toward the most recent samples. */
+    if( slot->count == UINT16_MAX || slot->total > UINT32_MAX - elapsed ) {
+        slot->total /= 2;
+        slot->count /= 2;
+    }
+
+    slot->total += elapsed;
+    slot->count++;
+
+    if( elapsed < slot->min ) {
+        slot->min = elapsed;
+    }
+
+    if( elapsed > slot->max ) {
+        slot->max = elapsed;
+    }
+
+    uint8_t bucket = getBucket( elapsed, shift );
+    if( slot->hist[ bucket ] < UINT16_MAX ) {
+        slot->hist[ bucket ]++;
+    }
+}
\ No newline at end of file
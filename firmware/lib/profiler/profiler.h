@@ -0,0 +1,93 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/profiler/profiler.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <string.h>
+
+
+
+/* Maximum number of profiled services in the main loop */
+#ifndef PROFILER_MAX_SLOTS
+#define PROFILER_MAX_SLOTS          18
+#endif
+
+/* Histogram buckets. The first bucket holds samples below 2^PROFILER_HIST_SHIFT
+   microseconds, each following bucket is 4 times wider than the previous one
+   (<128us, <512us, <2ms, <8ms, <32ms, >=32ms) */
+#define PROFILER_HIST_BUCKETS       6
+#define PROFILER_HIST_SHIFT         7
+
+/* Default loop time budget (microseconds) */
+#define PROFILER_DEFAULT_BUDGET     10000
+
+
+/* Timing statistics of a single profiled slot */
+struct ProfilerSlot {
+    uint32_t min;                                   /* Minimum time (us) */
+    uint32_t max;                                   /* Maximum time (us) */
+    uint32_t total;                                 /* Sum of samples, used to compute the mean */
+    uint16_t count;                                 /* Number of samples in total */
+    uint16_t hist[ PROFILER_HIST_BUCKETS ];         /* Log-bucketed histogram */
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Main loop profiler
+ *
+ * @details Records the time spent in each service called by the main loop.
+ *          Timestamps are provided by the caller (micros()) so the recorder
+ *          does not depend on the Arduino core.
+ *
+ *******************************************************************************/
+class LoopProfiler {
+
+  public:
+    LoopProfiler( uint32_t budget = PROFILER_DEFAULT_BUDGET );
+    void reset();
+    void beginLoop( uint32_t now );
+    void mark( uint8_t slot, uint32_t now );
+    void endLoop( uint32_t now );
+    const ProfilerSlot* getSlot( uint8_t slot );
+    const ProfilerSlot* getLoopSlot() { return &_loop; }
+    uint32_t getMean( const ProfilerSlot* slot );
+    uint32_t getLoopCount() { return _loopCount; }
+    uint32_t getOverBudgetCount() { return _overBudget; }
+    uint32_t getBudget() { return _budget; }
+    void setBudget( uint32_t budget ) { _budget = budget; }
+
+    static uint8_t getBucket( uint32_t elapsed, uint8_t shift = PROFILER_HIST_SHIFT );
+    static uint32_t getBucketLimit( uint8_t bucket, uint8_t shift = PROFILER_HIST_SHIFT );
+    static void record( ProfilerSlot* slot, uint32_t elapsed, uint8_t shift = PROFILER_HIST_SHIFT );
+
+
+  private:
+
+    ProfilerSlot _slots[ PROFILER_MAX_SLOTS ];      /* Per service statistics */
+    ProfilerSlot _loop;                             /* Whole loop statistics */
+    uint32_t _loopStart;                            /* Timestamp when the current loop started */
+    uint32_t _lastMark;                             /* Timestamp of the last mark */
+    uint32_t _budget;                               /* Loop time budget (us) */
+    uint32_t _overBudget;                           /* Number of loops that exceeded the budget */
+    uint32_t _loopCount;                            /* Number of loops recorded */
+};
+
+#endif /* PROFILER_H */
\ No newline at end of file
@@ -0,0 +1,125 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/tracer/tracer.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include "tracer.h"
+
+#if TRACER_ENABLED == 1
+
+
+Tracer g_tracer;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Record an event. Can be called from C code and interrupt 
+ *          handlers.
+ *
+ * @param   id     Event ID
+ * @param   arg    Event argument
+ * 
+ */
+void trace_record( uint8_t id, uint16_t arg ) {
+    g_tracer.record( id, arg );
+}
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Record an event.
+ *
+ * @param   id     Event ID
+ * @param   arg    Event argument
+ * 
+ */
+void Tracer::record( uint8_t id, uint16_t arg ) {
+    if( _paused == true ) {
+        return;
+    }
+
+#if defined( __AVR__ )
+    uint8_t sreg = SREG;
+    cli();
+#endif
+
+    /* Timestamp taken with the interrupts disabled, an event recorded by an
+       interrupt handler can't be stored ahead of an earlier one. */
+    TraceEntry* entry = &_ring[ _head ];
+    entry->time = micros();
+    entry->arg = arg;
+    entry->id = id;
+
+    _head = ( _head + 1 ) % TRACE_BUFFER_SIZE;
+
+    if( _count < TRACE_BUFFER_SIZE ) {
+        _count++;
+    } else {
+        _overwritten++;
+    }
+
+#if defined( __AVR__ )
+    SREG = sreg;
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Discard all events.
+ * 
+ */
+void Tracer::clear() {
+#if defined( __AVR__ )
+    uint8_t sreg = SREG;
+    cli();
+#endif
+
+    _head = 0;
+    _count = 0;
+    _overwritten = 0;
+
+#if defined( __AVR__ )
+    SREG = sreg;
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get an event from the ring. The recording should be paused 
+ *          while the events are read.
+ *
+ * @param   index    Event index, 0 being the oldest event.
+ * @param   entry    Receives the event.
+ *
+ * @return  TRUE if successful, FALSE if the index is out of range.
+ * 
+ */
+bool Tracer::getEntry( uint8_t index, TraceEntry* entry ) {
+    if( index >= _count ) {
+        return false;
+    }
+
+    uint8_t pos = ( _head + TRACE_BUFFER_SIZE - _count + index ) % TRACE_BUFFER_SIZE;
+    *entry = _ring[ pos ];
+
+    return true;
+}
+
+#endif /* TRACER_ENABLED */
\ No newline at end of file
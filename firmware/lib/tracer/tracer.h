@@ -0,0 +1,118 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/tracer/tracer.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <stdint.h>
+
+
+
+/* Record the scheduler and interrupt events. When disabled, trace_record()
+   does nothing and the 'trace' console commands are left out. */
+#ifndef TRACER_ENABLED
+#define TRACER_ENABLED              1
+#endif
+
+/* Number of events kept in the ring, the oldest events are overwritten */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE           64
+#endif
+
+/* Binary dump format */
+#define TRACE_DUMP_MAGIC            "TRCE"
+#define TRACE_DUMP_VERSION          1
+
+/* Trace ID of a service which was not assigned one */
+#define TRACE_ID_NONE               0xFF
+
+/* Events recorded by the task manager. Application events start at
+   TRACE_EVENT_USER. */
+#define TRACE_EVENT_DISPATCH_BEGIN  1       /* arg: service trace ID */
+#define TRACE_EVENT_DISPATCH_END    2       /* arg: service trace ID */
+#define TRACE_EVENT_TASK_START      3       /* arg: service trace ID (MSB), task ID (LSB) */
+#define TRACE_EVENT_TASK_END        4       /* arg: service trace ID (MSB), error code (LSB) */
+#define TRACE_EVENT_USER            16
+
+
+#if TRACER_ENABLED == 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void trace_record( uint8_t id, uint16_t arg );
+
+#ifdef __cplusplus
+}
+
+
+/* Single trace event */
+struct TraceEntry {
+    uint32_t time;                          /* Timestamp (us) */
+    uint16_t arg;                           /* Event argument */
+    uint8_t id;                             /* Event ID */
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Event tracer
+ *
+ * @details Records timestamped events in a ring buffer. record() can be 
+ *          called from interrupt handlers. 
+ *
+ *          The class has no constructor so events can be recorded before 
+ *          the global constructors are run.
+ *
+ *******************************************************************************/
+class Tracer {
+
+  public:
+    void record( uint8_t id, uint16_t arg );
+    void clear();
+    void pause( bool paused ) { _paused = paused; }
+    bool isPaused() { return _paused; }
+    uint8_t getCount() { return _count; }
+    uint32_t getOverwritten() { return _overwritten; }
+    bool getEntry( uint8_t index, TraceEntry* entry );
+
+
+  private:
+    TraceEntry _ring[ TRACE_BUFFER_SIZE ];  /* Event ring buffer */
+    volatile uint8_t _head;                 /* Position of the next event */
+    volatile uint8_t _count;                /* Number of events in the ring */
+    volatile uint32_t _overwritten;         /* Number of events lost because the ring was full */
+    volatile bool _paused;                  /* Recording suspended (eg. during a dump) */
+};
+
+
+extern Tracer g_tracer;
+
+#endif /* __cplusplus */
+
+#else
+
+static inline void trace_record( uint8_t id, uint16_t arg ) {
+    ( void )id;
+    ( void )arg;
+}
+
+#endif /* TRACER_ENABLED */
+
+#endif /* TRACER_H */
\ No newline at end of file
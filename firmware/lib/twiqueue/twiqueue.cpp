@@ -0,0 +1,291 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/twiqueue/twiqueue.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include "twiqueue.h"
+
+
+TwiQueue g_twi;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Initialize the queue and the bus hardware.
+ *
+ * @param   frequency    SCL frequency (Hz)
+ * 
+ */
+void TwiQueue::begin( uint32_t frequency ) {
+    _head = 0;
+    _active = 0;
+    _tail = 0;
+    _busy = false;
+
+    this->clearStats();
+
+    twi_begin( frequency );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Queue a transaction. Must only be called from the main loop.
+ *
+ * @param   transaction    Transaction to run, must be idle.
+ * 
+ * @return  TRUE if successful, FALSE if the queue is full or the transaction
+ *          is already queued.
+ * 
+ */
+bool TwiQueue::submit( TwiTransaction* transaction ) {
+    if( transaction->state != TWI_STATE_IDLE ) {
+        return false;
+    }
+
+    uint8_t head = _head;
+    uint8_t next = ( head + 1 ) & ( TWI_QUEUE_SIZE - 1 );
+
+    if( next == _tail ) {
+        return false;
+    }
+
+    transaction->state = TWI_STATE_QUEUED;
+    transaction->result = TWI_RESULT_OK;
+    _ring[ head ] = transaction;
+
+    uint8_t pending = ( uint8_t )( next - _tail ) & ( TWI_QUEUE_SIZE - 1 );
+    if( pending > _peak ) {
+        _peak = pending;
+    }
+
+    /* Publish the transaction and start the bus if it is idle. The 
+       interrupt must not end the active transaction in between. */
+    noInterrupts();
+
+    _head = next;
+
+    bool start = ( _busy == false );
+    _busy = true;
+
+    if( start == true ) {
+        this->startNext();
+    }
+
+    interrupts();
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Start the transaction at the active position.
+ * 
+ */
+void TwiQueue::startNext() {
+    TwiTransaction* transaction = _ring[ _active ];
+
+    transaction->state = TWI_STATE_BUSY;
+    _startTime = millis();
+
+    twi_start( transaction );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Called by the hardware layer when the active transaction ends,
+ *          from interrupt context. Starts the next queued transaction.
+ *
+ * @param   result    Transaction result (TWI_RESULT_*)
+ * 
+ */
+void TwiQueue::onComplete( uint8_t result ) {
+    TwiTransaction* transaction = _ring[ _active ];
+
+    transaction->result = result;
+    transaction->state = TWI_STATE_COMPLETE;
+
+    _active = ( _active + 1 ) & ( TWI_QUEUE_SIZE - 1 );
+
+    if( _active != _head ) {
+        this->startNext();
+    } else {
+        _busy = false;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Retire the ended transactions and call their callbacks. Resets 
+ *          the bus if the active transaction takes too long.
+ * 
+ */
+void TwiQueue::processEvents() {
+
+    noInterrupts();
+
+    if( _busy == true && millis() - _startTime > TWI_TIMEOUT ) {
+        twi_reset();
+        this->onComplete( TWI_RESULT_TIMEOUT );
+    }
+
+    interrupts();
+
+    while( _tail != _active ) {
+        TwiTransaction* transaction = _ring[ _tail ];
+
+        _tail = ( _tail + 1 ) & ( TWI_QUEUE_SIZE - 1 );
+
+        _count++;
+        if( transaction->result != TWI_RESULT_OK ) {
+            _errors++;
+
+        } else {
+            _bytes += transaction->txLength + transaction->rxLength;
+        }
+
+        /* The transaction can be submitted again from its callback */
+        transaction->state = TWI_STATE_IDLE;
+
+        if( transaction->callback != NULL ) {
+            transaction->callback( transaction );
+        }
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Run a transaction and wait until it ends. The transactions 
+ *          queued before it are completed first.
+ *
+ * @param   address     7-bit device address
+ * @param   txData      Bytes to write
+ * @param   txLength    Number of bytes to write
+ * @param   rxData      Buffer receiving the bytes read
+ * @param   rxLength    Number of bytes to read
+ * 
+ * @return  Transaction result
+ * 
+ * @retval  0   Success
+ * @retval  2   Received NACK on transmit of address
+ * @retval  3   Received NACK on transmit of data
+ * @retval  4   Other error
+ * @retval  5   Timeout
+ * 
+ */
+uint8_t TwiQueue::transfer( uint8_t address, const void* txData, uint8_t txLength, void* rxData, uint8_t rxLength ) {
+    TwiTransaction transaction;
+
+    transaction.address = address;
+    transaction.txData = ( const uint8_t* )txData;
+    transaction.txLength = txLength;
+    transaction.rxData = ( uint8_t* )rxData;
+    transaction.rxLength = rxLength;
+    transaction.callback = NULL;
+    transaction.context = NULL;
+    transaction.state = TWI_STATE_IDLE;
+
+    unsigned long start = micros();
+
+    while( this->submit( &transaction ) == false ) {
+        this->processEvents();
+    }
+
+    while( transaction.state != TWI_STATE_IDLE ) {
+        this->processEvents();
+    }
+
+    _blockingTime += micros() - start;
+
+    return transaction.result;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Write to a device register and wait until it ends.
+ *
+ * @param   address    7-bit device address
+ * @param   reg        Register address
+ * @param   data       Bytes to write
+ * @param   length     Number of bytes (maximum TWI_MAX_REGISTER_WRITE)
+ * 
+ * @return  Transaction result, 1 if the data is too long.
+ * 
+ */
+uint8_t TwiQueue::writeRegister( uint8_t address, uint8_t reg, const void* data, uint8_t length ) {
+    uint8_t buffer[ TWI_MAX_REGISTER_WRITE + 1 ];
+
+    if( length > TWI_MAX_REGISTER_WRITE ) {
+        return TWI_RESULT_TOO_LONG;
+    }
+
+    buffer[ 0 ] = reg;
+    memcpy( buffer + 1, data, length );
+
+    return this->transfer( address, buffer, length + 1 );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Read from a device register and wait until it ends.
+ *
+ * @param   address    7-bit device address
+ * @param   reg        Register address
+ * @param   data       Buffer receiving the bytes read
+ * @param   length     Number of bytes to read
+ * 
+ * @return  Transaction result
+ * 
+ */
+uint8_t TwiQueue::readRegister( uint8_t address, uint8_t reg, void* data, uint8_t length ) {
+    return this->transfer( address, &reg, 1, data, length );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Reset the statistics.
+ * 
+ */
+void TwiQueue::clearStats() {
+    _peak = this->getPending();
+    _count = 0;
+    _errors = 0;
+    _blockingTime = 0;
+    _bytes = 0;
+    _statsTime = millis();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the average bus traffic since the statistics were cleared.
+ * 
+ * @return  Bytes transferred per second.
+ * 
+ */
+uint32_t TwiQueue::getByteRate() {
+    uint32_t seconds = ( millis() - _statsTime ) / 1000;
+
+    return ( seconds > 0 ) ? _bytes / seconds : _bytes;
+}
\ No newline at end of file
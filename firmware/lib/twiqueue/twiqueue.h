@@ -0,0 +1,141 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : lib/twiqueue/twiqueue.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef TWIQUEUE_H
+#define TWIQUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+
+/* Size of the transaction ring, must be a power of 2. One slot is kept 
+   empty to tell a full queue from an empty one. */
+#ifndef TWI_QUEUE_SIZE
+#define TWI_QUEUE_SIZE              8
+#endif
+
+/* Maximum time a transaction can hold the bus before the bus is reset (ms) */
+#ifndef TWI_TIMEOUT
+#define TWI_TIMEOUT                 25
+#endif
+
+/* Maximum number of data bytes written by writeRegister() */
+#ifndef TWI_MAX_REGISTER_WRITE
+#define TWI_MAX_REGISTER_WRITE      32
+#endif
+
+/* Transaction states */
+enum {
+    TWI_STATE_IDLE = 0,                     /* Not queued, result of the last run is valid */
+    TWI_STATE_QUEUED,                       /* Waiting for the bus */
+    TWI_STATE_BUSY,                         /* On the bus */
+    TWI_STATE_COMPLETE,                     /* Ended, waiting for processEvents() */
+};
+
+/* Transaction results, same values as Wire.endTransmission() */
+enum {
+    TWI_RESULT_OK = 0,
+    TWI_RESULT_TOO_LONG = 1,
+    TWI_RESULT_NACK_ADDRESS = 2,
+    TWI_RESULT_NACK_DATA = 3,
+    TWI_RESULT_ERROR = 4,
+    TWI_RESULT_TIMEOUT = 5,
+};
+
+
+struct TwiTransaction;
+typedef void ( *TwiCallback )( TwiTransaction* transaction );
+
+/* I2C transaction : writes 'txLength' bytes then reads 'rxLength' bytes 
+   after a repeated start. The transaction and its buffers must stay valid
+   until it is back to the idle state. */
+struct TwiTransaction {
+    uint8_t address;                        /* 7-bit device address */
+    const uint8_t* txData;                  /* Bytes to write */
+    uint8_t txLength;
+    uint8_t* rxData;                        /* Receives the bytes read */
+    uint8_t rxLength;
+    TwiCallback callback;                   /* Called from processEvents() once ended, may be NULL */
+    void* context;                          /* Callback argument */
+    volatile uint8_t state;                 /* TWI_STATE_* */
+    volatile uint8_t result;                /* TWI_RESULT_* */
+};
+
+
+/* Bus hardware layer, implemented by src/drivers/twi.cpp (TWI peripheral)
+   or by the native build. twi_start() is called with a single transaction 
+   on the bus, the hardware calls TwiQueue::onComplete() when it ends. */
+void twi_begin( uint32_t frequency );
+void twi_start( TwiTransaction* transaction );
+void twi_reset();
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Asynchronous I2C transaction queue
+ *
+ * @details Transactions are submitted by the main loop and run one after 
+ *          the other by the TWI interrupt. Their callbacks are called 
+ *          from processEvents() in submission order. transfer() is a
+ *          blocking wrapper for the paths which need the result right 
+ *          away (initialization, configuration).
+ *
+ *******************************************************************************/
+class TwiQueue {
+
+  public:
+    void begin( uint32_t frequency );
+    bool submit( TwiTransaction* transaction );
+    void processEvents();
+    uint8_t transfer( uint8_t address, const void* txData, uint8_t txLength, void* rxData = NULL, uint8_t rxLength = 0 );
+    uint8_t writeRegister( uint8_t address, uint8_t reg, const void* data, uint8_t length );
+    uint8_t readRegister( uint8_t address, uint8_t reg, void* data, uint8_t length );
+    bool isIdle() { return _busy == false; }
+    uint8_t getPending() { return ( uint8_t )( _head - _tail ) & ( TWI_QUEUE_SIZE - 1 ); }
+    uint8_t getPeak() { return _peak; }
+    uint32_t getCount() { return _count; }
+    uint16_t getErrors() { return _errors; }
+    uint32_t getBlockingTime() { return _blockingTime; }
+    uint32_t getByteCount() { return _bytes; }
+    uint32_t getByteRate();
+    void clearStats();
+    void onComplete( uint8_t result );
+
+
+  private:
+    void startNext();
+
+    TwiTransaction* _ring[ TWI_QUEUE_SIZE ];  /* Transaction ring */
+    volatile uint8_t _head;                 /* Position of the next transaction, written by submit() */
+    volatile uint8_t _active;               /* Transaction on the bus, written by onComplete() */
+    volatile uint8_t _tail;                 /* Oldest transaction not retired, written by processEvents() */
+    volatile bool _busy;                    /* A transaction is on the bus */
+    uint8_t _peak;                          /* Highest number of queued transactions */
+    unsigned long _startTime;               /* Time the active transaction started (ms) */
+    uint32_t _count;                        /* Completed transactions */
+    uint16_t _errors;                       /* Failed transactions */
+    uint32_t _blockingTime;                 /* Time spent waiting in transfer() (us) */
+    uint32_t _bytes;                        /* Bytes transferred by the successful transactions */
+    unsigned long _statsTime;               /* Time the statistics were cleared (ms) */
+};
+
+
+extern TwiQueue g_twi;
+
+#endif /* TWIQUEUE_H */
\ No newline at end of file
@@ -34,6 +34,7 @@
 
 #define MAX_TIMEZONE_ID                  339
 #define TZ_DB_VERSION                    "2023c"
+#define TZ_CAPTION_LENGTH                14
 
 #define TZ_REGION_AFRICA_INDEX           0
 #define TZ_REGION_AFRICA_SIZE            19
@@ -863,4 +864,692 @@ const TimeZoneRules TimeZonesTable[] PROGMEM = {
     { TZ_AMERICA_ARGENTINA_USHUAIA, -180, 0, 0, 0, 0, 0, TZ_M03, -180, 0, 0, 0, 0, 0, TZ_M03 },
 };
 
+
+/* Timezone captions shown by the selection screen, in table order */
+const char TimeZoneCaptions[] PROGMEM = {
+    "Abidjan\0"
+    "Algiers\0"
+    "Bissau\0"
+    "Cairo\0"
+    "Casablanca\0"
+    "Ceuta\0"
+    "El Aaiun\0"
+    "Johannesburg\0"
+    "Juba\0"
+    "Khartoum\0"
+    "Lagos\0"
+    "Maputo\0"
+    "Monrovia\0"
+    "Nairobi\0"
+    "Ndjamena\0"
+    "Sao Tome\0"
+    "Tripoli\0"
+    "Tunis\0"
+    "Windhoek\0"
+    "Casey\0"
+    "Davis\0"
+    "Macquarie\0"
+    "Mawson\0"
+    "Palmer\0"
+    "Rothera\0"
+    "Troll\0"
+    "Almaty\0"
+    "Anadyr\0"
+    "Aqtau\0"
+    "Aqtobe\0"
+    "Ashgabat\0"
+    "Atyrau\0"
+    "Baku\0"
+    "Bangkok\0"
+    "Barnaul\0"
+    "Bishkek\0"
+    "Chita\0"
+    "Choibalsan\0"
+    "Colombo\0"
+    "Dhaka\0"
+    "Dili\0"
+    "Dushanbe\0"
+    "Famagusta\0"
+    "Ho Chi Minh\0"
+    "Hong Kong\0"
+    "Hovd\0"
+    "Irkutsk\0"
+    "Jakarta\0"
+    "Jayapura\0"
+    "Kabul\0"
+    "Kamchatka\0"
+    "Karachi\0"
+    "Kathmandu\0"
+    "Khandyga\0"
+    "Kolkata\0"
+    "Krasnoyarsk\0"
+    "Kuching\0"
+    "Macau\0"
+    "Magadan\0"
+    "Makassar\0"
+    "Manila\0"
+    "Nicosia\0"
+    "Novokuznetsk\0"
+    "Novosibirsk\0"
+    "Omsk\0"
+    "Oral\0"
+    "Pontianak\0"
+    "Pyongyang\0"
+    "Qostanay\0"
+    "Qyzylorda\0"
+    "Sakhalin\0"
+    "Samarkand\0"
+    "Seoul\0"
+    "Shanghai\0"
+    "Singapore\0"
+    "Srednekolymsk\0"
+    "Taipei\0"
+    "Tashkent\0"
+    "Tbilisi\0"
+    "Thimphu\0"
+    "Tokyo\0"
+    "Tomsk\0"
+    "Ulaanbaatar\0"
+    "Urumqi\0"
+    "Ust-Nera\0"
+    "Vladivostok\0"
+    "Yakutsk\0"
+    "Yangon\0"
+    "Yekaterinburg\0"
+    "Yerevan\0"
+    "Azores\0"
+    "Bermuda\0"
+    "Canary\0"
+    "Cape Verde\0"
+    "Faroe\0"
+    "Madeira\0"
+    "South Georgia\0"
+    "Stanley\0"
+    "Adelaide\0"
+    "Brisbane\0"
+    "Broken Hill\0"
+    "Darwin\0"
+    "Eucla\0"
+    "Hobart\0"
+    "Lindeman\0"
+    "Lord Howe\0"
+    "Melbourne\0"
+    "Perth\0"
+    "Sydney\0"
+    "Barbados\0"
+    "Grand Turk\0"
+    "Havana\0"
+    "Jamaica\0"
+    "Martinique\0"
+    "Port-au-Prince\0"
+    "Puerto Rico\0"
+    "Santo Domingo\0"
+    "Bahia Banderas\0"
+    "Belize\0"
+    "Cancun\0"
+    "Chihuahua\0"
+    "Ciudad Juarez\0"
+    "Costa Rica\0"
+    "El Salvador\0"
+    "Guatemala\0"
+    "Hermosillo\0"
+    "Managua\0"
+    "Matamoros\0"
+    "Mazatlan\0"
+    "Merida\0"
+    "Mexico City\0"
+    "Monterrey\0"
+    "Ojinaga\0"
+    "Panama\0"
+    "Tegucigalpa\0"
+    "Tijuana\0"
+    "GMT-10\0"
+    "GMT+10\0"
+    "GMT-11\0"
+    "GMT+11\0"
+    "GMT-12\0"
+    "GMT+12\0"
+    "GMT-13\0"
+    "GMT-14\0"
+    "GMT-1\0"
+    "GMT+1\0"
+    "GMT-2\0"
+    "GMT+2\0"
+    "GMT-3\0"
+    "GMT+3\0"
+    "GMT-4\0"
+    "GMT+4\0"
+    "GMT-5\0"
+    "GMT+5\0"
+    "GMT-6\0"
+    "GMT+6\0"
+    "GMT-7\0"
+    "GMT+7\0"
+    "GMT-8\0"
+    "GMT+8\0"
+    "GMT-9\0"
+    "GMT+9\0"
+    "GMT\0"
+    "UTC\0"
+    "Andorra\0"
+    "Astrakhan\0"
+    "Athens\0"
+    "Belgrade\0"
+    "Berlin\0"
+    "Brussels\0"
+    "Bucharest\0"
+    "Budapest\0"
+    "Chisinau\0"
+    "Dublin\0"
+    "Gibraltar\0"
+    "Helsinki\0"
+    "Istanbul\0"
+    "Kaliningrad\0"
+    "Kirov\0"
+    "Kyiv\0"
+    "Lisbon\0"
+    "London\0"
+    "Madrid\0"
+    "Malta\0"
+    "Minsk\0"
+    "Moscow\0"
+    "Paris\0"
+    "Prague\0"
+    "Riga\0"
+    "Rome\0"
+    "Samara\0"
+    "Saratov\0"
+    "Simferopol\0"
+    "Sofia\0"
+    "Tallinn\0"
+    "Tirane\0"
+    "Ulyanovsk\0"
+    "Vienna\0"
+    "Vilnius\0"
+    "Volgograd\0"
+    "Warsaw\0"
+    "Zurich\0"
+    "Chagos\0"
+    "Maldives\0"
+    "Mauritius\0"
+    "Amman\0"
+    "Baghdad\0"
+    "Beirut\0"
+    "Damascus\0"
+    "Dubai\0"
+    "Gaza\0"
+    "Hebron\0"
+    "Jerusalem\0"
+    "Qatar\0"
+    "Riyadh\0"
+    "Tehran\0"
+    "Adak\0"
+    "Anchorage\0"
+    "Beulah, ND\0"
+    "Boise\0"
+    "Cambridge Bay\0"
+    "Center, ND\0"
+    "Chicago\0"
+    "Danmarkshavn\0"
+    "Dawson Creek\0"
+    "Dawson\0"
+    "Denver\0"
+    "Detroit\0"
+    "Edmonton\0"
+    "Fort Nelson\0"
+    "Glace Bay\0"
+    "Goose Bay\0"
+    "Halifax\0"
+    "Indianapolis\0"
+    "Inuvik\0"
+    "Iqaluit\0"
+    "Juneau\0"
+    "Knox, IN\0"
+    "Los Angeles\0"
+    "Louisville, KY\0"
+    "Marengo, IN\0"
+    "Menominee\0"
+    "Metlakatla\0"
+    "Miquelon\0"
+    "Moncton\0"
+    "Monticello, KY\0"
+    "New Salem, ND\0"
+    "New York\0"
+    "Nome\0"
+    "Nuuk\0"
+    "Petersburg, IN\0"
+    "Phoenix\0"
+    "Rankin Inlet\0"
+    "Regina\0"
+    "Resolute\0"
+    "Scoresbysund\0"
+    "Sitka\0"
+    "St Johns\0"
+    "Swift Current\0"
+    "Tell City, IN\0"
+    "Thule\0"
+    "Toronto\0"
+    "Vancouver\0"
+    "Vevay, IN\0"
+    "Vincennes, IN\0"
+    "Whitehorse\0"
+    "Winamac, IN\0"
+    "Winnipeg\0"
+    "Yakutat\0"
+    "Apia\0"
+    "Auckland\0"
+    "Bougainville\0"
+    "Chatham\0"
+    "Easter\0"
+    "Efate\0"
+    "Fakaofo\0"
+    "Fiji\0"
+    "Galapagos\0"
+    "Gambier\0"
+    "Guadalcanal\0"
+    "Guam\0"
+    "Honolulu\0"
+    "Kanton\0"
+    "Kiritimati\0"
+    "Kosrae\0"
+    "Kwajalein\0"
+    "Marquesas\0"
+    "Nauru\0"
+    "Niue\0"
+    "Norfolk\0"
+    "Noumea\0"
+    "Pago Pago\0"
+    "Palau\0"
+    "Pitcairn\0"
+    "Port Moresby\0"
+    "Rarotonga\0"
+    "Tahiti\0"
+    "Tarawa\0"
+    "Tongatapu\0"
+    "Araguaina\0"
+    "Asuncion\0"
+    "Bahia\0"
+    "Belem\0"
+    "Boa Vista\0"
+    "Bogota\0"
+    "Buenos Aires\0"
+    "Campo Grande\0"
+    "Caracas\0"
+    "Catamarca\0"
+    "Cayenne\0"
+    "Cordoba\0"
+    "Cuiaba\0"
+    "Eirunepe\0"
+    "Fortaleza\0"
+    "Guayaquil\0"
+    "Guyana\0"
+    "Jujuy\0"
+    "La Paz\0"
+    "La Rioja\0"
+    "Lima\0"
+    "Maceio\0"
+    "Manaus\0"
+    "Mendoza\0"
+    "Montevideo\0"
+    "Noronha\0"
+    "Paramaribo\0"
+    "Porto Velho\0"
+    "Punta Arenas\0"
+    "Recife\0"
+    "Rio Branco\0"
+    "Rio Gallegos\0"
+    "Salta\0"
+    "San Juan\0"
+    "San Luis\0"
+    "Santarem\0"
+    "Santiago\0"
+    "Sao Paulo\0"
+    "Tucuman\0"
+    "Ushuaia\0"
+};
+
+
+/* Offset of each caption in TimeZoneCaptions */
+const uint16_t TimeZoneCaptionOffsets[] PROGMEM = {
+    0,
+    8,
+    16,
+    23,
+    29,
+    40,
+    46,
+    55,
+    68,
+    73,
+    82,
+    88,
+    95,
+    104,
+    112,
+    121,
+    130,
+    138,
+    144,
+    153,
+    159,
+    165,
+    175,
+    182,
+    189,
+    197,
+    203,
+    210,
+    217,
+    223,
+    230,
+    239,
+    246,
+    251,
+    259,
+    267,
+    275,
+    281,
+    292,
+    300,
+    306,
+    311,
+    320,
+    330,
+    342,
+    352,
+    357,
+    365,
+    373,
+    382,
+    388,
+    398,
+    406,
+    416,
+    425,
+    433,
+    445,
+    453,
+    459,
+    467,
+    476,
+    483,
+    491,
+    504,
+    516,
+    521,
+    526,
+    536,
+    546,
+    555,
+    565,
+    574,
+    584,
+    590,
+    599,
+    609,
+    623,
+    630,
+    639,
+    647,
+    655,
+    661,
+    667,
+    679,
+    686,
+    695,
+    707,
+    715,
+    722,
+    736,
+    744,
+    751,
+    759,
+    766,
+    777,
+    783,
+    791,
+    805,
+    813,
+    822,
+    831,
+    843,
+    850,
+    856,
+    863,
+    872,
+    882,
+    892,
+    898,
+    905,
+    914,
+    925,
+    932,
+    940,
+    951,
+    966,
+    978,
+    992,
+    1007,
+    1014,
+    1021,
+    1031,
+    1045,
+    1056,
+    1068,
+    1078,
+    1089,
+    1097,
+    1107,
+    1116,
+    1123,
+    1135,
+    1145,
+    1153,
+    1160,
+    1172,
+    1180,
+    1187,
+    1194,
+    1201,
+    1208,
+    1215,
+    1222,
+    1229,
+    1236,
+    1242,
+    1248,
+    1254,
+    1260,
+    1266,
+    1272,
+    1278,
+    1284,
+    1290,
+    1296,
+    1302,
+    1308,
+    1314,
+    1320,
+    1326,
+    1332,
+    1338,
+    1344,
+    1348,
+    1352,
+    1360,
+    1370,
+    1377,
+    1386,
+    1393,
+    1402,
+    1412,
+    1421,
+    1430,
+    1437,
+    1447,
+    1456,
+    1465,
+    1477,
+    1483,
+    1488,
+    1495,
+    1502,
+    1509,
+    1515,
+    1521,
+    1528,
+    1534,
+    1541,
+    1546,
+    1551,
+    1558,
+    1566,
+    1577,
+    1583,
+    1591,
+    1598,
+    1608,
+    1615,
+    1623,
+    1633,
+    1640,
+    1647,
+    1654,
+    1663,
+    1673,
+    1679,
+    1687,
+    1694,
+    1703,
+    1709,
+    1714,
+    1721,
+    1731,
+    1737,
+    1744,
+    1751,
+    1756,
+    1766,
+    1777,
+    1783,
+    1797,
+    1808,
+    1816,
+    1829,
+    1842,
+    1849,
+    1856,
+    1864,
+    1873,
+    1885,
+    1895,
+    1905,
+    1913,
+    1926,
+    1933,
+    1941,
+    1948,
+    1957,
+    1969,
+    1984,
+    1996,
+    2006,
+    2017,
+    2026,
+    2034,
+    2049,
+    2063,
+    2072,
+    2077,
+    2082,
+    2097,
+    2105,
+    2118,
+    2125,
+    2134,
+    2147,
+    2153,
+    2162,
+    2176,
+    2190,
+    2196,
+    2204,
+    2214,
+    2224,
+    2238,
+    2249,
+    2261,
+    2270,
+    2278,
+    2283,
+    2292,
+    2305,
+    2313,
+    2320,
+    2326,
+    2334,
+    2339,
+    2349,
+    2357,
+    2369,
+    2374,
+    2383,
+    2390,
+    2401,
+    2408,
+    2418,
+    2428,
+    2434,
+    2439,
+    2447,
+    2454,
+    2464,
+    2470,
+    2479,
+    2492,
+    2502,
+    2509,
+    2516,
+    2526,
+    2536,
+    2545,
+    2551,
+    2557,
+    2567,
+    2574,
+    2587,
+    2600,
+    2608,
+    2618,
+    2626,
+    2634,
+    2641,
+    2650,
+    2660,
+    2670,
+    2677,
+    2683,
+    2690,
+    2699,
+    2704,
+    2711,
+    2718,
+    2726,
+    2737,
+    2745,
+    2756,
+    2768,
+    2781,
+    2788,
+    2799,
+    2812,
+    2818,
+    2827,
+    2836,
+    2845,
+    2854,
+    2864,
+    2872,
+};
+
 #endif /* TZDATA_H */
@@ -45,6 +45,8 @@
 #include "bsp/include/nm_bsp.h"
 #include "bsp/include/nm_bsp_arduino.h"
 #include "common/include/nm_common.h"
+#include <trace_events.h>
+#include <isr_events.h>
 
 int8_t gi8Winc1501CsPin = WINC1501_SPI_CS_PIN;
 int8_t gi8Winc1501ResetPin = WINC1501_RESET_PIN;
@@ -65,6 +67,9 @@ void __attribute__((weak)) detachInterruptMultiArch(uint32_t pin)
 
 static void chip_isr(void)
 {
+	trace_record(TRACE_EVENT_ISR_WIFI, 0);
+	event_queue_push(ISR_EVENT_WIFI, 0);
+
 	if (gpfIsr) {
 		gpfIsr();
 	}
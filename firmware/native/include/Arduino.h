@@ -0,0 +1,151 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/Arduino.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+/* Minimal subset of the Arduino core API used by the firmware, implemented
+   on top of the host C library for the native build. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr_stdio.h>
+
+
+
+#define HIGH                0x1
+#define LOW                 0x0
+
+#define INPUT               0x0
+#define OUTPUT              0x1
+#define INPUT_PULLUP        0x2
+
+#define CHANGE              1
+#define FALLING             2
+#define RISING              3
+
+#define LSBFIRST            0
+#define MSBFIRST            1
+
+#define DEC                 10
+#define HEX                 16
+#define OCT                 8
+#define BIN                 2
+
+/* Pins (ATmega2560) */
+#define NUM_DIGITAL_PINS    70
+#define PIN_A0              54
+#define A0                  54
+#define A1                  55
+#define A2                  56
+#define A3                  57
+#define A4                  58
+#define A5                  59
+#define A6                  60
+#define A7                  61
+#define A8                  62
+#define A9                  63
+#define A10                 64
+#define A11                 65
+#define A12                 66
+#define A13                 67
+#define A14                 68
+#define A15                 69
+
+#define NOT_AN_INTERRUPT    -1
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+#define min(a,b)                ((a)<(b)?(a):(b))
+#define max(a,b)                ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define round(x)                ((x)>=0?(long)((x)+0.5):(long)((x)-0.5))
+#define sq(x)                   ((x)*(x))
+
+#define lowByte(w)              ((uint8_t) ((w) & 0xff))
+#define highByte(w)             ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)     (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)      ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)    ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b)                  (1UL << (b))
+
+#define digitalPinToInterrupt(p)    ( (p) )
+#define digitalPinToPort(p)         ( (p) )
+#define digitalPinToBitMask(p)      ( (uint8_t)0x01 )
+#define portOutputRegister(p)       ( nativePortRegister( p ) )
+
+#define interrupts()            sei()
+#define noInterrupts()          cli()
+
+/* Flash strings are plain strings on the host */
+class __FlashStringHelper;
+#define F(string_literal)       ( reinterpret_cast<const __FlashStringHelper *>( PSTR( string_literal )))
+
+
+unsigned long millis();
+unsigned long micros();
+void delay( unsigned long ms );
+void delayMicroseconds( unsigned int us );
+void yield();
+
+void pinMode( uint8_t pin, uint8_t mode );
+void digitalWrite( uint8_t pin, uint8_t val );
+int digitalRead( uint8_t pin );
+int analogRead( uint8_t pin );
+void analogWrite( uint8_t pin, int val );
+void attachInterrupt( uint8_t interruptNum, void ( *userFunc )( void ), int mode );
+void detachInterrupt( uint8_t interruptNum );
+volatile uint8_t* nativePortRegister( uint8_t pin );
+
+long random( long howbig );
+long random( long howsmall, long howbig );
+void randomSeed( unsigned long seed );
+long map( long x, long in_min, long in_max, long out_min, long out_max );
+
+char* itoa( int value, char* str, int base );
+char* ltoa( long value, char* str, int base );
+char* utoa( unsigned int value, char* str, int base );
+char* ultoa( unsigned long value, char* str, int base );
+
+/* avr-libc extensions */
+char* strupr( char* str );
+char* strlwr( char* str );
+extern char* __malloc_heap_start;
+
+void setup();
+void loop();
+
+
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+#endif /* ARDUINO_H */
\ No newline at end of file
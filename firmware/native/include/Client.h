@@ -0,0 +1,51 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/Client.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_CLIENT_H
+#define NATIVE_CLIENT_H
+
+#include "Stream.h"
+#include "IPAddress.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Arduino network client interface
+ *
+ *******************************************************************************/
+class Client : public Stream {
+
+  public:
+    virtual int connect( IPAddress ip, uint16_t port ) = 0;
+    virtual int connect( const char* host, uint16_t port ) = 0;
+    virtual size_t write( uint8_t ) = 0;
+    virtual size_t write( const uint8_t* buf, size_t size ) = 0;
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int read( uint8_t* buf, size_t size ) = 0;
+    virtual int peek() = 0;
+    virtual void flush() = 0;
+    virtual void stop() = 0;
+    virtual uint8_t connected() = 0;
+    virtual operator bool() = 0;
+
+  protected:
+    uint8_t* rawIPAddress( IPAddress& addr ) { return ( uint8_t* )&addr; }
+};
+
+#endif /* NATIVE_CLIENT_H */
\ No newline at end of file
@@ -0,0 +1,60 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/EEPROM.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_EEPROM_H
+#define NATIVE_EEPROM_H
+
+#include <Arduino.h>
+
+
+
+/*******************************************************************************
+ *
+ * @brief   EEPROM emulation, persisted in a host file (see native.h)
+ *
+ *******************************************************************************/
+class EEPROMClass {
+
+  public:
+    uint8_t read( int address );
+    void write( int address, uint8_t value );
+    void update( int address, uint8_t value );
+    uint16_t length() { return E2END + 1; }
+
+    template <typename T> T& get( int address, T& value ) {
+        uint8_t* ptr = ( uint8_t* )&value;
+
+        for( size_t i = 0; i < sizeof( T ); i++ ) {
+            *ptr++ = this->read( address + i );
+        }
+        return value;
+    }
+
+    template <typename T> const T& put( int address, const T& value ) {
+        const uint8_t* ptr = ( const uint8_t* )&value;
+
+        for( size_t i = 0; i < sizeof( T ); i++ ) {
+            this->update( address + i, *ptr++ );
+        }
+        return value;
+    }
+};
+
+
+extern EEPROMClass EEPROM;
+
+#endif /* NATIVE_EEPROM_H */
\ No newline at end of file
@@ -0,0 +1,53 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/HardwareSerial.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_HARDWARESERIAL_H
+#define NATIVE_HARDWARESERIAL_H
+
+#include "Stream.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Serial port mapped to the host terminal (stdin/stdout)
+ *
+ *******************************************************************************/
+class HardwareSerial : public Stream {
+
+  public:
+    void begin( unsigned long baud ) { ( void )baud; }
+    void end() {}
+    virtual int available();
+    virtual int read();
+    virtual int peek();
+    virtual void flush();
+    virtual size_t write( uint8_t c );
+    virtual size_t write( const uint8_t* buffer, size_t size );
+    using Print::write;
+    operator bool() { return true; }
+
+  private:
+    int fill();
+
+    int _peek = -1;
+};
+
+
+extern HardwareSerial Serial;
+
+#endif /* NATIVE_HARDWARESERIAL_H */
\ No newline at end of file
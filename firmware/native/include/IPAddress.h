@@ -0,0 +1,60 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/IPAddress.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_IPADDRESS_H
+#define NATIVE_IPADDRESS_H
+
+#include <stdint.h>
+
+
+
+/*******************************************************************************
+ *
+ * @brief   IPv4 address, stored in network byte order
+ *
+ *******************************************************************************/
+class IPAddress {
+
+  public:
+    IPAddress() { _address.dword = 0; }
+    IPAddress( uint8_t a, uint8_t b, uint8_t c, uint8_t d );
+    IPAddress( uint32_t address ) { _address.dword = address; }
+    IPAddress( const uint8_t* address );
+
+    bool fromString( const char* address );
+
+    operator uint32_t() const { return _address.dword; }
+    bool operator==( const IPAddress& addr ) const { return _address.dword == addr._address.dword; }
+    bool operator==( const uint8_t* addr ) const;
+
+    uint8_t operator[]( int index ) const { return _address.bytes[ index ]; }
+    uint8_t& operator[]( int index ) { return _address.bytes[ index ]; }
+
+    IPAddress& operator=( const uint8_t* address );
+    IPAddress& operator=( uint32_t address ) { _address.dword = address; return *this; }
+
+  private:
+    union {
+        uint8_t bytes[ 4 ];
+        uint32_t dword;
+    } _address;
+};
+
+
+extern const IPAddress INADDR_NONE;
+
+#endif /* NATIVE_IPADDRESS_H */
\ No newline at end of file
@@ -0,0 +1,80 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/Print.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_PRINT_H
+#define NATIVE_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+
+
+class __FlashStringHelper;
+
+
+/*******************************************************************************
+ *
+ * @brief   Arduino Print interface
+ *
+ *******************************************************************************/
+class Print {
+
+  public:
+    virtual ~Print() {}
+
+    int getWriteError() { return _writeError; }
+    void clearWriteError() { _writeError = 0; }
+
+    virtual size_t write( uint8_t ) = 0;
+    virtual size_t write( const uint8_t* buffer, size_t size );
+    size_t write( const char* str ) { return str == nullptr ? 0 : write( ( const uint8_t* )str, strlen( str )); }
+    size_t write( const char* buffer, size_t size ) { return write( ( const uint8_t* )buffer, size ); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print( const __FlashStringHelper* str );
+    size_t print( const char* str );
+    size_t print( char c );
+    size_t print( unsigned char value, int base = 10 );
+    size_t print( int value, int base = 10 );
+    size_t print( unsigned int value, int base = 10 );
+    size_t print( long value, int base = 10 );
+    size_t print( unsigned long value, int base = 10 );
+    size_t print( double value, int digits = 2 );
+
+    size_t println( const __FlashStringHelper* str );
+    size_t println( const char* str );
+    size_t println( char c );
+    size_t println( unsigned char value, int base = 10 );
+    size_t println( int value, int base = 10 );
+    size_t println( unsigned int value, int base = 10 );
+    size_t println( long value, int base = 10 );
+    size_t println( unsigned long value, int base = 10 );
+    size_t println( double value, int digits = 2 );
+    size_t println();
+
+  protected:
+    void setWriteError( int error = 1 ) { _writeError = error; }
+
+  private:
+    size_t printNumber( unsigned long value, uint8_t base );
+
+    int _writeError = 0;
+};
+
+#endif /* NATIVE_PRINT_H */
\ No newline at end of file
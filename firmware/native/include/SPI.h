@@ -0,0 +1,93 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/SPI.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_SPI_H
+#define NATIVE_SPI_H
+
+#include <Arduino.h>
+
+
+
+#define SPI_HAS_TRANSACTION         1
+
+#define SPI_MODE0                   0x00
+#define SPI_MODE1                   0x04
+#define SPI_MODE2                   0x08
+#define SPI_MODE3                   0x0C
+
+#define SPI_CLOCK_DIV2              0x04
+#define SPI_CLOCK_DIV4              0x00
+#define SPI_CLOCK_DIV8              0x05
+#define SPI_CLOCK_DIV16             0x01
+#define SPI_CLOCK_DIV32             0x06
+#define SPI_CLOCK_DIV64             0x02
+#define SPI_CLOCK_DIV128            0x03
+
+
+class SPISettings {
+
+  public:
+    SPISettings() {}
+    SPISettings( uint32_t clock, uint8_t bitOrder, uint8_t dataMode ) {
+        ( void )clock; ( void )bitOrder; ( void )dataMode;
+    }
+};
+
+
+/* Sends a byte to the emulated device selected (see native.h), returns 0xFF
+   if none is. */
+uint8_t nativeSPITransfer( uint8_t data );
+
+
+/*******************************************************************************
+ *
+ * @brief   SPI bus. Transfers go to the emulated devices registered with 
+ *          nativeRegisterSPIDevice().
+ *
+ *******************************************************************************/
+class SPIClass {
+
+  public:
+    static void begin() {}
+    static void end() {}
+    static void beginTransaction( SPISettings settings ) { ( void )settings; }
+    static void endTransaction() {}
+    static void usingInterrupt( uint8_t interruptNumber ) { ( void )interruptNumber; }
+    static void setBitOrder( uint8_t bitOrder ) { ( void )bitOrder; }
+    static void setDataMode( uint8_t dataMode ) { ( void )dataMode; }
+    static void setClockDivider( uint8_t clockDiv ) { ( void )clockDiv; }
+    static uint8_t transfer( uint8_t data ) { return nativeSPITransfer( data ); }
+
+    static uint16_t transfer16( uint16_t data ) {
+        uint16_t high = nativeSPITransfer( data >> 8 );
+        return ( high << 8 ) | nativeSPITransfer( data & 0xFF );
+    }
+
+    static void transfer( void* buf, size_t count ) {
+        uint8_t* data = ( uint8_t* )buf;
+
+        while( count-- ) {
+            *data = nativeSPITransfer( *data );
+            data++;
+        }
+    }
+};
+
+
+extern SPIClass SPI;
+
+#endif /* NATIVE_SPI_H */
\ No newline at end of file
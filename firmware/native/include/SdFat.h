@@ -0,0 +1,205 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/SdFat.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_SDFAT_H
+#define NATIVE_SDFAT_H
+
+/* Subset of the SdFat 2.x API backed by a host directory (see native.h).
+   Paths are resolved relative to the volume working directory. */
+
+#include <Arduino.h>
+
+
+
+/* Open flags, same values as SdFat on AVR */
+typedef uint8_t oflag_t;
+
+#undef O_RDONLY
+#undef O_WRONLY
+#undef O_RDWR
+#undef O_ACCMODE
+#undef O_APPEND
+#undef O_CREAT
+#undef O_TRUNC
+#undef O_EXCL
+#define O_RDONLY                    0x00
+#define O_WRONLY                    0x01
+#define O_RDWR                      0x02
+#define O_ACCMODE                   ( O_RDONLY | O_WRONLY | O_RDWR )
+#define O_APPEND                    0x08
+#define O_CREAT                     0x10
+#define O_TRUNC                     0x20
+#define O_EXCL                      0x40
+#define O_READ                      O_RDONLY
+#define O_WRITE                     O_WRONLY
+
+/* Timestamp flags */
+#define T_ACCESS                    1
+#define T_CREATE                    2
+#define T_WRITE                     4
+
+/* FAT date/time fields */
+#define FS_DATE(year, month, day)   (( year ) > 2107 || ( month ) > 12 || ( day ) > 31 ? 0 : \
+                                     ( uint16_t )((( year ) - 1980 ) << 9 | ( month ) << 5 | ( day )))
+#define FS_TIME(hour, minute, sec)  (( hour ) > 23 || ( minute ) > 59 || ( sec ) > 59 ? 0 : \
+                                     ( uint16_t )(( hour ) << 11 | ( minute ) << 5 | ( sec ) >> 1 ))
+#define FS_YEAR(date)               ( 1980 + (( date ) >> 9 ))
+#define FS_MONTH(date)              ((( date ) >> 5 ) & 0x0F )
+#define FS_DAY(date)                (( date ) & 0x1F )
+#define FS_HOUR(time)               (( time ) >> 11 )
+#define FS_MINUTE(time)             ((( time ) >> 5 ) & 0x3F )
+#define FS_SECOND(time)             ( 2 * (( time ) & 0x1F ))
+
+#define FS_MAX_PATH                 256
+
+
+namespace FsDateTime {
+    extern void ( *callback )( uint16_t* date, uint16_t* time, uint8_t* ms10 );
+
+    inline void setCallback( void ( *dateTime )( uint16_t* date, uint16_t* time, uint8_t* ms10 )) {
+        callback = dateTime;
+    }
+
+    inline void clearCallback() {
+        callback = nullptr;
+    }
+}
+
+
+class FsVolume;
+
+
+/*******************************************************************************
+ *
+ * @brief   File or directory on the emulated SD card
+ *
+ *******************************************************************************/
+class FsFile : public Stream {
+
+  public:
+    FsFile() {}
+    FsFile( const char* path, oflag_t oflag = O_RDONLY ) { this->open( path, oflag ); }
+    ~FsFile() { this->close(); }
+    FsFile( const FsFile& ) = delete;
+    FsFile& operator=( const FsFile& ) = delete;
+
+    bool open( const char* path, oflag_t oflag = O_RDONLY );
+    bool open( FsFile* dir, const char* path, oflag_t oflag = O_RDONLY );
+    bool open( FsFile* dir, uint32_t index, oflag_t oflag = O_RDONLY );
+    bool openNext( FsFile* dir, oflag_t oflag = O_RDONLY );
+    bool openRoot( FsVolume* vol );
+    bool close();
+    bool isOpen() const { return _fd >= 0 || _dir != nullptr; }
+    bool isDir() const { return _dir != nullptr; }
+    bool isFile() const { return _fd >= 0; }
+    bool isReadOnly() const;
+    operator bool() const { return this->isOpen(); }
+
+    virtual int available();
+    virtual int read();
+    int read( void* buf, size_t count );
+    virtual int peek();
+    virtual size_t write( uint8_t c );
+    virtual size_t write( const uint8_t* buf, size_t count );
+    size_t write( const void* buf, size_t count ) { return this->write( ( const uint8_t* )buf, count ); }
+    using Print::write;
+    virtual void flush() { this->sync(); }
+    bool sync();
+
+    uint64_t fileSize() const;
+    uint64_t size() const { return this->fileSize(); }
+    uint64_t curPosition() const;
+    bool seekSet( uint64_t pos );
+    bool truncate( uint64_t length );
+    uint32_t dirIndex();
+    bool rewind();
+    void rewindDirectory() { if( this->isDir() ) this->rewind(); }
+
+    size_t getName( char* name, size_t size );
+    size_t printName( Print* pr );
+    bool exists( const char* path );
+    bool rename( const char* newPath );
+    bool remove();
+    bool rmdir();
+    uint8_t getError() const { return _error; }
+    void clearError() { _error = 0; }
+
+    bool getCreateDateTime( uint16_t* pdate, uint16_t* ptime );
+    bool getModifyDateTime( uint16_t* pdate, uint16_t* ptime );
+    bool timestamp( uint8_t flags, uint16_t year, uint8_t month, uint8_t day,
+                    uint8_t hour, uint8_t minute, uint8_t second );
+
+  private:
+    bool openPath( const char* path, oflag_t oflag );
+
+    int _fd = -1;                         /* Host file descriptor */
+    void* _dir = nullptr;                 /* Host directory stream (DIR*) */
+    char* _path = nullptr;                /* Host path */
+    oflag_t _flags = 0;
+    uint8_t _error = 0;
+};
+
+typedef FsFile SdFile;
+typedef FsFile File32;
+typedef FsFile ExFile;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Emulated volume
+ *
+ *******************************************************************************/
+class FsVolume {
+
+  public:
+    bool begin();
+    void end();
+    bool exists( const char* path );
+    bool mkdir( const char* path, bool pFlag = true );
+    bool remove( const char* path );
+    bool rename( const char* oldPath, const char* newPath );
+    bool rmdir( const char* path );
+    bool chdir( const char* path = "/" );
+    void hostPath( const char* path, char* buffer, size_t size );
+
+  private:
+    bool _mounted = false;
+    char _cwd[ FS_MAX_PATH ] = "/";
+};
+
+
+
+/*******************************************************************************
+ *
+ * @brief   SD card
+ *
+ *******************************************************************************/
+class SdFat : public FsVolume {
+
+  public:
+    bool begin( uint8_t csPin );
+    void end();
+    uint8_t sdErrorCode() { return _errorCode; }
+    uint8_t sdErrorData() { return 0; }
+    FsVolume* vol() { return this; }
+
+  private:
+    uint8_t _errorCode = 0;
+};
+
+#endif /* NATIVE_SDFAT_H */
\ No newline at end of file
@@ -0,0 +1,45 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/Stream.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_STREAM_H
+#define NATIVE_STREAM_H
+
+#include "Print.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Arduino Stream interface
+ *
+ *******************************************************************************/
+class Stream : public Print {
+
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout( unsigned long timeout ) { _timeout = timeout; }
+    size_t readBytes( char* buffer, size_t length );
+    size_t readBytes( uint8_t* buffer, size_t length ) { return readBytes( ( char* )buffer, length ); }
+
+  protected:
+    unsigned long _timeout = 1000;
+};
+
+#endif /* NATIVE_STREAM_H */
\ No newline at end of file
@@ -0,0 +1,27 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr/interrupt.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_INTERRUPT_H
+#define NATIVE_AVR_INTERRUPT_H
+
+/* Interrupts are emulated by calling the handlers from the host main loop,
+   so they never preempt the firmware and cli()/sei() only track the state. */
+
+void sei();
+void cli();
+
+#endif /* NATIVE_AVR_INTERRUPT_H */
\ No newline at end of file
@@ -0,0 +1,39 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr/io.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_IO_H
+#define NATIVE_AVR_IO_H
+
+#include <stdint.h>
+
+
+
+/* Memory layout of the ATmega2560 */
+#define RAMSTART                    0x200
+#define RAMEND                      0x21FF
+#define E2END                       0xFFF
+
+/* MCU status register reset flags */
+#define PORF                        0
+#define EXTRF                       1
+#define BORF                        2
+#define WDRF                        3
+#define JTRF                        4
+
+extern uint8_t MCUSR;
+
+#endif /* NATIVE_AVR_IO_H */
\ No newline at end of file
@@ -0,0 +1,80 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr/pgmspace.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_PGMSPACE_H
+#define NATIVE_AVR_PGMSPACE_H
+
+/* On the host, program memory and data memory share the same address space.
+   PROGMEM is dropped and the pgm_read_* accessors are plain dereferences. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+
+
+#define PROGMEM
+#define PGM_P                       const char *
+#define PGM_VOID_P                  const void *
+#define PSTR(s)                     ( s )
+
+/* The accessors keep the type of the pointed object so pointer tables
+   (eg. PROGMEM string arrays read with pgm_read_word) work on 64-bit hosts. */
+template <typename T> inline T __pgm_read( const T* addr ) { return *addr; }
+inline uint8_t __pgm_read( const void* addr ) { return *( const uint8_t* )addr; }
+
+#define pgm_read_byte(addr)         ( (uint8_t)( *( const uint8_t* )( addr )))
+#define pgm_read_byte_near(addr)    pgm_read_byte( addr )
+#define pgm_read_byte_far(addr)     pgm_read_byte( addr )
+#define pgm_read_word(addr)         __pgm_read( addr )
+#define pgm_read_word_near(addr)    __pgm_read( addr )
+#define pgm_read_dword(addr)        __pgm_read( addr )
+#define pgm_read_dword_near(addr)   __pgm_read( addr )
+#define pgm_read_ptr(addr)          __pgm_read( addr )
+#define pgm_read_float(addr)        __pgm_read( addr )
+
+#define memcpy_P                    memcpy
+#define memcmp_P                    memcmp
+#define strlen_P                    strlen
+#define strnlen_P                   strnlen
+#define strcpy_P                    strcpy
+#define strncpy_P                   strncpy
+#define strcat_P                    strcat
+#define strncat_P                   strncat
+#define strcmp_P                    strcmp
+#define strncmp_P                   strncmp
+#define strcasecmp_P                strcasecmp
+#define strncasecmp_P               strncasecmp
+#define strchr_P                    strchr
+#define strrchr_P                   strrchr
+#define strstr_P                    strstr
+
+char* strcasestr_P( const char* haystack, const char* needle );
+char* strtok_rP( char* str, const char* delim, char** last );
+
+/* avr-libc uses '%S' for strings located in program memory, they are
+   translated to '%s' before calling the host implementation. */
+int vsnprintf_P( char* buffer, size_t size, const char* format, va_list args );
+int snprintf_P( char* buffer, size_t size, const char* format, ... );
+int vsprintf_P( char* buffer, const char* format, va_list args );
+int sprintf_P( char* buffer, const char* format, ... );
+int printf_P( const char* format, ... );
+
+#endif /* NATIVE_AVR_PGMSPACE_H */
\ No newline at end of file
@@ -0,0 +1,49 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr/power.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_POWER_H
+#define NATIVE_AVR_POWER_H
+
+/* Peripheral power reduction has no effect on the host */
+#define power_adc_disable()         do {} while( 0 )
+#define power_adc_enable()          do {} while( 0 )
+#define power_spi_disable()         do {} while( 0 )
+#define power_spi_enable()          do {} while( 0 )
+#define power_twi_disable()         do {} while( 0 )
+#define power_twi_enable()          do {} while( 0 )
+#define power_usart0_disable()      do {} while( 0 )
+#define power_usart0_enable()       do {} while( 0 )
+#define power_usart1_disable()      do {} while( 0 )
+#define power_usart1_enable()       do {} while( 0 )
+#define power_usart2_disable()      do {} while( 0 )
+#define power_usart2_enable()       do {} while( 0 )
+#define power_usart3_disable()      do {} while( 0 )
+#define power_usart3_enable()       do {} while( 0 )
+#define power_timer0_disable()      do {} while( 0 )
+#define power_timer0_enable()       do {} while( 0 )
+#define power_timer1_disable()      do {} while( 0 )
+#define power_timer1_enable()       do {} while( 0 )
+#define power_timer2_disable()      do {} while( 0 )
+#define power_timer2_enable()       do {} while( 0 )
+#define power_timer3_disable()      do {} while( 0 )
+#define power_timer3_enable()       do {} while( 0 )
+#define power_timer4_disable()      do {} while( 0 )
+#define power_timer4_enable()       do {} while( 0 )
+#define power_timer5_disable()      do {} while( 0 )
+#define power_timer5_enable()       do {} while( 0 )
+
+#endif /* NATIVE_AVR_POWER_H */
\ No newline at end of file
@@ -0,0 +1,42 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr/sleep.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_SLEEP_H
+#define NATIVE_AVR_SLEEP_H
+
+#include <stdint.h>
+
+
+
+#define SLEEP_MODE_IDLE             0
+#define SLEEP_MODE_ADC              1
+#define SLEEP_MODE_PWR_DOWN         2
+#define SLEEP_MODE_PWR_SAVE         3
+#define SLEEP_MODE_STANDBY          6
+#define SLEEP_MODE_EXT_STANDBY      7
+
+#define set_sleep_mode(mode)        nativeSetSleepMode( mode )
+#define sleep_enable()              do {} while( 0 )
+#define sleep_disable()             do {} while( 0 )
+
+void nativeSetSleepMode( uint8_t mode );
+
+/* In idle mode, returns on the next timer 0 tick (~1 ms). Otherwise, blocks
+   until an emulated interrupt is raised */
+void sleep_mode();
+
+#endif /* NATIVE_AVR_SLEEP_H */
\ No newline at end of file
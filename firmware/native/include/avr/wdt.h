@@ -0,0 +1,41 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr/wdt.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_WDT_H
+#define NATIVE_AVR_WDT_H
+
+#include <stdint.h>
+
+
+
+#define WDTO_15MS                   0
+#define WDTO_30MS                   1
+#define WDTO_60MS                   2
+#define WDTO_120MS                  3
+#define WDTO_250MS                  4
+#define WDTO_500MS                  5
+#define WDTO_1S                     6
+#define WDTO_2S                     7
+#define WDTO_4S                     8
+#define WDTO_8S                     9
+
+/* The watchdog resets the host program if it is not fed in time */
+void wdt_enable( uint8_t timeout );
+void wdt_disable();
+void wdt_reset();
+
+#endif /* NATIVE_AVR_WDT_H */
\ No newline at end of file
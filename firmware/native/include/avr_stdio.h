@@ -0,0 +1,53 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/avr_stdio.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_AVR_STDIO_H
+#define NATIVE_AVR_STDIO_H
+
+/* Emulation of the avr-libc user stream (fdev_setup_stream) used by IPrint
+   and the US2066 driver. Must be included after <stdio.h>. */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+
+
+#define _FDEV_SETUP_READ            0x01
+#define _FDEV_SETUP_WRITE           0x02
+#define _FDEV_SETUP_RW              ( _FDEV_SETUP_READ | _FDEV_SETUP_WRITE )
+
+struct avr_file_t {
+    int ( *put )( char, avr_file_t* );
+    int ( *get )( avr_file_t* );
+    uint8_t flags;
+    void* udata;
+};
+
+#undef FILE
+#define FILE avr_file_t
+
+#define fdev_setup_stream(stream, p, g, f) \
+    do { ( stream )->put = p; ( stream )->get = g; ( stream )->flags = f; ( stream )->udata = 0; } while( 0 )
+
+#define fdev_set_udata(stream, u)   do { ( stream )->udata = u; } while( 0 )
+#define fdev_get_udata(stream)      (( stream )->udata )
+
+int vfprintf( avr_file_t* stream, const char* format, va_list args );
+int vfprintf_P( avr_file_t* stream, const char* format, va_list args );
+
+#endif /* NATIVE_AVR_STDIO_H */
\ No newline at end of file
@@ -0,0 +1,112 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/include/native.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_H
+#define NATIVE_H
+
+/* Host side hooks of the native build. They are used by the emulated
+   peripherals and by host tools to drive the firmware (pin levels,
+   I2C devices, interrupts). The firmware itself never includes this file. */
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+
+/* Default level of input pins which are not driven by the firmware */
+#define NATIVE_DEFAULT_PIN_LEVEL    1
+
+/* Sockets bound to a privileged port (telnet, ftp) are moved above this
+   offset on the host. */
+#ifndef NATIVE_PORT_OFFSET
+#define NATIVE_PORT_OFFSET          10000
+#endif
+
+/* Host directory used as the SD card root, overridden by $NATIVE_SDCARD */
+#define NATIVE_SDCARD_DIR           "sdcard"
+
+/* File used to persist the EEPROM content, overridden by $NATIVE_EEPROM */
+#define NATIVE_EEPROM_FILE          "eeprom.bin"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Emulated I2C device
+ *
+ *******************************************************************************/
+class NativeI2CDevice {
+
+  public:
+    NativeI2CDevice( uint8_t address ) { _address = address; }
+    uint8_t getAddress() { return _address; }
+
+    virtual void onWrite( const uint8_t* data, size_t length ) = 0;
+    virtual size_t onRead( uint8_t* data, size_t length ) = 0;
+    virtual void poll() {}
+
+  private:
+    uint8_t _address;
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Emulated SPI device, receives the transfers made while its chip
+ *          select pin is low.
+ *
+ *******************************************************************************/
+class NativeSPIDevice {
+
+  public:
+    NativeSPIDevice( uint8_t pin_cs ) { _pin_cs = pin_cs; }
+    uint8_t getSelectPin() { return _pin_cs; }
+
+    virtual uint8_t onTransfer( uint8_t data ) = 0;
+
+  private:
+    uint8_t _pin_cs;
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Emulated device on a USART in SPI master mode, receives the bytes
+ *          written to the data register.
+ *
+ *******************************************************************************/
+class NativeUSARTDevice {
+
+  public:
+    virtual void onTransmit( uint8_t data ) = 0;
+};
+
+
+void nativeSetPinLevel( uint8_t pin, uint8_t level );
+uint8_t nativeGetPinLevel( uint8_t pin );
+void nativeSetAnalogValue( uint8_t pin, int value );
+void nativePollInterrupts();
+void nativeRegisterI2CDevice( NativeI2CDevice* device );
+void nativePollI2CDevices();
+void nativeRegisterSPIDevice( NativeSPIDevice* device );
+void nativeRegisterUSARTDevice( uint8_t usart, NativeUSARTDevice* device );
+void nativeUSARTTransmit( uint8_t usart, uint8_t data );
+void nativeBegin();
+void nativeExit( int code );
+void nativeSetResetPin( uint8_t pin );
+
+#endif /* NATIVE_H */
\ No newline at end of file
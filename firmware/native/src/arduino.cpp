@@ -0,0 +1,448 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/arduino.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <avr/wdt.h>
+#include <avr/sleep.h>
+#include <native.h>
+
+#include <sys/time.h>
+#include <unistd.h>
+
+
+
+uint8_t MCUSR = ( 1 << PORF );
+
+/* Used by freeMemory(), the heap start is set so the free memory reports
+   the SRAM size of the ATmega2560 minus the stack usage. */
+char* __malloc_heap_start = nullptr;
+char* __brkval = nullptr;
+
+static struct timeval _start;
+static uint8_t _pinLevel[ NUM_DIGITAL_PINS ];
+static uint8_t _pinMode[ NUM_DIGITAL_PINS ];
+static int _analogValue[ NUM_DIGITAL_PINS ];
+static volatile uint8_t _portRegister;
+
+static void ( *_isr[ NUM_DIGITAL_PINS ] )( void );
+static uint8_t _isrMode[ NUM_DIGITAL_PINS ];
+static uint8_t _isrPrevLevel[ NUM_DIGITAL_PINS ];
+static bool _interruptsEnabled = true;
+
+static unsigned long _wdtTimeout = 0;
+static unsigned long _wdtLastReset = 0;
+
+static int16_t _resetPin = -1;
+static uint8_t _sleepMode = SLEEP_MODE_IDLE;
+
+
+/*******************************************************************************
+ *
+ * @brief   Initialize the emulated MCU state. Called before setup().
+ *
+ */
+void nativeBegin() {
+
+    char top;
+
+    gettimeofday( &_start, NULL );
+    __malloc_heap_start = &top - ( RAMEND - RAMSTART + 1 );
+
+    for( uint8_t i = 0; i < NUM_DIGITAL_PINS; i++ ) {
+        _pinLevel[ i ] = NATIVE_DEFAULT_PIN_LEVEL;
+        _isrPrevLevel[ i ] = NATIVE_DEFAULT_PIN_LEVEL;
+        _pinMode[ i ] = INPUT;
+        _analogValue[ i ] = 0;
+        _isr[ i ] = nullptr;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Terminate the host program
+ *
+ * @param   code    Exit code
+ *
+ */
+void nativeExit( int code ) {
+
+    fflush( stdout );
+    exit( code );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Set a pin which terminates the program when driven low (reset).
+ *
+ * @param   pin    Pin number
+ *
+ */
+void nativeSetResetPin( uint8_t pin ) {
+    _resetPin = pin;
+}
+
+
+unsigned long micros() {
+    struct timeval now;
+    gettimeofday( &now, NULL );
+
+    uint64_t elapsed = ( uint64_t )( now.tv_sec - _start.tv_sec ) * 1000000ULL + ( now.tv_usec - _start.tv_usec );
+
+    /* Wrap around like the 32-bit AVR counter */
+    return ( unsigned long )( elapsed & 0xFFFFFFFFUL );
+}
+
+
+unsigned long millis() {
+    struct timeval now;
+    gettimeofday( &now, NULL );
+
+    uint64_t elapsed = ( uint64_t )( now.tv_sec - _start.tv_sec ) * 1000ULL + ( now.tv_usec - _start.tv_usec ) / 1000;
+
+    return ( unsigned long )( elapsed & 0xFFFFFFFFUL );
+}
+
+
+void delay( unsigned long ms ) {
+    unsigned long start = millis();
+
+    while( ( millis() - start ) < ms ) {
+        usleep( 1000 );
+        nativePollInterrupts();
+    }
+}
+
+
+void delayMicroseconds( unsigned int us ) {
+    usleep( us );
+}
+
+
+void yield() {}
+
+
+void pinMode( uint8_t pin, uint8_t mode ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return;
+    }
+
+    _pinMode[ pin ] = mode;
+}
+
+
+void digitalWrite( uint8_t pin, uint8_t val ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return;
+    }
+
+    if( _pinMode[ pin ] != OUTPUT ) {
+        return;
+    }
+
+    _pinLevel[ pin ] = ( val == LOW ) ? LOW : HIGH;
+
+    if( pin == _resetPin && val == LOW ) {
+        printf( "\n[native] reset requested\n" );
+        nativeExit( 0 );
+    }
+}
+
+
+int digitalRead( uint8_t pin ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return LOW;
+    }
+
+    return _pinLevel[ pin ];
+}
+
+
+int analogRead( uint8_t pin ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return 0;
+    }
+
+    return _analogValue[ pin ];
+}
+
+
+void analogWrite( uint8_t pin, int val ) {
+    pinMode( pin, OUTPUT );
+    digitalWrite( pin, ( val > 127 ) ? HIGH : LOW );
+}
+
+
+volatile uint8_t* nativePortRegister( uint8_t pin ) {
+    ( void )pin;
+    return &_portRegister;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Drive the level of an input pin from the host side.
+ *
+ * @param   pin      Pin number
+ * @param   level    HIGH or LOW
+ *
+ */
+void nativeSetPinLevel( uint8_t pin, uint8_t level ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return;
+    }
+
+    _pinLevel[ pin ] = ( level == LOW ) ? LOW : HIGH;
+}
+
+
+uint8_t nativeGetPinLevel( uint8_t pin ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return LOW;
+    }
+
+    return _pinLevel[ pin ];
+}
+
+
+void nativeSetAnalogValue( uint8_t pin, int value ) {
+    if( pin >= NUM_DIGITAL_PINS ) {
+        return;
+    }
+
+    _analogValue[ pin ] = value;
+}
+
+
+void attachInterrupt( uint8_t interruptNum, void ( *userFunc )( void ), int mode ) {
+    if( interruptNum >= NUM_DIGITAL_PINS ) {
+        return;
+    }
+
+    _isrMode[ interruptNum ] = mode;
+    _isrPrevLevel[ interruptNum ] = _pinLevel[ interruptNum ];
+    _isr[ interruptNum ] = userFunc;
+}
+
+
+void detachInterrupt( uint8_t interruptNum ) {
+    if( interruptNum >= NUM_DIGITAL_PINS ) {
+        return;
+    }
+
+    _isr[ interruptNum ] = nullptr;
+}
+
+
+void sei() {
+    _interruptsEnabled = true;
+}
+
+
+void cli() {
+    _interruptsEnabled = false;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Call the handlers of the pending external interrupts and check the
+ *          watchdog timer. Called between each pass of the main loop.
+ *
+ */
+void nativePollInterrupts() {
+
+    if( _wdtTimeout > 0 && ( millis() - _wdtLastReset ) > _wdtTimeout ) {
+        printf( "\n[native] watchdog timeout\n" );
+        nativeExit( 2 );
+    }
+
+    if( _interruptsEnabled == false ) {
+        return;
+    }
+
+    for( uint8_t pin = 0; pin < NUM_DIGITAL_PINS; pin++ ) {
+
+        void ( *isr )( void ) = _isr[ pin ];
+        uint8_t level = _pinLevel[ pin ];
+        uint8_t prev = _isrPrevLevel[ pin ];
+
+        _isrPrevLevel[ pin ] = level;
+
+        if( isr == nullptr ) {
+            continue;
+        }
+
+        bool trigger;
+        switch( _isrMode[ pin ] ) {
+            case LOW:       trigger = ( level == LOW ); break;
+            case CHANGE:    trigger = ( level != prev ); break;
+            case FALLING:   trigger = ( level == LOW && prev == HIGH ); break;
+            case RISING:    trigger = ( level == HIGH && prev == LOW ); break;
+            default:        trigger = false; break;
+        }
+
+        if( trigger == true ) {
+            isr();
+        }
+    }
+}
+
+
+void nativeSetSleepMode( uint8_t mode ) {
+    _sleepMode = mode;
+}
+
+
+void sleep_mode() {
+
+    /* Timer 0 overflow interrupt wakes up the CPU */
+    if( _sleepMode == SLEEP_MODE_IDLE ) {
+        usleep( 1024 );
+
+        nativePollI2CDevices();
+        nativePollInterrupts();
+        return;
+    }
+
+    /* Wake up on the first interrupt */
+    while( true ) {
+        nativePollI2CDevices();
+
+        for( uint8_t pin = 0; pin < NUM_DIGITAL_PINS; pin++ ) {
+            if( _isr[ pin ] != nullptr && _pinLevel[ pin ] == LOW ) {
+                nativePollInterrupts();
+                return;
+            }
+        }
+
+        usleep( 10000 );
+    }
+}
+
+
+void wdt_enable( uint8_t timeout ) {
+    _wdtTimeout = 15UL << timeout;
+    _wdtLastReset = millis();
+}
+
+
+void wdt_disable() {
+    _wdtTimeout = 0;
+}
+
+
+void wdt_reset() {
+    _wdtLastReset = millis();
+}
+
+
+long random( long howbig ) {
+    if( howbig == 0 ) {
+        return 0;
+    }
+
+    return ::random() % howbig;
+}
+
+
+long random( long howsmall, long howbig ) {
+    if( howsmall >= howbig ) {
+        return howsmall;
+    }
+
+    return random( howbig - howsmall ) + howsmall;
+}
+
+
+void randomSeed( unsigned long seed ) {
+    if( seed != 0 ) {
+        srandom( seed );
+    }
+}
+
+
+long map( long x, long in_min, long in_max, long out_min, long out_max ) {
+    return ( x - in_min ) * ( out_max - out_min ) / ( in_max - in_min ) + out_min;
+}
+
+
+char* ultoa( unsigned long value, char* str, int base ) {
+    char buffer[ 8 * sizeof( long ) + 1 ];
+    char* ptr = &buffer[ sizeof( buffer ) - 1 ];
+
+    *ptr = '\0';
+
+    if( base < 2 || base > 36 ) {
+        base = 10;
+    }
+
+    do {
+        uint8_t digit = value % base;
+        *--ptr = ( digit < 10 ) ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+
+    } while( value > 0 );
+
+    return strcpy( str, ptr );
+}
+
+
+char* ltoa( long value, char* str, int base ) {
+    if( value < 0 && base == 10 ) {
+        *str = '-';
+        ultoa( -( unsigned long )value, str + 1, base );
+        return str;
+    }
+
+    return ultoa( ( unsigned long )value, str, base );
+}
+
+
+char* utoa( unsigned int value, char* str, int base ) {
+    return ultoa( value, str, base );
+}
+
+
+char* itoa( int value, char* str, int base ) {
+    if( value < 0 && base == 10 ) {
+        return ltoa( value, str, base );
+    }
+
+    /* Negative values in other bases are printed as 16-bit like on the AVR */
+    return ultoa( ( unsigned int )value & 0xFFFF, str, base );
+}
+
+
+char* strupr( char* str ) {
+    for( char* ptr = str; *ptr != '\0'; ptr++ ) {
+        *ptr = toupper( *ptr );
+    }
+
+    return str;
+}
+
+
+char* strlwr( char* str ) {
+    for( char* ptr = str; *ptr != '\0'; ptr++ ) {
+        *ptr = tolower( *ptr );
+    }
+
+    return str;
+}
\ No newline at end of file
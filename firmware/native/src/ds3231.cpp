@@ -0,0 +1,225 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/ds3231.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <native.h>
+#include "ds3231.h"
+
+#include <sys/time.h>
+
+
+
+#define REG_SEC             0x00
+#define REG_AL1SEC          0x07
+#define REG_CONTROL         0x0E
+#define REG_STATUS          0x0F
+#define REG_TMP_UP          0x11
+
+#define CTRL_A1IE           ( 1 << 0 )
+#define CTRL_INTCN          ( 1 << 2 )
+#define STATUS_A1F          ( 1 << 0 )
+#define ALARM_MASK          ( 1 << 7 )
+
+
+static uint8_t bin2bcd( uint8_t value ) { return value + 6 * ( value / 10 ); }
+static uint8_t bcd2bin( uint8_t value ) { return value - 6 * ( value >> 4 ); }
+
+
+/*******************************************************************************
+ *
+ * @brief   Convert a number of days since 1970-01-01 to a civil date
+ *
+ */
+static void civilFromDays( int64_t days, int* year, uint8_t* month, uint8_t* day ) {
+
+    days += 719468;
+
+    int64_t era = ( days >= 0 ? days : days - 146096 ) / 146097;
+    unsigned doe = ( unsigned )( days - era * 146097 );
+    unsigned yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+    unsigned doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+    unsigned mp = ( 5 * doy + 2 ) / 153;
+
+    *day = doy - ( 153 * mp + 2 ) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = ( int )( yoe + era * 400 ) + ( *month <= 2 );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Convert a civil date to a number of days since 1970-01-01
+ *
+ */
+static int64_t daysFromCivil( int year, uint8_t month, uint8_t day ) {
+
+    year -= ( month <= 2 );
+
+    int64_t era = ( year >= 0 ? year : year - 399 ) / 400;
+    unsigned yoe = ( unsigned )( year - era * 400 );
+    unsigned doy = ( 153 * ( month > 2 ? month - 3 : month + 9 ) + 2 ) / 5 + day - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + ( int64_t )doe - 719468;
+}
+
+
+static int64_t hostTime() {
+    struct timeval now;
+    gettimeofday( &now, NULL );
+
+    return now.tv_sec;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Class constructor
+ *
+ * @param   address    I2C address
+ * @param   pin_irq    Pin connected to the INT/SQW output
+ *
+ */
+NativeDS3231::NativeDS3231( uint8_t address, uint8_t pin_irq ) : NativeI2CDevice( address ) {
+
+    _pin_irq = pin_irq;
+    _pointer = 0;
+    _offset = 0;
+    _lastSecond = 0;
+
+    memset( _regs, 0, sizeof( _regs ));
+    _regs[ REG_CONTROL ] = CTRL_INTCN;
+    _regs[ REG_TMP_UP ] = 25;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Update the time keeping registers from the host clock (UTC)
+ *
+ */
+void NativeDS3231::updateTime() {
+
+    int64_t now = hostTime() + _offset;
+    int64_t days = now / 86400;
+    int32_t secs = now % 86400;
+    int year;
+    uint8_t month, day;
+
+    civilFromDays( days, &year, &month, &day );
+
+    _regs[ 0 ] = bin2bcd( secs % 60 );
+    _regs[ 1 ] = bin2bcd(( secs / 60 ) % 60 );
+    _regs[ 2 ] = bin2bcd( secs / 3600 );
+    _regs[ 3 ] = (( days + 4 ) % 7 ) + 1;
+    _regs[ 4 ] = bin2bcd( day );
+    _regs[ 5 ] = bin2bcd( month );
+    _regs[ 6 ] = bin2bcd( year % 100 );
+}
+
+
+void NativeDS3231::onWrite( const uint8_t* data, size_t length ) {
+
+    if( length == 0 ) {
+        return;
+    }
+
+    _pointer = data[ 0 ];
+
+    if( length == 1 ) {
+        return;
+    }
+
+    bool timeChanged = false;
+    this->updateTime();
+
+    for( size_t i = 1; i < length; i++ ) {
+        if( _pointer <= 6 ) {
+            timeChanged = true;
+        }
+
+        _regs[ _pointer ] = data[ i ];
+        _pointer = ( _pointer + 1 ) % sizeof( _regs );
+    }
+
+    if( timeChanged == true ) {
+        int64_t t = daysFromCivil( 2000 + bcd2bin( _regs[ 6 ] ), bcd2bin( _regs[ 5 ] & 0x1F ), bcd2bin( _regs[ 4 ] )) * 86400
+                    + bcd2bin( _regs[ 2 ] & 0x3F ) * 3600
+                    + bcd2bin( _regs[ 1 ] ) * 60
+                    + bcd2bin( _regs[ 0 ] );
+
+        _offset = t - hostTime();
+    }
+
+    this->updateIrq();
+}
+
+
+size_t NativeDS3231::onRead( uint8_t* data, size_t length ) {
+
+    this->updateTime();
+
+    for( size_t i = 0; i < length; i++ ) {
+        data[ i ] = _regs[ _pointer ];
+        _pointer = ( _pointer + 1 ) % sizeof( _regs );
+    }
+
+    return length;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Check the alarm 1 match every second and drive the IRQ pin
+ *
+ */
+void NativeDS3231::poll() {
+
+    int64_t now = hostTime();
+    if( now == _lastSecond ) {
+        return;
+    }
+    _lastSecond = now;
+
+    this->updateTime();
+
+    bool match = true;
+    for( uint8_t i = 0; i < 3; i++ ) {
+        uint8_t alarm = _regs[ REG_AL1SEC + i ];
+
+        if(( alarm & ALARM_MASK ) == 0 && alarm != _regs[ REG_SEC + i ] ) {
+            match = false;
+        }
+    }
+
+    if( match == true ) {
+        _regs[ REG_STATUS ] |= STATUS_A1F;
+    }
+
+    this->updateIrq();
+}
+
+
+void NativeDS3231::updateIrq() {
+
+    bool active = ( _regs[ REG_CONTROL ] & CTRL_INTCN ) &&
+                  ( _regs[ REG_CONTROL ] & CTRL_A1IE ) &&
+                  ( _regs[ REG_STATUS ] & STATUS_A1F );
+
+    nativeSetPinLevel( _pin_irq, active ? LOW : HIGH );
+}
\ No newline at end of file
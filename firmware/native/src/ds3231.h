@@ -0,0 +1,50 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/ds3231.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_DS3231_H
+#define NATIVE_DS3231_H
+
+#include <native.h>
+
+
+
+/*******************************************************************************
+ *
+ * @brief   DS3231 RTC emulation, keeps the host time (UTC) plus the offset
+ *          set by the firmware. Only the alarm 1 interrupt is emulated.
+ *
+ *******************************************************************************/
+class NativeDS3231 : public NativeI2CDevice {
+
+  public:
+    NativeDS3231( uint8_t address, uint8_t pin_irq );
+    virtual void onWrite( const uint8_t* data, size_t length );
+    virtual size_t onRead( uint8_t* data, size_t length );
+    virtual void poll();
+
+  private:
+    void updateTime();
+    void updateIrq();
+
+    uint8_t _regs[ 0x13 ];
+    uint8_t _pointer;
+    uint8_t _pin_irq;
+    int64_t _offset;
+    int64_t _lastSecond;
+};
+
+#endif /* NATIVE_DS3231_H */
\ No newline at end of file
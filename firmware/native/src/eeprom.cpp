@@ -0,0 +1,108 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/eeprom.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <EEPROM.h>
+#include <native.h>
+
+/* Host stdio stream, see avr_stdio.h */
+#undef FILE
+
+
+
+EEPROMClass EEPROM;
+
+static uint8_t _eeprom[ E2END + 1 ];
+static bool _loaded = false;
+
+
+
+static const char* getEepromFile() {
+    const char* path = getenv( "NATIVE_EEPROM" );
+
+    return ( path != nullptr ) ? path : NATIVE_EEPROM_FILE;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Load the EEPROM content from the host file. A blank EEPROM is
+ *          filled with 0xFF.
+ *
+ */
+static void loadEeprom() {
+
+    _loaded = true;
+    memset( _eeprom, 0xFF, sizeof( _eeprom ));
+
+    FILE* file = fopen( getEepromFile(), "rb" );
+    if( file == nullptr ) {
+        return;
+    }
+
+    if( fread( _eeprom, 1, sizeof( _eeprom ), file ) != sizeof( _eeprom )) {
+        memset( _eeprom, 0xFF, sizeof( _eeprom ));
+    }
+
+    fclose( file );
+}
+
+
+static void saveEeprom() {
+
+    FILE* file = fopen( getEepromFile(), "wb" );
+    if( file == nullptr ) {
+        return;
+    }
+
+    fwrite( _eeprom, 1, sizeof( _eeprom ), file );
+    fclose( file );
+}
+
+
+uint8_t EEPROMClass::read( int address ) {
+    if( _loaded == false ) {
+        loadEeprom();
+    }
+
+    if( address < 0 || address > E2END ) {
+        return 0xFF;
+    }
+
+    return _eeprom[ address ];
+}
+
+
+void EEPROMClass::write( int address, uint8_t value ) {
+    if( _loaded == false ) {
+        loadEeprom();
+    }
+
+    if( address < 0 || address > E2END ) {
+        return;
+    }
+
+    _eeprom[ address ] = value;
+    saveEeprom();
+}
+
+
+void EEPROMClass::update( int address, uint8_t value ) {
+    if( this->read( address ) != value ) {
+        this->write( address, value );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/hostnet.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+#include <native.h>
+#include "hostnet.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Create a non-blocking socket
+ *
+ * @param   stream    TRUE for a TCP socket, FALSE for UDP.
+ *
+ * @return  File descriptor or HOSTNET_ERROR.
+ *
+ */
+int hostnetSocket( bool stream ) {
+
+    int fd = socket( AF_INET, stream ? SOCK_STREAM : SOCK_DGRAM, 0 );
+    if( fd < 0 ) {
+        return HOSTNET_ERROR;
+    }
+
+    int enable = 1;
+    setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof( enable ));
+
+    if( stream == true ) {
+        setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof( enable ));
+    }
+
+    fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_NONBLOCK );
+    return fd;
+}
+
+
+int hostnetBind( int fd, uint32_t addr, uint16_t port ) {
+    struct sockaddr_in sa;
+
+    /* Privileged ports can't be used by a regular user */
+    if( port != 0 && ntohs( port ) < 1024 ) {
+        port = htons( ntohs( port ) + NATIVE_PORT_OFFSET );
+    }
+
+    memset( &sa, 0, sizeof( sa ));
+    sa.sin_family = AF_INET;
+    sa.sin_port = port;
+    sa.sin_addr.s_addr = addr;
+
+    return ( bind( fd, ( struct sockaddr* )&sa, sizeof( sa )) == 0 ) ? 0 : HOSTNET_ERROR;
+}
+
+
+int hostnetListen( int fd, int backlog ) {
+    return ( listen( fd, backlog ) == 0 ) ? 0 : HOSTNET_ERROR;
+}
+
+
+int hostnetConnect( int fd, uint32_t addr, uint16_t port ) {
+    struct sockaddr_in sa;
+
+    memset( &sa, 0, sizeof( sa ));
+    sa.sin_family = AF_INET;
+    sa.sin_port = port;
+    sa.sin_addr.s_addr = addr;
+
+    if( connect( fd, ( struct sockaddr* )&sa, sizeof( sa )) == 0 || errno == EINPROGRESS ) {
+        return 0;
+    }
+
+    return HOSTNET_ERROR;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Check the progress of a non-blocking connect
+ *
+ * @return  1 if connected, 0 if still in progress or HOSTNET_ERROR.
+ *
+ */
+int hostnetConnectStatus( int fd ) {
+    struct sockaddr_in sa;
+    socklen_t len = sizeof( sa );
+
+    if( getpeername( fd, ( struct sockaddr* )&sa, &len ) == 0 ) {
+        return 1;
+    }
+
+    int error = 0;
+    len = sizeof( error );
+    getsockopt( fd, SOL_SOCKET, SO_ERROR, &error, &len );
+
+    return ( error == 0 || error == EINPROGRESS ) ? 0 : HOSTNET_ERROR;
+}
+
+
+int hostnetAccept( int fd, uint32_t* addr, uint16_t* port ) {
+    struct sockaddr_in sa;
+    socklen_t len = sizeof( sa );
+
+    int client = accept( fd, ( struct sockaddr* )&sa, &len );
+    if( client < 0 ) {
+        return ( errno == EAGAIN || errno == EWOULDBLOCK ) ? HOSTNET_WOULD_BLOCK : HOSTNET_ERROR;
+    }
+
+    int enable = 1;
+    setsockopt( client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof( enable ));
+    fcntl( client, F_SETFL, fcntl( client, F_GETFL ) | O_NONBLOCK );
+
+    *addr = sa.sin_addr.s_addr;
+    *port = sa.sin_port;
+    return client;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Receive data from a connected socket
+ *
+ * @return  Number of bytes received, 0 if the connection was closed by the
+ *          peer, HOSTNET_WOULD_BLOCK if no data is available or HOSTNET_ERROR.
+ *
+ */
+int hostnetRecv( int fd, uint8_t* buffer, size_t size ) {
+
+    ssize_t n = recv( fd, buffer, size, 0 );
+    if( n < 0 ) {
+        return ( errno == EAGAIN || errno == EWOULDBLOCK ) ? HOSTNET_WOULD_BLOCK : HOSTNET_ERROR;
+    }
+
+    return ( int )n;
+}
+
+
+int hostnetRecvFrom( int fd, uint8_t* buffer, size_t size, uint32_t* addr, uint16_t* port ) {
+    struct sockaddr_in sa;
+    socklen_t len = sizeof( sa );
+
+    ssize_t n = recvfrom( fd, buffer, size, 0, ( struct sockaddr* )&sa, &len );
+    if( n < 0 ) {
+        return ( errno == EAGAIN || errno == EWOULDBLOCK ) ? HOSTNET_WOULD_BLOCK : HOSTNET_ERROR;
+    }
+
+    *addr = sa.sin_addr.s_addr;
+    *port = sa.sin_port;
+    return ( int )n;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send data to a connected socket. Waits for the host send buffer
+ *          to drain like the WINC1500 does when its buffers are full.
+ *
+ * @return  Number of bytes sent or HOSTNET_ERROR.
+ *
+ */
+int hostnetSend( int fd, const uint8_t* buffer, size_t size ) {
+    size_t sent = 0;
+
+    while( sent < size ) {
+        ssize_t n = send( fd, buffer + sent, size - sent, MSG_NOSIGNAL );
+
+        if( n < 0 ) {
+            if( errno != EAGAIN && errno != EWOULDBLOCK ) {
+                return HOSTNET_ERROR;
+            }
+
+            struct pollfd pfd = { fd, POLLOUT, 0 };
+            if( poll( &pfd, 1, 1000 ) <= 0 ) {
+                return HOSTNET_ERROR;
+            }
+            continue;
+        }
+
+        sent += n;
+    }
+
+    return ( int )sent;
+}
+
+
+int hostnetSendTo( int fd, const uint8_t* buffer, size_t size, uint32_t addr, uint16_t port ) {
+    struct sockaddr_in sa;
+
+    memset( &sa, 0, sizeof( sa ));
+    sa.sin_family = AF_INET;
+    sa.sin_port = port;
+    sa.sin_addr.s_addr = addr;
+
+    ssize_t n = sendto( fd, buffer, size, 0, ( struct sockaddr* )&sa, sizeof( sa ));
+    return ( n < 0 ) ? HOSTNET_ERROR : ( int )n;
+}
+
+
+void hostnetClose( int fd ) {
+    if( fd >= 0 ) {
+        close( fd );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Resolve a hostname (blocking)
+ *
+ * @return  IPv4 address or 0 if the hostname could not be resolved.
+ *
+ */
+uint32_t hostnetResolve( const char* hostname ) {
+    struct addrinfo hints;
+    struct addrinfo* result;
+
+    memset( &hints, 0, sizeof( hints ));
+    hints.ai_family = AF_INET;
+
+    if( getaddrinfo( hostname, NULL, &hints, &result ) != 0 ) {
+        return 0;
+    }
+
+    uint32_t addr = (( struct sockaddr_in* )result->ai_addr )->sin_addr.s_addr;
+    freeaddrinfo( result );
+
+    return addr;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/hostnet.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_HOSTNET_H
+#define NATIVE_HOSTNET_H
+
+/* Thin wrapper around the host BSD sockets. It is kept apart from the WINC1500
+   headers since both declare socket(), bind(), connect(), etc. Addresses and
+   ports are in network byte order. */
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+
+#define HOSTNET_WOULD_BLOCK         -1
+#define HOSTNET_ERROR               -2
+
+int hostnetSocket( bool stream );
+int hostnetBind( int fd, uint32_t addr, uint16_t port );
+int hostnetListen( int fd, int backlog );
+int hostnetConnect( int fd, uint32_t addr, uint16_t port );
+int hostnetConnectStatus( int fd );
+int hostnetAccept( int fd, uint32_t* addr, uint16_t* port );
+int hostnetRecv( int fd, uint8_t* buffer, size_t size );
+int hostnetRecvFrom( int fd, uint8_t* buffer, size_t size, uint32_t* addr, uint16_t* port );
+int hostnetSend( int fd, const uint8_t* buffer, size_t size );
+int hostnetSendTo( int fd, const uint8_t* buffer, size_t size, uint32_t addr, uint16_t port );
+void hostnetClose( int fd );
+uint32_t hostnetResolve( const char* hostname );
+
+#endif /* NATIVE_HOSTNET_H */
\ No newline at end of file
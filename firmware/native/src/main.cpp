@@ -0,0 +1,83 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/main.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <hardware.h>
+#include <drivers/rtc.h>
+#include <drivers/qt1070.h>
+#include <native.h>
+#include "ds3231.h"
+#include "qt1070.h"
+#include "us2066.h"
+
+
+
+/* Delay between each pass of the main loop (us), overridden by
+   $NATIVE_LOOP_DELAY. Keeps the host CPU usage low. */
+#define NATIVE_LOOP_DELAY           1000
+
+static NativeDS3231 _rtc( I2C_ADDR_DS3231, PIN_INT_RTC );
+static NativeQT1070 _keypad( I2C_ADDR_AT42QT1070, PIN_INT_KEYPAD );
+static NativeUS2066 _lcd( I2C_ADDR_OLED );
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Native build entry point. Sets the initial state of the board
+ *          inputs then runs the firmware main loop.
+ *
+ */
+int main( int argc, char** argv ) {
+    ( void )argc;
+    ( void )argv;
+
+    nativeBegin();
+
+    /* Board inputs : running on mains power, SD card inserted,
+       buttons released and alarm switch off. */
+    nativeSetPinLevel( PIN_ON_BATTERY, LOW );
+    nativeSetPinLevel( PIN_SD_DETECT, LOW );
+    nativeSetPinLevel( PIN_FACTORY_RESET, HIGH );
+    nativeSetPinLevel( PIN_ALARM_SW, LOW );
+    nativeSetPinLevel( PIN_INT_KEYPAD, HIGH );
+    nativeSetPinLevel( PIN_VS1053_DREQ, HIGH );
+
+    nativeSetResetPin( PIN_FACTORY_RESET );
+    nativeRegisterI2CDevice( &_rtc );
+    nativeRegisterI2CDevice( &_keypad );
+    nativeRegisterI2CDevice( &_lcd );
+
+    const char* env = getenv( "NATIVE_LOOP_DELAY" );
+    unsigned long loopDelay = ( env != nullptr ) ? strtoul( env, nullptr, 10 ) : NATIVE_LOOP_DELAY;
+
+    setup();
+
+    while( true ) {
+        loop();
+
+        nativePollI2CDevices();
+        nativePollInterrupts();
+
+        if( loopDelay > 0 ) {
+            delayMicroseconds( loopDelay );
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
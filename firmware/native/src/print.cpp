@@ -0,0 +1,212 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/print.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <Print.h>
+#include <Stream.h>
+#include <IPAddress.h>
+
+
+
+const IPAddress INADDR_NONE( 0, 0, 0, 0 );
+
+
+size_t Print::write( const uint8_t* buffer, size_t size ) {
+    size_t n = 0;
+
+    while( size-- ) {
+        if( this->write( *buffer++ ) == 0 ) {
+            break;
+        }
+        n++;
+    }
+
+    return n;
+}
+
+
+size_t Print::print( const __FlashStringHelper* str ) {
+    return this->write( ( const char* )str );
+}
+
+
+size_t Print::print( const char* str ) {
+    return this->write( str );
+}
+
+
+size_t Print::print( char c ) {
+    return this->write( ( uint8_t )c );
+}
+
+
+size_t Print::print( unsigned char value, int base ) {
+    return this->print( ( unsigned long )value, base );
+}
+
+
+size_t Print::print( int value, int base ) {
+    return this->print( ( long )value, base );
+}
+
+
+size_t Print::print( unsigned int value, int base ) {
+    return this->print( ( unsigned long )value, base );
+}
+
+
+size_t Print::print( long value, int base ) {
+    if( base == 10 && value < 0 ) {
+        return this->print( '-' ) + this->printNumber( -( unsigned long )value, 10 );
+    }
+
+    if( base == 0 ) {
+        return this->write( ( uint8_t )value );
+    }
+
+    return this->printNumber( ( unsigned long )value, base );
+}
+
+
+size_t Print::print( unsigned long value, int base ) {
+    if( base == 0 ) {
+        return this->write( ( uint8_t )value );
+    }
+
+    return this->printNumber( value, base );
+}
+
+
+size_t Print::print( double value, int digits ) {
+    char buffer[ 32 ];
+
+    snprintf( buffer, sizeof( buffer ), "%.*f", digits, value );
+    return this->write( buffer );
+}
+
+
+size_t Print::println( const __FlashStringHelper* str ) { return this->print( str ) + this->println(); }
+size_t Print::println( const char* str ) { return this->print( str ) + this->println(); }
+size_t Print::println( char c ) { return this->print( c ) + this->println(); }
+size_t Print::println( unsigned char value, int base ) { return this->print( value, base ) + this->println(); }
+size_t Print::println( int value, int base ) { return this->print( value, base ) + this->println(); }
+size_t Print::println( unsigned int value, int base ) { return this->print( value, base ) + this->println(); }
+size_t Print::println( long value, int base ) { return this->print( value, base ) + this->println(); }
+size_t Print::println( unsigned long value, int base ) { return this->print( value, base ) + this->println(); }
+size_t Print::println( double value, int digits ) { return this->print( value, digits ) + this->println(); }
+
+
+size_t Print::println() {
+    return this->write( "\r\n" );
+}
+
+
+size_t Print::printNumber( unsigned long value, uint8_t base ) {
+    char buffer[ 8 * sizeof( long ) + 1 ];
+
+    ultoa( value, buffer, ( base < 2 ) ? 10 : base );
+
+    /* Arduino prints hexadecimal digits in uppercase */
+    for( char* ptr = buffer; *ptr != '\0'; ptr++ ) {
+        *ptr = toupper( *ptr );
+    }
+
+    return this->write( buffer );
+}
+
+
+size_t Stream::readBytes( char* buffer, size_t length ) {
+    size_t count = 0;
+    unsigned long start = millis();
+
+    while( count < length && ( millis() - start ) < _timeout ) {
+        int c = this->read();
+
+        if( c < 0 ) {
+            continue;
+        }
+
+        *buffer++ = ( char )c;
+        count++;
+    }
+
+    return count;
+}
+
+
+IPAddress::IPAddress( uint8_t a, uint8_t b, uint8_t c, uint8_t d ) {
+    _address.bytes[ 0 ] = a;
+    _address.bytes[ 1 ] = b;
+    _address.bytes[ 2 ] = c;
+    _address.bytes[ 3 ] = d;
+}
+
+
+IPAddress::IPAddress( const uint8_t* address ) {
+    memcpy( _address.bytes, address, sizeof( _address.bytes ));
+}
+
+
+IPAddress& IPAddress::operator=( const uint8_t* address ) {
+    memcpy( _address.bytes, address, sizeof( _address.bytes ));
+    return *this;
+}
+
+
+bool IPAddress::operator==( const uint8_t* addr ) const {
+    return memcmp( addr, _address.bytes, sizeof( _address.bytes )) == 0;
+}
+
+
+bool IPAddress::fromString( const char* address ) {
+    uint16_t acc = 0;
+    uint8_t dots = 0;
+    bool digit = false;
+
+    while( *address ) {
+        char c = *address++;
+
+        if( c >= '0' && c <= '9' ) {
+            acc = acc * 10 + ( c - '0' );
+            digit = true;
+
+            if( acc > 255 ) {
+                return false;
+            }
+
+        } else if( c == '.' ) {
+            if( dots == 3 || digit == false ) {
+                return false;
+            }
+
+            _address.bytes[ dots++ ] = acc;
+            acc = 0;
+            digit = false;
+
+        } else {
+            return false;
+        }
+    }
+
+    if( dots != 3 || digit == false ) {
+        return false;
+    }
+
+    _address.bytes[ 3 ] = acc;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/qt1070.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <native.h>
+#include "qt1070.h"
+
+
+
+#define REG_CHIPID          0x00
+#define REG_DETECTION       0x02
+#define REG_KEYSTATUS       0x03
+
+#define CHIPID              0x2E
+#define DETECTION_TOUCH     ( 1 << 0 )
+
+
+
+NativeQT1070::NativeQT1070( uint8_t address, uint8_t pin_irq ) : NativeI2CDevice( address ) {
+
+    memset( _regs, 0, sizeof( _regs ));
+
+    _regs[ REG_CHIPID ] = CHIPID;
+    _pointer = 0;
+    _pin_irq = pin_irq;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Set the keys currently touched and assert the change line.
+ *
+ * @param   keys    Key status (bit 0-6)
+ *
+ */
+void NativeQT1070::setKeys( uint8_t keys ) {
+
+    _regs[ REG_KEYSTATUS ] = keys & 0x7F;
+    _regs[ REG_DETECTION ] = ( keys != 0 ) ? DETECTION_TOUCH : 0;
+
+    nativeSetPinLevel( _pin_irq, LOW );
+}
+
+
+void NativeQT1070::onWrite( const uint8_t* data, size_t length ) {
+
+    if( length == 0 ) {
+        return;
+    }
+
+    _pointer = data[ 0 ];
+
+    for( size_t i = 1; i < length; i++ ) {
+        _regs[ _pointer ] = data[ i ];
+        _pointer = ( _pointer + 1 ) % sizeof( _regs );
+    }
+}
+
+
+size_t NativeQT1070::onRead( uint8_t* data, size_t length ) {
+
+    for( size_t i = 0; i < length; i++ ) {
+
+        /* Reading the status registers deasserts the change line */
+        if( _pointer == REG_DETECTION || _pointer == REG_KEYSTATUS ) {
+            nativeSetPinLevel( _pin_irq, HIGH );
+        }
+
+        data[ i ] = _regs[ _pointer ];
+        _pointer = ( _pointer + 1 ) % sizeof( _regs );
+    }
+
+    return length;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/qt1070.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_QT1070_H
+#define NATIVE_QT1070_H
+
+#include <native.h>
+
+
+
+/*******************************************************************************
+ *
+ * @brief   AT42QT1070 touch controller emulation. Keys are set by the host
+ *          with setKeys(), the change line is asserted until the firmware
+ *          reads the status registers.
+ *
+ *******************************************************************************/
+class NativeQT1070 : public NativeI2CDevice {
+
+  public:
+    NativeQT1070( uint8_t address, uint8_t pin_irq );
+    virtual void onWrite( const uint8_t* data, size_t length );
+    virtual size_t onRead( uint8_t* data, size_t length );
+    void setKeys( uint8_t keys );
+
+  private:
+    uint8_t _regs[ 0x3A ];
+    uint8_t _pointer;
+    uint8_t _pin_irq;
+};
+
+#endif /* NATIVE_QT1070_H */
\ No newline at end of file
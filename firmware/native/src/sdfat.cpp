@@ -0,0 +1,705 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/sdfat.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <errno.h>
+
+/* Host open flags, the SdFat header redefines the O_* macros. */
+static const int HOST_O_RDONLY = O_RDONLY;
+static const int HOST_O_WRONLY = O_WRONLY;
+static const int HOST_O_RDWR = O_RDWR;
+static const int HOST_O_APPEND = O_APPEND;
+static const int HOST_O_CREAT = O_CREAT;
+static const int HOST_O_TRUNC = O_TRUNC;
+static const int HOST_O_EXCL = O_EXCL;
+
+#include <SdFat.h>
+#include <native.h>
+
+
+
+void ( *FsDateTime::callback )( uint16_t* date, uint16_t* time, uint8_t* ms10 ) = nullptr;
+
+/* Volume used to resolve relative paths */
+static FsVolume* _cwv = nullptr;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Convert a host timestamp (UTC) to FAT date and time fields
+ *
+ */
+static void toFatDateTime( time_t ts, uint16_t* pdate, uint16_t* ptime ) {
+
+    int64_t days = ts / 86400;
+    int32_t secs = ts % 86400;
+
+    /* Civil date from days since epoch */
+    days += 719468;
+    int64_t era = ( days >= 0 ? days : days - 146096 ) / 146097;
+    unsigned doe = ( unsigned )( days - era * 146097 );
+    unsigned yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+    unsigned doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+    unsigned mp = ( 5 * doy + 2 ) / 153;
+    unsigned day = doy - ( 153 * mp + 2 ) / 5 + 1;
+    unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    int year = ( int )( yoe + era * 400 ) + ( month <= 2 );
+
+    if( year < 1980 ) {
+        year = 1980;
+    }
+
+    *pdate = FS_DATE( year, month, day );
+    *ptime = FS_TIME( secs / 3600, ( secs / 60 ) % 60, secs % 60 );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the host path of a file on the volume
+ *
+ * @param   path      Path on the volume (absolute or relative to the working
+ *                    directory)
+ * @param   buffer    Buffer to store the host path
+ * @param   size      Size of the buffer
+ *
+ */
+void FsVolume::hostPath( const char* path, char* buffer, size_t size ) {
+
+    const char* root = getenv( "NATIVE_SDCARD" );
+    if( root == nullptr ) {
+        root = NATIVE_SDCARD_DIR;
+    }
+
+    if( path[ 0 ] == '/' ) {
+        snprintf( buffer, size, "%s%s", root, path );
+    } else {
+        snprintf( buffer, size, "%s%s%s%s", root, _cwd, ( _cwd[ strlen( _cwd ) - 1 ] == '/' ) ? "" : "/", path );
+    }
+}
+
+
+bool FsVolume::begin() {
+    char path[ FS_MAX_PATH ];
+
+    this->hostPath( "/", path, sizeof( path ));
+
+    struct stat st;
+    if( stat( path, &st ) != 0 || S_ISDIR( st.st_mode ) == false ) {
+        return false;
+    }
+
+    strcpy( _cwd, "/" );
+    _mounted = true;
+    _cwv = this;
+
+    return true;
+}
+
+
+void FsVolume::end() {
+    _mounted = false;
+
+    if( _cwv == this ) {
+        _cwv = nullptr;
+    }
+}
+
+
+bool FsVolume::exists( const char* path ) {
+    char hpath[ FS_MAX_PATH ];
+    struct stat st;
+
+    if( _mounted == false ) {
+        return false;
+    }
+
+    this->hostPath( path, hpath, sizeof( hpath ));
+    return stat( hpath, &st ) == 0;
+}
+
+
+bool FsVolume::mkdir( const char* path, bool pFlag ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( _mounted == false ) {
+        return false;
+    }
+
+    this->hostPath( path, hpath, sizeof( hpath ));
+
+    if( pFlag == true ) {
+        for( char* ptr = hpath + 1; *ptr != '\0'; ptr++ ) {
+            if( *ptr == '/' ) {
+                *ptr = '\0';
+                ::mkdir( hpath, 0755 );
+                *ptr = '/';
+            }
+        }
+    }
+
+    return ::mkdir( hpath, 0755 ) == 0;
+}
+
+
+bool FsVolume::remove( const char* path ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( _mounted == false ) {
+        return false;
+    }
+
+    this->hostPath( path, hpath, sizeof( hpath ));
+    return unlink( hpath ) == 0;
+}
+
+
+bool FsVolume::rename( const char* oldPath, const char* newPath ) {
+    char hold[ FS_MAX_PATH ];
+    char hnew[ FS_MAX_PATH ];
+
+    if( _mounted == false ) {
+        return false;
+    }
+
+    this->hostPath( oldPath, hold, sizeof( hold ));
+    this->hostPath( newPath, hnew, sizeof( hnew ));
+    return ::rename( hold, hnew ) == 0;
+}
+
+
+bool FsVolume::rmdir( const char* path ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( _mounted == false ) {
+        return false;
+    }
+
+    this->hostPath( path, hpath, sizeof( hpath ));
+    return ::rmdir( hpath ) == 0;
+}
+
+
+bool FsVolume::chdir( const char* path ) {
+    char hpath[ FS_MAX_PATH ];
+    char cwd[ FS_MAX_PATH ];
+    struct stat st;
+
+    if( _mounted == false ) {
+        return false;
+    }
+
+    if( path[ 0 ] == '/' ) {
+        snprintf( cwd, sizeof( cwd ), "%s", path );
+    } else {
+        snprintf( cwd, sizeof( cwd ), "%s%s%s", _cwd, ( _cwd[ strlen( _cwd ) - 1 ] == '/' ) ? "" : "/", path );
+    }
+
+    this->hostPath( cwd, hpath, sizeof( hpath ));
+    if( stat( hpath, &st ) != 0 || S_ISDIR( st.st_mode ) == false ) {
+        return false;
+    }
+
+    strcpy( _cwd, cwd );
+    return true;
+}
+
+
+bool SdFat::begin( uint8_t csPin ) {
+    ( void )csPin;
+
+    if( FsVolume::begin() == false ) {
+
+        /* SD_CARD_ERROR_CMD0 */
+        _errorCode = 0x01;
+        return false;
+    }
+
+    _errorCode = 0;
+    return true;
+}
+
+
+void SdFat::end() {
+    FsVolume::end();
+}
+
+
+bool FsFile::openPath( const char* hpath, oflag_t oflag ) {
+    struct stat st;
+
+    this->close();
+
+    if( stat( hpath, &st ) == 0 && S_ISDIR( st.st_mode )) {
+
+        if(( oflag & ( O_WRONLY | O_RDWR )) != 0 ) {
+            return false;
+        }
+
+        _dir = opendir( hpath );
+        if( _dir == nullptr ) {
+            return false;
+        }
+
+    } else {
+
+        int flags = 0;
+        switch( oflag & O_ACCMODE ) {
+            case O_WRONLY:  flags = HOST_O_WRONLY; break;
+            case O_RDWR:    flags = HOST_O_RDWR; break;
+            default:        flags = HOST_O_RDONLY; break;
+        }
+
+        if( oflag & O_APPEND ) flags |= HOST_O_APPEND;
+        if( oflag & O_CREAT ) flags |= HOST_O_CREAT;
+        if( oflag & O_TRUNC ) flags |= HOST_O_TRUNC;
+        if( oflag & O_EXCL ) flags |= HOST_O_EXCL;
+
+        _fd = ::open( hpath, flags, 0644 );
+        if( _fd < 0 ) {
+            return false;
+        }
+    }
+
+    _path = strdup( hpath );
+    _flags = oflag;
+    _error = 0;
+
+    return true;
+}
+
+
+bool FsFile::open( const char* path, oflag_t oflag ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( _cwv == nullptr ) {
+        return false;
+    }
+
+    _cwv->hostPath( path, hpath, sizeof( hpath ));
+    return this->openPath( hpath, oflag );
+}
+
+
+bool FsFile::open( FsFile* dir, const char* path, oflag_t oflag ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( dir == nullptr || dir->isDir() == false ) {
+        return false;
+    }
+
+    snprintf( hpath, sizeof( hpath ), "%s/%s", dir->_path, path );
+    return this->openPath( hpath, oflag );
+}
+
+
+/* The directory index of a host file is its position in the readdir order */
+bool FsFile::open( FsFile* dir, uint32_t index, oflag_t oflag ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( dir == nullptr || dir->isDir() == false ) {
+        return false;
+    }
+
+    DIR* hdir = opendir( dir->_path );
+    if( hdir == nullptr ) {
+        return false;
+    }
+
+    struct dirent* entry;
+    while(( entry = readdir( hdir )) != nullptr ) {
+
+        if( strcmp( entry->d_name, "." ) == 0 || strcmp( entry->d_name, ".." ) == 0 ) {
+            continue;
+        }
+
+        if( index-- == 0 ) {
+            snprintf( hpath, sizeof( hpath ), "%s/%s", dir->_path, entry->d_name );
+            closedir( hdir );
+
+            return this->openPath( hpath, oflag );
+        }
+    }
+
+    closedir( hdir );
+    return false;
+}
+
+
+bool FsFile::openNext( FsFile* dir, oflag_t oflag ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( dir == nullptr || dir->isDir() == false ) {
+        return false;
+    }
+
+    struct dirent* entry;
+    while(( entry = readdir( ( DIR* )dir->_dir )) != nullptr ) {
+
+        if( strcmp( entry->d_name, "." ) == 0 || strcmp( entry->d_name, ".." ) == 0 ) {
+            continue;
+        }
+
+        snprintf( hpath, sizeof( hpath ), "%s/%s", dir->_path, entry->d_name );
+        return this->openPath( hpath, oflag );
+    }
+
+    this->close();
+    return false;
+}
+
+
+bool FsFile::openRoot( FsVolume* vol ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( vol == nullptr ) {
+        return false;
+    }
+
+    vol->hostPath( "/", hpath, sizeof( hpath ));
+    return this->openPath( hpath, O_RDONLY );
+}
+
+
+bool FsFile::close() {
+
+    if( _fd >= 0 ) {
+        ::close( _fd );
+        _fd = -1;
+    }
+
+    if( _dir != nullptr ) {
+        closedir( ( DIR* )_dir );
+        _dir = nullptr;
+    }
+
+    if( _path != nullptr ) {
+        free( _path );
+        _path = nullptr;
+    }
+
+    return true;
+}
+
+
+bool FsFile::isReadOnly() const {
+    return _path != nullptr && access( _path, W_OK ) != 0;
+}
+
+
+int FsFile::available() {
+    if( _fd < 0 ) {
+        return 0;
+    }
+
+    uint64_t remaining = this->fileSize() - this->curPosition();
+    return ( remaining > INT16_MAX ) ? INT16_MAX : ( int )remaining;
+}
+
+
+int FsFile::read() {
+    uint8_t c;
+
+    return ( this->read( &c, 1 ) == 1 ) ? c : -1;
+}
+
+
+int FsFile::read( void* buf, size_t count ) {
+    if( _fd < 0 ) {
+        return -1;
+    }
+
+    ssize_t n = ::read( _fd, buf, count );
+    if( n < 0 ) {
+        _error = 0x02;
+        return -1;
+    }
+
+    return ( int )n;
+}
+
+
+int FsFile::peek() {
+    int c = this->read();
+
+    if( c >= 0 ) {
+        lseek( _fd, -1, SEEK_CUR );
+    }
+
+    return c;
+}
+
+
+size_t FsFile::write( uint8_t c ) {
+    return this->write( &c, 1 );
+}
+
+
+size_t FsFile::write( const uint8_t* buf, size_t count ) {
+    if( _fd < 0 ) {
+        return 0;
+    }
+
+    ssize_t n = ::write( _fd, buf, count );
+    if( n < 0 || ( size_t )n != count ) {
+
+        /* WRITE_ERROR */
+        _error = 0x01;
+        return ( n < 0 ) ? 0 : n;
+    }
+
+    return n;
+}
+
+
+bool FsFile::sync() {
+    return _fd >= 0;
+}
+
+
+uint64_t FsFile::fileSize() const {
+    struct stat st;
+
+    if( _fd < 0 || fstat( _fd, &st ) != 0 ) {
+        return 0;
+    }
+
+    return st.st_size;
+}
+
+
+uint64_t FsFile::curPosition() const {
+    if( _dir != nullptr ) {
+        return telldir( ( DIR* )_dir );
+    }
+
+    if( _fd < 0 ) {
+        return 0;
+    }
+
+    return lseek( _fd, 0, SEEK_CUR );
+}
+
+
+bool FsFile::seekSet( uint64_t pos ) {
+    if( _dir != nullptr ) {
+        seekdir( ( DIR* )_dir, ( long )pos );
+        return true;
+    }
+
+    if( _fd < 0 ) {
+        return false;
+    }
+
+    return lseek( _fd, pos, SEEK_SET ) >= 0;
+}
+
+
+bool FsFile::truncate( uint64_t length ) {
+    if( _fd < 0 ) {
+        return false;
+    }
+
+    return ftruncate( _fd, length ) == 0;
+}
+
+
+uint32_t FsFile::dirIndex() {
+    char parent[ FS_MAX_PATH ];
+    uint32_t index = 0;
+
+    if( _path == nullptr ) {
+        return 0;
+    }
+
+    snprintf( parent, sizeof( parent ), "%s", _path );
+
+    char* base = strrchr( parent, '/' );
+    if( base == nullptr ) {
+        return 0;
+    }
+
+    *base++ = '\0';
+
+    DIR* hdir = opendir( parent );
+    if( hdir == nullptr ) {
+        return 0;
+    }
+
+    struct dirent* entry;
+    while(( entry = readdir( hdir )) != nullptr ) {
+
+        if( strcmp( entry->d_name, "." ) == 0 || strcmp( entry->d_name, ".." ) == 0 ) {
+            continue;
+        }
+
+        if( strcmp( entry->d_name, base ) == 0 ) {
+            break;
+        }
+
+        index++;
+    }
+
+    closedir( hdir );
+    return index;
+}
+
+
+bool FsFile::rewind() {
+    if( _dir != nullptr ) {
+        rewinddir( ( DIR* )_dir );
+        return true;
+    }
+
+    return this->seekSet( 0 );
+}
+
+
+size_t FsFile::getName( char* name, size_t size ) {
+    if( _path == nullptr || size == 0 ) {
+        return 0;
+    }
+
+    const char* base = strrchr( _path, '/' );
+    base = ( base == nullptr || base[ 1 ] == '\0' ) ? "/" : base + 1;
+
+    snprintf( name, size, "%s", base );
+    return strlen( name );
+}
+
+
+size_t FsFile::printName( Print* pr ) {
+    char name[ FS_MAX_PATH ];
+
+    if( this->getName( name, sizeof( name )) == 0 ) {
+        return 0;
+    }
+
+    return pr->write( name );
+}
+
+
+bool FsFile::exists( const char* path ) {
+    char hpath[ FS_MAX_PATH ];
+    struct stat st;
+
+    if( this->isDir() == false ) {
+        return false;
+    }
+
+    snprintf( hpath, sizeof( hpath ), "%s/%s", _path, path );
+    return stat( hpath, &st ) == 0;
+}
+
+
+bool FsFile::rename( const char* newPath ) {
+    char hpath[ FS_MAX_PATH ];
+
+    if( _path == nullptr || _cwv == nullptr ) {
+        return false;
+    }
+
+    _cwv->hostPath( newPath, hpath, sizeof( hpath ));
+    if( ::rename( _path, hpath ) != 0 ) {
+        return false;
+    }
+
+    free( _path );
+    _path = strdup( hpath );
+    return true;
+}
+
+
+bool FsFile::remove() {
+    if( _fd < 0 ) {
+        return false;
+    }
+
+    char* path = strdup( _path );
+    this->close();
+
+    bool result = ( unlink( path ) == 0 );
+    free( path );
+    return result;
+}
+
+
+bool FsFile::rmdir() {
+    if( _dir == nullptr ) {
+        return false;
+    }
+
+    char* path = strdup( _path );
+    this->close();
+
+    bool result = ( ::rmdir( path ) == 0 );
+    free( path );
+    return result;
+}
+
+
+bool FsFile::getCreateDateTime( uint16_t* pdate, uint16_t* ptime ) {
+    struct stat st;
+
+    if( _path == nullptr || stat( _path, &st ) != 0 ) {
+        return false;
+    }
+
+    toFatDateTime( st.st_ctime, pdate, ptime );
+    return true;
+}
+
+
+bool FsFile::getModifyDateTime( uint16_t* pdate, uint16_t* ptime ) {
+    struct stat st;
+
+    if( _path == nullptr || stat( _path, &st ) != 0 ) {
+        return false;
+    }
+
+    toFatDateTime( st.st_mtime, pdate, ptime );
+    return true;
+}
+
+
+bool FsFile::timestamp( uint8_t flags, uint16_t year, uint8_t month, uint8_t day,
+                        uint8_t hour, uint8_t minute, uint8_t second ) {
+
+    if( _path == nullptr || ( flags & T_WRITE ) == 0 ) {
+        return _path != nullptr;
+    }
+
+    /* Days since epoch from the civil date */
+    int y = year - ( month <= 2 );
+    int64_t era = ( y >= 0 ? y : y - 399 ) / 400;
+    unsigned yoe = ( unsigned )( y - era * 400 );
+    unsigned doy = ( 153 * ( month > 2 ? month - 3 : month + 9 ) + 2 ) / 5 + day - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = era * 146097 + ( int64_t )doe - 719468;
+
+    struct timespec times[ 2 ];
+    times[ 0 ].tv_sec = days * 86400 + hour * 3600 + minute * 60 + second;
+    times[ 0 ].tv_nsec = 0;
+    times[ 1 ] = times[ 0 ];
+
+    return utimensat( AT_FDCWD, _path, times, 0 ) == 0;
+}
\ No newline at end of file
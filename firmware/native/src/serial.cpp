@@ -0,0 +1,100 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/serial.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <HardwareSerial.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+
+HardwareSerial Serial;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Read the next character from the terminal without blocking.
+ *
+ * @return  Character read or -1 if none are available.
+ *
+ */
+int HardwareSerial::fill() {
+
+    static bool nonblock = false;
+
+    if( _peek >= 0 ) {
+        return _peek;
+    }
+
+    if( nonblock == false ) {
+        fcntl( STDIN_FILENO, F_SETFL, fcntl( STDIN_FILENO, F_GETFL ) | O_NONBLOCK );
+        nonblock = true;
+    }
+
+    uint8_t c;
+    if( ::read( STDIN_FILENO, &c, 1 ) != 1 ) {
+        return -1;
+    }
+
+    _peek = c;
+    return _peek;
+}
+
+
+int HardwareSerial::available() {
+    return ( this->fill() >= 0 ) ? 1 : 0;
+}
+
+
+int HardwareSerial::peek() {
+    return this->fill();
+}
+
+
+int HardwareSerial::read() {
+    int c = this->fill();
+
+    _peek = -1;
+    return c;
+}
+
+
+void HardwareSerial::flush() {
+    fflush( stdout );
+}
+
+
+size_t HardwareSerial::write( uint8_t c ) {
+    fputc( c, stdout );
+
+    if( c == '\n' ) {
+        fflush( stdout );
+    }
+
+    return 1;
+}
+
+
+size_t HardwareSerial::write( const uint8_t* buffer, size_t size ) {
+    size_t n = fwrite( buffer, 1, size, stdout );
+
+    fflush( stdout );
+    return n;
+}
\ No newline at end of file
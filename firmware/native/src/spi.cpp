@@ -0,0 +1,69 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/spi.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <native.h>
+
+
+
+#define NATIVE_MAX_SPI_DEVICES      4
+
+SPIClass SPI;
+
+static NativeSPIDevice* _devices[ NATIVE_MAX_SPI_DEVICES ];
+static uint8_t _numDevices = 0;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Attach an emulated device to the SPI bus
+ *
+ * @param   device    Device instance
+ *
+ */
+void nativeRegisterSPIDevice( NativeSPIDevice* device ) {
+
+    if( _numDevices >= NATIVE_MAX_SPI_DEVICES ) {
+        return;
+    }
+
+    _devices[ _numDevices++ ] = device;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a byte to the device whose chip select pin is low.
+ *
+ * @param   data    Byte sent
+ *
+ * @return  Byte received, 0xFF if no device is selected.
+ *
+ */
+uint8_t nativeSPITransfer( uint8_t data ) {
+
+    for( uint8_t i = 0; i < _numDevices; i++ ) {
+        if( nativeGetPinLevel( _devices[ i ]->getSelectPin() ) == LOW ) {
+            return _devices[ i ]->onTransfer( data );
+        }
+    }
+
+    return 0xFF;
+}
\ No newline at end of file
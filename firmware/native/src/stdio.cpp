@@ -0,0 +1,174 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/stdio.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Translate an avr-libc format string for the host printf. Strings
+ *          in program memory ('%S') are plain strings on the host.
+ *
+ * @param   format    Format string
+ *
+ * @return  Pointer to the translated format, must be freed by the caller.
+ *
+ */
+static char* translateFormat( const char* format ) {
+
+    char* result = strdup( format );
+    if( result == nullptr ) {
+        return nullptr;
+    }
+
+    char* ptr = result;
+    while( *ptr != '\0' ) {
+
+        if( *ptr++ != '%' ) {
+            continue;
+        }
+
+        /* Skip flags, width, precision and length modifiers */
+        while( *ptr != '\0' && strchr( "-+ #0123456789.*lhz", *ptr ) != nullptr ) {
+            ptr++;
+        }
+
+        if( *ptr == 'S' ) {
+            *ptr = 's';
+        }
+
+        if( *ptr != '\0' ) {
+            ptr++;
+        }
+    }
+
+    return result;
+}
+
+
+int vsnprintf_P( char* buffer, size_t size, const char* format, va_list args ) {
+    char* fmt = translateFormat( format );
+    if( fmt == nullptr ) {
+        return -1;
+    }
+
+    int length = vsnprintf( buffer, size, fmt, args );
+
+    free( fmt );
+    return length;
+}
+
+
+int snprintf_P( char* buffer, size_t size, const char* format, ... ) {
+    va_list args;
+    va_start( args, format );
+
+    int length = vsnprintf_P( buffer, size, format, args );
+
+    va_end( args );
+    return length;
+}
+
+
+int vsprintf_P( char* buffer, const char* format, va_list args ) {
+    return vsnprintf_P( buffer, SIZE_MAX, format, args );
+}
+
+
+int sprintf_P( char* buffer, const char* format, ... ) {
+    va_list args;
+    va_start( args, format );
+
+    int length = vsprintf_P( buffer, format, args );
+
+    va_end( args );
+    return length;
+}
+
+
+int printf_P( const char* format, ... ) {
+    char* fmt = translateFormat( format );
+    if( fmt == nullptr ) {
+        return -1;
+    }
+
+    va_list args;
+    va_start( args, format );
+
+    int length = vprintf( fmt, args );
+
+    va_end( args );
+    free( fmt );
+    return length;
+}
+
+
+char* strcasestr_P( const char* haystack, const char* needle ) {
+    return ( char* )strcasestr( haystack, needle );
+}
+
+
+char* strtok_rP( char* str, const char* delim, char** last ) {
+    return strtok_r( str, delim, last );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Formatted output to an avr-libc user stream.
+ *
+ * @param   stream    Stream created with fdev_setup_stream()
+ * @param   format    Format string
+ * @param   args      Arguments
+ *
+ * @return  Number of characters written.
+ *
+ */
+int vfprintf( avr_file_t* stream, const char* format, va_list args ) {
+
+    if( stream == nullptr || stream->put == nullptr ) {
+        return -1;
+    }
+
+    char* buffer;
+    int length = vasprintf( &buffer, format, args );
+    if( length < 0 ) {
+        return -1;
+    }
+
+    for( int i = 0; i < length; i++ ) {
+        stream->put( buffer[ i ], stream );
+    }
+
+    free( buffer );
+    return length;
+}
+
+
+int vfprintf_P( avr_file_t* stream, const char* format, va_list args ) {
+    char* fmt = translateFormat( format );
+    if( fmt == nullptr ) {
+        return -1;
+    }
+
+    int length = vfprintf( stream, fmt, args );
+
+    free( fmt );
+    return length;
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/twi.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <twiqueue.h>
+#include <native.h>
+
+
+
+#define NATIVE_MAX_I2C_DEVICES      8
+
+static NativeI2CDevice* _devices[ NATIVE_MAX_I2C_DEVICES ];
+static uint8_t _numDevices = 0;
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Attach an emulated device to the I2C bus
+ *
+ * @param   device    Device instance
+ *
+ */
+void nativeRegisterI2CDevice( NativeI2CDevice* device ) {
+
+    if( _numDevices >= NATIVE_MAX_I2C_DEVICES ) {
+        return;
+    }
+
+    _devices[ _numDevices++ ] = device;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Let the emulated devices update their state (timers, interrupts)
+ *
+ */
+void nativePollI2CDevices() {
+
+    for( uint8_t i = 0; i < _numDevices; i++ ) {
+        _devices[ i ]->poll();
+    }
+}
+
+
+static NativeI2CDevice* findDevice( uint8_t address ) {
+
+    for( uint8_t i = 0; i < _numDevices; i++ ) {
+        if( _devices[ i ]->getAddress() == address ) {
+            return _devices[ i ];
+        }
+    }
+
+    return nullptr;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   TWI hardware layer of the native build. Transactions are routed 
+ *          to the emulated devices and complete immediately, transactions
+ *          to an unknown address are NACKed.
+ *
+ */
+void twi_begin( uint32_t frequency ) {
+    ( void )frequency;
+}
+
+
+void twi_reset() {
+}
+
+
+void twi_start( TwiTransaction* transaction ) {
+
+    NativeI2CDevice* device = findDevice( transaction->address );
+
+    if( device == nullptr ) {
+        g_twi.onComplete( TWI_RESULT_NACK_ADDRESS );
+        return;
+    }
+
+    if( transaction->txLength > 0 || transaction->rxLength == 0 ) {
+        device->onWrite( transaction->txData, transaction->txLength );
+    }
+
+    if( transaction->rxLength > 0 ) {
+        size_t length = device->onRead( transaction->rxData, transaction->rxLength );
+
+        /* Missing bytes read as 0xFF (SDA pulled up) */
+        if( length < transaction->rxLength ) {
+            memset( transaction->rxData + length, 0xFF, transaction->rxLength - length );
+        }
+    }
+
+    g_twi.onComplete( TWI_RESULT_OK );
+}
\ No newline at end of file
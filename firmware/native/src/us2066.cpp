@@ -0,0 +1,128 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/us2066.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <native.h>
+#include "us2066.h"
+
+
+
+#define CONTROL_CONTINUE    0x80
+#define CONTROL_DATA        0x40
+
+#define CMD_CLEAR           0x01
+#define CMD_CGRAM           0x40
+#define CMD_DDRAM           0x80
+
+
+
+NativeUS2066::NativeUS2066( uint8_t address ) : NativeI2CDevice( address ) {
+
+    memset( _ddram, ' ', sizeof( _ddram ));
+    memset( _cgram, 0, sizeof( _cgram ));
+    _counter = 0;
+    _selectCGRAM = false;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the character at the specified position.
+ *
+ * @param   row     Row number (0 based)
+ * @param   col     Column number (0 based)
+ *
+ * @return  Character code
+ * 
+ */
+uint8_t NativeUS2066::getChar( uint8_t row, uint8_t col ) {
+
+    return _ddram[ ( col + ( row * 0x40 )) & 0x7F ];
+}
+
+
+void NativeUS2066::onWrite( const uint8_t* data, size_t length ) {
+
+    size_t i = 0;
+
+    while( i + 1 < length ) {
+        uint8_t control = data[ i++ ];
+
+        /* Co=0 : all the remaining bytes are data or commands */
+        if(( control & CONTROL_CONTINUE ) == 0 ) {
+
+            for( ; i < length; i++ ) {
+
+                if( control & CONTROL_DATA ) {
+                    this->write( data[ i ] );
+                } else {
+                    this->command( data[ i ] );
+                }
+            }
+
+            return;
+        }
+
+        if( control & CONTROL_DATA ) {
+            this->write( data[ i++ ] );
+        } else {
+            this->command( data[ i++ ] );
+        }
+    }
+}
+
+
+size_t NativeUS2066::onRead( uint8_t* data, size_t length ) {
+
+    /* Busy flag cleared, address counter */
+    for( size_t i = 0; i < length; i++ ) {
+        data[ i ] = _counter;
+    }
+
+    return length;
+}
+
+
+void NativeUS2066::command( uint8_t cmd ) {
+
+    if( cmd == CMD_CLEAR ) {
+        memset( _ddram, ' ', sizeof( _ddram ));
+        _counter = 0;
+        _selectCGRAM = false;
+
+    } else if( cmd & CMD_DDRAM ) {
+        _counter = cmd & 0x7F;
+        _selectCGRAM = false;
+
+    } else if( cmd & CMD_CGRAM ) {
+        _counter = cmd & 0x3F;
+        _selectCGRAM = true;
+    }
+}
+
+
+void NativeUS2066::write( uint8_t value ) {
+
+    if( _selectCGRAM == true ) {
+        _cgram[ _counter ] = value;
+        _counter = ( _counter + 1 ) & 0x3F;
+
+    } else {
+        _ddram[ _counter ] = value;
+        _counter = ( _counter + 1 ) & 0x7F;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/us2066.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_US2066_H
+#define NATIVE_US2066_H
+
+#include <native.h>
+
+
+
+/*******************************************************************************
+ *
+ * @brief   US2066 OLED controller emulation. Decodes the control bytes and
+ *          keeps the DDRAM and CGRAM contents, commands other than clear
+ *          and set DDRAM/CGRAM address are ignored.
+ *
+ *******************************************************************************/
+class NativeUS2066 : public NativeI2CDevice {
+
+  public:
+    NativeUS2066( uint8_t address );
+    virtual void onWrite( const uint8_t* data, size_t length );
+    virtual size_t onRead( uint8_t* data, size_t length );
+    uint8_t getChar( uint8_t row, uint8_t col );
+
+  private:
+    void command( uint8_t cmd );
+    void write( uint8_t value );
+
+    uint8_t _ddram[ 0x80 ];
+    uint8_t _cgram[ 0x40 ];
+    uint8_t _counter;
+    bool _selectCGRAM;
+};
+
+#endif /* NATIVE_US2066_H */
\ No newline at end of file
@@ -0,0 +1,65 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/usart.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <native.h>
+
+
+
+/* USART0 to USART3 of the ATmega2560 */
+#define NATIVE_NUM_USARTS           4
+
+static NativeUSARTDevice* _devices[ NATIVE_NUM_USARTS ];
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Attach an emulated device to a USART used in SPI master mode.
+ *
+ * @param   usart     USART number
+ * @param   device    Device instance or nullptr to detach it
+ *
+ */
+void nativeRegisterUSARTDevice( uint8_t usart, NativeUSARTDevice* device ) {
+
+    if( usart >= NATIVE_NUM_USARTS ) {
+        return;
+    }
+
+    _devices[ usart ] = device;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a byte to the device attached to a USART, the byte is 
+ *          dropped if there is none.
+ *
+ * @param   usart    USART number
+ * @param   data     Byte sent
+ *
+ */
+void nativeUSARTTransmit( uint8_t usart, uint8_t data ) {
+
+    if( usart >= NATIVE_NUM_USARTS || _devices[ usart ] == nullptr ) {
+        return;
+    }
+
+    _devices[ usart ]->onTransmit( data );
+}
\ No newline at end of file
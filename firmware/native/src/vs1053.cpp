@@ -0,0 +1,142 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/vs1053.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <native.h>
+#include "vs1053.h"
+
+
+
+NativeVS1053::NativeVS1053( uint8_t pin_xdcs, uint8_t pin_dreq ) : NativeSPIDevice( pin_xdcs ) {
+    _pin_dreq = pin_dreq;
+    _started = false;
+    _byteRate = 0;
+    _lastPlay = 0;
+    _remainder = 0;
+    _level = 0;
+    _minLevel = 0;
+    _underruns = 0;
+    _dry = false;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Empty the buffer and start playing at the given rate. Until 
+ *          stop() is called, DREQ follows the buffer level.
+ *
+ * @param   byteRate    Stream bit rate / 8
+ *
+ */
+void NativeVS1053::start( uint32_t byteRate ) {
+    _started = false;
+    _byteRate = byteRate;
+    _remainder = 0;
+    _level = 0;
+    _minLevel = NATIVE_VS1053_FIFO_SIZE;
+    _underruns = 0;
+    _dry = false;
+
+    nativeSetPinLevel( _pin_dreq, HIGH );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stop playing, DREQ stays high like a codec without a stream.
+ *
+ */
+void NativeVS1053::stop() {
+    _byteRate = 0;
+
+    nativeSetPinLevel( _pin_dreq, HIGH );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Play the buffer up to the current time and update DREQ.
+ *
+ */
+void NativeVS1053::poll() {
+    if( _byteRate == 0 ) {
+        return;
+    }
+
+    this->play();
+
+    nativeSetPinLevel( _pin_dreq, ( NATIVE_VS1053_FIFO_SIZE - _level >= NATIVE_VS1053_DREQ_FREE ) ? HIGH : LOW );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Remove the bytes played since the last call from the buffer. 
+ *          Playback starts once the buffer was filled.
+ *
+ */
+void NativeVS1053::play() {
+    unsigned long now = micros();
+
+    if( _started == false ) {
+        _lastPlay = now;
+        return;
+    }
+
+    uint64_t bytes = ( uint64_t )( now - _lastPlay ) * _byteRate + _remainder;
+    _lastPlay = now;
+    _remainder = bytes % 1000000UL;
+    bytes /= 1000000UL;
+
+    /* Count each time the buffer runs dry once */
+    if( bytes > _level ) {
+        if( _dry == false ) {
+            _underruns++;
+            _dry = true;
+        }
+
+        _level = 0;
+    } else {
+        _level -= bytes;
+    }
+
+    if( _level < _minLevel ) {
+        _minLevel = _level;
+    }
+}
+
+
+uint8_t NativeVS1053::onTransfer( uint8_t data ) {
+    ( void )data;
+
+    if( _byteRate == 0 ) {
+        return 0xFF;
+    }
+
+    if( _level < NATIVE_VS1053_FIFO_SIZE ) {
+        _level++;
+    }
+
+    _dry = false;
+
+    if( _level == NATIVE_VS1053_FIFO_SIZE ) {
+        _started = true;
+    }
+
+    this->poll();
+    return 0xFF;
+}
\ No newline at end of file
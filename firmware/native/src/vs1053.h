@@ -0,0 +1,67 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/vs1053.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NATIVE_VS1053_H
+#define NATIVE_VS1053_H
+
+#include <native.h>
+
+
+
+/* Size of the codec stream buffer (bytes) */
+#define NATIVE_VS1053_FIFO_SIZE     2048
+
+/* Free space needed by the codec to assert DREQ (bytes) */
+#define NATIVE_VS1053_DREQ_FREE     32
+
+
+
+/*******************************************************************************
+ *
+ * @brief   VS1053 stream buffer emulation. The data sent while XDCS is low
+ *          fills the buffer, which is played at a constant byte rate once
+ *          started. DREQ is high while the buffer has room for a block.
+ *
+ *******************************************************************************/
+class NativeVS1053 : public NativeSPIDevice {
+
+  public:
+    NativeVS1053( uint8_t pin_xdcs, uint8_t pin_dreq );
+    virtual uint8_t onTransfer( uint8_t data );
+    void start( uint32_t byteRate );
+    void stop();
+    void poll();
+
+    uint16_t getLevel() { return _level; }
+    uint16_t getMinLevel() { return _minLevel; }
+    uint32_t getUnderruns() { return _underruns; }
+
+  private:
+    void play();
+
+    uint8_t _pin_dreq;
+    bool _started;
+    uint32_t _byteRate;
+    unsigned long _lastPlay;
+    uint32_t _remainder;
+    uint16_t _level;
+    uint16_t _minLevel;
+    uint32_t _underruns;
+    bool _dry;
+};
+
+#endif /* NATIVE_VS1053_H */
\ No newline at end of file
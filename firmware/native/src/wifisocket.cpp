@@ -0,0 +1,460 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/wifisocket.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <drivers/wifi/wifisocket.h>
+#include <heap_sites.h>
+#include "hostnet.h"
+
+
+
+/* Largest datagram received on an UDP socket */
+#define NATIVE_UDP_BUFFER_SIZE      1472
+
+WiFiSocket g_wifisocket;
+
+/* Host file descriptor of each socket */
+static int _fd[ MAX_SOCKET ];
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Class constructor
+ *
+ */
+WiFiSocket::WiFiSocket() {
+
+    for( int i = 0; i < MAX_SOCKET; i++ ) {
+        _fd[ i ] = -1;
+
+        _info[ i ].state = SOCKET_STATE_INVALID;
+        _info[ i ].parent = -1;
+        _info[ i ].recvMsg.s16BufferSize = 0;
+        _info[ i ].buffer.data = NULL;
+        _info[ i ].buffer.head = NULL;
+        _info[ i ].buffer.length = 0;
+
+        memset( &_info[ i ]._lastSendtoAddr, 0x00, sizeof( _info[ i ]._lastSendtoAddr ));
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   WINC socket events are not used on the host, host sockets are
+ *          polled instead.
+ *
+ */
+void WiFiSocket::handleEvent( SOCKET sock, uint8 u8Msg, void *pvMsg ) {
+    ( void )sock;
+    ( void )u8Msg;
+    ( void )pvMsg;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Create a new socket
+ *
+ * @param   u16Domain    Socket domain (AF_INET)
+ * @param   u8Type       SOCK_STREAM or SOCK_DGRAM
+ * @param   u8Flags      Socket flags. SSL is not supported on the host.
+ *
+ * @return  Socket ID or -1 if an error occured.
+ *
+ */
+SOCKET WiFiSocket::create( uint16 u16Domain, uint8 u8Type, uint8 u8Flags ) {
+
+    if( u16Domain != AF_INET || ( u8Flags & SOCKET_FLAGS_SSL )) {
+        return -1;
+    }
+
+    SOCKET first = ( u8Type == SOCK_STREAM ) ? 0 : TCP_SOCK_MAX;
+    SOCKET last = ( u8Type == SOCK_STREAM ) ? TCP_SOCK_MAX : MAX_SOCKET;
+
+    for( SOCKET sock = first; sock < last; sock++ ) {
+
+        if( _info[ sock ].state != SOCKET_STATE_INVALID ) {
+            continue;
+        }
+
+        int fd = hostnetSocket( u8Type == SOCK_STREAM );
+        if( fd < 0 ) {
+            return -1;
+        }
+
+        _fd[ sock ] = fd;
+        _info[ sock ].state = SOCKET_STATE_IDLE;
+        _info[ sock ].parent = -1;
+        return sock;
+    }
+
+    return -1;
+}
+
+
+bool WiFiSocket::requestBind( SOCKET sock, struct sockaddr *pstrAddr, uint8 u8AddrLen ) {
+    ( void )u8AddrLen;
+
+    if( sock < 0 || sock >= MAX_SOCKET ) {
+        return false;
+    }
+
+    struct sockaddr_in* addr = ( struct sockaddr_in* )pstrAddr;
+
+    if( hostnetBind( _fd[ sock ], addr->sin_addr.s_addr, addr->sin_port ) < 0 ) {
+        return false;
+    }
+
+    _info[ sock ].state = SOCKET_STATE_BOUND;
+    _info[ sock ].recvMsg.s16BufferSize = 0;
+
+    return true;
+}
+
+
+uint8_t WiFiSocket::bound( SOCKET sock ) {
+
+    if( sock < 0 ) {
+        return 0;
+    }
+
+    return ( _info[ sock ].state == SOCKET_STATE_BOUND );
+}
+
+
+bool WiFiSocket::requestListen( SOCKET sock, uint8 backlog ) {
+
+    if( sock < 0 || hostnetListen( _fd[ sock ], backlog ) < 0 ) {
+        return false;
+    }
+
+    _info[ sock ].state = SOCKET_STATE_LISTENING;
+
+    return true;
+}
+
+
+uint8_t WiFiSocket::listening( SOCKET sock ) {
+
+    if( sock < 0 ) {
+        return 0;
+    }
+
+    return ( _info[ sock ].state == SOCKET_STATE_LISTENING );
+}
+
+
+bool WiFiSocket::requestConnect( SOCKET sock, struct sockaddr *pstrAddr, uint8 u8AddrLen ) {
+    ( void )u8AddrLen;
+
+    if( sock < 0 ) {
+        return false;
+    }
+
+    struct sockaddr_in* addr = ( struct sockaddr_in* )pstrAddr;
+
+    if( hostnetConnect( _fd[ sock ], addr->sin_addr.s_addr, addr->sin_port ) < 0 ) {
+        return false;
+    }
+
+    _info[ sock ].state = SOCKET_STATE_CONNECTING;
+    _info[ sock ].recvMsg.s16BufferSize = 0;
+    _info[ sock ].recvMsg.strRemoteAddr.sin_port = addr->sin_port;
+    _info[ sock ].recvMsg.strRemoteAddr.sin_addr.s_addr = addr->sin_addr.s_addr;
+
+    return true;
+}
+
+
+uint8_t WiFiSocket::connected( SOCKET sock ) {
+
+    if( sock < 0 ) {
+        return 0;
+    }
+
+    if( _info[ sock ].state == SOCKET_STATE_CONNECTING ) {
+
+        switch( hostnetConnectStatus( _fd[ sock ] )) {
+            case 1:
+                _info[ sock ].state = SOCKET_STATE_CONNECTED;
+                break;
+
+            case 0:
+                break;
+
+            default:
+                _info[ sock ].state = SOCKET_STATE_IDLE;
+                _info[ sock ].recvMsg.strRemoteAddr.sin_port = 0;
+                _info[ sock ].recvMsg.strRemoteAddr.sin_addr.s_addr = 0;
+                break;
+        }
+
+    } else if( _info[ sock ].state == SOCKET_STATE_CONNECTED && _info[ sock ].buffer.length == 0 ) {
+
+        /* Detect a connection closed by the peer */
+        this->fillRecvBuffer( sock );
+    }
+
+    return ( _info[ sock ].state == SOCKET_STATE_CONNECTED );
+}
+
+
+sint8 WiFiSocket::setopt( SOCKET socket, uint8 u8Level, uint8 option_name, const void *option_value, uint16 u16OptionLen ) {
+    ( void )socket;
+    ( void )u8Level;
+    ( void )option_name;
+    ( void )option_value;
+    ( void )u16OptionLen;
+
+    /* WINC specific options (SSL, UDP send callback) have no host equivalent */
+    return 0;
+}
+
+
+int WiFiSocket::available( SOCKET sock ) {
+
+    if( _info[ sock ].state != SOCKET_STATE_CONNECTED && _info[ sock ].state != SOCKET_STATE_BOUND ) {
+        return 0;
+    }
+
+    if( _info[ sock ].buffer.length == 0 ) {
+        this->fillRecvBuffer( sock );
+    }
+
+    return _info[ sock ].buffer.length;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Host sockets are not delivered by WINC events, the host socket 
+ *          is read when the receive buffer is empty.
+ *
+ */
+int WiFiSocket::buffered( SOCKET sock ) {
+    return this->available( sock );
+}
+
+
+int WiFiSocket::peek( SOCKET sock ) {
+
+    if( this->available( sock ) == 0 ) {
+        return -1;
+    }
+
+    return *_info[ sock ].buffer.head;
+}
+
+
+int WiFiSocket::read( SOCKET sock, uint8_t* buf, size_t size ) {
+
+    int bytesRead = 0;
+
+    while( size > 0 ) {
+
+        int avail = this->available( sock );
+        if( avail <= 0 ) {
+            break;
+        }
+
+        int toCopy = ( ( int )size > avail ) ? avail : size;
+
+        memcpy( buf, _info[ sock ].buffer.head, toCopy );
+        _info[ sock ].buffer.head += toCopy;
+        _info[ sock ].buffer.length -= toCopy;
+
+        buf += toCopy;
+        size -= toCopy;
+        bytesRead += toCopy;
+
+        /* Do not read past the end of the current datagram */
+        if( sock >= TCP_SOCK_MAX ) {
+            break;
+        }
+    }
+
+    return bytesRead;
+}
+
+
+IPAddress WiFiSocket::remoteIP( SOCKET sock ) {
+    return ( uint32_t )_info[ sock ].recvMsg.strRemoteAddr.sin_addr.s_addr;
+}
+
+
+uint16_t WiFiSocket::remotePort( SOCKET sock ) {
+    return _info[ sock ].recvMsg.strRemoteAddr.sin_port;
+}
+
+
+size_t WiFiSocket::write( SOCKET sock, const uint8_t *buf, size_t size ) {
+
+    if( _info[ sock ].state != SOCKET_STATE_CONNECTED ) {
+        return 0;
+    }
+
+    if( hostnetSend( _fd[ sock ], buf, size ) < 0 ) {
+        this->close( sock );
+        return 0;
+    }
+
+    return size;
+}
+
+
+sint16 WiFiSocket::sendto( SOCKET sock, void *pvSendBuffer, uint16 u16SendLength, uint16 flags, struct sockaddr *pstrDestAddr, uint8 u8AddrLen ) {
+    ( void )flags;
+    ( void )u8AddrLen;
+
+    if( _info[ sock ].state != SOCKET_STATE_BOUND ) {
+        return -1;
+    }
+
+    struct sockaddr_in* addr = ( struct sockaddr_in* )pstrDestAddr;
+
+    return hostnetSendTo( _fd[ sock ], ( const uint8_t* )pvSendBuffer, u16SendLength,
+                          addr->sin_addr.s_addr, addr->sin_port );
+}
+
+
+sint8 WiFiSocket::close( SOCKET sock ) {
+
+    if( sock < 0 || sock >= MAX_SOCKET ) {
+        return SOCK_ERR_INVALID_ARG;
+    }
+
+    _info[ sock ].state = SOCKET_STATE_INVALID;
+    _info[ sock ].parent = -1;
+
+    if( _info[ sock ].buffer.data != NULL ) {
+        g_pool.release( _info[ sock ].buffer.data );
+    }
+    _info[ sock ].buffer.data = NULL;
+    _info[ sock ].buffer.head = NULL;
+    _info[ sock ].buffer.length = 0;
+    _info[ sock ].recvMsg.s16BufferSize = 0;
+
+    memset( &_info[ sock ]._lastSendtoAddr, 0x00, sizeof( _info[ sock ]._lastSendtoAddr ));
+
+    hostnetClose( _fd[ sock ] );
+    _fd[ sock ] = -1;
+
+    return SOCK_ERR_NO_ERROR;
+}
+
+
+int WiFiSocket::hasParent( SOCKET sock, SOCKET child ) {
+
+    if( _info[ child ].parent != sock ) {
+        return 0;
+    }
+
+    return 1;
+}
+
+
+SOCKET WiFiSocket::accepted( SOCKET sock ) {
+
+    if( sock < 0 || _info[ sock ].state != SOCKET_STATE_LISTENING ) {
+        return -1;
+    }
+
+    for( SOCKET s = 0; s < TCP_SOCK_MAX; s++ ) {
+
+        if( _info[ s ].state != SOCKET_STATE_INVALID ) {
+            continue;
+        }
+
+        uint32_t addr;
+        uint16_t port;
+
+        int fd = hostnetAccept( _fd[ sock ], &addr, &port );
+        if( fd < 0 ) {
+            return -1;
+        }
+
+        _fd[ s ] = fd;
+        _info[ s ].state = SOCKET_STATE_CONNECTED;
+        _info[ s ].parent = sock;
+        _info[ s ].recvMsg.s16BufferSize = 0;
+        _info[ s ].recvMsg.strRemoteAddr.sin_addr.s_addr = addr;
+        _info[ s ].recvMsg.strRemoteAddr.sin_port = port;
+
+        return s;
+    }
+
+    return -1;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Read pending data from the host socket into the receive buffer.
+ *          The socket is closed if the connection was closed by the peer.
+ *
+ * @param   sock    Socket ID
+ *
+ * @return  1 if data was received, 0 otherwise.
+ *
+ */
+int WiFiSocket::fillRecvBuffer( SOCKET sock ) {
+
+    bool udp = ( sock >= TCP_SOCK_MAX );
+    int size = udp ? NATIVE_UDP_BUFFER_SIZE : SOCKET_BUFFER_SIZE;
+
+    if( _info[ sock ].buffer.data == NULL ) {
+        _info[ sock ].buffer.data = ( uint8_t* )g_pool.alloc( size, HEAP_SITE_SOCKET_BUFFER );
+        _info[ sock ].buffer.head = _info[ sock ].buffer.data;
+        _info[ sock ].buffer.length = 0;
+
+        if( _info[ sock ].buffer.data == NULL ) {
+            return 0;
+        }
+    }
+
+    int received;
+
+    if( udp == true ) {
+        uint32_t addr;
+        uint16_t port;
+
+        received = hostnetRecvFrom( _fd[ sock ], _info[ sock ].buffer.data, size, &addr, &port );
+        if( received > 0 ) {
+            _info[ sock ].recvMsg.strRemoteAddr.sin_addr.s_addr = addr;
+            _info[ sock ].recvMsg.strRemoteAddr.sin_port = port;
+        }
+
+    } else {
+        received = hostnetRecv( _fd[ sock ], _info[ sock ].buffer.data, size );
+
+        if( received == 0 || received == HOSTNET_ERROR ) {
+            this->close( sock );
+            return 0;
+        }
+    }
+
+    if( received <= 0 ) {
+        return 0;
+    }
+
+    _info[ sock ].buffer.head = _info[ sock ].buffer.data;
+    _info[ sock ].buffer.length = received;
+
+    return 1;
+}
\ No newline at end of file
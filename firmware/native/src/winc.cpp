@@ -0,0 +1,297 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : native/src/winc.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <native.h>
+#include <winc1500api.h>
+#include <trace_events.h>
+#include <isr_events.h>
+#include "hostnet.h"
+
+
+
+/* Emulation of the subset of the WINC1500 host driver used by the WiFi class.
+   The network is always available through the host, responses are queued and
+   delivered to the callbacks by m2m_wifi_handle_events() like the real driver
+   does. Sockets are handled by the native WiFiSocket implementation. */
+
+#define NATIVE_WIFI_RSSI            -40
+
+extern "C" {
+    int8_t gi8Winc1501CsPin = -1;
+    int8_t gi8Winc1501ResetPin = -1;
+    int8_t gi8Winc1501IntnPin = -1;
+    int8_t gi8Winc1501ChipEnPin = -1;
+
+    uint32 nmdrv_firm_ver = M2M_MAKE_VERSION( 19, 6, 1 );
+}
+
+static tpfAppWifiCb _wifiCb = nullptr;
+static tpfAppResolveCb _resolveCb = nullptr;
+static tpfPingCb _pingCb = nullptr;
+
+static bool _dhcp = true;
+static tstrM2MIPConfig _ipConfig;
+
+static struct {
+    bool connect;
+    bool disconnect;
+    bool dhcp;
+    bool rssi;
+    bool resolve;
+    bool ping;
+} _pending;
+
+static char _resolveName[ 64 ];
+static uint32 _resolveIP;
+static uint32 _pingIP;
+
+
+/* The IRQ line is asserted while responses are waiting to be delivered */
+static void raiseIrq() {
+    if( gi8Winc1501IntnPin >= 0 ) {
+        trace_record( TRACE_EVENT_ISR_WIFI, 0 );
+        event_queue_push( ISR_EVENT_WIFI, 0 );
+        nativeSetPinLevel( gi8Winc1501IntnPin, LOW );
+    }
+}
+
+
+
+extern "C" {
+
+sint8 nm_bsp_init( void ) {
+    return M2M_SUCCESS;
+}
+
+
+sint8 nm_bsp_deinit( void ) {
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_init( tstrWifiInitParam* pWifiInitParam ) {
+    _wifiCb = pWifiInitParam->pfAppWifiCb;
+    memset( &_pending, 0, sizeof( _pending ));
+
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_deinit( void* arg ) {
+    ( void )arg;
+
+    _wifiCb = nullptr;
+    return M2M_SUCCESS;
+}
+
+
+void socketInit( void ) {}
+
+
+void socketDeinit( void ) {}
+
+
+void registerSocketCallback( tpfAppSocketCb socket_cb, tpfAppResolveCb resolve_cb ) {
+    ( void )socket_cb;
+
+    _resolveCb = resolve_cb;
+}
+
+
+sint8 m2m_ssl_set_active_ciphersuites( uint32 u32SslCsBMP ) {
+    ( void )u32SslCsBMP;
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_enable_dhcp( uint8 u8DhcpEn ) {
+    _dhcp = ( u8DhcpEn != 0 );
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_set_static_ip( tstrM2MIPConfig* pstrStaticIPConf ) {
+    _ipConfig = *pstrStaticIPConf;
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_connect( char* pcSsid, uint8 u8SsidLen, uint8 u8SecType, void* pvAuthInfo, uint16 u16Ch ) {
+    ( void )pcSsid;
+    ( void )u8SsidLen;
+    ( void )u8SecType;
+    ( void )pvAuthInfo;
+    ( void )u16Ch;
+
+    if( _dhcp == true ) {
+
+        /* The host is reached through the loopback interface */
+        memset( &_ipConfig, 0, sizeof( _ipConfig ));
+        _ipConfig.u32StaticIP = IPAddress( 127, 0, 0, 1 );
+        _ipConfig.u32Gateway = IPAddress( 127, 0, 0, 1 );
+        _ipConfig.u32DNS = IPAddress( 127, 0, 0, 1 );
+        _ipConfig.u32SubnetMask = IPAddress( 255, 0, 0, 0 );
+        _ipConfig.u32DhcpLeaseTime = 86400;
+
+        _pending.dhcp = true;
+    }
+
+    _pending.connect = true;
+    raiseIrq();
+
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_disconnect( void ) {
+    _pending.disconnect = true;
+    raiseIrq();
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_set_device_name( uint8* pu8DeviceName, uint8 u8DeviceNameLength ) {
+    ( void )pu8DeviceName;
+    ( void )u8DeviceNameLength;
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_get_mac_address( uint8* pu8MacAddr ) {
+    static const uint8 mac[ 6 ] = { 0xF8, 0xF0, 0x05, 0x00, 0x00, 0x01 };
+
+    memcpy( pu8MacAddr, mac, sizeof( mac ));
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_req_curr_rssi( void ) {
+    _pending.rssi = true;
+    raiseIrq();
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_enable_sntp( uint8 bEnable ) {
+    ( void )bEnable;
+    return M2M_SUCCESS;
+}
+
+
+sint8 m2m_wifi_set_sytem_time( uint32 u32UTCSeconds ) {
+    ( void )u32UTCSeconds;
+    return M2M_SUCCESS;
+}
+
+
+sint8 gethostbyname( uint8* pcHostName ) {
+    if( pcHostName == nullptr || strlen( ( char* )pcHostName ) >= sizeof( _resolveName )) {
+        return SOCK_ERR_INVALID_ARG;
+    }
+
+    strcpy( _resolveName, ( char* )pcHostName );
+
+    /* The host resolver is blocking, the result is delivered on the
+       next call to m2m_wifi_handle_events() */
+    _resolveIP = hostnetResolve( _resolveName );
+    _pending.resolve = true;
+    raiseIrq();
+
+    return SOCK_ERR_NO_ERROR;
+}
+
+
+sint8 m2m_ping_req( uint32 u32DstIP, uint8 u8TTL, tpfPingCb fpPingCb ) {
+    ( void )u8TTL;
+
+    /* ICMP requires privileges on the host, the ping always succeeds */
+    _pingIP = u32DstIP;
+    _pingCb = fpPingCb;
+    _pending.ping = true;
+    raiseIrq();
+
+    return M2M_SUCCESS;
+}
+
+
+uint16 m2m_strlen( uint8* pcStr ) {
+    return strlen( ( char* )pcStr );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Deliver the queued responses to the registered callbacks
+ *
+ */
+sint8 m2m_wifi_handle_events( void* arg ) {
+    ( void )arg;
+
+    if( _wifiCb == nullptr ) {
+        return M2M_SUCCESS;
+    }
+
+    if( _pending.connect == true ) {
+        _pending.connect = false;
+
+        tstrM2mWifiStateChanged state = { M2M_WIFI_CONNECTED, 0 };
+        _wifiCb( M2M_WIFI_RESP_CON_STATE_CHANGED, &state );
+    }
+
+    if( _pending.dhcp == true ) {
+        _pending.dhcp = false;
+
+        _wifiCb( M2M_WIFI_REQ_DHCP_CONF, &_ipConfig );
+    }
+
+    if( _pending.disconnect == true ) {
+        _pending.disconnect = false;
+
+        tstrM2mWifiStateChanged state = { M2M_WIFI_DISCONNECTED, 0 };
+        _wifiCb( M2M_WIFI_RESP_CON_STATE_CHANGED, &state );
+    }
+
+    if( _pending.rssi == true ) {
+        _pending.rssi = false;
+
+        sint8 rssi = NATIVE_WIFI_RSSI;
+        _wifiCb( M2M_WIFI_RESP_CURRENT_RSSI, &rssi );
+    }
+
+    if( _pending.resolve == true && _resolveCb != nullptr ) {
+        _pending.resolve = false;
+
+        _resolveCb( ( uint8* )_resolveName, _resolveIP );
+    }
+
+    if( _pending.ping == true && _pingCb != nullptr ) {
+        _pending.ping = false;
+
+        _pingCb( _pingIP, 1, PING_ERR_SUCCESS );
+    }
+
+    if( gi8Winc1501IntnPin >= 0 ) {
+        nativeSetPinLevel( gi8Winc1501IntnPin, HIGH );
+    }
+
+    return M2M_SUCCESS;
+}
+
+}
\ No newline at end of file
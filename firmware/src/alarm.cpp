@@ -20,10 +20,59 @@
 #include "ui/screen.h"
 #include "ui/ui.h"
 #include "services/homeassistant.h"
-
-
-
-uint8_t vs1053_buffer[VS1053_DATA_BLOCK_SIZE];
+#include "services/logger.h"
+
+
+
+uint8_t vs1053_ring[ ALARM_RING_SECTORS ][ ALARM_RING_SECTOR_SIZE ];
+
+
+/* Flashing : on/off every 2 sec. at speed 1 */
+static const NeoEffectFrame ALARM_EFFECT_FLASHING[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 25, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_HOLD },
+    {  2000, 0,                     0, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_HOLD },
+    {  4000, NEOEFFECT_BASE_LEVEL, 25, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_END },
+};
+
+/* Red flash : red on/off every 2 sec. at speed 1 */
+static const NeoEffectFrame ALARM_EFFECT_RED_FLASH[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 25, COLOR_RED,            NEOEFFECT_FLAG_HOLD },
+    {  2000, 0,                     0, COLOR_RED,            NEOEFFECT_FLAG_HOLD },
+    {  4000, NEOEFFECT_BASE_LEVEL, 25, COLOR_RED,            NEOEFFECT_FLAG_END },
+};
+
+/* White flash : alternate between the clock color and white every 2 sec. at speed 1 */
+static const NeoEffectFrame ALARM_EFFECT_WHITE_FLASH[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 25, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_HOLD },
+    {  2000, NEOEFFECT_BASE_LEVEL, 25, COLOR_WHITE,          NEOEFFECT_FLAG_HOLD },
+    {  4000, NEOEFFECT_BASE_LEVEL, 25, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_END },
+};
+
+/* Fading : between 3/4 of the clock brightness and 20% above in 4 sec. at speed 1 */
+static const NeoEffectFrame ALARM_EFFECT_FADING[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL,  0, NEOEFFECT_BASE_COLOR, 0 },
+    {  1000, NEOEFFECT_BASE_LEVEL, 20, NEOEFFECT_BASE_COLOR, 0 },
+    {  3000, 96,                    0, NEOEFFECT_BASE_COLOR, 0 },
+    {  4000, NEOEFFECT_BASE_LEVEL,  0, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_END },
+};
+
+/* Rainbow : green, red, blue color wheel in 12.75 sec. at speed 1 */
+static const NeoEffectFrame ALARM_EFFECT_RAINBOW[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 25, COLOR_GREEN,          0 },
+    {  4250, NEOEFFECT_BASE_LEVEL, 25, COLOR_RED,            0 },
+    {  8500, NEOEFFECT_BASE_LEVEL, 25, COLOR_BLUE,           0 },
+    { 12750, NEOEFFECT_BASE_LEVEL, 25, COLOR_GREEN,          NEOEFFECT_FLAG_END },
+};
+
+/* Clock effects, indexed by visual mode (ALARM_VISUAL_*) */
+static const NeoEffectFrame* const ALARM_VISUAL_EFFECTS[ MAX_ALARM_VISUALS ] PROGMEM = {
+    nullptr,
+    ALARM_EFFECT_FLASHING,
+    ALARM_EFFECT_FADING,
+    ALARM_EFFECT_RAINBOW,
+    ALARM_EFFECT_WHITE_FLASH,
+    ALARM_EFFECT_RED_FLASH,
+};
 
 
 
@@ -41,7 +90,10 @@ uint8_t vs1053_buffer[VS1053_DATA_BLOCK_SIZE];
  * 
  */
 Alarm::Alarm( int8_t pin_reset, int8_t pin_cs, int8_t pin_xdcs, int8_t pin_dreq, int8_t pin_alarm_sw, 
-              int8_t pin_amp_shdn, SDCardManager* sdcard ) : VS1053( pin_cs, pin_xdcs, pin_dreq, pin_reset ) {
+              int8_t pin_amp_shdn, SDCardManager* sdcard ) : VS1053( pin_cs, pin_xdcs, pin_dreq, pin_reset ),
+                                                             _volumeEnvelope( ALARM_VOLUME_UPDATE_INTERVAL ),
+                                                             _lampEnvelope( ALARM_LIGHT_UPDATE_INTERVAL ),
+                                                             _clockEnvelope( ALARM_LIGHT_UPDATE_INTERVAL ) {
 
     _sdcard = sdcard;
     _sd_present = false;
@@ -153,9 +205,9 @@ bool Alarm::isSDCardPresent() {
 
 /*******************************************************************************
  *
- * @brief   Open the next music file in the SD card root directory. 
+ * @brief   Open the next music file in the SD card sound index. 
  * 
- * @details If the end of the directory was reached, it will select the 
+ * @details If the end of the index was reached, it will select the 
  *          fallback file stored in program memory. The next time 
  *          openNextFile is called, it will select the first file.
  *
@@ -185,83 +237,93 @@ bool Alarm::openNextFile() {
  * @details If the file is not found or card was removed, it will use the fallback
  *          file instead.
  *
+ * @param   name    Name of the file, NULL to select the file following the
+ *                  current one in the sound index.
+ *
  * @return  TRUE if successful, FALSE otherwise.
  * 
  */
 bool Alarm::openFile( char* name ) {
 
-    if( _rootDir.isOpen() == false ) {
-
-        /* Open root directory */
-        if( _rootDir.open("/") == false ) {
-
-            this->profile.filename[0] = '\0';
-            return false;
-        }
-    }
+    SoundIndexEntry entry;
+    int16_t index = -1;
 
     /* Close current file if open */
     if( this->currentFile.isOpen() == true ) {
         this->currentFile.close();
     }
 
-    char buffer[ MAX_LENGTH_ALARM_FILENAME + 1 ];
+    /* The index is being rebuilt, open the file by name. The next file can't
+       be selected until the index is ready, the current one is kept. */
+    if( g_soundIndex.isReady() == false ) {
+
+        if( name == NULL ) {
+            name = this->profile.filename;
+        }
+
+        _soundIndexPos = -1;
+        _soundDataOffset = 0;
+
+        if( strlen( name ) > 0 && g_soundIndex.openSound( name, &this->currentFile ) == true ) {
+
+            if( name != this->profile.filename ) {
+                this->currentFile.getName( this->profile.filename, sizeof( this->profile.filename ));
+            }
+
+            return true;
+        }
+
+        this->profile.filename[0] = '\0';
+        return false;
+    }
 
     if( name != NULL ) {
 
         /* Open the specified file */
         if( strlen( name ) > 0 ) {
-            this->currentFile.open( &_rootDir, name, O_READ );
-            this->currentFile.getName( buffer, MAX_LENGTH_ALARM_FILENAME );
+            index = g_soundIndex.find( name );
         }
 
+    } else if( strlen( this->profile.filename ) == 0 ) {
+
+        /* The fallback file is selected, start over from the first file. */
+        index = 0;
+
     } else {
-        /* Open the next file in the root directory */
-        if( this->currentFile.openNext( &_rootDir, O_READ ) == true ) {
-        
-            this->currentFile.getName( buffer, MAX_LENGTH_ALARM_FILENAME );
 
-            /* If the next filename is the same than the currently slected one, go
-            to the next file. */
-            if( strcmp( this->profile.filename, buffer ) == 0 ) {
-                this->currentFile.openNext( &_rootDir, O_READ );
-            }
+        /* Locate the current file, the last position is checked first. */
+        if( _soundIndexPos < 0
+            || g_soundIndex.readEntry( _soundIndexPos, &entry ) == false
+            || strcasecmp( entry.name, this->profile.filename ) != 0 ) {
+
+            _soundIndexPos = g_soundIndex.find( this->profile.filename );
+        }
+
+        /* Select the next file, or the fallback file after the last one. */
+        index = _soundIndexPos + 1;
+        if( index >= g_soundIndex.getCount() ) {
+            index = -1;
         }
     }
 
-    while( this->currentFile.isOpen() == true ) {
+    if( index >= 0 && g_soundIndex.readEntry( index, &entry ) == true ) {
 
-        this->currentFile.getName( buffer, MAX_LENGTH_ALARM_FILENAME );
+        if( g_soundIndex.openSound( &entry, &this->currentFile ) == true ) {
 
-        /* Validate file extension */
-        if( this->currentFile.isFile() == true ) {
-            if( strcasestr_P( buffer, PSTR( ".mp3" )) != NULL
-                || strcasestr_P( buffer, PSTR( ".mid" )) != NULL
-                || strcasestr_P( buffer, PSTR( ".ogg" )) != NULL
-                || strcasestr_P( buffer, PSTR( ".aac" )) != NULL
-                || strcasestr_P( buffer, PSTR( ".wav" )) != NULL ) {
+            strcpy( this->profile.filename, entry.name );
 
-                /* File extention is valid */
-                strcpy( this->profile.filename, buffer );
-                return true;
-            }
+            _soundIndexPos = index;
+            _soundDataOffset = entry.dataOffset;
+            return true;
         }
-
-        /* invalid extention, close the file and go for the next one. */
-        this->currentFile.close();
-        this->currentFile.openNext( &_rootDir, O_READ );
-        this->currentFile.getName( buffer, MAX_LENGTH_ALARM_FILENAME );
     }
 
-    if( this->currentFile.isOpen() == false ) {
-        _rootDir.rewindDirectory();
-
-        /* If failed to open, set profile to default internal alarm sound */
-        this->profile.filename[0] = '\0';
-        return false;
-    }
+    /* If failed to open, set profile to default internal alarm sound */
+    this->profile.filename[0] = '\0';
 
-    return true;
+    _soundIndexPos = -1;
+    _soundDataOffset = 0;
+    return false;
 }
 
 
@@ -429,6 +491,7 @@ void Alarm::play( uint8_t mode ) {
     }
 
     if( mode & ALARM_MODE_AUDIO ) {
+        this->beginAudioStats();
         this->audioStart();
     }
 
@@ -450,6 +513,7 @@ void Alarm::stop() {
 
     if( _playMode & ALARM_MODE_AUDIO ) {
         this->audioStop();
+        this->endAudioStats();
     }
 
     if( _playMode & ALARM_MODE_VISUAL || _playMode & ALARM_MODE_LAMP ) {
@@ -473,6 +537,16 @@ void Alarm::stop() {
  */
 void Alarm::audioStop() {
     _amplifier.disableOutputs();
+    _volumeEnvelope.stop();
+
+    #if ALARM_FEED_INTERRUPT == 1
+    this->detachDataInterrupt();
+    #endif
+
+    if( _audioPlayStart != 0 ) {
+        _audioPlayTime += millis() - _audioPlayStart;
+        _audioPlayStart = 0;
+    }
 
     if( _playMode & ALARM_MODE_AUDIO ) {
 
@@ -499,6 +573,9 @@ void Alarm::audioStart() {
     if( this->profile.gradual == true && ( ( _playMode & ALARM_MODE_TEST ) == 0 ) ) {
         this->setVolume( 0 );
 
+        /* The codec volume is in 0.5 dB steps, already perceptually linear */
+        _volumeEnvelope.start( 0, this->profile.volume, this->getGradualDuration(), ENVELOPE_CURVE_LINEAR );
+
     } else {
         this->setVolume( this->profile.volume );
     }
@@ -509,9 +586,11 @@ void Alarm::audioStart() {
         _pgm_audio_ptr = 0;
 
     } else {
-        this->currentFile.rewind();
+        this->currentFile.seekSet( _soundDataOffset );
     }
 
+    this->resetRing();
+
     /* reset playback */
     this->sciWrite( VS1053_REG_MODE, VS1053_MODE_SM_LINE1 | VS1053_MODE_SM_SDINEW );
 
@@ -523,6 +602,12 @@ void Alarm::audioStart() {
     sciWrite( VS1053_REG_DECODETIME, 0x00 );
     sciWrite( VS1053_REG_DECODETIME, 0x00 );
     _amplifier.enableOutputs();
+
+    #if ALARM_FEED_INTERRUPT == 1
+    this->attachDataInterrupt( isr_vs1053_dreq );
+    #endif
+
+    _audioPlayStart = millis();
 }
 
 
@@ -599,6 +684,50 @@ void Alarm::setVolume( uint8_t vol ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Get the length of the gradual wake-up of the current profile.
+ *
+ * @return  Duration in ms.
+ * 
+ */
+uint32_t Alarm::getGradualDuration() {
+
+    uint8_t minutes = constrain( this->profile.gradualTime, MIN_ALARM_GRADUAL_TIME, MAX_ALARM_GRADUAL_TIME );
+
+    return minutes * 60000UL;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Update the codec volume, lamp and clock brightness during the
+ *          gradual wake-up. Each output is only written when its value 
+ *          changes, at most once per update interval.
+ *
+ */
+void Alarm::processGradual() {
+
+    uint8_t value;
+
+    if( _volumeEnvelope.update( &value ) == true ) {
+        this->setVolume( value );
+    }
+
+    if( _lampEnvelope.update( &value ) == true ) {
+        g_lamp.setBrightness( value );
+    }
+
+    if( _clockEnvelope.update( &value ) == true ) {
+        g_clock.setBrightness( value );
+
+        if( g_clock.isEffectActive() == false ) {
+            g_clock.update();
+        }
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   Returns whether or not the current alarm state is snoozing.
@@ -667,136 +796,29 @@ void Alarm::visualStart() {
         this->profile.lamp.delay_off = 0;
         g_lamp.deactivate( true );
         g_lamp.activate( &this->profile.lamp );
-    }
-
-    /* Visual mode not enabled */
-    if( ( _playMode & ALARM_MODE_VISUAL ) == 0
-            || this->profile.visualMode == ALARM_VISUAL_NONE ) {
-        return;
-    }
-
-    _visualStepReverse = false;
-
-    switch( this->profile.visualMode ) {
 
-        case ALARM_VISUAL_FADING:
-            _visualStepValue = g_config.clock.clock_brightness;
-            break;
-
-        default:
-            _visualStepValue = 0;
-            break;
-    }
-
-    this->updateVisualStepDelay();
-}
-
-
-/*******************************************************************************
- *
- * @brief   Update the visual effect animation next step delay when speed 
- *          settings changes.
- *
- */
-inline void Alarm::updateVisualStepDelay() {
+        if( this->profile.gradual == true && ( ( _playMode & ALARM_MODE_TEST ) == 0 ) ) {
+            g_lamp.setBrightness( 0 );
 
-    switch( this->profile.visualMode ) {
-
-        case ALARM_VISUAL_FADING:
-        case ALARM_VISUAL_RAINBOW:
-            _visualStepDelay = 250 / this->profile.effectSpeed;
-            break;
-
-        case ALARM_VISUAL_NONE:
-            _visualStepDelay = 0;
-            break;
-
-        default:
-            _visualStepDelay = 2000 / this->profile.effectSpeed;
-            break;
-    }
-}
-
-
-/*******************************************************************************
- *
- * @brief   Process the next step of the visual effect animation.
- *
- */
-inline void Alarm::visualStep() {
-    if( this->profile.visualMode == ALARM_VISUAL_NONE ) {
-        return;
+            /* The pixel driver already applies the gamma correction */
+            _lampEnvelope.start( 0, this->profile.lamp.brightness, this->getGradualDuration(), ENVELOPE_CURVE_LINEAR );
+        }
     }
 
-    /* Check if visual effect is enabled */
-    if( _visualStepDelay == 0 ) {
-        return;
+    /* Bring the clock to full brightness */
+    if( _playMode & ALARM_MODE_VISUAL && this->profile.gradual == true && ( ( _playMode & ALARM_MODE_TEST ) == 0 ) ) {
+        _clockEnvelope.start( g_config.clock.clock_brightness, 100, this->getGradualDuration(), ENVELOPE_CURVE_LINEAR );
     }
 
-    /* Check if the effect next step delay is elapsed */
-    if( ( millis() - _timerStart ) < _visualStepDelay ) {
+    /* Visual mode not enabled */
+    if( ( _playMode & ALARM_MODE_VISUAL ) == 0
+            || this->profile.visualMode == ALARM_VISUAL_NONE
+            || this->profile.visualMode >= MAX_ALARM_VISUALS ) {
         return;
     }
 
-    switch( this->profile.visualMode ) {
-        case ALARM_VISUAL_FLASHING:
-        case ALARM_VISUAL_RED_FLASH:
-
-            _visualStepReverse = !_visualStepReverse;
-
-            g_clock.setBrightness( _visualStepReverse ? 0 : ( g_config.clock.clock_brightness + 25 ) );
-
-            if( this->profile.visualMode == ALARM_VISUAL_RED_FLASH ) {
-                g_clock.setColorFromTable( COLOR_RED );
-            }
-
-            break;
-
-        case ALARM_VISUAL_WHITE_FLASH:
-            _visualStepReverse = !_visualStepReverse;
-
-            g_clock.setBrightness( g_config.clock.clock_brightness + 25 );
-            g_clock.setColorFromTable( _visualStepReverse ? COLOR_WHITE : g_config.clock.clock_color );
-            break;
-
-        case ALARM_VISUAL_FADING:
-            if( _visualStepValue
-                    < ( ( g_config.clock.clock_brightness < 25 ) ? 5 : ( g_config.clock.clock_brightness - 20 ) ) ) {
-                _visualStepReverse = false;
-            }
-
-            if( _visualStepValue > ( g_config.clock.clock_brightness + 20 ) ) {
-                _visualStepReverse = true;
-            }
-
-            _visualStepValue += ( _visualStepReverse ? -5 : 5 );
-            g_clock.setBrightness( _visualStepValue );
-            break;
-
-        case ALARM_VISUAL_RAINBOW:
-            g_clock.setBrightness( g_config.clock.clock_brightness + 25 );
-
-            _visualStepValue += 5;
-
-            if( _visualStepValue < 85 ) {
-                g_clock.setColorRGB( _visualStepValue * 3, 255 - _visualStepValue * 3, 0 );
-
-            } else if( _visualStepValue < 170 ) {
-                g_clock.setColorRGB( 255 - ( _visualStepValue - 85 ) * 3, 0,
-                                     ( _visualStepValue - 85 ) * 3 );
-
-            } else {
-                g_clock.setColorRGB( 0, ( _visualStepValue - 170 ) * 3,
-                                     255 - ( _visualStepValue - 170 ) * 3 );
-            }
-
-            break;
-    }
-
-    g_clock.update();
-
-    _timerStart = millis();
-    this->updateVisualStepDelay();
+    g_clock.startEffect( ( const NeoEffectFrame * )pgm_read_ptr( &ALARM_VISUAL_EFFECTS[ this->profile.visualMode ] ),
+                         this->profile.effectSpeed );
 }
 
 
@@ -807,10 +829,14 @@ inline void Alarm::visualStep() {
  */
 inline void Alarm::visualStop() {
 
+    _lampEnvelope.stop();
+    _clockEnvelope.stop();
+
     /* Turn off lamp if active */
     g_lamp.deactivate();
 
     /* Restore clock settings */
+    g_clock.stopEffect();
     g_clock.setColorFromTable( g_config.clock.clock_color );
     g_clock.setBrightness( g_config.clock.clock_brightness );
     g_clock.update();
@@ -894,85 +920,479 @@ void Alarm::processEvents() {
     }
 
 
-    if( this->profile.gradual == true && ( ( _playMode & ALARM_MODE_TEST ) == 0 ) ) {
-        uint8_t volume = ( uint8_t )( ( unsigned long )( millis() - _alarmStart ) / ( 45000 / this->profile.volume ) );
-
-        if( volume > this->profile.volume ) {
-            volume = this->profile.volume;
-        }
-
-        if( volume != _volume ) {
-            this->setVolume( volume );
-        }
-    }
+    this->processGradual();
 
 
     if( _playMode & ALARM_MODE_AUDIO ) {
         g_power.resetSuspendDelay();
         this->feedBuffer();
+        this->pollAudioStats();
     }
 
     if( _playMode & ALARM_MODE_VISUAL ) {
-        this->visualStep();
+
+        /* Follow the speed changes made while testing the profile, the
+           frames are rendered by the clock driver. */
+        g_clock.setEffectSpeed( this->profile.effectSpeed );
     }
 }
 
 
 /*******************************************************************************
  *
- * @brief   Send data to the codec when it is ready to receive data.
+ * @brief   Send data to the codec from the ring buffer if it is ready to 
+ *          receive data, then refill the sectors sent.
  *
  */
-inline void Alarm::feedBuffer() {
+void Alarm::feedBuffer() {
     if( _playMode & ALARM_MODE_SNOOZE ) {
         return;
     }
-    
-    size_t bytesRead;
 
-    uint8_t blocks = VS1053_BLOCKS_PER_RUN;
-    while( blocks-- > 0 ) {
+    noInterrupts();
+    bool busy = _feeding;
+    _feeding = true;
+    interrupts();
+
+    if( busy == false ) {
+
+        #if ALARM_FEED_INTERRUPT == 1
+        /* Catch up if a data request was missed while the ring was empty */
+        this->feedCodec( 0 );
+        #else
+        this->feedCodec( VS1053_BLOCKS_PER_RUN );
+        #endif
+
+        _feeding = false;
+    }
+
+    for( uint8_t i = 0; i < ALARM_RING_SECTORS; i++ ) {
+        if( _ringLength[ i ] == 0 ) {
+            this->fillSector( i );
+        }
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send blocks from the ring buffer while the codec is ready to 
+ *          receive data. The caller must own the _feeding flag.
+ *
+ * @param   max_blocks    Maximum number of blocks to send, 0 for no limit.
+ *
+ */
+void Alarm::feedCodec( uint8_t max_blocks ) {
+    uint8_t blocks = 0;
+
+    while( max_blocks == 0 || blocks < max_blocks ) {
 
         /* Check if the codec is ready to receive the next block. */
         if( this->readyForData() == false ) {
-            break;
+
+            /* The FIFO is full, the number of bytes sent gives the free 
+               space it had when the feed started. */
+            if( _fifoFilled == true && blocks * VS1053_DATA_BLOCK_SIZE > _fifoMaxFree ) {
+                _fifoMaxFree = blocks * VS1053_DATA_BLOCK_SIZE;
+            }
+
+            _fifoFilled = true;
+            return;
         }
-    
-        if( this->currentFile.isOpen() == false ) {
 
-            /* Playback from program memory space. */
-            if( _pgm_audio_ptr + VS1053_DATA_BLOCK_SIZE > DEFAULT_ALARMSOUND_DATA_LENGTH ) {
+        uint8_t sector = _ringSector;
 
-                bytesRead = DEFAULT_ALARMSOUND_DATA_LENGTH - _pgm_audio_ptr;
+        if( _ringLength[ sector ] == 0 ) {
 
-                memcpy_P( &vs1053_buffer, &_DEFAULT_ALARMSOUND_DATA[_pgm_audio_ptr], bytesRead );
+            /* The ring could not keep up with the codec */
+            if( _fifoFilled == true ) {
+                _underruns++;
+            }
 
-                _pgm_audio_ptr = 0;
+            return;
+        }
 
-            } else {
+        uint16_t length = min( VS1053_DATA_BLOCK_SIZE, _ringLength[ sector ] - _ringPosition );
 
-                bytesRead = VS1053_DATA_BLOCK_SIZE;
+        this->playData( &vs1053_ring[ sector ][ _ringPosition ], length );
+        _ringPosition += length;
+        _bytesSent += length;
+        blocks++;
 
-                memcpy_P( &vs1053_buffer, &_DEFAULT_ALARMSOUND_DATA[_pgm_audio_ptr],
-                        VS1053_DATA_BLOCK_SIZE );
+        /* Sector sent, continue with the next one */
+        if( _ringPosition >= _ringLength[ sector ] ) {
+            _ringLength[ sector ] = 0;
+            _ringPosition = 0;
+            _ringSector = ( sector + 1 ) % ALARM_RING_SECTORS;
+        }
+    }
+}
 
-                _pgm_audio_ptr += VS1053_DATA_BLOCK_SIZE;
-            }
 
+/*******************************************************************************
+ *
+ * @brief   Feed the codec when it requests data, regardless of how long the 
+ *          main loop is blocked. Called from the DREQ interrupt.
+ *
+ */
+void Alarm::onDataRequest() {
+    if( _feeding == true ) {
+        return;
+    }
+
+    _feeding = true;
+    _interruptFeeds++;
 
-        } else {
-            /* Playback from file on SD card. */
-            bytesRead = this->currentFile.read( vs1053_buffer, VS1053_DATA_BLOCK_SIZE );
+    /* Filling the FIFO takes up to ~2.5 ms, let the other interrupts be 
+       serviced meanwhile. A nested data request returns on _feeding. */
+    interrupts();
 
-            if( bytesRead == 0 ) {
+    this->feedCodec( 0 );
+    _feeding = false;
+}
 
-                /* Play the file in loop */
-                this->currentFile.rewind();
 
-            }
+/*******************************************************************************
+ *
+ * @brief   Fill a sector of the ring buffer. Reads from the SD card are kept
+ *          aligned on whole sectors so they bypass the SdFat cache.
+ *
+ * @param   sector    Sector of the ring to fill.
+ *
+ */
+void Alarm::fillSector( uint8_t sector ) {
+
+    uint8_t *buffer = vs1053_ring[ sector ];
+    int length;
+
+    if( this->currentFile.isOpen() == false ) {
+
+        /* Playback from program memory space. */
+        length = min( ALARM_RING_SECTOR_SIZE, DEFAULT_ALARMSOUND_DATA_LENGTH - _pgm_audio_ptr );
+
+        memcpy_P( buffer, &_DEFAULT_ALARMSOUND_DATA[ _pgm_audio_ptr ], length );
+
+        _pgm_audio_ptr += length;
+        if( _pgm_audio_ptr >= DEFAULT_ALARMSOUND_DATA_LENGTH ) {
+            _pgm_audio_ptr = 0;
+        }
+
+    } else {
+
+        /* Playback from file on SD card. */
+        length = this->currentFile.read( buffer, ALARM_RING_SECTOR_SIZE );
+
+        if( length <= 0 ) {
+
+            /* Play the file in loop */
+            this->currentFile.seekSet( _soundDataOffset );
+            length = this->currentFile.read( buffer, ALARM_RING_SECTOR_SIZE );
+        }
+
+        if( length < 0 ) {
+            length = 0;
+        }
+
+        _sectorReads++;
+    }
+
+    noInterrupts();
+    _ringLength[ sector ] = length;
+    interrupts();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Discard the content of the ring buffer and fill it from the 
+ *          current position of the alarm sound.
+ *
+ */
+void Alarm::resetRing() {
+    _ringPosition = 0;
+    _ringSector = 0;
+    _fifoFilled = false;
+
+    for( uint8_t i = 0; i < ALARM_RING_SECTORS; i++ ) {
+        this->fillSector( i );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Clears the audio playback statistics.
+ *
+ */
+void Alarm::clearAudioStats() {
+    noInterrupts();
+
+    /* Keep the statistics of the alarm playing */
+    _audioUnderrunsStart -= _underruns;
+    _audioBytesStart -= _bytesSent;
+
+    _underruns = 0;
+    _bytesSent = 0;
+    _interruptFeeds = 0;
+    _fifoMaxFree = 0;
+    interrupts();
+
+    _sectorReads = 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the lowest level of the codec FIFO measured when it was fed
+ *          since the playback started.
+ *
+ * @return  FIFO level in bytes.
+ *
+ */
+uint16_t Alarm::getFifoMinLevel() {
+    uint16_t free;
+
+    noInterrupts();
+    free = _fifoMaxFree;
+    interrupts();
+
+    return ( free < VS1053_FIFO_SIZE ) ? VS1053_FIFO_SIZE - free : 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the number of times the codec requested data while the ring
+ *          was empty.
+ *
+ * @return  Number of underruns.
+ *
+ */
+uint32_t Alarm::getUnderruns() {
+    uint32_t count;
+
+    noInterrupts();
+    count = _underruns;
+    interrupts();
+
+    return count;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the number of bytes sent to the codec.
+ *
+ * @return  Number of bytes.
+ *
+ */
+uint32_t Alarm::getBytesSent() {
+    uint32_t count;
+
+    noInterrupts();
+    count = _bytesSent;
+    interrupts();
+
+    return count;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the number of times the codec was fed from the DREQ
+ *          interrupt.
+ *
+ * @return  Number of interrupt feeds.
+ *
+ */
+uint32_t Alarm::getInterruptFeeds() {
+    uint32_t count;
+
+    noInterrupts();
+    count = _interruptFeeds;
+    interrupts();
+
+    return count;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Start collecting the audio playback statistics of a new alarm.
+ *
+ */
+void Alarm::beginAudioStats() {
+    uint32_t count = _audioStats.count;
+
+    memset( &_audioStats, 0, sizeof( _audioStats ));
+    _audioStats.count = count + 1;
+
+    noInterrupts();
+    _audioUnderrunsStart = _underruns;
+    _audioBytesStart = _bytesSent;
+    interrupts();
+
+    _audioPlayTime = 0;
+    _audioStatsPoll = millis();
+    _audioLatencyPending = true;
+    _audioStatsActive = true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Update the playback counters of the current alarm.
+ *
+ */
+void Alarm::updateAudioStats() {
+    noInterrupts();
+    _audioStats.underruns = _underruns - _audioUnderrunsStart;
+    _audioStats.bytes = _bytesSent - _audioBytesStart;
+    interrupts();
+
+    _audioStats.duration = _audioPlayTime;
+
+    if( _audioPlayStart != 0 ) {
+        _audioStats.duration += millis() - _audioPlayStart;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Poll the codec status while the alarm is playing. The start 
+ *          latency is measured when the codec decodes the first frame 
+ *          header of the stream.
+ *
+ */
+void Alarm::pollAudioStats() {
+    if( _audioStatsActive == false ) {
+        return;
+    }
+
+    if( _audioLatencyPending == true ) {
+        unsigned long elapsed = millis() - _alarmStart;
+
+        if( this->sciRead( VS1053_REG_HDAT1 ) != 0 ) {
+            _audioStats.startLatency = ( elapsed > 0 ) ? elapsed : 1;
+            _audioLatencyPending = false;
+
+            g_log.add( EVENT_ALARM_AUDIO_START, _audioStats.startLatency );
+
+        } else if( elapsed > 0xFFFF ) {
+
+            /* Nothing decoded, the latency is left to 0 */
+            _audioLatencyPending = false;
         }
+    }
 
-        this->playData( vs1053_buffer, bytesRead );
+    if( millis() - _audioStatsPoll < ALARM_AUDIO_STATS_INTERVAL ) {
+        return;
+    }
+
+    _audioStatsPoll = millis();
+
+    _audioStats.decodeTime = this->sciRead( VS1053_REG_DECODETIME );
+    _audioStats.hdat0 = this->sciRead( VS1053_REG_HDAT0 );
+    _audioStats.hdat1 = this->sciRead( VS1053_REG_HDAT1 );
+    _audioStats.byteRate = this->wramRead( VS1053_PARA_BYTERATE );
+
+    this->updateAudioStats();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stop collecting the audio playback statistics, log them and 
+ *          publish them to home assistant.
+ *
+ */
+void Alarm::endAudioStats() {
+    if( _audioStatsActive == false ) {
+        return;
+    }
+
+    _audioStatsActive = false;
+    this->updateAudioStats();
+
+    uint32_t underruns = ( _audioStats.underruns > 0xFFFF ) ? 0xFFFF : _audioStats.underruns;
+    uint32_t rate = this->getAudioDataRate();
+
+    if( rate > 0xFFFF ) {
+        rate = 0xFFFF;
+    }
+
+    g_log.add( EVENT_ALARM_AUDIO_END, ( underruns << 16 ) | rate );
+
+    #if HASS_AUDIO_SENSORS == 1
+    g_homeassistant.updateSensor( SENSOR_ID_AUDIO_UNDERRUNS, true );
+    g_homeassistant.updateSensor( SENSOR_ID_AUDIO_DATA_RATE, true );
+    g_homeassistant.updateSensor( SENSOR_ID_AUDIO_BITRATE, true );
+    g_homeassistant.updateSensor( SENSOR_ID_AUDIO_START_LATENCY, true );
+    #endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the average rate at which the audio data of the last alarm
+ *          was sent to the codec.
+ *
+ * @return  Data rate in bytes/s.
+ *
+ */
+uint32_t Alarm::getAudioDataRate() {
+    if( _audioStats.duration == 0 ) {
+        return 0;
+    }
+
+    return ( uint64_t )_audioStats.bytes * 1000 / _audioStats.duration;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the name of the stream format detected by the codec 
+ *          during the last alarm.
+ *
+ * @return  Pointer to the name in program memory.
+ *
+ */
+const char *Alarm::getAudioFormatName() {
+    uint16_t format = _audioStats.hdat1;
+
+    if( format == 0 ) {
+        return S_AUDIO_FORMAT_NONE;
+    }
+
+    /* MPEG frame sync word */
+    if( ( format & 0xFFE0 ) == 0xFFE0 ) {
+        return S_AUDIO_FORMAT_MPEG;
+    }
+
+    switch( format ) {
+        case 0x7665:
+            return S_AUDIO_FORMAT_WAV;
+
+        case 0x4154:
+        case 0x4144:
+        case 0x4D34:
+            return S_AUDIO_FORMAT_AAC;
+
+        case 0x574D:
+            return S_AUDIO_FORMAT_WMA;
+
+        case 0x4F67:
+            return S_AUDIO_FORMAT_OGG;
+
+        case 0x664C:
+            return S_AUDIO_FORMAT_FLAC;
+
+        case 0x4D54:
+            return S_AUDIO_FORMAT_MIDI;
+
+        default:
+            return S_AUDIO_FORMAT_UNKNOWN;
     }
 }
 
@@ -1154,4 +1574,13 @@ int16_t Alarm::getNextAlarmOffset( int8_t alarm_id, DateTime* currentTime, bool
 
     return ( a_dayOffset * 1440 ) + ( ( a_hour - currentTime->hour() ) * 60 )
            + ( a_min - currentTime->minute() );
+}
+
+/*******************************************************************************
+ *
+ * @brief   Interrupt service routine for the codec data request (DREQ).
+ * 
+ */
+void isr_vs1053_dreq() {
+    g_alarm.onDataRequest();
 }
\ No newline at end of file
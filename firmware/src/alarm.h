@@ -23,6 +23,8 @@
 #include <SPI.h>
 #include <EEPROM.h>
 #include "drivers/sdcard.h"
+#include "soundindex.h"
+#include "drivers/envelope.h"
 #include <avr/pgmspace.h>
 #include <time.h>
 #include <hardware.h>
@@ -56,9 +58,42 @@
 
 #define VS1053_DATA_BLOCK_SIZE      32
 #define VS1053_BLOCKS_PER_RUN       16
+#define VS1053_FIFO_SIZE            2048
+
+/* Feed the codec from the DREQ interrupt, the main loop only refills the ring */
+#define ALARM_FEED_INTERRUPT        1
+
+/* Codec status polling interval while the alarm is playing (ms) */
+#define ALARM_AUDIO_STATS_INTERVAL  1000
+
+/* Minimum interval between two updates of the gradual wake-up outputs (ms) */
+#define ALARM_VOLUME_UPDATE_INTERVAL    100
+#define ALARM_LIGHT_UPDATE_INTERVAL     30
+
+/* Audio ring buffer, filled with whole SD card sectors */
+#define ALARM_RING_SECTOR_SIZE      512
+#define ALARM_RING_SECTORS          2
 
 
 
+/*******************************************************************************
+ *
+ * @brief   Audio playback statistics of the last alarm
+ *
+ *******************************************************************************/
+struct AlarmAudioStats {
+    uint32_t count;             /* Number of alarms played since boot */
+    uint32_t underruns;         /* Codec data requests while the ring was empty */
+    uint32_t bytes;             /* Bytes sent to the codec */
+    uint32_t duration;          /* Time spent playing, snooze excluded (ms) */
+    uint16_t startLatency;      /* Alarm trigger to first decoded frame (ms), 0 if not decoded */
+    uint16_t decodeTime;        /* Codec decode time (s) */
+    uint16_t byteRate;          /* Stream bitrate reported by the codec (bytes/s) */
+    uint16_t hdat0;             /* Stream header data */
+    uint16_t hdat1;             /* Stream format */
+};
+
+
 /*******************************************************************************
  *
  * @brief   Load/save alarm profiles and play alarm sound on set time.
@@ -101,19 +136,54 @@ class Alarm : private VS1053 {
     bool isPlaying();
     uint8_t getPlayMode();
     bool isAlarmEnabled();
+    void clearAudioStats();
+    void onDataRequest();
+    uint16_t getFifoMinLevel();
+    uint32_t getUnderruns();
+    uint32_t getBytesSent();
+    uint32_t getInterruptFeeds();
+    uint32_t getAudioDataRate();
+    const char *getAudioFormatName();
+
+    /* Gets the audio playback statistics of the last alarm. */
+    const AlarmAudioStats *getAudioStats()  { return &_audioStats; }
+
+    /* Gets the number of sectors read from the alarm sound file. */
+    uint32_t getSectorReads()               { return _sectorReads; }
+
+    /* Gets the number of volume and brightness writes of the gradual wake-up. */
+    uint32_t getGradualWrites()             { return _volumeEnvelope.getWrites() + _lampEnvelope.getWrites() + 
+                                                     _clockEnvelope.getWrites(); }
+
+    /* Gets the number of intermediate volume and brightness values coalesced. */
+    uint32_t getGradualWritesSaved()        { return _volumeEnvelope.getWritesSaved() + _lampEnvelope.getWritesSaved() + 
+                                                     _clockEnvelope.getWritesSaved(); }
+
     struct AlarmProfile profile;
     FsFile currentFile;
     
 
 
   private:
+#ifdef NATIVE
+    friend class BenchAccess;   /* Host benchmarks (bench/) */
+#endif
+
+
     void feedBuffer();
+    void feedCodec( uint8_t max_blocks );
+    void fillSector( uint8_t sector );
+    void resetRing();
+    void beginAudioStats();
+    void updateAudioStats();
+    void pollAudioStats();
+    void endAudioStats();
     void visualStart();
-    void visualStep();
     void visualStop();
+    void processGradual();
+    uint32_t getGradualDuration();
     void audioStop();
     void audioStart();
-    inline void updateVisualStepDelay();
     void initAmplifier();
 
     
@@ -125,19 +195,40 @@ class Alarm : private VS1053 {
     unsigned long _alarmStart = 0;
     unsigned long _snoozeStart = 0;
     uint16_t _playDelay = 0;
-    uint16_t _visualStepDelay = 0;
-    uint8_t _visualStepValue = 0;
-    bool _visualStepReverse = false;
     bool _sd_present = false;
     bool _alarm_sw_on = false;
     uint8_t _playMode = ALARM_MODE_OFF;
     uint8_t _volume = 0;
+    Envelope _volumeEnvelope;                                       /* Gradual wake-up of the codec volume */
+    Envelope _lampEnvelope;                                         /* Gradual wake-up of the lamp brightness */
+    Envelope _clockEnvelope;                                        /* Gradual wake-up of the clock brightness */
     uint16_t _pgm_audio_ptr = 0;
+    volatile uint16_t _ringLength[ ALARM_RING_SECTORS ] = { 0 };    /* Bytes in each sector, 0 if empty */
+    volatile uint16_t _ringPosition = 0;                            /* Position in the sector being sent */
+    volatile uint8_t _ringSector = 0;                               /* Sector being sent */
+    volatile bool _feeding = false;                                 /* Codec being fed (main loop or interrupt) */
+    volatile bool _fifoFilled = false;                              /* Codec FIFO was full at least once */
+    volatile uint16_t _fifoMaxFree = 0;                             /* Largest free space in the FIFO when fed */
+    volatile uint32_t _underruns = 0;
+    volatile uint32_t _bytesSent = 0;
+    volatile uint32_t _interruptFeeds = 0;
+    uint32_t _sectorReads = 0;
+    AlarmAudioStats _audioStats = {};
+    bool _audioStatsActive = false;                                 /* Collecting statistics for the current alarm */
+    bool _audioLatencyPending = false;                              /* Waiting for the first decoded frame */
+    uint32_t _audioUnderrunsStart = 0;                              /* Underruns when the alarm was triggered */
+    uint32_t _audioBytesStart = 0;                                  /* Bytes sent when the alarm was triggered */
+    uint32_t _audioPlayTime = 0;                                    /* Time played before the last snooze (ms) */
+    unsigned long _audioPlayStart = 0;                              /* Start of the current playback, 0 if stopped */
+    unsigned long _audioStatsPoll = 0;                              /* Last codec status poll */
     SDCardManager* _sdcard;
-    FsFile _rootDir;
+    int16_t _soundIndexPos = -1;                                    /* Position of the current file in the sound index */
+    uint32_t _soundDataOffset = 0;                                  /* Offset of the audio data in the current file */
     TPA2016 _amplifier;
 };
 
+void isr_vs1053_dreq();
+
 extern Alarm g_alarm;
 
 #endif /* ALARM_H */
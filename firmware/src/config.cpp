@@ -52,6 +52,8 @@ void ConfigManager::load( uint8_t section ) {
         return;
     }
 
+    this->upgradeEeprom();
+
     if( section & EEPROM_SECTION_CLOCK ) {
 
         for( c = 0; c < sizeof( ClockSettings ); c++ ) {
@@ -88,6 +90,7 @@ void ConfigManager::save( uint8_t section ) {
     /* Save valid config magic number (0xBEEF) */
     EEPROM.update( EEPROM_ADDR_MAGIC + 0, 0xEF );
     EEPROM.update( EEPROM_ADDR_MAGIC + 1, 0xBE );
+    EEPROM.update( EEPROM_ADDR_LAYOUT_VER, EEPROM_LAYOUT_VERSION );
 
     if( section & EEPROM_SECTION_CLOCK ) {
 
@@ -188,6 +191,7 @@ void ConfigManager::reset() {
     profile.visualMode = ALARM_VISUAL_NONE;
     profile.effectSpeed = 5;
     profile.gradual = false;
+    profile.gradualTime = 1;
     profile.dow = 0x7F;
 
     profile.lamp.brightness = 60;
@@ -241,6 +245,49 @@ void ConfigManager::formatEeprom() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Convert the settings stored by a previous firmware to the current
+ *          EEPROM layout.
+ * 
+ * @details The profiles are stored one after the other, a larger profile 
+ *          structure moves every profile but the first one. Profiles are
+ *          moved starting from the last one so the source is never
+ *          overwritten before it is read.
+ * 
+ */
+void ConfigManager::upgradeEeprom() {
+
+    uint8_t version = EEPROM.read( EEPROM_ADDR_LAYOUT_VER );
+
+    if( version == EEPROM_LAYOUT_VERSION ) {
+        return;
+    }
+
+    /* Erased byte (0xFF) on the firmwares without a layout version */
+    if( version > EEPROM_LAYOUT_VERSION ) {
+        version = 0;
+    }
+
+    if( version == 0 ) {
+        const uint8_t oldSize = offsetof( struct AlarmProfile, gradualTime );
+
+        for( int8_t id = MAX_NUM_PROFILES - 1; id >= 0; id-- ) {
+            struct AlarmProfile profile;
+
+            for( uint8_t i = 0; i < oldSize; i++ ) {
+                *((( uint8_t* )&profile ) + i ) = EEPROM.read( EEPROM_ADDR_PROFILES + ( id * oldSize ) + i );
+            }
+
+            profile.gradualTime = MIN_ALARM_GRADUAL_TIME;
+            g_alarm.saveProfile( &profile, id );
+        }
+    }
+
+    EEPROM.update( EEPROM_ADDR_LAYOUT_VER, EEPROM_LAYOUT_VERSION );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Run tasks for the configuration manager.
@@ -251,16 +298,24 @@ void ConfigManager::runTasks() {
     switch( this->getCurrentTask() ) {
 
         case TASK_CONFIG_BACKUP:
-            if( this->writeNextLine() == false ) {
-                this->endBackup();
-            }
+            do {
+                if( this->writeNextLine() == false ) {
+                    this->endBackup();
+                    break;
+                }
+
+            } while( this->budgetRemaining() == true );
 
             break;
 
         case TASK_CONFIG_RESTORE:
-            if( this->readNextLine() == false ) {
-                this->endRestore();
-            }
+            do {
+                if( this->readNextLine() == false ) {
+                    this->endRestore();
+                    break;
+                }
+
+            } while( this->budgetRemaining() == true );
 
             break;
 
@@ -273,6 +328,18 @@ void ConfigManager::runTasks() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if a backup or restore task is running.
+ *
+ * @return  TRUE if the manager needs to run, FALSE otherwise.
+ * 
+ */
+bool ConfigManager::hasPendingWork() {
+    return this->isBusy();
+}
+
+
 /*******************************************************************************
  *
  * @brief   Starts the configuration backup task.
@@ -588,6 +655,10 @@ bool ConfigManager::readNextLine() {
     } else if( this->matchSettingName( name, SETTING_NAME_GRADUAL, SECTION_ID_ALARM ) == true ) {
         this->parseSettingValue( value, &g_alarm.profile.gradual, SETTING_TYPE_BOOL );
 
+    } else if( this->matchSettingName( name, SETTING_NAME_GRADUAL_TIME, SECTION_ID_ALARM ) == true ) {
+        this->parseSettingValue( value, &g_alarm.profile.gradualTime, SETTING_TYPE_INTEGER,
+                                 MIN_ALARM_GRADUAL_TIME, MAX_ALARM_GRADUAL_TIME );
+
     } else if( this->matchSettingName( name, SETTING_NAME_DOW, SECTION_ID_ALARM ) == true ) {
         this->parseSettingValue( value, &g_alarm.profile.dow, SETTING_TYPE_DOW );
 
@@ -1016,6 +1087,10 @@ bool ConfigManager::writeNextLine()  {
             this->writeConfigLine( SETTING_NAME_GRADUAL, SETTING_TYPE_BOOL, &g_alarm.profile.gradual );
             break;
 
+        case SETTING_ID_ALARM_GRADUAL_TIME:
+            this->writeConfigLine( SETTING_NAME_GRADUAL_TIME, SETTING_TYPE_INTEGER, &g_alarm.profile.gradualTime );
+            break;
+
         case SETTING_ID_ALARM_DOW:
             this->writeConfigLine( SETTING_NAME_DOW, SETTING_TYPE_DOW, &g_alarm.profile.dow );
             break;
@@ -67,6 +67,8 @@
 #define MAX_ALARM_VOLUME                100
 #define MIN_ALARM_VISUAL_EFFECT_SPEED   1
 #define MAX_ALARM_VISUAL_EFFECT_SPEED   10
+#define MIN_ALARM_GRADUAL_TIME          1
+#define MAX_ALARM_GRADUAL_TIME          30
 #define MAX_TZ_NAME_LENGTH              40
 #define MAX_MQTT_HOST_LENGTH            64
 #define MAX_MQTT_USERNAME_LENGTH        32
@@ -77,11 +79,22 @@
 
 /* EEPROM addresses */
 #define EEPROM_ADDR_MAGIC               0
+#define EEPROM_ADDR_LAYOUT_VER          2
 #define EEPROM_ADDR_FIRMWARE_VER        4
 #define EEPROM_ADDR_CLOCK_CONFIG        10
 #define EEPROM_ADDR_NETWORK_CONFIG      EEPROM_ADDR_CLOCK_CONFIG + ( sizeof( ClockSettings ) )
 #define EEPROM_ADDR_PROFILES            EEPROM_ADDR_NETWORK_CONFIG + ( sizeof( NetworkSettings ) )
 
+/* EEPROM layout version, increment when the size of a settings structure changes.
+   Version 0 : alarm profiles without 'gradualTime'
+
+   The firmwares before the layout version never wrote EEPROM_ADDR_LAYOUT_VER,
+   nor EEPROM_ADDR_FIRMWARE_VER, so neither can identify them. The byte is 
+   assumed to be erased (0xFF) on those boards. Any value other than the 
+   current version is read as version 0. A board where other code left it
+   at 1 would skip the migration, and needs a 'factory reset'. */
+#define EEPROM_LAYOUT_VERSION           1
+
 /* EEPROM settings sections */
 #define EEPROM_SECTION_CLOCK            0x01
 #define EEPROM_SECTION_NETWORK          0x02
@@ -135,6 +148,7 @@ PROG_STR( SETTING_NAME_DOW,                 "dow" );
 PROG_STR( SETTING_NAME_FILENAME,            "filename" );
 PROG_STR( SETTING_NAME_MESSAGE,             "message" );
 PROG_STR( SETTING_NAME_GRADUAL,             "gradual" );
+PROG_STR( SETTING_NAME_GRADUAL_TIME,        "gradual-time" );
 PROG_STR( SETTING_NAME_VISUAL_MODE,         "effect-mode" );
 PROG_STR( SETTING_NAME_VISUAL_SPEED,        "effect-speed" );
 PROG_STR( SETTING_NAME_DHCP,                "dhcp" );
@@ -213,6 +227,7 @@ enum {
     SETTING_ID_ALARM_SNOOZE,
     SETTING_ID_ALARM_VOLUME,
     SETTING_ID_ALARM_GRADUAL,
+    SETTING_ID_ALARM_GRADUAL_TIME,
     SETTING_ID_ALARM_DOW,
     SETTING_ID_ALARM_MESSAGE,
     SETTING_ID_ALARM_VISUAL,
@@ -278,6 +293,7 @@ struct AlarmProfile {
     struct Time time;
     uint8_t dow = 0x7F;
     struct NightLampSettings lamp;
+    uint8_t gradualTime = 1;            /* Length of the gradual wake-up (minutes) */
 };
 
 /* Clock settings */
@@ -342,18 +358,24 @@ class ConfigManager : public ITask {
     void endBackup( int error = TASK_SUCCESS );
     void endRestore( int error = TASK_SUCCESS );
     void runTasks();
+    bool hasPendingWork();
 
     ClockSettings clock;        /* Clock settings */
     NetworkSettings network;    /* Network settings */
 
 
   private:
+#ifdef NATIVE
+    friend class BenchAccess;   /* Host benchmarks (bench/) */
+#endif
+
     bool writeNextLine();
     void writeConfigLine( const char* name, uint8_t type, void* value );
     bool readNextLine();
     uint8_t parseConfigLine( char* name, char* value );
     void parseSettingValue( char* src, void* dest, uint8_t type, uint8_t min = 0, uint8_t max = 255 );
     bool matchSettingName( char* testName, const char* name, uint8_t section );
+    void upgradeEeprom();
 
     uint8_t _currentSettingID = 0;      /* Current settings ID read or written to config file */
     uint8_t _currentSectionID = 0;      /* Current section ID read or written to config file */
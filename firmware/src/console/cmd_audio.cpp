@@ -0,0 +1,51 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/console/cmd_audio.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <alarm.h>
+#include "console_base.h"
+
+
+
+/*******************************************************************************
+ * 
+ * @brief   Prints the audio playback statistics of the last alarm
+ * 
+ */
+void ConsoleBase::printAudioStats() {
+
+    const AlarmAudioStats *stats = g_alarm.getAudioStats();
+
+    if( stats->count == 0 ) {
+        this->println_P( S_CONSOLE_AUDIO_NONE );
+        return;
+    }
+
+    this->printfln_P( S_CONSOLE_AUDIO_COUNT, stats->count );
+
+    if( stats->startLatency > 0 ) {
+        this->printfln_P( S_CONSOLE_AUDIO_LATENCY, stats->startLatency );
+    } else {
+        this->println_P( S_CONSOLE_AUDIO_NO_LATENCY );
+    }
+
+    this->printfln_P( S_CONSOLE_AUDIO_PLAY_TIME, stats->duration / 1000, stats->duration % 1000, stats->decodeTime );
+    this->printfln_P( S_CONSOLE_AUDIO_DATA, stats->bytes, g_alarm.getAudioDataRate() );
+    this->printfln_P( S_CONSOLE_AUDIO_UNDERRUNS, stats->underruns );
+    this->printfln_P( S_CONSOLE_AUDIO_STREAM, g_alarm.getAudioFormatName(), ( uint16_t )(( stats->byteRate * 8UL ) / 1000 ),
+                      stats->hdat0, stats->hdat1 );
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/console/cmd_free.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <freemem.h>
+#include <heap_sites.h>
+#include "console_base.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts the 'free' command task. Prints the memory summary, the
+ *          call sites and the pool classes are printed by the task.
+ *
+ */
+void ConsoleBase::beginTaskPrintHeap() {
+    HeapFreeInfo info;
+    g_heap.getFreeInfo( &info );
+
+    _taskIndex = 0;
+    this->startTask( TASK_CONSOLE_PRINT_HEAP );
+
+    this->printfln_P( S_CONSOLE_FREEMEM, g_freeMemory );
+    this->printfln_P( S_CONSOLE_STACKMIN, getStackMinFree() );
+    this->printfln_P( S_CONSOLE_TOTALMEM, RAMEND - RAMSTART + 1 );
+    this->println();
+
+    this->printfln_P( S_CONSOLE_HEAP_USED, g_heap.getLiveBytes(), g_heap.getPeakBytes() );
+    this->printfln_P( S_CONSOLE_HEAP_ALLOCS, g_heap.getAllocCount(), g_heap.getFreeCount(), g_heap.getFailCount() );
+    this->printfln_P( S_CONSOLE_HEAP_FREE_LIST, info.chunks, info.freeListBytes, info.largestChunk );
+    this->printfln_P( S_CONSOLE_HEAP_LARGEST, info.largestAllocatable, info.fragmentation );
+    this->println();
+
+#if HEAPSTAT_SITE_STATS == 1
+    this->println_P( S_CONSOLE_HEAP_HEADER );
+#else
+    /* Call sites are not tracked, skip to the pool size classes */
+    _taskIndex = HEAP_SITE_COUNT;
+    this->println_P( S_CONSOLE_POOL_HEADER );
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Print the statistics of the next allocation call site or
+ *          pool size class.
+ *
+ */
+void ConsoleBase::runTaskPrintHeap() {
+
+    if( _taskIndex < HEAP_SITE_COUNT ) {
+        const HeapSiteStats *site;
+        site = g_heap.getSite( _taskIndex );
+
+        this->print_P( (const char *)pgm_read_word( &( S_HEAP_SITE_NAMES[ _taskIndex ])), 14, TEXT_ALIGN_LEFT );
+        this->printfln_P( S_CONSOLE_HEAP_ROW, site->allocs, site->bytes, site->largest, site->failures );
+
+        _taskIndex++;
+
+        if( _taskIndex == HEAP_SITE_COUNT ) {
+            this->println();
+            this->println_P( S_CONSOLE_POOL_HEADER );
+        }
+
+        return;
+    }
+
+    const MemPoolClass *cls;
+    cls = g_pool.getClass( _taskIndex - HEAP_SITE_COUNT );
+
+    this->printfln_P( S_CONSOLE_POOL_ROW, cls->blockSize, cls->blocks, cls->used, cls->peak,
+                      cls->fallbacks, cls->failures );
+
+    _taskIndex++;
+
+    if( _taskIndex >= HEAP_SITE_COUNT + g_pool.getClassCount() ) {
+        this->println();
+        this->endTask( TASK_SUCCESS );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Print the chunks in the allocator free list followed by the free
+ *          space between the heap and the stack.
+ *
+ */
+void ConsoleBase::printHeapMap() {
+    void* addr[ HEAPSTAT_MAX_MAP_CHUNKS ];
+    size_t size[ HEAPSTAT_MAX_MAP_CHUNKS ];
+    uint8_t count;
+
+    count = g_heap.getFreeMap( addr, size, HEAPSTAT_MAX_MAP_CHUNKS );
+
+    HeapFreeInfo info;
+    g_heap.getFreeInfo( &info );
+
+    this->println_P( S_CONSOLE_HEAP_MAP_HEADER );
+
+    for( uint8_t i = 0; i < count; i++ ) {
+        this->printfln_P( S_CONSOLE_HEAP_MAP_ROW, ( unsigned int )( uintptr_t )addr[ i ], size[ i ] );
+    }
+
+    this->printfln_P( S_CONSOLE_HEAP_MAP_TOP, info.topBytes );
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/console/cmd_perf.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <profiler_slots.h>
+#include <isr_events.h>
+#include <ui/screen.h>
+#include <drivers/us2066.h>
+#include <drivers/neoclock.h>
+#include <drivers/lamp.h>
+#include <alarm.h>
+#include "console_base.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts the 'perf' command task
+ *
+ */
+void ConsoleBase::beginTaskPrintPerf() {
+    _taskIndex = 0;
+
+    this->startTask( TASK_CONSOLE_PRINT_PERF );
+    this->println();
+    this->println_P( S_CONSOLE_PERF_HEADER );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Print the statistics of the next profiled service.
+ *
+ */
+void ConsoleBase::runTaskPrintPerf() {
+
+    const ProfilerSlot *slot;
+
+    if( _taskIndex < PROF_SLOT_COUNT ) {
+        slot = g_profiler.getSlot( _taskIndex );
+        this->print_P( (const char *)pgm_read_word( &( S_PROF_SLOT_NAMES[ _taskIndex ])), 11, TEXT_ALIGN_LEFT );
+
+    } else {
+        slot = g_profiler.getLoopSlot();
+        this->print_P( S_PROF_SLOT_LOOP, 11, TEXT_ALIGN_LEFT );
+    }
+
+    this->printfln_P( S_CONSOLE_PERF_ROW,
+                      ( slot->count > 0 ) ? slot->min : 0,
+                      g_profiler.getMean( slot ),
+                      slot->max,
+                      slot->hist[ 0 ], slot->hist[ 1 ], slot->hist[ 2 ],
+                      slot->hist[ 3 ], slot->hist[ 4 ], slot->hist[ 5 ] );
+
+    _taskIndex++;
+
+    if( _taskIndex > PROF_SLOT_COUNT ) {
+        this->println();
+        this->printfln_P( S_CONSOLE_PERF_LOOPS, g_profiler.getLoopCount() );
+        this->printfln_P( S_CONSOLE_PERF_BUDGET, g_profiler.getOverBudgetCount(), g_profiler.getBudget() );
+        this->printfln_P( S_CONSOLE_PERF_IDLE, g_scheduler.getIdleTime(), g_scheduler.getIdlePercent() );
+        this->printfln_P( S_CONSOLE_PERF_DISPATCH, g_scheduler.getDispatchCount(), g_scheduler.getSkipCount() );
+
+        this->println();
+        this->println_P( S_CONSOLE_PERF_ISR_HEADER );
+
+        for( uint8_t i = 0; i < ISR_EVENT_SOURCE_COUNT; i++ ) {
+            EventSourceStats stats;
+            g_events.getStats( i, &stats );
+
+            this->print_P( (const char *)pgm_read_word( &( S_ISR_EVENT_NAMES[ i ])), 11, TEXT_ALIGN_LEFT );
+            this->printfln_P( S_CONSOLE_PERF_ISR_ROW, stats.count, stats.overflows, 
+                              g_events.getMeanLatency( i ), stats.latencyMax );
+        }
+
+        this->printfln_P( S_CONSOLE_PERF_QUEUE, g_events.getPending(), g_events.getPeak(), EVENT_QUEUE_SIZE - 1 );
+        this->printfln_P( S_CONSOLE_PERF_LCD, g_lcd.getFrameCount(), g_lcd.getLastFrameTransactions(), 
+                          g_lcd.getMaxFrameTransactions() );
+        this->printfln_P( S_CONSOLE_PERF_CGRAM, g_lcd.getGlyphUploads(), g_lcd.getGlyphSkips() );
+        this->printfln_P( S_CONSOLE_PERF_I2C, g_twi.getCount(), g_twi.getErrors(), g_twi.getPeak(), 
+                          TWI_QUEUE_SIZE - 1, g_twi.getBlockingTime() );
+        this->printfln_P( S_CONSOLE_PERF_I2C_BYTES, g_twi.getByteCount(), g_twi.getByteRate() );
+        this->printfln_P( S_CONSOLE_PERF_AUDIO, g_alarm.getSectorReads(), g_alarm.getUnderruns() );
+        this->printfln_P( S_CONSOLE_PERF_AUDIO_FIFO, g_alarm.getFifoMinLevel(), g_alarm.getInterruptFeeds() );
+        this->printfln_P( S_CONSOLE_PERF_GRADUAL, g_alarm.getGradualWrites(), g_alarm.getGradualWritesSaved() );
+        this->printfln_P( S_CONSOLE_PERF_NEOPIXEL, g_clock.getFramesSent(), g_clock.getFramesSkipped(),
+                          g_lamp.getFramesSent(), g_lamp.getFramesSkipped() );
+        this->printfln_P( S_CONSOLE_PERF_FX_CLOCK, g_clock.getEffect()->getFrameCount(), g_clock.getEffect()->getLateFrames(),
+                          g_clock.getEffect()->getMeanJitter(), g_clock.getEffect()->getMaxJitter() );
+        this->printfln_P( S_CONSOLE_PERF_FX_LAMP, g_lamp.getEffect()->getFrameCount(), g_lamp.getEffect()->getLateFrames(),
+                          g_lamp.getEffect()->getMeanJitter(), g_lamp.getEffect()->getMaxJitter() );
+
+        this->endTask( TASK_SUCCESS );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Print the keypress to display latency histogram of each screen.
+ *
+ */
+void ConsoleBase::printKeyLatency() {
+
+    const ProfilerSlot *slot;
+    uint8_t screenId;
+
+    this->println();
+
+    if( g_screen.getKeyLatency( 0, &screenId ) == nullptr ) {
+        this->println_P( S_CONSOLE_PERF_UI_EMPTY );
+        return;
+    }
+
+    this->println_P( S_CONSOLE_PERF_UI_HEADER );
+
+    for( uint8_t i = 0; ( slot = g_screen.getKeyLatency( i, &screenId )) != nullptr; i++ ) {
+
+        if( screenId == SCREEN_LATENCY_ID_OTHER ) {
+            this->print_P( S_CONSOLE_PERF_UI_OTHER );
+        } else {
+            this->printf_P( S_CONSOLE_PERF_UI_ID, screenId );
+        }
+
+        this->printfln_P( S_CONSOLE_PERF_UI_ROW,
+                          slot->count, slot->min,
+                          g_profiler.getMean( slot ),
+                          slot->max,
+                          slot->hist[ 0 ], slot->hist[ 1 ], slot->hist[ 2 ],
+                          slot->hist[ 3 ], slot->hist[ 4 ], slot->hist[ 5 ] );
+    }
+}
\ No newline at end of file
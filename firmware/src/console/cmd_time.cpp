@@ -350,7 +350,7 @@ bool ConsoleBase::beginTaskSetTimeZone() {
 void ConsoleBase::runTaskSetTimeZone() {
     int16_t zone_id;
     
-    if( param_tz_name > 0 ) {
+    if( param_tz_name != nullptr ) {
         
         zone_id = findTimezoneByName( param_tz_name );
 
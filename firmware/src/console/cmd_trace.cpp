@@ -0,0 +1,100 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/console/cmd_trace.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <trace_events.h>
+#include "console_base.h"
+
+#if TRACER_ENABLED == 1
+
+/* Number of events sent per pass */
+#define TRACE_DUMP_EVENTS_PER_PASS  8
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Print the number of events in the trace buffer.
+ *
+ */
+void ConsoleBase::printTraceStatus() {
+    this->printfln_P( S_CONSOLE_TRACE_STATUS, g_tracer.getCount(), TRACE_BUFFER_SIZE, 
+                      g_tracer.getOverwritten() );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts the 'trace dump' command task. Recording is paused and
+ *          the dump header is sent. The events are sent by the task.
+ * 
+ * @details Binary format (little endian) : 
+ *              "TRCE", version (u8), event count (u8), overwritten (u32)
+ *          followed by each event, oldest first : 
+ *              timestamp in us (u32), event ID (u8), argument (u16)
+ *
+ */
+void ConsoleBase::beginTaskTraceDump() {
+    uint32_t overwritten;
+
+    g_tracer.pause( true );
+
+    _taskIndex = 0;
+    this->startTask( TASK_CONSOLE_TRACE_DUMP );
+
+    this->print_P( PSTR( TRACE_DUMP_MAGIC ));
+    this->print(( char )TRACE_DUMP_VERSION );
+    this->print(( char )g_tracer.getCount() );
+
+    overwritten = g_tracer.getOverwritten();
+    for( uint8_t i = 0; i < 4; i++ ) {
+        this->print(( char )( overwritten >> ( i * 8 )));
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send the next events of the trace buffer.
+ *
+ */
+void ConsoleBase::runTaskTraceDump() {
+    TraceEntry entry;
+
+    for( uint8_t i = 0; i < TRACE_DUMP_EVENTS_PER_PASS; i++ ) {
+
+        if( g_tracer.getEntry( _taskIndex, &entry ) == false ) {
+            g_tracer.pause( false );
+
+            this->println();
+            this->endTask( TASK_SUCCESS );
+            return;
+        }
+
+        for( uint8_t n = 0; n < 4; n++ ) {
+            this->print(( char )( entry.time >> ( n * 8 )));
+        }
+
+        this->print(( char )entry.id );
+        this->print(( char )( entry.arg & 0xFF ));
+        this->print(( char )( entry.arg >> 8 ));
+
+        _taskIndex++;
+    }
+}
+
+#endif /* TRACER_ENABLED */
\ No newline at end of file
@@ -21,6 +21,10 @@
 #include <services/ntpclient.h>
 #include <services/ftpserver.h>
 #include <freemem.h>
+#include <profiler_slots.h>
+#include <isr_events.h>
+#include <ui/screen.h>
+#include <alarm.h>
 #include "console_base.h"
 
 
@@ -565,17 +569,26 @@ void ConsoleBase::parseCommand() {
     } else if( this->matchCommandName( S_COMMAND_CLEAR, false ) == true ) {
         this->clearScreen();
 
+    /* 'free map' command */
+    } else if( this->matchCommandName( S_COMMAND_FREE_MAP, false ) == true ) {
+        this->printHeapMap();
+        this->println();
+
     /* 'free' command */
     } else if( this->matchCommandName( S_COMMAND_FREE, false ) == true ) {
-        this->printfln_P( S_CONSOLE_FREEMEM, g_freeMemory );
-        this->printfln_P( S_CONSOLE_TOTALMEM, RAMEND - RAMSTART + 1 );
-        this->println();
+        this->beginTaskPrintHeap();
+        started = true;
 
     /* 'batt status' command */
     } else if( this->matchCommandName( S_COMMAND_BATT_STATUS, false ) == true ) {
          this->printBattStatus();
          this->println();
 
+    /* 'audio stats' command */
+    } else if( this->matchCommandName( S_COMMAND_AUDIO_STATS, false ) == true ) {
+        this->printAudioStats();
+        this->println();
+
     /* 'logs' command */
     } else if( this->matchCommandName( S_COMMAND_LOGS, false ) == true ) {
          this->beginTaskPrintLogs();
@@ -606,6 +619,47 @@ void ConsoleBase::parseCommand() {
         g_ftpServer.printServerStatus( this );
         this->println();
 
+    /* 'perf reset' command */
+    } else if( this->matchCommandName( S_COMMAND_PERF_RESET, false ) == true ) {
+        g_profiler.reset();
+        g_events.clearStats();
+        g_twi.clearStats();
+        g_clock.clearStats();
+        g_lamp.clearStats();
+        g_alarm.clearAudioStats();
+        g_screen.resetKeyLatency();
+        this->println_P( S_CONSOLE_PERF_RESET );
+        this->println();
+
+    /* 'perf ui' command */
+    } else if( this->matchCommandName( S_COMMAND_PERF_UI, false ) == true ) {
+        this->printKeyLatency();
+        this->println();
+
+    /* 'perf' command */
+    } else if( this->matchCommandName( S_COMMAND_PERF, false ) == true ) {
+        this->beginTaskPrintPerf();
+        started = true;
+
+#if TRACER_ENABLED == 1
+    /* 'trace clear' command */
+    } else if( this->matchCommandName( S_COMMAND_TRACE_CLEAR, false ) == true ) {
+        g_tracer.clear();
+        g_tracer.pause( false );
+        this->println_P( S_CONSOLE_TRACE_CLEARED );
+        this->println();
+
+    /* 'trace dump' command */
+    } else if( this->matchCommandName( S_COMMAND_TRACE_DUMP, false ) == true ) {
+        this->beginTaskTraceDump();
+        started = true;
+
+    /* 'trace' command */
+    } else if( this->matchCommandName( S_COMMAND_TRACE, false ) == true ) {
+        this->printTraceStatus();
+        this->println();
+#endif
+
     /* No command entered, display the prompt again. */
     } else if( strlen( _inputBuffer ) == 0 ) {
 
@@ -736,6 +790,20 @@ void ConsoleBase::runTasks() {
             case TASK_CONSOLE_PRINT_JULIETTE_ANSI:
                 this->runTaskPrintJulietteANSI();
                 break;
+
+            case TASK_CONSOLE_PRINT_PERF:
+                this->runTaskPrintPerf();
+                break;
+
+            case TASK_CONSOLE_PRINT_HEAP:
+                this->runTaskPrintHeap();
+                break;
+
+#if TRACER_ENABLED == 1
+            case TASK_CONSOLE_TRACE_DUMP:
+                this->runTaskTraceDump();
+                break;
+#endif
         }
 
         /* If task is done, displays the prompt and reset input buffer */
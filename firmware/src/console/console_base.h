@@ -51,6 +51,9 @@ enum consoleTaskIds {
     TASK_CONSOLE_MQTT_ENABLE,
     TASK_CONSOLE_MQTT_DISABLE,
     TASK_CONSOLE_PRINT_JULIETTE_ANSI,
+    TASK_CONSOLE_PRINT_PERF,
+    TASK_CONSOLE_PRINT_HEAP,
+    TASK_CONSOLE_TRACE_DUMP,
 };
 
 /* Accepted commands */ 
@@ -77,16 +80,24 @@ PROG_STR( S_COMMAND_NET_PING,         "net ping" );   /* alias of "ping" */
 PROG_STR( S_COMMAND_NSLOOKUP,         "nslookup" );
 PROG_STR( S_COMMAND_PING,             "ping" );
 PROG_STR( S_COMMAND_FREE,             "free" );
+PROG_STR( S_COMMAND_FREE_MAP,         "free map" );
 PROG_STR( S_COMMAND_SETTING_BACKUP,   "config backup" );
 PROG_STR( S_COMMAND_SETTING_RESTORE,  "config restore" );
 PROG_STR( S_COMMAND_FACTORY_RESET,    "factory reset" );
 PROG_STR( S_COMMAND_BATT_STATUS,      "batt status");
+PROG_STR( S_COMMAND_AUDIO_STATS,      "audio stats");
 PROG_STR( S_COMMAND_MQTT_ENABLE,      "mqtt enable");
 PROG_STR( S_COMMAND_MQTT_DISABLE,     "mqtt disable");
 PROG_STR( S_COMMAND_MQTT_STATUS,      "mqtt status");
 PROG_STR( S_COMMAND_MQTT_SEND,        "mqtt send");
 PROG_STR( S_COMMAND_JULIETTE,         "juliette");
 PROG_STR( S_COMMAND_FTP_STATUS,       "ftp status");
+PROG_STR( S_COMMAND_PERF,             "perf");
+PROG_STR( S_COMMAND_PERF_RESET,       "perf reset");
+PROG_STR( S_COMMAND_PERF_UI,          "perf ui");
+PROG_STR( S_COMMAND_TRACE,            "trace");
+PROG_STR( S_COMMAND_TRACE_DUMP,       "trace dump");
+PROG_STR( S_COMMAND_TRACE_CLEAR,      "trace clear");
 
 /* Command descriptions */ 
 PROG_STR( S_HELP_HELP,                "Display this message." );
@@ -107,11 +118,18 @@ PROG_STR( S_HELP_SETTING_BACKUP,      "Save settings to a file on the SD card."
 PROG_STR( S_HELP_SETTING_RESTORE,     "Restore settings from a file on the SD card." );
 PROG_STR( S_HELP_FACTORY_RESET,       "Restore settings to their default values." );
 PROG_STR( S_HELP_BATT_STATUS,         "Get the battery health status" );
+PROG_STR( S_HELP_AUDIO_STATS,         "Show the audio playback statistics of the last alarm" );
 PROG_STR( S_HELP_MQTT_ENABLE,         "Enable the MQTT client" );
 PROG_STR( S_HELP_MQTT_DISABLE,        "Disable the MQTT client" );
 PROG_STR( S_HELP_MQTT_STATUS,         "Display the client connection status" );
 PROG_STR( S_HELP_MQTT_SEND_TOPIC,     "Send a message" );
 PROG_STR( S_HELP_FTP_STATUS,          "Show FTP server status" );
+PROG_STR( S_HELP_PERF,                "Show the time spent by each service in the main loop" );
+PROG_STR( S_HELP_PERF_RESET,          "Clear the main loop statistics" );
+PROG_STR( S_HELP_PERF_UI,             "Show the keypress to display latency of each screen" );
+PROG_STR( S_HELP_TRACE,               "Show the number of events in the trace buffer" );
+PROG_STR( S_HELP_TRACE_DUMP,          "Send the trace buffer in binary format" );
+PROG_STR( S_HELP_TRACE_CLEAR,         "Clear the trace buffer and resume recording" );
 
 /* Commands usage */ 
 PROG_STR( S_USAGE_NSLOOKUP,           "nslookup [hostname]" );
@@ -120,7 +138,7 @@ PROG_STR( S_USAGE_SERVICE,            "service [name] (enable|disable|status)" )
 PROG_STR( S_USAGE_MQTT_SEND,          "mqtt send [topic] [payload]" );
 
 /* Commands listed on the help menu */
-#define CONSOLE_HELP_MENU_ITEMS       23
+#define CONSOLE_HELP_MENU_ITEMS       30
 const char* const S_COMMANDS[] PROGMEM = {
     S_COMMAND_HELP,
     S_COMMAND_DATE,
@@ -139,12 +157,21 @@ const char* const S_COMMANDS[] PROGMEM = {
     S_COMMAND_SETTING_RESTORE,
     S_COMMAND_FACTORY_RESET,
     S_COMMAND_BATT_STATUS,
+    S_COMMAND_AUDIO_STATS,
     S_COMMAND_REBOOT,
     S_COMMAND_MQTT_ENABLE,
     S_COMMAND_MQTT_DISABLE,
     S_COMMAND_MQTT_STATUS,
     S_COMMAND_MQTT_SEND,
     S_COMMAND_FTP_STATUS,
+    S_COMMAND_PERF,
+    S_COMMAND_PERF_RESET,
+    S_COMMAND_PERF_UI,
+#if TRACER_ENABLED == 1
+    S_COMMAND_TRACE,
+    S_COMMAND_TRACE_DUMP,
+    S_COMMAND_TRACE_CLEAR,
+#endif
 };
 const char* const S_HELP_COMMANDS[] PROGMEM = {
     S_HELP_HELP,
@@ -164,12 +191,21 @@ const char* const S_HELP_COMMANDS[] PROGMEM = {
     S_HELP_SETTING_RESTORE,
     S_HELP_FACTORY_RESET,
     S_HELP_BATT_STATUS,
+    S_HELP_AUDIO_STATS,
     S_HELP_REBOOT,
     S_HELP_MQTT_ENABLE,
     S_HELP_MQTT_DISABLE,
     S_HELP_MQTT_STATUS,
     S_HELP_MQTT_SEND_TOPIC,
     S_HELP_FTP_STATUS,
+    S_HELP_PERF,
+    S_HELP_PERF_RESET,
+    S_HELP_PERF_UI,
+#if TRACER_ENABLED == 1
+    S_HELP_TRACE,
+    S_HELP_TRACE_DUMP,
+    S_HELP_TRACE_CLEAR,
+#endif
 };
 
 enum ctrlSequences { 
@@ -188,7 +224,7 @@ enum ctrlSequences {
  * @brief   Console base class
  * 
  *******************************************************************************/
-class ConsoleBase : public IPrint, protected ITask {
+class ConsoleBase : public IPrint, public ITask {
 
   public:
     ConsoleBase();
@@ -209,6 +245,10 @@ class ConsoleBase : public IPrint, protected ITask {
 
 
   private:
+#ifdef NATIVE
+    friend class BenchAccess;   /* Host benchmarks (bench/) */
+#endif
+
     char _inputBuffer[ INPUT_BUFFER_LENGTH + 1 ];
     char _historyBuffer[ CMD_HISTORY_BUFFER_LENGTH + 1];
     char* _inputParameter;
@@ -299,6 +339,9 @@ class ConsoleBase : public IPrint, protected ITask {
     /* 'batt status' command */
     void printBattStatus();
 
+    /* 'audio stats' command */
+    void printAudioStats();
+
     /* 'logs' command */
     void beginTaskPrintLogs(); 
     void runTaskPrintLogs();
@@ -321,6 +364,21 @@ class ConsoleBase : public IPrint, protected ITask {
     /* Juliette */
     bool beginPrintJulietteANSI();
     void runTaskPrintJulietteANSI();
+
+    /* 'perf' command */
+    void beginTaskPrintPerf();
+    void runTaskPrintPerf();
+    void printKeyLatency();
+
+    /* 'free' command */
+    void beginTaskPrintHeap();
+    void runTaskPrintHeap();
+    void printHeapMap();
+
+    /* 'trace' command */
+    void printTraceStatus();
+    void beginTaskTraceDump();
+    void runTaskTraceDump();
 };
 
 #endif  /* CONSOLE_H */
\ No newline at end of file
@@ -146,12 +146,29 @@ void ALS::processEvents() {
         return;
     }
     
-    if( millis() - _lastIntegrationStart >= 500 ) {
+    /* Read the count from both channels (visible+ir and ir) without
+       waiting, the result is used once the transaction ends. */
+    if( millis() - _lastIntegrationStart >= 500 && _channelsRead.state == TWI_STATE_IDLE ) {
 
         _lastIntegrationStart = millis();
 
+        _channelsCommand = TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | TSL2591_REG_C0DATAL;
+
+        _channelsRead.address = TSL2591_I2C_ADDR;
+        _channelsRead.txData = &_channelsCommand;
+        _channelsRead.txLength = 1;
+        _channelsRead.rxData = _channels;
+        _channelsRead.rxLength = sizeof( _channels );
+        _channelsRead.callback = NULL;
+
+        _channelsPending = g_twi.submit( &_channelsRead );
+    }
+
+    if( _channelsPending == true && _channelsRead.state == TWI_STATE_IDLE ) {
+        _channelsPending = false;
+
         /* Calculate required dimming */
-        uint8_t dimming = this->calculateAmbientDimming();
+        uint8_t dimming = ( _channelsRead.result == TWI_RESULT_OK ) ? this->calculateAmbientDimming() : _targetAmbientDimming;
 
         /* Check if the dimming value is outside stable range. */
         if( _targetAmbientDimming < ( dimming < ALS_STABLE_RANGE ? 0 : dimming - ALS_STABLE_RANGE ) || 
@@ -202,9 +219,9 @@ uint8_t ALS::calculateAmbientDimming() {
         return 0;
     }
 
-    /* Read the count from both channels (visible+ir and ir ). */
-    uint16_t vis_ir = this->readWord( TSL2591_REG_C0DATAL );
-    uint16_t ir = this->readWord( TSL2591_REG_C1DATAL );
+    /* Count from both channels (visible+ir and ir ). */
+    uint16_t vis_ir = _channels[ 1 ] << 8 | _channels[ 0 ];
+    uint16_t ir = _channels[ 3 ] << 8 | _channels[ 2 ];
 
     /* If either one of the channel overflow, no dimming required. */
     if(( vis_ir == 0xFFFF ) | ( ir == 0xFFFF )) {
@@ -272,12 +289,9 @@ uint8_t ALS::calculateAmbientDimming() {
  */
 bool ALS::writeByte( uint8_t address, uint8_t value ) {
 
-    Wire.beginTransmission( TSL2591_I2C_ADDR );
-
-    Wire.write( TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | ( address & 0x1F ) );
-    Wire.write( value );
+    uint8_t command = TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | ( address & 0x1F );
 
-    return ( Wire.endTransmission() == 0 );
+    return ( g_twi.writeRegister( TSL2591_I2C_ADDR, command, &value, 1 ) == TWI_RESULT_OK );
 }
 
 
@@ -292,13 +306,12 @@ bool ALS::writeByte( uint8_t address, uint8_t value ) {
  */
 uint8_t ALS::readByte( uint8_t address ) {
 
-    Wire.beginTransmission( TSL2591_I2C_ADDR );
-    Wire.write( TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | ( address & 0x1F ) );
-    Wire.endTransmission();
+    uint8_t command = TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | ( address & 0x1F );
+    uint8_t value = 0xFF;
 
-    Wire.requestFrom( TSL2591_I2C_ADDR, 1 );
+    g_twi.readRegister( TSL2591_I2C_ADDR, command, &value, 1 );
 
-    return Wire.read();
+    return value;
 }
 
 
@@ -312,15 +325,11 @@ uint8_t ALS::readByte( uint8_t address ) {
  * 
  */
 uint16_t ALS::readWord( uint8_t address ) {
-    Wire.beginTransmission( TSL2591_I2C_ADDR );
-    Wire.write( TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | ( address & 0x1F ) );
-    Wire.endTransmission();
-
-    Wire.requestFrom( TSL2591_I2C_ADDR, 2 );
 
-    uint8_t buffer[2];
+    uint8_t command = TSL2591_COMMAND_SELECT | TSL2591_TRANSACTION_NORMAL | ( address & 0x1F );
+    uint8_t buffer[2] = { 0xFF, 0xFF };
 
-    Wire.readBytes( buffer, sizeof( buffer ) );
+    g_twi.readRegister( TSL2591_I2C_ADDR, command, buffer, sizeof( buffer ));
 
     return buffer[1] << 8 | buffer[0];
 }
\ No newline at end of file
@@ -19,7 +19,7 @@
 #define _ALS_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "twi.h"
 #include <itask.h>
 
 
@@ -120,6 +120,10 @@ class ALS {
     uint32_t _lastValueChange;        /* Timestamp of the previous diming ammount change */
     uint8_t _currentAmbientDimming;   /* Current dimming amount */
     uint8_t _targetAmbientDimming;    /* Target dimming amount */
+    TwiTransaction _channelsRead;     /* Channels data read transaction */
+    uint8_t _channelsCommand;         /* Command byte of the channels read */
+    uint8_t _channels[ 4 ];           /* Channels data (C0DATAL - C1DATAH) */
+    bool _channelsPending = false;    /* Channels data read is queued */
 };
 
 
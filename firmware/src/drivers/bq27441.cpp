@@ -89,6 +89,63 @@ bool BQ27441::begin( uint16_t capacity ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Poll the flags and average power registers in the background. 
+ *          Each register is read in its own transaction, at least one 
+ *          loop apart to give the monitor time between the transactions.
+ * 
+ */
+void BQ27441::processEvents() {
+    if( _init == false ) {
+        return;
+    }
+
+    if( _poll.state != TWI_STATE_IDLE ) {
+        return;
+    }
+
+    switch( _pollStep ) {
+        case 0:
+            if( millis() - _lastPoll < BQ27441_POLL_INTERVAL ) {
+                return;
+            }
+
+            _lastPoll = millis();
+            _pollCommand = BQ27441_COMMAND_FLAGS;
+            break;
+
+        case 1:
+            if( _poll.result != TWI_RESULT_OK ) {
+                _pollStep = 0;
+                _pollValid = false;
+                return;
+            }
+
+            _flags = ( ( uint16_t ) _pollData[1] << 8 ) | _pollData[0];
+            _pollCommand = BQ27441_COMMAND_AVG_POWER;
+            break;
+
+        default:
+            _pollStep = 0;
+            _pollValid = ( _poll.result == TWI_RESULT_OK );
+            _avgPower = ( ( uint16_t ) _pollData[1] << 8 ) | _pollData[0];
+            return;
+    }
+
+    _poll.address = I2C_ADDR_BQ27441;
+    _poll.txData = &_pollCommand;
+    _poll.txLength = 1;
+    _poll.rxData = _pollData;
+    _poll.rxLength = sizeof( _pollData );
+    _poll.callback = NULL;
+
+    if( g_twi.submit( &_poll ) == true ) {
+        _pollStep++;
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   Enable config update mode.
@@ -265,7 +322,8 @@ int16_t BQ27441::getAvgCurrent() {
 
 /*******************************************************************************
  *
- * @brief   Gets the state of the battery.
+ * @brief   Gets the state of the battery. Uses the values read by 
+ *          processEvents() if available.
  *
  * @return  Value representing the current battery state
  * 
@@ -282,8 +340,17 @@ uint8_t BQ27441::getBatteryState() {
         return BATTERY_STATE_NOT_PRESENT;
     }
 
-    uint16_t flags = this->readWord( BQ27441_COMMAND_FLAGS );
-    int16_t power = this->getAvgPower();
+    uint16_t flags;
+    int16_t power;
+
+    if( _pollValid == true ) {
+        flags = _flags;
+        power = _avgPower;
+
+    } else {
+        flags = this->readWord( BQ27441_COMMAND_FLAGS );
+        power = this->getAvgPower();
+    }
 
     /* Check if battery is plugged */
     if( ( flags & BQ27441_FLAG_BAT_DET ) == 0 ) {
@@ -432,10 +499,7 @@ uint8_t BQ27441::getStateOfCharge( bool filtered ) {
 uint8_t BQ27441::write( uint8_t reg, void* data, uint8_t size ) {
     uint8_t res;
 
-    Wire.beginTransmission( I2C_ADDR_BQ27441 );
-    Wire.write( reg );
-    Wire.write( ( char* )data, size );
-    res = Wire.endTransmission( true );
+    res = g_twi.writeRegister( I2C_ADDR_BQ27441, reg, data, size );
 
     delayMicroseconds( 100 );
 
@@ -478,16 +542,8 @@ uint8_t BQ27441::write( uint8_t reg, uint8_t data ) {
 uint8_t BQ27441::read( uint8_t reg, void* data, uint8_t size ) {
     uint8_t length = 0;
 
-    Wire.beginTransmission( I2C_ADDR_BQ27441 );
-    Wire.write( reg );
-    Wire.endTransmission( true );
-
-
-    Wire.requestFrom( I2C_ADDR_BQ27441, ( int )size, true );
-
-    while( Wire.available() ) {
-        *( ( char* )data + length ) = Wire.read();
-        length++;
+    if( g_twi.readRegister( I2C_ADDR_BQ27441, reg, data, size ) == TWI_RESULT_OK ) {
+        length = size;
     }
 
     delayMicroseconds( 100 );
@@ -19,7 +19,7 @@
 #define BQ27441_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "twi.h"
 
 
 #define BQ27441_UNSEAL_KEY	            0x8000
@@ -133,6 +133,9 @@
 #define BATTERY_STATE_DISCHARGE_HALF    4
 #define BATTERY_STATE_DISCHARGE_LOW     5
 
+/* Interval between the battery state polls (ms) */
+#define BQ27441_POLL_INTERVAL           2000
+
 
 
 /*******************************************************************************
@@ -145,6 +148,7 @@ class BQ27441 {
   public:
     BQ27441();
     bool begin( uint16_t capacity );
+    void processEvents();
     bool isReady();
     bool isBatteryPresent();
     bool isCharging();
@@ -175,6 +179,15 @@ class BQ27441 {
     bool unseal();
 
     bool _init = false;     /* Class initialized */
+
+    TwiTransaction _poll = {};              /* Battery state poll transaction */
+    uint8_t _pollStep = 0;                  /* Register being polled */
+    uint8_t _pollCommand;                   /* Command byte of the poll transaction */
+    uint8_t _pollData[ 2 ];                 /* Poll transaction received word */
+    unsigned long _lastPoll = 0;            /* Time of the last battery state poll */
+    bool _pollValid = false;                /* Polled values are valid */
+    uint16_t _flags;                        /* Last polled flags */
+    int16_t _avgPower;                      /* Last polled average power (mW) */
 };
 
 
@@ -0,0 +1,181 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/drivers/envelope.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include "envelope.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Class constructor
+ *
+ * @param   interval    Minimum interval between two writes to the output (ms)
+ *
+ */
+Envelope::Envelope( uint16_t interval ) {
+    _interval = interval;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts the envelope. The output is expected to be set to the
+ *          start value by the caller.
+ *
+ * @param   from        Start value
+ * @param   to          End value
+ * @param   duration    Length of the ramp (ms)
+ * @param   curve       Envelope curve (ENVELOPE_CURVE_*)
+ * @param   table       Custom curve table (PROGMEM), ENVELOPE_TABLE_POINTS
+ *                      long. Only used with ENVELOPE_CURVE_TABLE.
+ *
+ */
+void Envelope::start( uint8_t from, uint8_t to, uint32_t duration, uint8_t curve, const uint8_t *table ) {
+
+    if( curve == ENVELOPE_CURVE_TABLE && table == nullptr ) {
+        curve = ENVELOPE_CURVE_LINEAR;
+    }
+
+    if( duration == 0 ) {
+        duration = 1;
+    }
+
+    _from = from;
+    _to = to;
+    _value = from;
+    _curve = curve;
+    _table = table;
+    _duration = duration;
+    _rate = 0xFFFFFFFFUL / duration;
+    _start = millis();
+    _lastWrite = _start;
+    _active = true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stops the envelope, the output keeps its last value.
+ *
+ */
+void Envelope::stop() {
+    _active = false;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Calculate the output value for the current time.
+ *
+ * @param   value    Pointer to the variable receiving the new output value
+ *
+ * @return  TRUE if the output must be updated, FALSE otherwise.
+ *
+ */
+bool Envelope::update( uint8_t *value ) {
+
+    if( _active == false ) {
+        return false;
+    }
+
+    uint32_t now = millis();
+    uint32_t elapsed = now - _start;
+    uint8_t next;
+
+    if( elapsed >= _duration ) {
+
+        /* End of the ramp, always written regardless of the interval */
+        next = _to;
+        _active = false;
+
+    } else {
+
+        if( now - _lastWrite < _interval ) {
+            return false;
+        }
+
+        next = this->getValue(( elapsed * _rate ) >> 16 );
+    }
+
+    if( next == _value ) {
+        return false;
+    }
+
+    uint8_t steps = ( next > _value ) ? next - _value : _value - next;
+    _writesSaved += steps - 1;
+    _writes++;
+
+    _value = next;
+    _lastWrite = now;
+
+    *value = next;
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the output value at a given position in the ramp.
+ *
+ * @param   position    Position, from 0 (start) to 0xFFFF (end)
+ *
+ * @return  Output value
+ *
+ */
+uint8_t Envelope::getValue( uint16_t position ) {
+
+    uint16_t level = this->getLevel( position );
+
+    if( _to >= _from ) {
+        return _from + ((( uint32_t )( _to - _from ) * level ) >> 16 );
+    } else {
+        return _from - ((( uint32_t )( _from - _to ) * level ) >> 16 );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Apply the envelope curve to a position in the ramp.
+ *
+ * @param   position    Position, from 0 (start) to 0xFFFF (end)
+ *
+ * @return  Level, from 0 (start value) to 0xFFFF (end value)
+ *
+ */
+uint16_t Envelope::getLevel( uint16_t position ) {
+
+    switch( _curve ) {
+        case ENVELOPE_CURVE_PERCEPTUAL:
+            return (( uint32_t )position * position ) >> 16;
+
+        case ENVELOPE_CURVE_TABLE: {
+
+            /* Interpolate between the two nearest points, 4096 positions apart.
+               The points are scaled by 257, a point at 255 is the end level. */
+            uint8_t index = position >> 12;
+            int32_t a = pgm_read_byte( &_table[ index ] );
+            int32_t b = pgm_read_byte( &_table[ index + 1 ] );
+
+            return ((( a << 12 ) + ( b - a ) * ( position & 0x0FFF )) * 257 ) >> 12;
+        }
+
+        default:
+            return position;
+    }
+}
\ No newline at end of file
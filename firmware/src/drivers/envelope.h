@@ -0,0 +1,91 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/drivers/envelope.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef ENVELOPE_H
+#define ENVELOPE_H
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+
+
+/* Envelope curves */
+#define ENVELOPE_CURVE_LINEAR       0
+#define ENVELOPE_CURVE_PERCEPTUAL   1   /* Square law, slow start for light outputs */
+#define ENVELOPE_CURVE_TABLE        2   /* Custom curve from a PROGMEM table */
+
+/* Number of points of a custom curve table, evenly spaced from 0 to 100% of
+   the duration. Each point is the level from 0 (start) to 255 (end value) */
+#define ENVELOPE_TABLE_POINTS       17
+
+
+/*******************************************************************************
+ *
+ * @brief   Ramps an output value from a start to an end value over a given
+ *          duration. The position in the ramp is a 16 bits fixed-point
+ *          fraction, calculated without any division once started.
+ *
+ *          New values are only returned when the minimum update interval
+ *          of the output is elapsed and the value changed, intermediate
+ *          values are coalesced in a single write.
+ *
+ *******************************************************************************/
+class Envelope {
+
+  public:
+    Envelope( uint16_t interval );
+    void start( uint8_t from, uint8_t to, uint32_t duration, uint8_t curve = ENVELOPE_CURVE_LINEAR,
+                const uint8_t *table = nullptr );
+    void stop();
+    bool update( uint8_t *value );
+    uint8_t getValue( uint16_t position );
+
+    /* Returns whether or not the envelope is running. */
+    bool isActive()                         { return _active; }
+
+    /* Gets the number of values written to the output. */
+    uint32_t getWrites()                    { return _writes; }
+
+    /* Gets the number of intermediate values coalesced with a later write. */
+    uint32_t getWritesSaved()               { return _writesSaved; }
+
+    /* Clears the write counters. */
+    void clearStats()                       { _writes = 0; _writesSaved = 0; }
+
+
+  private:
+    friend class BenchAccess;               /* Host benchmarks (bench/) */
+
+    uint16_t getLevel( uint16_t position );
+
+    bool _active = false;
+    uint8_t _from = 0;
+    uint8_t _to = 0;
+    uint8_t _value = 0;                     /* Last value written to the output */
+    uint8_t _curve = ENVELOPE_CURVE_LINEAR;
+    const uint8_t *_table = nullptr;        /* Custom curve table (PROGMEM) */
+    uint16_t _interval;                     /* Minimum interval between two writes (ms) */
+    uint32_t _start = 0;
+    uint32_t _duration = 0;                 /* Length of the ramp (ms) */
+    uint32_t _rate = 0;                     /* Position increment per ms, 32 bits fraction */
+    uint32_t _lastWrite = 0;
+
+    uint32_t _writes = 0;
+    uint32_t _writesSaved = 0;
+};
+
+#endif /* ENVELOPE_H */
\ No newline at end of file
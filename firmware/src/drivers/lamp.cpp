@@ -21,14 +21,40 @@
 
 
 
+/* Flashing : on/off every 2.5 sec. at speed 1 */
+static const NeoEffectFrame LAMP_EFFECT_FLASHING[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 0, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_HOLD },
+    {  2500, 0,                    0, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_HOLD },
+    {  5000, NEOEFFECT_BASE_LEVEL, 0, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_END },
+};
+
+/* Fading : from the lamp brightness down to 1/8th and back in 10 sec. at speed 1 */
+static const NeoEffectFrame LAMP_EFFECT_FADING[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 0, NEOEFFECT_BASE_COLOR, 0 },
+    {  5000, 16,                   0, NEOEFFECT_BASE_COLOR, 0 },
+    { 10000, NEOEFFECT_BASE_LEVEL, 0, NEOEFFECT_BASE_COLOR, NEOEFFECT_FLAG_END },
+};
+
+/* Rainbow : green, red, blue color wheel in 12.75 sec. at speed 1 */
+static const NeoEffectFrame LAMP_EFFECT_RAINBOW[] PROGMEM = {
+    {     0, NEOEFFECT_BASE_LEVEL, 0, COLOR_GREEN,          0 },
+    {  4250, NEOEFFECT_BASE_LEVEL, 0, COLOR_RED,            0 },
+    {  8500, NEOEFFECT_BASE_LEVEL, 0, COLOR_BLUE,           0 },
+    { 12750, NEOEFFECT_BASE_LEVEL, 0, COLOR_GREEN,          NEOEFFECT_FLAG_END },
+};
+
+
+
 /*******************************************************************************
  *
  * @brief   Class constructor
  *
  * @param   pin_leds    Pin ID connected to the nepoxel data line.
+ * @param   output      Output backend (NEOPIXEL_OUTPUT_*)
  * 
  */
-Lamp::Lamp( int8_t pin_leds ) : NeoPixel( pin_leds, -1 ) {
+Lamp::Lamp( int8_t pin_leds, uint8_t output ) : NeoPixel( pin_leds, -1, output ),
+                                                 _fadeOut( NEOEFFECT_FRAME_INTERVAL / 1000 ) {
 
 }
 
@@ -47,22 +73,12 @@ void Lamp::setBrightness( uint8_t brightness, bool force ) {
         return;
     }
 
-    if( brightness > 100 ) {
-        brightness = 100;
-    }
-
-    /* Need to update the fading speed accordingly if the brightness changes. */
-    if( _mode == LAMP_MODE_FADING ) {
-        this->updateVisualStepDelay();
-        return;
-    }
+    NeoPixel::setBrightness( brightness );
 
-    if( _mode == LAMP_MODE_FLASHING && _brightness == 0 ) {
-        return;
+    /* The effect picks up the new brightness on its next frame */
+    if( this->isEffectActive() == false ) {
+        this->update();
     }
-
-    NeoPixel::setBrightness( brightness );
-    this->update();
 }
 
 
@@ -80,10 +96,6 @@ void Lamp::setColorFromTable( uint8_t id, bool force ) {
         return;
     }
 
-    if( _mode == LAMP_MODE_RAINBOW ) {
-        return;
-    }
-    
     NeoPixel::setColorFromTable( id );
     this->update();
 }
@@ -105,37 +117,11 @@ void Lamp::setColorRGB( uint8_t r, uint8_t g, uint8_t b, bool force ) {
         return;
     }
 
-    if( _mode == LAMP_MODE_RAINBOW ) {
-        return;
-    }
-
     NeoPixel::setColorRGB( r, g, b );
     this->update();
 }
 
 
-/*******************************************************************************
- *
- * @brief   Sets the visual effect animation speed.
- *
- * @param   speed   1 (slowest), 10 (fastest)
- * 
- */
-void Lamp::setEffectSpeed( uint8_t speed ) {
-    if( speed > 10 ) {
-        speed = 10;
-    }
-
-    if( speed == 0 ) {
-        speed = 1;
-    }
-
-    _visualStepSpeed = speed;
-
-    this->updateVisualStepDelay();
-}
-
-
 /*******************************************************************************
  *
  * @brief   Sets the lamp off delay.
@@ -154,6 +140,7 @@ void Lamp::setDelayOff( uint8_t delay ) {
 
         /* Reset timer */
         _timerStart = millis();
+        _fadeOut.stop();
     }
 }
 
@@ -188,26 +175,31 @@ void Lamp::activate( struct NightLampSettings *settings, bool test_mode, bool fo
     
     _settings = settings;
     _delay_off = ( test_mode == true ) ? 0 : settings->delay_off;
-    _visualStepSpeed = settings->speed;
-    _visualStepReverse = false;
+    _fadeOut.stop();
     _timerStart = millis();
     this->setColorFromTable( settings->color, force );
     this->setBrightness( settings->brightness, force );
     _mode = mode;
 
-    this->update();
-
     switch( _mode ) {
+        case LAMP_MODE_FLASHING:
+            this->startEffect( LAMP_EFFECT_FLASHING, settings->speed );
+            break;
+
         case LAMP_MODE_FADING:
-            _visualStepValue = settings->brightness;
+            this->startEffect( LAMP_EFFECT_FADING, settings->speed );
+            break;
+
+        case LAMP_MODE_RAINBOW:
+            this->startEffect( LAMP_EFFECT_RAINBOW, settings->speed );
             break;
 
         default:
-            _visualStepValue = 0;
+            this->stopEffect();
             break;
     }
 
-    this->updateVisualStepDelay();
+    this->update();
 }
 
 
@@ -223,35 +215,6 @@ bool Lamp::isActive() {
 }
 
 
-/*******************************************************************************
- *
- * @brief   Update the visual effect animation next step delay when speed 
- *          settings changes.
- *
- */
-void Lamp::updateVisualStepDelay() {
-
-    switch( _mode ) {
-        case LAMP_MODE_FLASHING:
-            _visualStepDelay = 2500 / _visualStepSpeed;
-            break;
-
-        case LAMP_MODE_FADING:
-            _visualStepDelay = ( 25000 / _visualStepSpeed ) /
-                                     max( _settings->brightness, LAMP_MIMIMUM_FADING_BRIGHTNESS );
-            break;
-
-        case LAMP_MODE_RAINBOW:
-            _visualStepDelay = 250 / _visualStepSpeed;
-            break;
-
-        default:
-            _visualStepDelay = 0;
-            break;
-    }
-}
-
-
 /*******************************************************************************
  *
  * @brief   Turn off the lamp
@@ -266,14 +229,17 @@ void Lamp::deactivate( bool force ) {
     }
 
     _mode = LAMP_MODE_OFF;
+    _fadeOut.stop();
+    this->setDithering( false );
+    this->stopEffect();
     this->update();
 }
 
 
 /*******************************************************************************
  *
- * @brief   Check if the turn-off delay timer has elapsed and execute the 
- *          visual effect animation next step.
+ * @brief   Check if the turn-off delay timer has elapsed and render the
+ *          visual effect animation next frame.
  * 
  */
 void Lamp::processEvents() {
@@ -282,101 +248,34 @@ void Lamp::processEvents() {
         return;
     }
 
-    /* Check if the OFF delay is elapsed */
-    if( _delay_off > 0 ) {
-
-        uint32_t timerEnd;
-        timerEnd = _timerStart + ( _delay_off * 60000UL);
-
-        if( millis() >= timerEnd ) {
-
-            if( millis() >= timerEnd + 5000 ) {
-                this->deactivate( true );
-                return;
-
-            } else {
-
-                uint8_t brightness;
-                brightness = _settings->brightness - ((millis() - timerEnd) * _settings->brightness / 5000 );
-
-                if ( brightness != _brightness ) {
+    /* Check if the OFF delay is elapsed, then fade out */
+    if( _delay_off > 0 && _fadeOut.isActive() == false ) {
 
-                    _brightness = brightness;
-                    this->update();
-                }
-            }
-
-            return;
+        if( millis() - _timerStart >= _delay_off * 60000UL ) {
+            _fadeOut.start( _brightness, 0, LAMP_FADE_OUT_TIME );
+            this->setDithering( true );
         }
     }
 
-    /* Check if lamp effect is enabled */
-    if( _visualStepDelay == 0 ) {
-        return;
-    }
+    if( _fadeOut.isActive() == true ) {
 
-    /* Check if the visual effect next step delay is elapsed */
-    if( ( millis() - _timerStart ) < _visualStepDelay ) {
-        return;
-    }
+        uint8_t brightness;
+        if( _fadeOut.update( &brightness ) == true ) {
+            _brightness = brightness;
 
-
-    switch( _mode ) {
-
-
-        case LAMP_MODE_FLASHING:
-            _visualStepReverse = !_visualStepReverse;
-            _brightness = _visualStepReverse ? 0 : _settings->brightness;
-            break;
-
-
-        case LAMP_MODE_FADING:
-
-            uint8_t maxStepValue;
-            maxStepValue = max( _settings->brightness, LAMP_MIMIMUM_FADING_BRIGHTNESS );
-
-            if( _visualStepValue >= maxStepValue ) {
-                _visualStepValue = maxStepValue;
-                _visualStepReverse = true;
-            }
-
-            if( _visualStepValue <= 5 ) {
-                _visualStepReverse = false;
-            }
-
-
-            _visualStepValue += ( _visualStepReverse ? -5 : 5 );
-            _brightness = _visualStepValue;
-            break;
-
-        case LAMP_MODE_RAINBOW:
-            _visualStepValue += 5;
-
-            if( _visualStepValue < 85 ) {
-
-                _r = _visualStepValue * 3;
-                _g = 255 - _visualStepValue * 3;
-                _b = 0;
-
-            } else if( _visualStepValue < 170 ) {
-
-                _r = 255 - ( _visualStepValue - 85 ) * 3;
-                _g = 0;
-                _b = ( _visualStepValue - 85 ) * 3;
-
-            } else {
-
-                _r = 0;
-                _g = ( _visualStepValue - 170 ) * 3;
-                _b = 255 - ( _visualStepValue - 170 ) * 3;
+            if( this->isEffectActive() == false ) {
+                this->update();
             }
+        }
 
-            break;
+        if( _fadeOut.isActive() == false ) {
+            this->deactivate( true );
+            return;
+        }
     }
 
-    this->update();
-
-    _timerStart = millis();
+    /* Render the next frame of the visual effect */
+    this->processEffect();
 }
 
 
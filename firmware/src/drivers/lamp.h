@@ -22,6 +22,7 @@
 #include <Arduino.h>
 #include <config.h>
 #include "neopixel.h"
+#include "envelope.h"
 
 
 #define LAMP_MODE_NOOVERRIDE  255
@@ -32,7 +33,8 @@
 #define LAMP_MODE_RAINBOW     4
 #define LAMP_MODE_NIGHTLIGHT  5
 
-#define LAMP_MIMIMUM_FADING_BRIGHTNESS  20
+/* Length of the fade out once the off delay is elapsed (ms) */
+#define LAMP_FADE_OUT_TIME    5000
 
 
    
@@ -44,11 +46,10 @@
 class Lamp : public NeoPixel {
 
   public:
-    Lamp( int8_t pin_leds );
+    Lamp( int8_t pin_leds, uint8_t output = NEOPIXEL_OUTPUT_BITBANG );
     void setBrightness( uint8_t brightness, bool force = false );
     void setColorFromTable( uint8_t id, bool force = false );
     void setColorRGB( uint8_t r, uint8_t g, uint8_t b, bool force = false );
-    void setEffectSpeed( uint8_t speed );
     void activate( struct NightLampSettings *settings, bool test_mode = false, bool force = false, uint8_t mode = LAMP_MODE_NOOVERRIDE );
     void deactivate( bool force = false );
     void processEvents();
@@ -59,17 +60,11 @@ class Lamp : public NeoPixel {
 
 
   private:
-    void updateVisualStepDelay();
-
-
     uint8_t _delay_off = 0;
     uint8_t _mode = LAMP_MODE_OFF;
     uint32_t _timerStart = 0;
-    uint16_t _visualStepDelay = 0;
-    uint8_t _visualStepValue = 0;
-    uint8_t _visualStepSpeed = 5;
-    bool _visualStepReverse = false;
     struct NightLampSettings *_settings;
+    Envelope _fadeOut;
 };
 
 
@@ -33,9 +33,10 @@
  *
  * @param   pin_leds    Pin ID connected to the neopixel data line.
  * @param   pin_shdn    Pin ID connected to the neopixel power MOSFET.
+ * @param   output      Output backend (NEOPIXEL_OUTPUT_*)
  * 
  */
-NeoClock::NeoClock( int8_t pin_leds, int8_t pin_shdn ) : NeoPixel( pin_leds, pin_shdn ) {
+NeoClock::NeoClock( int8_t pin_leds, int8_t pin_shdn, uint8_t output ) : NeoPixel( pin_leds, pin_shdn, output ) {
 
     _flashTimerStart = millis();
 }
@@ -178,6 +179,11 @@ void NeoClock::processEvents() {
         }
     }
 
+    /* Render the next frame of the alarm visual effect */
+    if( this->isEffectActive() == true ) {
+        this->processEffect();
+    }
+
     /* Update the clock display if requested. */
     if( _updateRequested == true ) {
 
@@ -244,7 +250,7 @@ bool NeoClock::requestClockUpdate( bool force ) {
             break;
 
         case SCREEN_ID_ROOT:
-            g_screen.requestScreenUpdate( false );
+            g_screen.invalidateRegion( ROOT_REGION_DATE | ROOT_REGION_STATUS );
 
         /* Fall-through */
 
@@ -54,7 +54,7 @@ static const uint8_t PROGMEM _charmap[ 12 ] = {
 class NeoClock : public NeoPixel {
 
   public:
-    NeoClock( int8_t pin_leds, int8_t pin_shdn );
+    NeoClock( int8_t pin_leds, int8_t pin_shdn, uint8_t output = NEOPIXEL_OUTPUT_BITBANG );
     void update();
     void setTestMode( bool testMode );
     void restoreClockDisplay();
@@ -0,0 +1,274 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/drivers/neoeffect.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <resources.h>
+#include "neoeffect.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts playing an effect.
+ *
+ * @param   frames    Pointer to the effect keyframes table (PROGMEM)
+ * @param   speed     Playback speed, 1 (slowest) to 10 (fastest)
+ * 
+ */
+void NeoEffect::start( const NeoEffectFrame *frames, uint8_t speed ) {
+
+    const NeoEffectFrame *frame = frames;
+
+    /* Find the length of the effect */
+    while(( pgm_read_byte( &frame->flags ) & NEOEFFECT_FLAG_END ) == 0 ) {
+        frame++;
+    }
+
+    _frames = frames;
+    _duration = pgm_read_word( &frame->time ) * 1000UL;
+    _position = 0;
+    _lastFrame = micros();
+    _nextFrame = _lastFrame;
+
+    this->setSpeed( speed );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stops the current effect.
+ * 
+ */
+void NeoEffect::stop() {
+    _frames = nullptr;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Sets the effect playback speed. Takes effect from the current
+ *          position in the effect.
+ *
+ * @param   speed     Playback speed, 1 (slowest) to 10 (fastest)
+ * 
+ */
+void NeoEffect::setSpeed( uint8_t speed ) {
+    if( speed > 10 ) {
+        speed = 10;
+    }
+
+    if( speed == 0 ) {
+        speed = 1;
+    }
+
+    _speed = speed;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Checks if the next frame is due and advance the effect position.
+ *          Frames are scheduled at a fixed interval, the delay between the 
+ *          scheduled and the actual frame time is recorded as jitter.
+ *
+ * @return  TRUE if a new frame must be rendered, FALSE otherwise.
+ * 
+ */
+bool NeoEffect::nextFrame() {
+
+    if( _frames == nullptr ) {
+        return false;
+    }
+
+    uint32_t now = micros();
+    uint32_t jitter = now - _nextFrame;
+
+    if( ( int32_t )jitter < 0 ) {
+        return false;
+    }
+
+    /* The frame counters stop at their maximum, the jitter accumulators are
+       halved before they overflow like the loop profiler slots. */
+    if( _frameCount < UINT32_MAX ) {
+        _frameCount++;
+    }
+
+    if( _jitterCount == UINT16_MAX || _jitterSum > UINT32_MAX - jitter ) {
+        _jitterSum /= 2;
+        _jitterCount /= 2;
+    }
+
+    _jitterSum += jitter;
+    _jitterCount++;
+
+    if( jitter > _jitterMax ) {
+        _jitterMax = jitter;
+    }
+
+    /* Drop the missed frames instead of catching up */
+    if( jitter >= NEOEFFECT_FRAME_INTERVAL ) {
+        if( _lateFrames < UINT32_MAX ) {
+            _lateFrames++;
+        }
+
+        _nextFrame = now + NEOEFFECT_FRAME_INTERVAL;
+
+    } else {
+        _nextFrame += NEOEFFECT_FRAME_INTERVAL;
+    }
+
+    _position += ( now - _lastFrame ) * _speed;
+    _lastFrame = now;
+
+    if( _position >= _duration ) {
+        _position = ( _duration > 0 ) ? _position % _duration : 0;
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Calculate the brightness and color at the current position in
+ *          the effect, interpolated between the surrounding keyframes.
+ *
+ * @param   base_brightness    Base brightness of the pixel string (0-100 %)
+ * @param   base_color         Base color of the pixel string (RGB)
+ * @param   brightness         Receives the brightness (0-100 %)
+ * @param   color              Receives the color (RGB)
+ *
+ * @return  TRUE if fading between two different keyframes, FALSE if the
+ *          values are held.
+ * 
+ */
+bool NeoEffect::render( uint8_t base_brightness, const uint8_t *base_color, uint8_t *brightness, uint8_t *color ) {
+
+    const NeoEffectFrame *frame = _frames;
+
+    if( frame == nullptr ) {
+        return false;
+    }
+
+    /* Find the keyframe preceding the current position */
+    while(( pgm_read_byte( &frame[ 1 ].flags ) & NEOEFFECT_FLAG_END ) == 0 
+            && pgm_read_word( &frame[ 1 ].time ) * 1000UL <= _position ) {
+
+        frame++;
+    }
+
+    *brightness = this->getFrameLevel( frame, base_brightness );
+    this->getFrameColor( frame, base_color, color );
+
+    if( pgm_read_byte( &frame->flags ) & NEOEFFECT_FLAG_HOLD ) {
+        return false;
+    }
+
+    /* Interpolation factor between the two keyframes (0-255) */
+    uint32_t start = pgm_read_word( &frame[ 0 ].time ) * 1000UL;
+    uint32_t span = pgm_read_word( &frame[ 1 ].time ) * 1000UL - start;
+    uint16_t weight = ( span >> 4 ) > 0 ? ((( _position - start ) >> 4 ) * 256 ) / ( span >> 4 ) : 0;
+
+    if( weight > 255 ) {
+        weight = 255;
+    }
+
+    uint8_t next[ 3 ];
+    uint8_t level = this->getFrameLevel( &frame[ 1 ], base_brightness );
+    this->getFrameColor( &frame[ 1 ], base_color, next );
+
+    if( level == *brightness && memcmp( next, color, sizeof( next )) == 0 ) {
+        return false;
+    }
+
+    /* Weighted sum in 8.8 fixed point, fits in 16 bits */
+    *brightness = (( uint16_t )*brightness * ( 256 - weight ) + ( uint16_t )level * weight ) >> 8;
+
+    for( uint8_t i = 0; i < 3; i++ ) {
+        color[ i ] = (( uint16_t )color[ i ] * ( 256 - weight ) + ( uint16_t )next[ i ] * weight ) >> 8;
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Calculate the brightness of a keyframe.
+ *
+ * @param   frame              Pointer to the keyframe (PROGMEM)
+ * @param   base_brightness    Base brightness of the pixel string (0-100 %)
+ *
+ * @return  Brightness (0-100 %)
+ * 
+ */
+uint8_t NeoEffect::getFrameLevel( const NeoEffectFrame *frame, uint8_t base_brightness ) {
+
+    int16_t level = (( uint16_t )base_brightness * pgm_read_byte( &frame->scale )) >> 7;
+    level += ( int8_t )pgm_read_byte( &frame->offset );
+
+    return constrain( level, 0, 100 );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the color of a keyframe.
+ *
+ * @param   frame         Pointer to the keyframe (PROGMEM)
+ * @param   base_color    Base color of the pixel string (RGB)
+ * @param   color         Receives the color (RGB)
+ * 
+ */
+void NeoEffect::getFrameColor( const NeoEffectFrame *frame, const uint8_t *base_color, uint8_t *color ) {
+
+    uint8_t id = pgm_read_byte( &frame->color );
+
+    if( id == NEOEFFECT_BASE_COLOR || id >= COLOR_TABLE_MAX_COLORS ) {
+        memcpy( color, base_color, 3 );
+
+    } else {
+        memcpy_P( color, &_COLOR_TABLE[ id ], 3 );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Gets the mean delay between the scheduled and actual frame time,
+ *          weighted toward the recent frames once the sum was halved.
+ *
+ * @return  Mean jitter in microseconds.
+ * 
+ */
+uint32_t NeoEffect::getMeanJitter() {
+    return ( _jitterCount > 0 ) ? _jitterSum / _jitterCount : 0;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Clears the frame statistics.
+ * 
+ */
+void NeoEffect::clearStats() {
+    _frameCount = 0;
+    _lateFrames = 0;
+    _jitterSum = 0;
+    _jitterCount = 0;
+    _jitterMax = 0;
+}
\ No newline at end of file
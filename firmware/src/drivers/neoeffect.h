@@ -0,0 +1,106 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/drivers/neoeffect.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef NEOEFFECT_H
+#define NEOEFFECT_H
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+
+
+/* Minimum interval between two frames (us), caps the frame rate to ~33 fps */
+#define NEOEFFECT_FRAME_INTERVAL    30000UL
+
+/* Keyframe color using the base color of the pixel string */
+#define NEOEFFECT_BASE_COLOR        0xFF
+
+/* Keyframe brightness scale equal to the base brightness */
+#define NEOEFFECT_BASE_LEVEL        128
+
+/* Keyframe flags */
+#define NEOEFFECT_FLAG_HOLD         0x01    /* Hold the values until the next keyframe (no interpolation) */
+#define NEOEFFECT_FLAG_END          0x02    /* End of the effect, the values should match the first keyframe */
+
+
+/*******************************************************************************
+ *
+ * @brief   Effect keyframe. An effect is a PROGMEM table of keyframes
+ *          sorted by time, terminated by a keyframe with the END flag. The
+ *          effect loops once the END keyframe is reached.
+ *
+ *          The brightness of a keyframe is relative to the base brightness
+ *          of the pixel string : ( base * scale / 128 ) + offset
+ *
+ *******************************************************************************/
+struct NeoEffectFrame {
+    uint16_t time;          /* Time from the start of the effect (ms at speed 1) */
+    uint8_t scale;          /* Brightness scale (NEOEFFECT_BASE_LEVEL = base brightness) */
+    int8_t offset;          /* Brightness offset (%) */
+    uint8_t color;          /* Color table ID or NEOEFFECT_BASE_COLOR */
+    uint8_t flags;          /* Keyframe flags */
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Keyframe effect player and frame scheduler
+ *
+ *******************************************************************************/
+class NeoEffect {
+
+  public:
+    void start( const NeoEffectFrame *frames, uint8_t speed );
+    void stop();
+    void setSpeed( uint8_t speed );
+    bool nextFrame();
+    bool render( uint8_t base_brightness, const uint8_t *base_color, uint8_t *brightness, uint8_t *color );
+    uint32_t getMeanJitter();
+    void clearStats();
+
+    /* Returns whether or not an effect is playing. */
+    bool isActive()                         { return _frames != nullptr; }
+
+    /* Gets the number of frames rendered. */
+    uint32_t getFrameCount()                { return _frameCount; }
+
+    /* Gets the number of frames later than a full frame interval. */
+    uint32_t getLateFrames()                { return _lateFrames; }
+
+    /* Gets the maximum delay between the scheduled and actual frame time (us). */
+    uint32_t getMaxJitter()                 { return _jitterMax; }
+
+
+  private:
+    uint8_t getFrameLevel( const NeoEffectFrame *frame, uint8_t base_brightness );
+    void getFrameColor( const NeoEffectFrame *frame, const uint8_t *base_color, uint8_t *color );
+
+    const NeoEffectFrame *_frames = nullptr;
+    uint8_t _speed = 1;
+    uint32_t _duration = 0;                 /* Length of the effect (us at speed 1) */
+    uint32_t _position = 0;                 /* Current position in the effect (us at speed 1) */
+    uint32_t _lastFrame = 0;                /* Time of the last frame (us) */
+    uint32_t _nextFrame = 0;                /* Scheduled time of the next frame (us) */
+
+    uint32_t _frameCount = 0;
+    uint32_t _lateFrames = 0;
+    uint32_t _jitterSum = 0;
+    uint16_t _jitterCount = 0;              /* Frames in the jitter sum */
+    uint32_t _jitterMax = 0;
+};
+
+#endif /* NEOEFFECT_H */
\ No newline at end of file
@@ -20,6 +20,60 @@
 #include "neopixel.h"
 #include "power.h"
 
+#ifdef NATIVE
+#include <native.h>
+#endif
+
+
+
+/* Brightness (0-100 %) to color scaling factor. Gamma 2.2 curve with a
+   black offset, 65535 * (( b + 7.67 ) / 107.67 ) ^ 2.2, which lifts the toe
+   so that level 1 maps a full channel to 1 and each level stays distinct. */
+static const uint16_t NEOPIXEL_GAMMA_TABLE[ 101 ] PROGMEM = {
+        0,   257,   326,   405,   493,   591,   699,   816,   944,  1081,
+     1229,  1387,  1556,  1736,  1926,  2127,  2339,  2562,  2796,  3041,
+     3297,  3565,  3845,  4136,  4438,  4752,  5078,  5416,  5766,  6127,
+     6501,  6887,  7285,  7695,  8117,  8552,  8999,  9459,  9931, 10416,
+    10913, 11423, 11946, 12482, 13030, 13591, 14166, 14753, 15353, 15966,
+    16593, 17233, 17885, 18552, 19231, 19924, 20630, 21349, 22083, 22829,
+    23589, 24363, 25150, 25952, 26766, 27595, 28437, 29293, 30163, 31047,
+    31945, 32857, 33783, 34723, 35677, 36645, 37628, 38624, 39635, 40660,
+    41699, 42753, 43821, 44903, 46000, 47111, 48237, 49377, 50532, 51701,
+    52885, 54084, 55297, 56525, 57768, 59025, 60298, 61585, 62887, 64203,
+    65535
+};
+
+/* WS2812 bits encoded as SPI symbols, 4 bits (MSB first) per entry */
+static const uint16_t NEOPIXEL_SPI_NIBBLES[ 16 ] PROGMEM = {
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6
+};
+
+#if defined( __AVR__ )
+
+/* USART registers and clock pin (XCKn) of each USART output */
+struct NeoPixelUSART {
+    volatile uint8_t *ucsra;
+    volatile uint8_t *xck_ddr;
+    uint8_t xck_bit;
+};
+
+static const NeoPixelUSART NEOPIXEL_USARTS[] = {
+    { &UCSR1A, &DDRD, PD5 },
+    { &UCSR2A, &DDRH, PH2 },
+    { &UCSR3A, &DDRJ, PJ2 },
+};
+
+/* Offsets of the USART registers from UCSRnA */
+#define USART_UCSRA             0
+#define USART_UCSRB             1
+#define USART_UCSRC             2
+#define USART_UBRRL             4
+#define USART_UBRRH             5
+#define USART_UDR               6
+
+#endif /* __AVR__ */
+
 
 
 /*******************************************************************************
@@ -28,11 +82,14 @@
  *
  * @param   pin_leds    Pin ID connected to the neopixel data line.
  * @param   pin_shdn    Pin ID connected to the neopixel power MOSFET.
+ * @param   output      Output backend (NEOPIXEL_OUTPUT_*). The USART 
+ *                      backends require the data line on the TXDn pin.
  * 
  */
-NeoPixel::NeoPixel( int8_t pin_leds, int8_t pin_shdn ) {
+NeoPixel::NeoPixel( int8_t pin_leds, int8_t pin_shdn, uint8_t output ) {
     _pin_leds = pin_leds;
     _pin_shdn = pin_shdn;
+    _output = output;
 
     _ambientDimming = 0;
 }
@@ -56,6 +113,10 @@ void NeoPixel::begin() {
         pinMode( _pin_shdn, OUTPUT );
     }
 
+    if( _output != NEOPIXEL_OUTPUT_BITBANG ) {
+        this->beginUSART();
+    }
+
     this->onPowerStateChange( g_power.getPowerMode() );
 }
 
@@ -96,29 +157,32 @@ void NeoPixel::onPowerStateChange( uint8_t state ) {
         digitalWrite( _pin_shdn, ( state == POWER_MODE_SUSPEND ? HIGH : LOW ) );
     }
 
+    /* The pixels may have lost power, send the next frame */
+    _lastNumPixels = 0;
+
     this->update();
 }
 
 
 /*******************************************************************************
  *
- * @brief   Calculate the pixel brightness and apply gamma correction for an 
- *          individual color channel.
+ * @brief   Gets the color scaling factor for a brightness value, the current 
+ *          ambient dimming and power mode.
  *
- * @param   color    Color channel value.
+ * @param   brightness    Brightness value 0-100 %
  *
- * @return  The corrected brightness value.
+ * @return  Gamma corrected scaling factor (0-65535)
  * 
  */
-inline uint8_t NeoPixel::getColorBrigthness( uint8_t color ) {
+uint16_t NeoPixel::getBrightnessScale( uint8_t brightness ) {
 
-    uint8_t brightness = _brightness;
+    bool visible = ( brightness > 0 );
 
-    /* Apply ambiant light dimming percentage */
-    brightness = brightness * ( 100 - _ambientDimming ) / 100;
+    /* Apply ambiant light dimming percentage (x * 41 / 4096 ~= x / 100) */
+    brightness = ( ( uint32_t )brightness * ( 100 - _ambientDimming ) * 41 ) >> 12;
 
     /* Keep the ambient dimming from turning the pixel off completely. */
-    if( _brightness > 0 && brightness < 1 ) {
+    if( visible == true && brightness < 1 ) {
         brightness = 1;
     }
 
@@ -130,15 +194,186 @@ inline uint8_t NeoPixel::getColorBrigthness( uint8_t color ) {
         }
     }
 
-    color = ( ( uint16_t )color * ( uint16_t )brightness ) / 100;
+    return pgm_read_word( &NEOPIXEL_GAMMA_TABLE[ brightness ] );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Scale an individual color channel. When dithering is enabled, the
+ *          fractional part of the result is accumulated across frames and
+ *          the channel is rounded up once the error carries over.
+ *
+ * @param   color      Color channel value.
+ * @param   scale      Scaling factor returned by getBrightnessScale.
+ * @param   channel    Channel index (GRB order).
+ *
+ * @return  The corrected channel value.
+ * 
+ */
+inline uint8_t NeoPixel::scaleColor( uint8_t color, uint16_t scale, uint8_t channel ) {
+
+    /* color * ( scale + 1 ), 8.16 fixed point */
+    uint32_t value = ( uint32_t )color * scale + color;
+    uint8_t result = value >> 16;
+
+    /* Keep the non-zero channels lit at the lowest levels */
+    if( result == 0 && color != 0 && scale != 0 ) {
+        return 1;
+    }
+
+    if( _dithering == true && result < 255 ) {
+        uint16_t error = _ditherError[ channel ] + ( uint8_t )( value >> 8 );
+
+        _ditherError[ channel ] = error;
+
+        if( error > 0xFF ) {
+            result++;
+        }
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Checks if a frame is identical to the last one sent to the pixels
+ *          and keeps a copy of it otherwise.
+ *
+ * @param   pixmap        Pointer to the pixel data buffer ( 1 bit per pixel )
+ * @param   num_pixels    Number of pixels contained in the pixel map.
+ * @param   color         Color components (GRB, brightness applied)
+ *
+ * @return  TRUE if the frame is identical, FALSE otherwise.
+ * 
+ */
+bool NeoPixel::isSameFrame( const uint8_t *pixmap, uint8_t num_pixels, const volatile uint8_t *color ) {
+
+    bool same = ( num_pixels == _lastNumPixels );
+    uint8_t length = ( num_pixels + 7 ) / 8;
+
+    for( uint8_t i = 0; i < 3; i++ ) {
+        if( _lastColor[ i ] != color[ i ] ) {
+            same = false;
+            _lastColor[ i ] = color[ i ];
+        }
+    }
+
+    for( uint8_t i = 0; i < length; i++ ) {
+        uint8_t pixels = pixmap[ i ];
+
+        /* Ignore the bits past the last pixel */
+        if( i == length - 1 && ( num_pixels % 8 ) != 0 ) {
+            pixels &= ( 1 << ( num_pixels % 8 )) - 1;
+        }
+
+        if( _lastPixmap[ i ] != pixels ) {
+            same = false;
+            _lastPixmap[ i ] = pixels;
+        }
+    }
+
+    _lastNumPixels = num_pixels;
+
+    return same;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Configure the USART of the output in SPI master mode.
+ * 
+ */
+void NeoPixel::beginUSART() {
+
+#if defined( __AVR__ )
+    const NeoPixelUSART *usart = &NEOPIXEL_USARTS[ _output - NEOPIXEL_OUTPUT_USART1 ];
+
+    _usart = usart->ucsra;
+
+    /* The clock pin must be an output for the master mode */
+    *usart->xck_ddr |= _BV( usart->xck_bit );
+
+    /* Baud rate must be zero while enabling the transmitter */
+    _usart[ USART_UBRRH ] = 0;
+    _usart[ USART_UBRRL ] = 0;
+
+    /* SPI master mode 0, MSB first, transmitter only */
+    _usart[ USART_UCSRC ] = _BV( UMSEL01 ) | _BV( UMSEL00 );
+    _usart[ USART_UCSRB ] = _BV( TXEN0 );
+
+    _usart[ USART_UBRRH ] = 0;
+    _usart[ USART_UBRRL ] = NEOPIXEL_SPI_UBRR;
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a frame through the USART output. Interrupts are only 
+ *          disabled while loading the symbols of a color component, they
+ *          are serviced between components while the data line is low.
+ *
+ * @param   pixmap        Pointer to the pixel data buffer ( 1 bit per pixel )
+ * @param   num_pixels    Number of pixels contained in the pixel map.
+ * @param   color         Color components (GRB, brightness applied)
+ * 
+ */
+void NeoPixel::showUSART( const uint8_t *pixmap, uint8_t num_pixels, const volatile uint8_t *color ) {
+
+    /* Symbols of a lit and an unlit pixel */
+    uint8_t symbols[ 2 ][ 3 * NEOPIXEL_SPI_COMP_SIZE ];
+
+    for( uint8_t i = 0; i < 3; i++ ) {
+        neopixelEncodeSPI( color[ i ], &symbols[ 1 ][ i * NEOPIXEL_SPI_COMP_SIZE ] );
+        neopixelEncodeSPI( 0, &symbols[ 0 ][ i * NEOPIXEL_SPI_COMP_SIZE ] );
+    }
+
+#if defined( __AVR__ )
+    volatile uint8_t *ucsra = &_usart[ USART_UCSRA ];
+    volatile uint8_t *udr = &_usart[ USART_UDR ];
+
+    /* Clear the transmit complete flag */
+    *ucsra = _BV( TXC0 );
+#endif
+
+    for( uint8_t i_pixel = 0; i_pixel < num_pixels; i_pixel++ ) {
+        const uint8_t *data = symbols[ ( pixmap[ i_pixel / 8 ] >> ( i_pixel % 8 )) & 0x01 ];
+
+        for( uint8_t i_comp = 0; i_comp < 3; i_comp++ ) {
+
+            /* Each component ends with a low level, which the pixels 
+               tolerate being stretched by an interrupt. */
+            noInterrupts();
+
+            for( uint8_t i = 0; i < NEOPIXEL_SPI_COMP_SIZE; i++ ) {
+#if defined( __AVR__ )
+                while(( *ucsra & _BV( UDRE0 )) == 0 );
+                *udr = *data++;
+#else
+                nativeUSARTTransmit( _output, *data++ );
+#endif
+            }
+
+            interrupts();
+        }
+    }
+
+#if defined( __AVR__ )
+    /* Wait for the last symbol then latch */
+    while(( *ucsra & _BV( TXC0 )) == 0 );
 
-    return color;
+    delayMicroseconds( 60 );
+#endif
 }
 
 
 /*******************************************************************************
  *
- * @brief   Send the data to each pixels.
+ * @brief   Send the data to each pixels. Nothing is sent if the frame is 
+ *          identical to the last one. The bit-banged output disables the 
+ *          interrupts for about 1.2 ms.
  *
  * @param   pixmap        Pointer to the pixel data buffer ( 1 bit per pixel )
  * @param   num_pixels    Number of pixels contained in the pixel map.
@@ -146,10 +381,7 @@ inline uint8_t NeoPixel::getColorBrigthness( uint8_t color ) {
  */
 void NeoPixel::show( uint8_t *pixmap, uint8_t num_pixels ) {
 
-    volatile uint8_t comp = 0;
     volatile uint8_t pixels = 0;
-    volatile uint8_t i_comp = 0;
-    volatile uint8_t i_bit = 0;
     uint8_t i_pixel = 0;
     uint8_t i_pixel_grp = 0;
 
@@ -160,13 +392,55 @@ void NeoPixel::show( uint8_t *pixmap, uint8_t num_pixels ) {
     }
 
 
+    uint8_t brightness = _brightness;
+    uint8_t color[ 3 ] = { _r, _g, _b };
+
+    bool fading = false;
+
+    /* Apply the current effect frame */
+    if( _effect.isActive() == true ) {
+        uint8_t base[ 3 ] = { _r, _g, _b };
+        fading = _effect.render( _brightness, base, &brightness, color );
+    }
+
+    /* Dither only while the levels change, held frames are left identical
+       so that they are skipped. */
+    if(( fading == true || _ditherRequested == true ) != _dithering ) {
+        _dithering = !_dithering;
+        memset( _ditherError, 0, sizeof( _ditherError ));
+    }
+
     /* Build gamma corrected color table in GRB order */
+    uint16_t scale = this->getBrightnessScale( brightness );
+    bool battery = ( g_power.getPowerMode() == POWER_MODE_ON_BATTERY );
+
     volatile uint8_t colorTable[3] = {
-        this->getColorBrigthness( g_power.getPowerMode() == POWER_MODE_ON_BATTERY ? 0 : _g ),
-        this->getColorBrigthness( g_power.getPowerMode() == POWER_MODE_ON_BATTERY ? 255 : _r ),
-        this->getColorBrigthness( g_power.getPowerMode() == POWER_MODE_ON_BATTERY ? 0 : _b ),
+        this->scaleColor( battery ? 0 : color[ 1 ], scale, 0 ),
+        this->scaleColor( battery ? 255 : color[ 0 ], scale, 1 ),
+        this->scaleColor( battery ? 0 : color[ 2 ], scale, 2 ),
     };
 
+    if( num_pixels > NEOPIXEL_MAX_PIXELS ) {
+        num_pixels = NEOPIXEL_MAX_PIXELS;
+    }
+
+    if( this->isSameFrame( pixmap, num_pixels, colorTable ) == true ) {
+        _framesSkipped++;
+        return;
+    }
+
+    _framesSent++;
+
+    if( _output != NEOPIXEL_OUTPUT_BITBANG ) {
+        this->showUSART( pixmap, num_pixels, colorTable );
+        return;
+    }
+
+
+#if defined( __AVR__ )
+    volatile uint8_t comp = 0;
+    volatile uint8_t i_comp = 0;
+    volatile uint8_t i_bit = 0;
 
     /* Get the port address and port bit from pin number */
     volatile uint8_t *port = portOutputRegister( digitalPinToPort( _pin_leds ) );
@@ -174,6 +448,7 @@ void NeoPixel::show( uint8_t *pixmap, uint8_t num_pixels ) {
 
     volatile uint8_t high = ( *port ) | pinMask;     /* Port data with neopixel data pin set high */
     volatile uint8_t low = ( *port ) & ~pinMask;     /* Port data with neopixel data pin set low */
+#endif
 
 
     /* Disable interrupts to prevent timing errors */
@@ -188,6 +463,7 @@ void NeoPixel::show( uint8_t *pixmap, uint8_t num_pixels ) {
 
         for( i_pixel = 0; i_pixel < 8; i_pixel++ ) {
 
+#if defined( __AVR__ )
             asm volatile(
                 "next_comp:                         \n\t"
                 "   inc %[i_comp]                   \n\t"
@@ -245,6 +521,7 @@ void NeoPixel::show( uint8_t *pixmap, uint8_t num_pixels ) {
                 [pixels]        "d"( pixels ),
                 [color]         "e"( &colorTable )
             );
+#endif
 
             pixels >>= 1;
         }
@@ -294,6 +571,61 @@ void NeoPixel::setBrightness( uint8_t brightness ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Enable/disable temporal dithering of the color channels. Only
+ *          useful while the pixels are refreshed continuously (brightness
+ *          fade), a static frame would flicker between two levels. Effects
+ *          enable it on their own while fading between two keyframes.
+ *
+ * @param   enabled    TRUE to enable dithering, FALSE otherwise.
+ * 
+ */
+void NeoPixel::setDithering( bool enabled ) {
+    _ditherRequested = enabled;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Starts playing an effect on the pixel string. The effect is
+ *          relative to the current brightness and color.
+ *
+ * @param   frames    Pointer to the effect keyframes table (PROGMEM)
+ * @param   speed     Playback speed, 1 (slowest) to 10 (fastest)
+ * 
+ */
+void NeoPixel::startEffect( const NeoEffectFrame *frames, uint8_t speed ) {
+
+    _effect.start( frames, speed );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stops the current effect.
+ * 
+ */
+void NeoPixel::stopEffect() {
+
+    _effect.stop();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Refresh the pixels when the next frame of the current effect
+ *          is due.
+ * 
+ */
+void NeoPixel::processEffect() {
+
+    if( _effect.nextFrame() == true ) {
+        this->update();
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   Sets the ambient dimming percentage.
@@ -347,4 +679,25 @@ void NeoPixel::setColorFromTable( uint8_t id ) {
     _r = pgm_read_byte( &_COLOR_TABLE[ id ][ 0 ] );
     _g = pgm_read_byte( &_COLOR_TABLE[ id ][ 1 ] );
     _b = pgm_read_byte( &_COLOR_TABLE[ id ][ 2 ] );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Encode a color component as SPI symbols for the USART output.
+ *          Each WS2812 bit becomes 3 SPI bits of 375 ns, 375 ns high for
+ *          a 0 and 750 ns high for a 1, for a 1.125 us bit period.
+ *
+ * @param   value     Color component.
+ * @param   buffer    Receives the symbols (NEOPIXEL_SPI_COMP_SIZE bytes)
+ * 
+ */
+void neopixelEncodeSPI( uint8_t value, uint8_t *buffer ) {
+
+    uint16_t high = pgm_read_word( &NEOPIXEL_SPI_NIBBLES[ value >> 4 ] );
+    uint16_t low = pgm_read_word( &NEOPIXEL_SPI_NIBBLES[ value & 0x0F ] );
+
+    buffer[ 0 ] = high >> 4;
+    buffer[ 1 ] = ( high << 4 ) | ( low >> 8 );
+    buffer[ 2 ] = low;
 }
\ No newline at end of file
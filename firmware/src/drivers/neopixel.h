@@ -20,6 +20,27 @@
 
 #include <Arduino.h>
 #include <avr/pgmspace.h>
+#include "neoeffect.h"
+
+
+
+/* Maximum number of pixels in a string */
+#define NEOPIXEL_MAX_PIXELS     40
+
+/* Output backends */
+#define NEOPIXEL_OUTPUT_BITBANG 0       /* Bit-banged, interrupts disabled during the whole frame */
+#define NEOPIXEL_OUTPUT_USART1  1       /* USART in SPI master mode, data line on TXDn */
+#define NEOPIXEL_OUTPUT_USART2  2
+#define NEOPIXEL_OUTPUT_USART3  3
+
+/* USART SPI master mode baud rate register, F_CPU / ( 2 * ( UBRR + 1 )) = 2.67 MHz */
+#define NEOPIXEL_SPI_UBRR       2
+
+/* Each WS2812 bit is sent as 3 SPI bits of 375 ns : 0 = 100, 1 = 110 */
+#define NEOPIXEL_SPI_BITS       3
+
+/* Encoded size of a color component, 8 WS2812 bits (bytes) */
+#define NEOPIXEL_SPI_COMP_SIZE  (( 8 * NEOPIXEL_SPI_BITS + 7 ) / 8 )
 
 
 
@@ -31,7 +52,7 @@
 class NeoPixel {
   
   public:
-    NeoPixel( int8_t pin_leds, int8_t pin_shdn );
+    NeoPixel( int8_t pin_leds, int8_t pin_shdn, uint8_t output = NEOPIXEL_OUTPUT_BITBANG );
     void begin();
     void end();
     void onPowerStateChange( uint8_t state );
@@ -39,22 +60,63 @@ class NeoPixel {
     void setColorFromTable( uint8_t id );
     void setBrightness( uint8_t brightness );
     void setAmbientDimming( uint8_t dimming );
+    void setDithering( bool enabled );
+    void startEffect( const NeoEffectFrame *frames, uint8_t speed );
+    void stopEffect();
+    void processEffect();
     virtual void update() = 0;
 
+    /* Gets the number of frames sent to the pixels. */
+    uint32_t getFramesSent()                { return _framesSent; }
+
+    /* Gets the number of frames identical to the last one sent. */
+    uint32_t getFramesSkipped()             { return _framesSkipped; }
+
+    /* Clears the frame counters. */
+    void clearStats()                       { _framesSent = 0; _framesSkipped = 0; _effect.clearStats(); }
+
+    /* Sets the effect playback speed, 1 (slowest) to 10 (fastest). */
+    void setEffectSpeed( uint8_t speed )    { _effect.setSpeed( speed ); }
+
+    /* Returns whether or not an effect is playing. */
+    bool isEffectActive()                   { return _effect.isActive(); }
+
+    /* Gets the effect player. */
+    NeoEffect* getEffect()                  { return &_effect; }
+
 
   protected:
     void show( uint8_t *pixmap, uint8_t num_leds );
+    bool isSameFrame( const uint8_t *pixmap, uint8_t num_pixels, const volatile uint8_t *color );
+    void beginUSART();
+    void showUSART( const uint8_t *pixmap, uint8_t num_pixels, const volatile uint8_t *color );
     void setPixel( uint8_t *pixmap, uint8_t id, bool state );
-    inline uint8_t getColorBrigthness( uint8_t color );
+    uint16_t getBrightnessScale( uint8_t brightness );
+    inline uint8_t scaleColor( uint8_t color, uint16_t scale, uint8_t channel );
 
     int8_t _pin_leds;
     int8_t _pin_shdn;
+    uint8_t _output;
+    volatile uint8_t *_usart = nullptr;     /* USART registers (UCSRnA) */
     uint8_t _brightness = 10;
     uint8_t _g = 0x00;
     uint8_t _b = 0x00;
     uint8_t _r = 0xFF;
     uint8_t _ambientDimming = 0;
     bool _init = false;
+    bool _dithering = false;
+    bool _ditherRequested = false;          /* Dithering enabled by setDithering() */
+    NeoEffect _effect;
+    uint8_t _ditherError[ 3 ] = { 0 };       /* Accumulated fractional part of each channel */
+
+    uint8_t _lastPixmap[ ( NEOPIXEL_MAX_PIXELS + 7 ) / 8 ];    /* Last frame sent */
+    uint8_t _lastColor[ 3 ];                /* Color components of the last frame (GRB, brightness applied) */
+    uint8_t _lastNumPixels = 0;             /* Number of pixels of the last frame, 0 if unknown */
+    uint32_t _framesSent = 0;
+    uint32_t _framesSkipped = 0;
 };
 
+
+void neopixelEncodeSPI( uint8_t value, uint8_t *buffer );
+
 #endif /* NEOPIXEL_H */
\ No newline at end of file
@@ -18,6 +18,8 @@
 
 #include "qt1070.h"
 #include "power.h"
+#include <trace_events.h>
+#include <isr_events.h>
 
 
 
@@ -156,10 +158,20 @@ uint8_t QT1070::processEvents() {
     uint8_t key = 0;
     unsigned long lastEventDelay;
 
+    /* Keys generated by the hold and repeat timers occur now */
+    uint32_t keyTime = micros();
+
     /* Calculate the elapsed time since the last event */
     lastEventDelay = this->lastEventStart > 0 ? millis() - this->lastEventStart : 0;
 
-    if( digitalRead( _pin_irq) == LOW ) {
+    /* The change line stays asserted until the status is read, in case the
+       event was dropped by a full queue. */
+    if( _eventPending == true || digitalRead( _pin_irq) == LOW ) {
+
+        if( _eventPending == true ) {
+            keyTime = _eventMicros;
+            _eventPending = false;
+        }
 
         /* Read the status bytes (2-3) to reset the interrupt */
         if( this->readStatus() == false ) {
@@ -180,7 +192,10 @@ uint8_t QT1070::processEvents() {
         }
 
         key = status.keys;
-        this->lastEventStart = millis();
+
+        /* Time the key changed, not the time the event was serviced */
+        this->lastEventStart = ( _eventTime != 0 ) ? _eventTime : millis();
+        _eventTime = 0;
 
     } else {
 
@@ -188,10 +203,37 @@ uint8_t QT1070::processEvents() {
     }
 
     if( ( this->firstKeyState != 0 ? this->firstKeyState : key ) & this->repeatMask ) {
-        return this->processKeyRepeatMode( key, lastEventDelay );
+        key = this->processKeyRepeatMode( key, lastEventDelay );
+
+    } else {
+        key = this->processKeyStandardMode( key, lastEventDelay );
     }
 
-    return this->processKeyStandardMode( key, lastEventDelay );
+    if( key != KEY_NONE ) {
+        _keyTime = keyTime;
+    }
+
+    return key;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Called by the main loop when the key change interrupt event is 
+ *          dequeued.
+ *
+ * @param   time    Time of the interrupt (us).
+ * 
+ */
+void QT1070::onInterruptEvent( uint32_t time ) {
+    _eventPending = true;
+    _eventMicros = time;
+    _eventTime = millis() - ( micros() - time ) / 1000;
+
+    /* 0 means no timestamp */
+    if( _eventTime == 0 ) {
+        _eventTime = 1;
+    }
 }
 
 
@@ -332,10 +374,7 @@ uint8_t QT1070::processKeyRepeatMode( uint8_t key, uint16_t lastEventDelay ) {
 uint8_t QT1070::write( uint8_t reg, void *data, uint8_t size ) {
     uint8_t res;
 
-    Wire.beginTransmission( I2C_ADDR_AT42QT1070 );
-    Wire.write( reg );
-    Wire.write( ( char * )data, size );
-    res = Wire.endTransmission( true );
+    res = g_twi.writeRegister( I2C_ADDR_AT42QT1070, reg, data, size );
 
     delay( 1 );
 
@@ -355,21 +394,12 @@ uint8_t QT1070::write( uint8_t reg, void *data, uint8_t size ) {
  * 
  */
 uint8_t QT1070::read( uint8_t reg, void *data, uint8_t size ) {
-    uint8_t length = 0;
-
-    Wire.beginTransmission( I2C_ADDR_AT42QT1070 );
-    Wire.write( reg );
-    Wire.endTransmission( true );
-
 
-    Wire.requestFrom( I2C_ADDR_AT42QT1070, ( int )size, true );
-
-    while( Wire.available() ) {
-        *( ( char * )data + length ) = Wire.read();
-        length++;
+    if( g_twi.readRegister( I2C_ADDR_AT42QT1070, reg, data, size ) != TWI_RESULT_OK ) {
+        return 0;
     }
 
-    return length;
+    return size;
 }
 
 
@@ -379,5 +409,8 @@ uint8_t QT1070::read( uint8_t reg, void *data, uint8_t size ) {
  *
  */
 void isr_qt1070() {
+    trace_record( TRACE_EVENT_ISR_KEYPAD, 0 );
+    event_queue_push( ISR_EVENT_KEYPAD, 0 );
+
     g_keypad.disableInterrupt();
 }
\ No newline at end of file
@@ -20,7 +20,7 @@
 #define QT1070_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "twi.h"
 
 
 
@@ -111,6 +111,10 @@ class QT1070 {
     bool readStatus();
     bool writeConfig();
     uint8_t processEvents();
+    void onInterruptEvent( uint32_t time );
+
+    /* Gets the time the last key returned by processEvents() occured (us). */
+    uint32_t getKeyTime()           { return _keyTime; }
 
     statusBlock status;
     configBlock config;
@@ -132,6 +136,10 @@ class QT1070 {
     uint8_t firstKeyState = 0;
     uint8_t lastKeyState = 0;
     unsigned long lastEventStart = 0;
+    bool _eventPending = false;
+    unsigned long _eventTime = 0;
+    uint32_t _eventMicros = 0;
+    uint32_t _keyTime = 0;
 };
 
 void isr_qt1070();
@@ -21,9 +21,8 @@
 #include "power.h"
 #include "neoclock.h"
 #include "wifi/wifi.h"
-
-
-volatile bool rtc_event = false;
+#include <trace_events.h>
+#include <isr_events.h>
 
 
 
@@ -76,8 +75,6 @@ DS3231::DS3231( int8_t pin_irq ) {
  */
 void DS3231::begin() {
 
-    Wire.begin();
-
     uint8_t control = ( DS3231_CTRL_INTCN );
     this->write( DS3231_REG_CONTROL, control );
 
@@ -199,30 +196,41 @@ bool DS3231::processEvents() {
         g_wifi.setSystemTime( &_now );
     }
 
-    if( rtc_event == false ) {
+    /* The interrupt line stays asserted until the alarm flag is cleared,
+       in case the event was dropped by a full queue. */
+    if( _eventPending == false && digitalRead( _pin_irq ) == HIGH ) {
         return false;
     }
 
     this->clearAlarmFlag();
     this->enableInterrupt();
-    rtc_event = false;
+    _eventPending = false;
 
     this->readTime( &_now );
     return true;
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Called by the main loop when the alarm interrupt event is 
+ *          dequeued.
+ * 
+ */
+void DS3231::onInterruptEvent() {
+    _eventPending = true;
+}
+
+
 /*******************************************************************************
  *
  * @brief   For debugging purposes. Prints the contents of all registers.
  * 
  */
 void DS3231::dumpRegs() {
-    Wire.beginTransmission( I2C_ADDR_DS3231 );
-    Wire.write( DS3231_REG_SEC );
-    Wire.endTransmission();
+    uint8_t regs[ 18 ];
 
-    Wire.requestFrom( I2C_ADDR_DS3231, 18 );
+    g_twi.readRegister( I2C_ADDR_DS3231, DS3231_REG_SEC, regs, sizeof( regs ));
 
     uint8_t i;
 
@@ -230,7 +238,7 @@ void DS3231::dumpRegs() {
         Serial.print( F( "Register 0x" ) );
         Serial.print( i, HEX );
         Serial.print( F( ": " ) );
-        Serial.print( Wire.read(), BIN );
+        Serial.print( regs[ i ], BIN );
         Serial.println( "" );
     }
 }
@@ -246,22 +254,20 @@ void DS3231::dumpRegs() {
  */
 void DS3231::readTime( DateTime *dt ) {
 
-    Wire.beginTransmission( I2C_ADDR_DS3231 );
-    Wire.write( DS3231_REG_SEC );
-    Wire.endTransmission();
+    uint8_t regs[ 7 ];
 
-    Wire.requestFrom( I2C_ADDR_DS3231, 8 );
+    g_twi.readRegister( I2C_ADDR_DS3231, DS3231_REG_SEC, regs, sizeof( regs ));
 
-    uint8_t ss = bcd2bin( Wire.read() );
-    uint8_t mm = bcd2bin( Wire.read() );
+    uint8_t ss = bcd2bin( regs[ 0 ] );
+    uint8_t mm = bcd2bin( regs[ 1 ] );
 
-    uint8_t hrreg = Wire.read();
+    uint8_t hrreg = regs[ 2 ];
     uint8_t hh = bcd2bin( ( hrreg & ~DS3231_HOUR_24H ) );  //Ignore 24 Hour bit
 
-    Wire.read();    /* Discard weekday value */
-    uint8_t  d = bcd2bin( Wire.read() );
-    uint8_t  m = bcd2bin( Wire.read() );
-    uint16_t y = bcd2bin( Wire.read() ) + 2000;
+    /* regs[ 3 ] : weekday, ignored */
+    uint8_t  d = bcd2bin( regs[ 4 ] );
+    uint8_t  m = bcd2bin( regs[ 5 ] );
+    uint16_t y = bcd2bin( regs[ 6 ] ) + 2000;
 
     _now.set( y, m, d, hh, mm, ss );
 
@@ -295,19 +301,17 @@ unsigned long DS3231::getEpoch() {
  * 
  */
 void DS3231::writeTime( DateTime *new_dt ) {
-    Wire.beginTransmission( I2C_ADDR_DS3231 );
+    uint8_t regs[ 7 ];
 
-    Wire.write( DS3231_REG_SEC );
+    regs[ 0 ] = bin2bcd( new_dt->second() );
+    regs[ 1 ] = bin2bcd( new_dt->minute() );
+    regs[ 2 ] = bin2bcd( new_dt->hour() & ~DS3231_HOUR_24H );
+    regs[ 3 ] = bin2bcd( new_dt->dow() );
+    regs[ 4 ] = bin2bcd( new_dt->day() );
+    regs[ 5 ] = bin2bcd( new_dt->month() );
+    regs[ 6 ] = bin2bcd( new_dt->year() % 100 );
 
-    Wire.write( bin2bcd( new_dt->second() ) );
-    Wire.write( bin2bcd( new_dt->minute() ) );
-    Wire.write( bin2bcd( new_dt->hour() & ~DS3231_HOUR_24H ) );
-    Wire.write( bin2bcd( new_dt->dow() ) );
-    Wire.write( bin2bcd( new_dt->day() ) );
-    Wire.write( bin2bcd( new_dt->month() ) );
-    Wire.write( bin2bcd( new_dt->year() % 100 ) );
-
-    Wire.endTransmission();
+    g_twi.writeRegister( I2C_ADDR_DS3231, DS3231_REG_SEC, regs, sizeof( regs ));
 
     _now = new_dt;
     this->resetMillis();
@@ -322,16 +326,11 @@ void DS3231::writeTime( DateTime *new_dt ) {
  * 
  */
 uint8_t DS3231::read( uint8_t reg ) {
+    uint8_t value = 0;
 
-    Wire.beginTransmission( I2C_ADDR_DS3231 );
-
-    Wire.write( reg );
+    g_twi.readRegister( I2C_ADDR_DS3231, reg, &value, 1 );
 
-    Wire.endTransmission();
-    delayMicroseconds( 10 );
-
-    Wire.requestFrom( I2C_ADDR_DS3231, 1 );
-    return Wire.read();
+    return value;
 }
 
 
@@ -344,12 +343,7 @@ uint8_t DS3231::read( uint8_t reg ) {
  * 
  */
 void DS3231::write( uint8_t reg, uint8_t value ) {
-    Wire.beginTransmission( I2C_ADDR_DS3231 );
-
-    Wire.write( reg );
-    Wire.write( value );
-
-    Wire.endTransmission();
+    g_twi.writeRegister( I2C_ADDR_DS3231, reg, &value, 1 );
 
     delayMicroseconds( 10 );
 }
@@ -403,7 +397,8 @@ void DS3231::adjustClock( DateTime *ndt, int16_t delay ) {
  * 
  */
 void isr_ds3231() {
-    rtc_event = true;
+    trace_record( TRACE_EVENT_ISR_RTC, 0 );
+    event_queue_push( ISR_EVENT_RTC, 0 );
 
     g_rtc.resetMillis();
     g_rtc.disableInterrupt();
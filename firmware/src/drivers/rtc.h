@@ -19,7 +19,7 @@
 #define RTC_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "twi.h"
 #include <time.h>
 
 
@@ -96,6 +96,7 @@ class DS3231 {
     void disableInterrupt();
     void clearAlarmFlag();
     bool processEvents();
+    void onInterruptEvent();
     void readTime( DateTime *dt = NULL );
     unsigned long getEpoch();
     void writeTime( DateTime *ndt );
@@ -111,6 +112,7 @@ class DS3231 {
     void write( uint8_t reg, uint8_t value );
 
     bool _init = false;
+    bool _eventPending = false;
     int8_t _pin_irq;
     unsigned long _secStart;
     unsigned long _delayStart;
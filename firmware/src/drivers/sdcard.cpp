@@ -20,6 +20,7 @@
 #include <services/logger.h>
 #include <drivers/rtc.h>
 #include <timezone.h>
+#include <soundindex.h>
 
 
 /*******************************************************************************
@@ -107,6 +108,7 @@ bool SDCardManager::detectCardPresence() {
             return false;
         }
 
+        g_soundIndex.end();
         this->end();
 
         g_log.add( EVENT_SD_REMOVED );
@@ -129,6 +131,9 @@ bool SDCardManager::detectCardPresence() {
     g_log.add( EVENT_SD_READY );
     
     _card_present = true;
+
+    /* Start validating the sound index, rebuilt only if the sound files changed. */
+    g_soundIndex.begin();
     return true;
 }
 
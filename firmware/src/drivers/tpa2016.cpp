@@ -350,18 +350,13 @@ void TPA2016::dumpRegs() {
 
     for( uint8_t i = 1; i < 8l;  i++ ) {
 
-        Wire.beginTransmission( TPA2016_I2C_ADDR );
-        Wire.write( i );
-        Wire.endTransmission();
-
-        Wire.requestFrom( TPA2016_I2C_ADDR, true );
-
-        while( Wire.available() == false );
+        uint8_t value;
+        g_twi.readRegister( TPA2016_I2C_ADDR, i, &value, 1 );
 
         // Serial.print( "REG: 0x" );
         // Serial.print( i, HEX );
         // Serial.print( " = 0x" );
-        // Serial.println( Wire.read(), HEX );
+        // Serial.println( value, HEX );
     }
 }
 
@@ -378,20 +373,7 @@ void TPA2016::dumpRegs() {
  */
 bool TPA2016::write( uint8_t reg, uint8_t data ) {
 
-    Wire.beginTransmission( TPA2016_I2C_ADDR );
-
-    uint8_t ret;
-    ret = Wire.write( reg );
-    if( ret < 1 ) {
-        return false;
-    }
-
-    ret = Wire.write( data );
-    if( ret < 1 ) {
-        return false;
-    }
-
-    Wire.endTransmission();
+    g_twi.writeRegister( TPA2016_I2C_ADDR, reg, &data, 1 );
 
     return true;
 }
\ No newline at end of file
@@ -19,7 +19,7 @@
 #define _TPA2016_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "twi.h"
 
 
 
@@ -0,0 +1,167 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/drivers/twi.cpp
+// Author  : Benoit Frigon <www.frigon.info>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#include <Arduino.h>
+#include <util/twi.h>
+#include "twi.h"
+
+
+
+/* Control register values */
+#define TWCR_ACK            ( _BV( TWEN ) | _BV( TWIE ) | _BV( TWINT ) | _BV( TWEA ))
+#define TWCR_NACK           ( _BV( TWEN ) | _BV( TWIE ) | _BV( TWINT ))
+#define TWCR_START          ( _BV( TWEN ) | _BV( TWIE ) | _BV( TWINT ) | _BV( TWSTA ))
+#define TWCR_STOP           ( _BV( TWEN ) | _BV( TWIE ) | _BV( TWINT ) | _BV( TWSTO ))
+
+
+static TwiTransaction* volatile _transaction;   /* Transaction on the bus */
+static volatile uint8_t _index;                 /* Position in the transmit or receive buffer */
+static volatile bool _receive;                  /* Reading phase of the transaction */
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Initialize the TWI peripheral.
+ *
+ * @param   frequency    SCL frequency (Hz)
+ * 
+ */
+void twi_begin( uint32_t frequency ) {
+
+    /* Internal pull-ups on SDA and SCL */
+    digitalWrite( SDA, HIGH );
+    digitalWrite( SCL, HIGH );
+
+    /* Prescaler = 1 */
+    TWSR &= ~( _BV( TWPS0 ) | _BV( TWPS1 ));
+    TWBR = (( F_CPU / frequency ) - 16 ) / 2;
+
+    TWCR = _BV( TWEN ) | _BV( TWIE );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a start condition for the given transaction. The rest of
+ *          the transaction is run by the TWI interrupt.
+ *
+ * @param   transaction    Transaction to run
+ * 
+ */
+void twi_start( TwiTransaction* transaction ) {
+    _transaction = transaction;
+    _index = 0;
+
+    /* Transactions without data to write start with the read phase */
+    _receive = ( transaction->txLength == 0 && transaction->rxLength > 0 );
+
+    TWCR = TWCR_START;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Release the bus and re-enable the peripheral, after a timeout.
+ * 
+ */
+void twi_reset() {
+    TWCR = 0;
+    TWCR = _BV( TWEN ) | _BV( TWIE );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Send a stop condition and end the transaction.
+ *
+ * @param   result    Transaction result
+ * 
+ */
+static void twi_stop( uint8_t result ) {
+    TWCR = TWCR_STOP;
+
+    /* Wait for the stop condition before starting the next transaction. */
+    while( TWCR & _BV( TWSTO ));
+
+    g_twi.onComplete( result );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   TWI interrupt, runs the transaction state machine.
+ * 
+ */
+ISR( TWI_vect ) {
+    TwiTransaction* transaction = _transaction;
+
+    switch( TW_STATUS ) {
+
+        /* Send the address with the direction of the current phase */
+        case TW_START:
+        case TW_REP_START:
+            _index = 0;
+            TWDR = ( transaction->address << 1 ) | ( _receive == true ? TW_READ : TW_WRITE );
+            TWCR = TWCR_NACK;
+            break;
+
+        /* Master transmitter */
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            if( _index < transaction->txLength ) {
+                TWDR = transaction->txData[ _index++ ];
+                TWCR = TWCR_NACK;
+
+            } else if( transaction->rxLength > 0 ) {
+                _receive = true;
+                TWCR = TWCR_START;
+
+            } else {
+                twi_stop( TWI_RESULT_OK );
+            }
+            break;
+
+        case TW_MT_SLA_NACK:
+        case TW_MR_SLA_NACK:
+            twi_stop( TWI_RESULT_NACK_ADDRESS );
+            break;
+
+        case TW_MT_DATA_NACK:
+            twi_stop( TWI_RESULT_NACK_DATA );
+            break;
+
+        /* Master receiver, the last byte is not acknowledged */
+        case TW_MR_DATA_ACK:
+            transaction->rxData[ _index++ ] = TWDR;
+
+            /* Fall through */
+        case TW_MR_SLA_ACK:
+            TWCR = ( _index + 1 < transaction->rxLength ) ? TWCR_ACK : TWCR_NACK;
+            break;
+
+        case TW_MR_DATA_NACK:
+            transaction->rxData[ _index++ ] = TWDR;
+            twi_stop( TWI_RESULT_OK );
+            break;
+
+        /* Arbitration lost or bus error */
+        default:
+            twi_stop( TWI_RESULT_ERROR );
+            break;
+    }
+}
\ No newline at end of file
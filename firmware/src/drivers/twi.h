@@ -0,0 +1,31 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : src/drivers/twi.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef TWI_H
+#define TWI_H
+
+#include <Arduino.h>
+#include <twiqueue.h>
+
+
+
+/* Bus frequency (Hz) */
+#ifndef TWI_FREQUENCY
+#define TWI_FREQUENCY               100000
+#endif
+
+#endif /* TWI_H */
\ No newline at end of file
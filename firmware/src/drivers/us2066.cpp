@@ -50,6 +50,16 @@ void US2066::begin() {
 
     _init = true;
 
+    /* CGRAM content is undefined after reset */
+    memset( _glyphs, 0, sizeof( _glyphs ));
+
+    /* Display off, no cursor after reset */
+    _state.display = false;
+    _state.cursor = false;
+    _state.blink = false;
+    _state.reverseDisplay = false;
+    _stateChanged = false;
+
     delay( 1 );
     pinMode( _pin_reset, OUTPUT );
 
@@ -98,6 +108,8 @@ void US2066::begin() {
     this->selectInstructions( US2066_ISET_STANDARD );   /* RE=0 */
 
     /* Clear display */
+    this->sendCommand( US2066_CMD_CLEAR );
+    memset( _panel, CHAR_SPACE, sizeof( _panel ));
     this->clear();
 
     /* Set cursor home */
@@ -213,13 +225,9 @@ void US2066::selectInstructions( uint8_t iset ) {
  */
 uint8_t US2066::sendCommand( uint8_t cmd ) {
 
+    uint8_t buffer[] = { US2066_MODE_CMD, cmd };
 
-    Wire.beginTransmission( _address );
-
-    Wire.write( US2066_MODE_CMD );
-    Wire.write( cmd );
-
-    return Wire.endTransmission();
+    return g_twi.transfer( _address, buffer, sizeof( buffer ));
 }
 
 
@@ -240,22 +248,23 @@ uint8_t US2066::sendCommand( uint8_t cmd ) {
  * 
  */
 uint8_t US2066::sendCommand( uint8_t cmd, uint8_t data ) {
-    Wire.beginTransmission( _address );
-
-    Wire.write( US2066_MODE_CMD | US2066_MODE_CONTINUE );
-    Wire.write( cmd );
 
     /* Data following commands in extended mode require D/C#=1. */
-    Wire.write( _current_iset == US2066_ISET_EXTENDED ? US2066_MODE_DATA : US2066_MODE_CMD );
-    Wire.write( data );
-
-    return Wire.endTransmission();
+    uint8_t buffer[] = { 
+        US2066_MODE_CMD | US2066_MODE_CONTINUE, 
+        cmd,
+        ( _current_iset == US2066_ISET_EXTENDED ) ? US2066_MODE_DATA : US2066_MODE_CMD,
+        data
+    };
+
+    return g_twi.transfer( _address, buffer, sizeof( buffer ));
 }
 
 
 /*******************************************************************************
  *
- * @brief   Write custom characters to the LCD CGRAM.
+ * @brief   Write custom characters to the LCD CGRAM. Characters already
+ *          loaded are skipped.
  *
  * @param   pchrmap    Pointer to the array containing the 
  *                     characters (8x8 bytes).
@@ -279,26 +288,36 @@ uint8_t US2066::setCustomCharacters( const unsigned char *pchrmap ) {
 
     uint8_t ch;
 
-    for( ch = 0; ch < 8; ch++ ) {
+    for( ch = 0; ch < US2066_CUSTOM_CHARACTERS; ch++ ) {
 
-        Wire.beginTransmission( _address );
-        Wire.write( US2066_MODE_CMD | US2066_MODE_CONTINUE );
-        Wire.write( US2066_CMD_CGRAM | ( ch << 3 ) );
+        const unsigned char *glyph = pchrmap + ( ch << 3 );
 
-        uint8_t i;
+        /* Only send the characters which differ from the CGRAM content */
+        if( this->isGlyphResident( ch, glyph ) == true ) {
+            _glyphSkips++;
+            continue;
+        }
 
-        for( i = 0; i < 8; i++ ) {
+        uint8_t buffer[ 3 + 8 ];
+        buffer[ 0 ] = US2066_MODE_CMD | US2066_MODE_CONTINUE;
+        buffer[ 1 ] = US2066_CMD_CGRAM | ( ch << 3 );
+        buffer[ 2 ] = US2066_MODE_DATA;
 
-            Wire.write( US2066_MODE_DATA | US2066_MODE_CONTINUE );
-            Wire.write( pgm_read_byte( pchrmap++ ) );
-        }
+        memcpy_P( &buffer[ 3 ], glyph, 8 );
 
         uint8_t res;
-        res = Wire.endTransmission();
+        res = g_twi.transfer( _address, buffer, sizeof( buffer ));
 
         if( res != 0 ) {
+            _glyphs[ ch ] = NULL;
             return res;
         }
+
+        _glyphs[ ch ] = glyph;
+        _glyphUploads++;
+
+        /* The address counter now points to the CGRAM */
+        _positionChanged = true;
     }
 
     return 0;
@@ -307,8 +326,41 @@ uint8_t US2066::setCustomCharacters( const unsigned char *pchrmap ) {
 
 /*******************************************************************************
  *
- * @brief   Set the DDRAM address corresponding to the specified 
- *          row and column.
+ * @brief   Check if a custom character is already loaded in the CGRAM.
+ *
+ * @param   slot     Character code (0-7)
+ * @param   glyph    Pointer to the character bitmap in program memory.
+ *
+ * @return  TRUE if the CGRAM contains the same bitmap, FALSE otherwise.
+ * 
+ */
+bool US2066::isGlyphResident( uint8_t slot, const unsigned char *glyph ) {
+    const unsigned char *resident = _glyphs[ slot ];
+
+    if( resident == NULL ) {
+        return false;
+    }
+
+    if( resident == glyph ) {
+        return true;
+    }
+
+    uint8_t i;
+
+    for( i = 0; i < 8; i++ ) {
+        if( pgm_read_byte( resident + i ) != pgm_read_byte( glyph + i )) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Set the position of the next characters written to the frame 
+ *          buffer. The DDRAM address is only sent by flush().
  *
  * @param   row     Row number (0 based)
  * @param   col     Column number (0 based)
@@ -318,9 +370,9 @@ void US2066::setPosition( uint8_t row, uint8_t col ) {
         this->begin();
     }
 
-    uint8_t dram_address = ( col + ( row * 0x40 ) );
-
-    this->sendCommand( US2066_CMD_DDRAM | ( dram_address & 0x7F ) );
+    _row = row;
+    _col = col;
+    _positionChanged = true;
 }
 
 
@@ -334,7 +386,12 @@ void US2066::clear() {
         this->begin();
     }
 
-    this->sendCommand( US2066_CMD_CLEAR );
+    memset( _frame, CHAR_SPACE, sizeof( _frame ));
+
+    _row = 0;
+    _col = 0;
+    _dirty = true;
+    _positionChanged = true;
 }
 
 
@@ -391,7 +448,8 @@ void US2066::setAmbientDimming( uint8_t dimming ) {
 
 /*******************************************************************************
  *
- * @brief   Sets the cursor state of the LCD module.
+ * @brief   Sets the cursor state of the LCD module. The display control
+ *          command is queued on the next flush, only if the state changed.
  *
  * @param   underline    Underline cursor ON or OFF.
  * @param   blinking     Blinking cursor (block).
@@ -401,10 +459,16 @@ void US2066::setCursor( bool underline, bool blinking ) {
         this->begin();
     }
 
+    /* Move the cursor to the current position on the next flush */
+    _positionChanged = true;
+
+    if( _state.cursor == underline && _state.blink == blinking ) {
+        return;
+    }
+
     _state.cursor = underline;
     _state.blink = blinking;
-
-    this->updateDisplayState();
+    _stateChanged = true;
 }
 
 
@@ -420,6 +484,10 @@ void US2066::setDisplay( bool on, bool reverse ) {
         this->begin();
     }
 
+    if( _state.display == on && _state.reverseDisplay == reverse ) {
+        return;
+    }
+
     _state.display = on;
     _state.reverseDisplay = reverse;
 
@@ -435,11 +503,9 @@ void US2066::setDisplay( bool on, bool reverse ) {
  * 
  */
 void US2066::updateDisplayState() {
-    uint8_t state = _state.blink |
-                    _state.cursor << 1 |
-                    _state.display << 2;
 
-    this->sendCommand( US2066_CMD_DISPLAY | state );
+    this->sendCommand( US2066_CMD_DISPLAY | this->getDisplayControl() );
+    _stateChanged = false;
 
 
     /* Select extended instruction set, reverse display is set while
@@ -453,6 +519,20 @@ void US2066::updateDisplayState() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Get the display control bits (display ON/OFF, cursor, blink).
+ *
+ * @return  Display control bits
+ * 
+ */
+uint8_t US2066::getDisplayControl() {
+    return _state.blink |
+           _state.cursor << 1 |
+           _state.display << 2;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Fills the LCD with the specified number of characters.
@@ -484,10 +564,234 @@ void US2066::fill( char c, uint8_t num ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Queue the characters of the frame buffer which differ from the 
+ *          contents of the module. Each run of changed characters is sent
+ *          in a single I2C transaction, without waiting for the bus. The 
+ *          remaining runs are sent on the next flush if all the transfer 
+ *          slots are in use.
+ * 
+ */
+void US2066::flush() {
+    if( _init == false ) {
+        return;
+    }
+
+    uint8_t transactions = 0;
+
+    /* A run failed, the panel contents is unknown. */
+    if( _resendAll == true ) {
+        _resendAll = false;
+        _dirty = true;
+
+        memset( _panel, 0, sizeof( _panel ));
+    }
+
+    if( _dirty == true ) {
+        _dirty = false;
+
+        for( uint8_t row = 0; row < US2066_DISPLAY_LINES; row++ ) {
+
+            uint8_t col = 0;
+            while( col < US2066_DISPLAY_COLUMNS ) {
+
+                if( _frame[ row ][ col ] == _panel[ row ][ col ] ) {
+                    col++;
+                    continue;
+                }
+
+                /* Extend the run up to the last changed character, short 
+                   gaps of unchanged characters are included. */
+                uint8_t start = col;
+                uint8_t end = col + 1;
+                uint8_t gap = 0;
+
+                for( col = end; col < US2066_DISPLAY_COLUMNS; col++ ) {
+
+                    if( _frame[ row ][ col ] != _panel[ row ][ col ] ) {
+                        end = col + 1;
+                        gap = 0;
+
+                    } else if( ++gap > US2066_FLUSH_MAX_GAP ) {
+                        break;
+                    }
+                }
+
+                if( this->sendRun( row, start, end - start ) == false ) {
+
+                    /* No transfer slot available, retry on the next flush */
+                    _dirty = true;
+                    break;
+                }
+
+                transactions++;
+                col = end;
+            }
+        }
+    }
+
+    /* The cursor is shown at the current DDRAM address, the runs moved it. */
+    bool moveCursor = ( _state.cursor == true || _state.blink == true ) && ( _positionChanged == true || transactions > 0 );
+
+    if(( _stateChanged == true || moveCursor == true ) && this->sendControl( moveCursor ) == true ) {
+        _stateChanged = false;
+        moveCursor = false;
+
+        transactions++;
+    }
+
+    /* Retry on the next flush if the transfer slot is still in use */
+    _positionChanged = moveCursor;
+
+    if( transactions > 0 ) {
+        _frameCount++;
+        _lastFrameTransactions = transactions;
+
+        if( transactions > _maxFrameTransactions ) {
+            _maxFrameTransactions = transactions;
+        }
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Queue a run of characters from the frame buffer. The panel 
+ *          contents is updated right away, onRunComplete() forces a full
+ *          resend if the transaction fails.
+ *
+ * @param   row       Row number (0 based)
+ * @param   col       Column of the first character (0 based)
+ * @param   length    Number of characters
+ *
+ * @return  TRUE if the run was queued, FALSE if no slot is available.
+ * 
+ */
+bool US2066::sendRun( uint8_t row, uint8_t col, uint8_t length ) {
+
+    US2066_RUN *run = NULL;
+
+    for( uint8_t i = 0; i < US2066_RUN_SLOTS; i++ ) {
+        if( _runs[ i ].transaction.state == TWI_STATE_IDLE ) {
+            run = &_runs[ i ];
+            break;
+        }
+    }
+
+    if( run == NULL ) {
+        return false;
+    }
+
+    uint8_t dram_address = ( col + ( row * 0x40 ) );
+
+    /* Set the DDRAM address. The following control byte has Co=0, only 
+       data bytes follow it. */
+    run->buffer[ 0 ] = US2066_MODE_CMD | US2066_MODE_CONTINUE;
+    run->buffer[ 1 ] = US2066_CMD_DDRAM | ( dram_address & 0x7F );
+    run->buffer[ 2 ] = US2066_MODE_DATA;
+    memcpy( &run->buffer[ 3 ], &_frame[ row ][ col ], length );
+
+    run->transaction.address = _address;
+    run->transaction.txData = run->buffer;
+    run->transaction.txLength = length + 3;
+    run->transaction.rxData = NULL;
+    run->transaction.rxLength = 0;
+    run->transaction.callback = &US2066::onRunComplete;
+    run->transaction.context = this;
+
+    if( g_twi.submit( &run->transaction ) == false ) {
+        return false;
+    }
+
+    _frameTransaction = &run->transaction;
+
+    memcpy( &_panel[ row ][ col ], &_frame[ row ][ col ], length );
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Queue the display control command, if the cursor state changed,
+ *          and the cursor position after the runs of the frame.
+ *
+ * @param   moveCursor    Set the DDRAM address to the current position
+ *
+ * @return  TRUE if the commands were queued, FALSE if the slot is in use.
+ * 
+ */
+bool US2066::sendControl( bool moveCursor ) {
+
+    uint8_t length = 0;
+
+    if( _control.state != TWI_STATE_IDLE ) {
+        return false;
+    }
+
+    if( _stateChanged == true ) {
+        _controlBuffer[ length++ ] = US2066_MODE_CMD | ( moveCursor ? US2066_MODE_CONTINUE : 0 );
+        _controlBuffer[ length++ ] = US2066_CMD_DISPLAY | this->getDisplayControl();
+    }
+
+    if( moveCursor == true ) {
+        uint8_t dram_address = ( _col + ( _row * 0x40 ) );
+
+        _controlBuffer[ length++ ] = US2066_MODE_CMD;
+        _controlBuffer[ length++ ] = US2066_CMD_DDRAM | ( dram_address & 0x7F );
+    }
+
+    _control.address = _address;
+    _control.txData = _controlBuffer;
+    _control.txLength = length;
+    _control.rxData = NULL;
+    _control.rxLength = 0;
+    _control.callback = &US2066::onRunComplete;
+    _control.context = this;
+
+    if( g_twi.submit( &_control ) == false ) {
+        return false;
+    }
+
+    _frameTransaction = &_control;
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Called by the I2C queue when a run or control transaction ends.
+ *          The frame is sent once its last queued transaction ends.
+ *
+ * @param   transaction    Run transaction
+ * 
+ */
+void US2066::onRunComplete( TwiTransaction *transaction ) {
+
+    US2066 *lcd = ( US2066* )transaction->context;
+
+    if( transaction->result != TWI_RESULT_OK ) {
+
+        if( transaction == &lcd->_control ) {
+            lcd->_stateChanged = true;
+            lcd->_positionChanged = true;
+        } else {
+            lcd->_resendAll = true;
+        }
+    }
+
+    if( transaction == lcd->_frameTransaction ) {
+        lcd->_frameTransaction = NULL;
+        lcd->_frameSentTime = micros();
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   IPrint interface callback for printing a single character. 
- *          Sends the output to the LCD module at the current coordinates.
+ *          Writes the character in the frame buffer at the current 
+ *          position, characters outside the display are dropped.
  *
  * @param   c    Character to print
  *
@@ -499,12 +803,53 @@ size_t US2066::_print( char c ) {
         this->begin();
     }
 
-    Wire.beginTransmission( _address );
+    if( _row < US2066_DISPLAY_LINES && _col < US2066_DISPLAY_COLUMNS ) {
+
+        if( _frame[ _row ][ _col ] != c ) {
+            _frame[ _row ][ _col ] = c;
+            _dirty = true;
+        }
+    }
+
+    _col++;
+
+    return 1;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   IPrint interface callback for writing a block of characters. 
+ *          Copies the characters in the frame buffer at the current 
+ *          position, characters outside the display are dropped.
+ *
+ * @param   buffer    Characters to write
+ * @param   length    Number of characters
+ *
+ * @return  Number of bytes written
+ * 
+ */
+size_t US2066::_write( const char *buffer, size_t length ) {
+    if( _init == false ) {
+        this->begin();
+    }
+
+    if( _row < US2066_DISPLAY_LINES && _col < US2066_DISPLAY_COLUMNS ) {
+        uint8_t count = US2066_DISPLAY_COLUMNS - _col;
+
+        if( length < count ) {
+            count = length;
+        }
+
+        if( memcmp( &_frame[ _row ][ _col ], buffer, count ) != 0 ) {
+            memcpy( &_frame[ _row ][ _col ], buffer, count );
+            _dirty = true;
+        }
+    }
 
-    Wire.write( US2066_MODE_DATA );
-    Wire.write( c );
+    _col = ( length < ( size_t )( 0xFF - _col )) ? _col + length : 0xFF;
 
-    return ( Wire.endTransmission() == 0 ? 1 : 0 );
+    return length;
 }
 
 
@@ -21,7 +21,7 @@
 
 #include <Arduino.h>
 #include <avr/pgmspace.h>
-#include <Wire.h>
+#include "twi.h"
 #include <resources.h>
 #include <iprint.h>
 
@@ -37,6 +37,20 @@
     #define US2066_DISPLAY_LINES    2
 #endif
 
+#ifndef US2066_DISPLAY_COLUMNS
+    #define US2066_DISPLAY_COLUMNS  16
+#endif
+
+/* Unchanged characters between two changed runs which are still sent in
+   the same transfer, cheaper than starting a new one. */
+#define US2066_FLUSH_MAX_GAP        3
+
+/* Number of runs which can be queued on the I2C bus at the same time */
+#define US2066_RUN_SLOTS            2
+
+/* Number of custom characters (CGRAM) */
+#define US2066_CUSTOM_CHARACTERS    8
+
 
 
 
@@ -154,6 +168,12 @@ typedef struct {
 
 } US2066_STATE;
 
+typedef struct {
+    TwiTransaction transaction = {};
+    uint8_t buffer[ 3 + US2066_DISPLAY_COLUMNS ];   /* DDRAM address command + data */
+
+} US2066_RUN;
+
 
 
 /*******************************************************************************
@@ -175,14 +195,42 @@ class US2066 : public IPrint {
     void setDisplay( bool on, bool reverse );
     uint8_t setCustomCharacters( const unsigned char *pchrmap );
     void fill( char c, uint8_t num );
+    void flush();
+
+    /* Gets the number of flushes which sent data to the module. */
+    uint32_t getFrameCount()                { return _frameCount; }
+
+    /* Returns whether or not the queued transactions of the last frame are sent. */
+    bool isFrameSent()                      { return _frameTransaction == NULL && _dirty == false; }
+
+    /* Gets the time the last frame was sent (us). */
+    uint32_t getFrameSentTime()             { return _frameSentTime; }
+
+    /* Gets the number of I2C transactions of the last frame. */
+    uint8_t getLastFrameTransactions()      { return _lastFrameTransactions; }
+
+    /* Gets the highest number of I2C transactions in a frame. */
+    uint8_t getMaxFrameTransactions()       { return _maxFrameTransactions; }
+
+    /* Gets the number of custom characters sent to the CGRAM. */
+    uint32_t getGlyphUploads()              { return _glyphUploads; }
+
+    /* Gets the number of custom characters already in the CGRAM. */
+    uint32_t getGlyphSkips()                { return _glyphSkips; }
 
 
   private:
     void selectInstructions( uint8_t iset );
     void updateDisplayState();
+    uint8_t getDisplayControl();
+    bool sendControl( bool moveCursor );
     uint8_t sendCommand( uint8_t cmd );
     uint8_t sendCommand( uint8_t cmd, uint8_t data );
+    bool sendRun( uint8_t row, uint8_t col, uint8_t length );
+    static void onRunComplete( TwiTransaction *transaction );
+    bool isGlyphResident( uint8_t slot, const unsigned char *glyph );
     size_t _print( char c );
+    size_t _write( const char *buffer, size_t length );
 
     bool _init = false;
     uint8_t _address = US2066_DEF_I2C_ADDR;
@@ -192,6 +240,27 @@ class US2066 : public IPrint {
     uint8_t _current_iset = US2066_ISET_STANDARD;
     FILE _lcdout = {0};
     US2066_STATE _state;
+
+    char _frame[ US2066_DISPLAY_LINES ][ US2066_DISPLAY_COLUMNS ];     /* Contents written by the application */
+    char _panel[ US2066_DISPLAY_LINES ][ US2066_DISPLAY_COLUMNS ];     /* Contents shown by the module */
+    uint8_t _row = 0;                       /* Current write position */
+    uint8_t _col = 0;
+    bool _dirty = false;                    /* Frame changed since the last flush */
+    bool _positionChanged = false;          /* Position changed since the last flush */
+    bool _stateChanged = false;             /* Cursor state changed since the last flush */
+    bool _resendAll = false;                /* A run failed, resend the whole frame */
+    US2066_RUN _runs[ US2066_RUN_SLOTS ];   /* Transfer slots of the queued runs */
+    TwiTransaction _control = {};           /* Transfer slot of the display control and cursor commands */
+    uint8_t _controlBuffer[ 4 ];
+    TwiTransaction *_frameTransaction = NULL;   /* Last queued transaction, NULL once sent */
+    uint32_t _frameSentTime = 0;
+    uint32_t _frameCount = 0;
+    uint8_t _lastFrameTransactions = 0;
+    uint8_t _maxFrameTransactions = 0;
+
+    const unsigned char *_glyphs[ US2066_CUSTOM_CHARACTERS ];     /* Glyphs (program memory) loaded in CGRAM */
+    uint32_t _glyphUploads = 0;
+    uint32_t _glyphSkips = 0;
 };
 
 void utf8ToLcdCharset( char* buffer, size_t length );
@@ -143,6 +143,35 @@ void VS1053::playData( uint8_t *buffer, size_t buffsiz ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Call a handler each time the codec requests data (DREQ rising).
+ *          The DREQ interrupt is masked during the SPI transactions of the
+ *          other devices on the bus, so the handler can send data safely.
+ *
+ * @param   handler    Interrupt handler.
+ * 
+ */
+void VS1053::attachDataInterrupt( void ( *handler )( void ) ) {
+
+    #ifdef SPI_HAS_TRANSACTION
+    SPI.usingInterrupt( digitalPinToInterrupt( _pin_dreq ) );
+    #endif
+
+    attachInterrupt( digitalPinToInterrupt( _pin_dreq ), handler, RISING );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Stop calling the data request handler.
+ * 
+ */
+void VS1053::detachDataInterrupt() {
+    detachInterrupt( digitalPinToInterrupt( _pin_dreq ) );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Set the volume attenuation in 0.5 DB increment for each channels. 
@@ -246,6 +275,22 @@ uint16_t VS1053::sciRead( uint8_t addr ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Read a word from the codec memory (parameters, GPIO).
+ *
+ * @param   addr    Address in memory.
+ *
+ * @return  Value read.
+ * 
+ */
+uint16_t VS1053::wramRead( uint16_t addr ) {
+    this->sciWrite( VS1053_REG_WRAMADDR, addr );
+
+    return this->sciRead( VS1053_REG_WRAM );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Write data the specified register.
@@ -45,6 +45,8 @@
 
 #define VS1053_INT_ENABLE       0xC01A
 
+#define VS1053_PARA_BYTERATE    0x1E05
+
 #define VS1053_MODE_SM_DIFF     0x0001
 #define VS1053_MODE_SM_LAYER12  0x0002
 #define VS1053_MODE_SM_RESET    0x0004
@@ -85,12 +87,15 @@ class VS1053 {
     bool readyForData();
     void playData( uint8_t *buffer, size_t buffsiz );
     void setVolume( uint8_t left, uint8_t right );
+    void attachDataInterrupt( void ( *handler )( void ) );
+    void detachDataInterrupt();
     void softReset();
     void reset();
 
 
   protected:
     uint16_t sciRead( uint8_t addr );
+    uint16_t wramRead( uint16_t addr );
     void sciWrite( uint8_t addr, uint16_t data );
     inline void spiwrite( uint8_t c );
     void spiwrite( uint8_t *buffer, size_t num );
@@ -250,6 +250,24 @@ int TCPClient::available() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Get the number of bytes received without polling the WiFi module
+ *          for new events. The events are handled by the WiFi service.
+ * 
+ * @return  Number of bytes available.
+ * 
+ */
+int TCPClient::buffered() {
+
+    if( _socket == -1 ) {
+        return 0;
+    }
+
+    return g_wifisocket.buffered( _socket );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Reads the next character from the packet buffer.
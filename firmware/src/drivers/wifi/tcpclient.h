@@ -46,6 +46,7 @@ class TCPClient : public Client {
     virtual size_t write( uint8_t );
     virtual size_t write( const uint8_t *buf, size_t size );
     virtual int available();
+    int buffered();
     virtual int read();
     virtual int read( uint8_t *buf, size_t size );
     virtual int peek();
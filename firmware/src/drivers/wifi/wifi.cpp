@@ -733,6 +733,23 @@ int32_t WiFi::getPingResult( IPAddress &dest ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if a task is running or if the WiFi module has events
+ *          waiting to be read (IRQ line asserted).
+ *
+ * @return  TRUE if the driver needs to run, FALSE otherwise.
+ * 
+ */
+bool WiFi::hasPendingWork() {
+    if( _init == false ) {
+        return false;
+    }
+
+    return this->isBusy() || digitalRead( gi8Winc1501IntnPin ) == LOW;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Handle WiFi module events and process running tasks.
@@ -744,6 +761,8 @@ void WiFi::runTasks() {
         return;
     }
 
+    this->setNextWake( WIFI_IDLE_WAKE );
+
     if( millis() - _lastRssiRequest > WIFI_RSSI_REQ_DELAY ) {
         _lastRssiRequest = millis();
 
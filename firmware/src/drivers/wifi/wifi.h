@@ -64,6 +64,7 @@ typedef enum {
 #define WIFI_SOCKET_CLOSE_TIMEOUT       250
 #define WIFI_PING_TIMEOUT               5000
 #define WIFI_RSSI_REQ_DELAY             5000
+#define WIFI_IDLE_WAKE                  50
 
 void wifimanager_wifi_cb( uint8_t u8MsgType, void *pvMsg );
 void wifimanager_resolve_cb( uint8 *hostName, uint32 hostIp );
@@ -95,6 +96,7 @@ class WiFi : public ITask {
     bool connected();
     wl_status_t status();
     void runTasks();
+    bool hasPendingWork();
     void handleEvent( uint8_t u8MsgType, void *pvMsg );
     void handleResolve( uint8 *hostName, uint32_t hostIp );
     void handlePingResponse( uint32 ip, uint32 rtt, uint8 error );
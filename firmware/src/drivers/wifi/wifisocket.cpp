@@ -22,6 +22,7 @@
 //******************************************************************************
 
 #include "wifisocket.h"
+#include <heap_sites.h>
 
 
 
@@ -391,6 +392,22 @@ int WiFiSocket::available( SOCKET sock ) {
 
     m2m_wifi_handle_events( NULL );
 
+    return this->buffered( sock );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the number of received bytes in the buffer without polling
+ *          the WiFi module for new events.
+ * 
+ * @param   sock    Socket ID
+ * 
+ * @return  Number of bytes available.
+ * 
+ */
+int WiFiSocket::buffered( SOCKET sock ) {
+
     if( _info[ sock ].state != SOCKET_STATE_CONNECTED && _info[ sock ].state != SOCKET_STATE_BOUND ) {
         return 0;
     }
@@ -416,7 +433,7 @@ int WiFiSocket::peek( SOCKET sock ) {
         return -1;
     }
 
-    if( available( sock ) == 0) {
+    if( this->buffered( sock ) == 0) {
         return -1;
     }
 
@@ -450,7 +467,7 @@ int WiFiSocket::read( SOCKET sock, uint8_t* buf, size_t size ) {
         return 0;
     }
 
-    int avail = available( sock );
+    int avail = this->buffered( sock );
 
     if( avail <= 0 ) {
         return 0;
@@ -632,7 +649,7 @@ sint8 WiFiSocket::close( SOCKET sock ) {
     _info[ sock ].parent = -1;
 
     if( _info[ sock ] .buffer.data != NULL ) {
-        free( _info[ sock ].buffer.data );
+        g_pool.release( _info[ sock ].buffer.data );
     }
     _info[ sock ].buffer.data = NULL;
     _info[ sock ].buffer.head = NULL;
@@ -707,7 +724,7 @@ SOCKET WiFiSocket::accepted( SOCKET sock ) {
 int WiFiSocket::fillRecvBuffer( SOCKET sock )
 {
     if( _info[ sock ].buffer.data == NULL) {
-        _info[ sock ].buffer.data = (uint8_t*)malloc( SOCKET_BUFFER_SIZE );
+        _info[ sock ].buffer.data = (uint8_t*)g_pool.alloc( SOCKET_BUFFER_SIZE, HEAP_SITE_SOCKET_BUFFER );
         _info[ sock ].buffer.head = _info[sock].buffer.data;
         _info[ sock ].buffer.length = 0;
     }
@@ -79,6 +79,7 @@ class WiFiSocket {
     uint8_t connected( SOCKET sock );
     sint8 setopt( SOCKET socket, uint8 u8Level, uint8 option_name, const void *option_value, uint16 u16OptionLen );
     int available( SOCKET sock );
+    int buffered( SOCKET sock );
     int peek( SOCKET sock );
     int read( SOCKET sock, uint8_t* buf, size_t size );
     size_t write( SOCKET sock, const uint8_t *buf, size_t size );
@@ -19,6 +19,8 @@
 #include <hardware.h>
 #include <config.h>
 #include <freemem.h>
+#include <profiler_slots.h>
+#include <isr_events.h>
 #include "services/console.h"
 #include "services/telnet_console.h"
 #include "services/ntpclient.h"
@@ -26,15 +28,17 @@
 #include "services/homeassistant.h"
 #include "services/logger.h"
 #include "services/ftpserver.h"
+#include "soundindex.h"
 #include "ui/ui.h"
 
 
 SDCardManager   g_sdcard( PIN_SD_DETECT, PIN_VS1053_SDCS );
 Alarm           g_alarm( PIN_VS1053_RESET, PIN_VS1053_CS, PIN_VS1053_XDCS, PIN_VS1053_DREQ,
                          PIN_ALARM_SW, PIN_AMP_SHDN, &g_sdcard );
+SoundIndex      g_soundIndex( &g_sdcard );
 WiFi            g_wifi( PIN_WIFI_CS, PIN_WIFI_IRQ, PIN_WIFI_RESET, PIN_WIFI_ENABLE );
-NeoClock        g_clock( PIN_NEOCLOCK, PIN_PIX_SHDN );
-Lamp            g_lamp( PIN_PIX_LAMP );
+NeoClock        g_clock( PIN_NEOCLOCK, PIN_PIX_SHDN, NEOCLOCK_OUTPUT );
+Lamp            g_lamp( PIN_PIX_LAMP, LAMP_OUTPUT );
 QT1070          g_keypad( PIN_INT_KEYPAD );
 US2066          g_lcd( I2C_ADDR_OLED, PIN_OLED_RESET );
 Power           g_power( PIN_ON_BATTERY, PIN_SYSOFF, PIN_FACTORY_RESET );
@@ -51,6 +55,8 @@ Logger          g_log;
 MqttClient      g_mqtt;
 HomeAssistant   g_homeassistant;
 FTPServer       g_ftpServer( &g_sdcard );
+LoopProfiler    g_profiler( LOOP_TIME_BUDGET );
+TaskScheduler   g_scheduler;
 
 bool g_prev_state_wifi = false;
 bool g_prev_state_telnetConsole = false;
@@ -119,9 +125,22 @@ bool checkFactoryReset() {
  */
 void setup() {
     
+    paintStack();
+
     g_log.add( EVENT_RESET, MCUSR );
     MCUSR = 0;
 
+    /* Identify the services in the event trace */
+    g_config.setTraceId( PROF_SLOT_CONFIG );
+    g_soundIndex.setTraceId( PROF_SLOT_SDCARD );
+    g_wifi.setTraceId( PROF_SLOT_WIFI );
+    g_console.setTraceId( PROF_SLOT_CONSOLE );
+    g_ntp.setTraceId( PROF_SLOT_NTP );
+    g_telnetConsole.setTraceId( PROF_SLOT_TELNET );
+    g_ftpServer.setTraceId( PROF_SLOT_FTP );
+    g_mqtt.setTraceId( PROF_SLOT_MQTT );
+    g_homeassistant.setTraceId( PROF_SLOT_HOMEASSISTANT );
+
     /* Enable watchdog timer */
     g_power.enableWatchdog();
 
@@ -131,8 +150,7 @@ void setup() {
     g_console.println_P( S_CONSOLE_INIT );
 
     /* Setup I2C */
-    Wire.begin();
-    Wire.setClock( 100000 );
+    g_twi.begin( TWI_FREQUENCY );
 
     /* Initialize power management driver */
     g_power.begin();
@@ -205,12 +223,40 @@ void setup() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Dispatch the events queued by the interrupt handlers, in the 
+ *          order they occured. WiFi events are only accounted for, the 
+ *          WINC1500 driver services its interrupt in g_wifi.
+ *
+ */
+void dispatchInterruptEvents() {
+    QueuedEvent event;
+
+    while( g_events.pop( &event ) == true ) {
+
+        switch( event.source ) {
+            case ISR_EVENT_RTC:
+                g_rtc.onInterruptEvent();
+                break;
+
+            case ISR_EVENT_KEYPAD:
+                g_keypad.onInterruptEvent( event.time );
+                break;
+        }
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   Main loop
  *
  */
 void loop() {
+    g_profiler.beginLoop( micros() );
+    g_scheduler.beginPass();
+
     g_freeMemory = freeMemory();
 
     /* Reset watchdog timer */
@@ -218,61 +264,84 @@ void loop() {
 
     /* Run power management tasks */
     g_power.detectPowerState();
+    g_battery.processEvents();
+    g_profiler.mark( PROF_SLOT_POWER, micros() );
 
-    /* Detect SD card presence */
+    /* Detect SD card presence, validate or rebuild the sound index */
     g_sdcard.detectCardPresence();
+    g_scheduler.dispatch( &g_soundIndex );
+    g_profiler.mark( PROF_SLOT_SDCARD, micros() );
+
+    /* Complete the I2C transactions */
+    g_twi.processEvents();
 
     /* If an RTC interrupt occured, read the current time */
+    dispatchInterruptEvents();
     g_rtc.processEvents();
+    g_profiler.mark( PROF_SLOT_RTC, micros() );
     
     /* Update the Clock display if needed */
     g_clock.processEvents();
+    g_profiler.mark( PROF_SLOT_CLOCK, micros() );
    
     /* Check for alarms, feed alarm audio buffer */
     g_alarm.processEvents();
+    g_profiler.mark( PROF_SLOT_ALARM, micros() );
 
     /* Process keypad events and check if screen has timed out */
     g_screen.processEvents();
+    g_profiler.mark( PROF_SLOT_SCREEN_EVENTS, micros() );
 
     /* Update the current screen if requested */
     g_screen.update();
+    g_profiler.mark( PROF_SLOT_SCREEN_UPDATE, micros() );
 
     /* Process lamp effect if lamp is active */
     g_lamp.processEvents();
+    g_profiler.mark( PROF_SLOT_LAMP, micros() );
 
     /* Run config manager tasks */
-    g_config.runTasks();
+    g_scheduler.dispatch( &g_config );
+    g_profiler.mark( PROF_SLOT_CONFIG, micros() );
 
     /* Run ambiand light sensor tasks */
     g_als.processEvents();
+    g_profiler.mark( PROF_SLOT_ALS, micros() );
 
     /* Process WIFI driver events */
-    g_wifi.runTasks();
+    g_scheduler.dispatch( &g_wifi );
+    g_profiler.mark( PROF_SLOT_WIFI, micros() );
 
     /* Process serial console inputs */
-    g_console.runTasks();
+    g_scheduler.dispatch( &g_console );
+    g_profiler.mark( PROF_SLOT_CONSOLE, micros() );
 
     /* Run NTP client tasks */
-    g_ntp.runTasks();
+    g_scheduler.dispatch( &g_ntp );
+    g_profiler.mark( PROF_SLOT_NTP, micros() );
 
     /* Process telnet server events */
-    g_telnetConsole.runTasks();
+    g_scheduler.dispatch( &g_telnetConsole );
+    g_profiler.mark( PROF_SLOT_TELNET, micros() );
 
     /* Process ftp server events */
-    g_ftpServer.runTasks();
+    g_scheduler.dispatch( &g_ftpServer );
+    g_profiler.mark( PROF_SLOT_FTP, micros() );
 
     /* Process MQTT client events */
-    g_mqtt.runTasks();
+    g_scheduler.dispatch( &g_mqtt );
+    g_profiler.mark( PROF_SLOT_MQTT, micros() );
 
     /* Push events to Home Assistant via MQTT */
-    g_homeassistant.runTasks();
+    g_scheduler.dispatch( &g_homeassistant );
+    g_profiler.mark( PROF_SLOT_HOMEASSISTANT, micros() );
 
     /* Update status icons on main display */
     if( g_telnetConsole.clientConnected() != g_prev_state_telnetConsole ) {
         g_prev_state_telnetConsole = g_telnetConsole.clientConnected();
 
         if( g_screen.getId() == SCREEN_ID_ROOT ) {
-            g_screen.requestScreenUpdate( false );
+            g_screen.invalidateRegion( ROOT_REGION_NETWORK );
         }
     }
 
@@ -280,7 +349,7 @@ void loop() {
         g_prev_state_wifi = g_wifi.connected();
 
         if( g_screen.getId() == SCREEN_ID_ROOT ) {
-            g_screen.requestScreenUpdate( false );
+            g_screen.invalidateRegion( ROOT_REGION_NETWORK );
         }
 
         if( g_screen.getId() == SCREEN_ID_NET_STATUS ) {
@@ -295,4 +364,14 @@ void loop() {
             g_screen.requestScreenUpdate( true );
         }
     }
+
+    /* Send the LCD changes made outside of the screen update */
+    g_lcd.flush();
+
+    g_profiler.mark( PROF_SLOT_STATUS_ICONS, micros() );
+    g_profiler.endLoop( micros() );
+
+    /* If no service had work to do, wait for the next interrupt. Audio 
+       playback needs the VS1053 buffer to be fed on every pass. */
+    g_scheduler.endPass( g_alarm.isPlaying() == false );
 }
\ No newline at end of file
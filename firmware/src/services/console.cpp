@@ -34,6 +34,21 @@ size_t Console::_print( char c ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   IPrint interface callback for writing a block of characters. 
+ *          Sends the output to the serial port.
+ * 
+ * @param   buffer    Characters to write
+ * @param   length    Number of characters
+ *
+ * @return  Number of bytes written
+ */
+size_t Console::_write( const char *buffer, size_t length ) {
+    return Serial.write(( const uint8_t* )buffer, length );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Reads the next character in the receive buffer.
@@ -130,3 +145,17 @@ void Console::resetConsole() {
 void Console::runTasks() {
     ConsoleBase::runTasks();
 }
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Checks if a command is running or if characters were received
+ *          on the serial port.
+ *
+ * @return  TRUE if the console needs to run, FALSE otherwise.
+ * 
+ */
+bool Console::hasPendingWork() {
+    return this->isBusy() || this->_available() > 0;
+}
\ No newline at end of file
@@ -31,12 +31,14 @@ class Console : public ConsoleBase {
 
   public:
     void runTasks();
+    bool hasPendingWork();
     void begin( unsigned long baud);
     void resetConsole();
 
 
   private:
     size_t _print( char c );
+    size_t _write( const char *buffer, size_t length );
     int _read();
     int _peek();
     int _available();
@@ -21,6 +21,8 @@
 #include <time.h>
 #include <drivers/rtc.h>
 #include <timezone.h>
+#include <heap_sites.h>
+#include <soundindex.h>
 
 
 /*******************************************************************************
@@ -68,6 +70,23 @@ char* FTPServer::uint64tostr( uint64_t value ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Get the file name part of a path.
+ * 
+ * @param   path  Path of the file
+ * 
+ * @return  Pointer to the file name in the path.
+ *
+ */
+const char* FTPServer::getBaseName( const char* path ) {
+
+    const char* name = strrchr( path, '/' );
+
+    return ( name != nullptr ) ? name + 1 : path;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Parse a timestamp argument. If a valid timestamp format is found, 
@@ -157,20 +176,16 @@ bool FTPServer::sendResponse( const char *msg, ... ) {
     char *buffer = nullptr;
     int msgLength;
 
-    if(( msgLength = vasprintf_P( &buffer, msg, args )) < 0 ) {
-
-        if( buffer != nullptr ) {
-            free( buffer );
-        }
+    msgLength = g_pool.vformat_P( &buffer, HEAP_SITE_FTP_RESPONSE, msg, args );
+    va_end( args );
 
+    if( msgLength < 0 ) {
         return false;
     }
 
-    va_end( args );
-
     int len = _control.write( buffer, msgLength );
 
-    free( buffer );
+    g_pool.release( buffer );
 
     return ( len == msgLength );
 }
@@ -317,6 +332,7 @@ void FTPServer::enableServer( bool enabled ) {
 
     if( enabled ) {
         _stateControl = FTP_STATE_WAIT_WIFI_CONNECTION;
+        this->wakeUp();
 
     } else {
         stopServer();
@@ -1089,6 +1105,8 @@ void FTPServer::processIncommingCommand( char *command, char *param ) {
         /* Delete the file or directory */
         if(( file.isDir() == true ? file.rmdir() : _sdcard->remove( param )) == true ) {
             this->sendResponse( FTP_REPLY_250_DELETED, param );
+
+            g_soundIndex.syncFile( this->getBaseName( param ));
         } else {
             this->sendResponse( FTP_REPLY_550_DELETE_FAILED, param );
         }
@@ -1182,9 +1200,15 @@ void FTPServer::processIncommingCommand( char *command, char *param ) {
             return;
         }
 
+        char name[ MAX_LENGTH_ALARM_FILENAME + 1 ];
+        _currentFile.getName( name, sizeof( name ));
+
         /* Rename the file */
         if( _currentFile.rename( param ) == true ) {
             this->sendResponse( FTP_REPLY_250_RENAMED, param );
+
+            g_soundIndex.syncFile( name );
+            g_soundIndex.syncFile( this->getBaseName( param ));
         } else {
             this->sendResponse( FTP_REPLY_450_CANT_RENAME, param );
         }
@@ -1548,12 +1572,12 @@ void FTPServer::sendDirectoryEntry( TCPClient *client, FsFile* file, char* filen
            display the month, day, hour and minute if more recent. */
         if(( now - 16070400 ) > mdate ) {
 
-            length = asprintf_P( &buffer, PSTR( "%s  1 %s ftpusers %13s %S %2d %5d %s\r\n" ), 
+            length = g_pool.format_P( &buffer, HEAP_SITE_FTP_LISTING, PSTR( "%s  1 %s ftpusers %13s %S %2d %5d %s\r\n" ), 
                             perms, g_config.network.ftp_username, this->uint64tostr( file->fileSize() ),
                             getMonthName( mdate.month(), true ), mdate.day(), mdate.year(), 
                             pfname );
         } else {
-            length = asprintf_P( &buffer, PSTR( "%s  1 %s ftpusers %13s %S %2d %02d:%02d %s\r\n" ), 
+            length = g_pool.format_P( &buffer, HEAP_SITE_FTP_LISTING, PSTR( "%s  1 %s ftpusers %13s %S %2d %02d:%02d %s\r\n" ), 
                             perms, g_config.network.ftp_username, this->uint64tostr( file->fileSize() ),
                             getMonthName( mdate.month(), true ), mdate.day(), mdate.hour(), mdate.minute(),
                             pfname );
@@ -1561,7 +1585,7 @@ void FTPServer::sendDirectoryEntry( TCPClient *client, FsFile* file, char* filen
         
     /* Name list only (NLST) */
     } else if( listType == FTP_LIST_TYPE_NAMES ) {
-        length = asprintf_P( &buffer, PSTR( "%s\r\n" ), pfname );
+        length = g_pool.format_P( &buffer, HEAP_SITE_FTP_LISTING, PSTR( "%s\r\n" ), pfname );
 
     /* Machine listing type (MLSD/MLST) */
     } else {
@@ -1569,7 +1593,7 @@ void FTPServer::sendDirectoryEntry( TCPClient *client, FsFile* file, char* filen
         const char *fmt = PSTR( "Type=%S;Size=%s;Modify=%d%02d%02d%02d%02d00;Create=%d%02d%02d%02d%02d00;"
                                 "Perm=%s;UNIX.owner=%s;UNIX.group=ftpusers %s\r\n" );
         
-        length = asprintf_P( &buffer, fmt, 
+        length = g_pool.format_P( &buffer, HEAP_SITE_FTP_LISTING, fmt, 
                              file->isDir() == true ? PSTR( "dir") : PSTR( "file" ),
                              this->uint64tostr( file->fileSize() ),
                              mdate.year(), mdate.month(), mdate.day(), mdate.hour(), mdate.minute(),
@@ -1579,7 +1603,7 @@ void FTPServer::sendDirectoryEntry( TCPClient *client, FsFile* file, char* filen
     
     client->write( buffer, length );
 
-    free( buffer );
+    g_pool.release( buffer );
 
     if( filename == nullptr ) {
         free( pfname );
@@ -1821,6 +1845,39 @@ void FTPServer::handleDataConnState() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if the server has work to do. While waiting for WiFi, 
+ *          listening or serving an idle client, the connection state is
+ *          checked on a timer.
+ *
+ * @return  TRUE if the server needs to run, FALSE otherwise.
+ * 
+ */
+bool FTPServer::hasPendingWork() {
+    if( _serverEnabled == false ) {
+        return false;
+    }
+
+    /* Transfer or directory listing in progress */
+    if( this->isBusy() == true ) {
+        return true;
+    }
+
+    switch( _stateControl ) {
+        case FTP_STATE_WAIT_WIFI_CONNECTION:
+        case FTP_STATE_LISTENING:
+            return false;
+
+        case FTP_STATE_CONNECTED:
+            return _control.buffered() > 0;
+
+        default:
+            return true;
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   Run server tasks.
@@ -1831,6 +1888,8 @@ void FTPServer::runTasks() {
         return;
     }
 
+    this->setNextWake( FTP_IDLE_WAKE );
+
     /* Stop server if WiFi connection is lost. */
     if( g_wifi.connected() == false && _stateControl != FTP_STATE_WAIT_WIFI_CONNECTION ) {
         
@@ -1894,50 +1953,54 @@ void FTPServer::runTasks() {
         case FTP_TASK_MACHINE_LISTING:
         case FTP_TASK_NAME_LISTING: {
 
-            /* Go to the next file in the directory */
-            FsFile file;
-            file.openNext( &_currentFile, O_READ );
+            /* Send as many entries as fits in the time slice */
+            do {
+                /* Go to the next file in the directory */
+                FsFile file;
+                file.openNext( &_currentFile, O_READ );
 
-            /* End of directory listing, close data connection */
-            if( file.isOpen() == false ) {
+                /* End of directory listing, close data connection */
+                if( file.isOpen() == false ) {
                 
-                this->endDataMode();
-                _currentFile.close();
+                    this->endDataMode();
+                    _currentFile.close();
 
-                if( this->getCurrentTask() == FTP_TASK_DIR_STAT ) {
-                    this->sendResponse( FTP_REPLY_212_DIR_STAT_END );
-                } else {
-                    this->sendResponse( FTP_REPLY_226_LIST_END, _nmatches );
-                }
+                    if( this->getCurrentTask() == FTP_TASK_DIR_STAT ) {
+                        this->sendResponse( FTP_REPLY_212_DIR_STAT_END );
+                    } else {
+                        this->sendResponse( FTP_REPLY_226_LIST_END, _nmatches );
+                    }
 
-                this->endTask( TASK_SUCCESS );
-                return;
-            }
+                    this->endTask( TASK_SUCCESS );
+                    return;
+                }
 
-            /* Generate directory list entry with the specified format */
-            switch( this->getCurrentTask() ) {
+                /* Generate directory list entry with the specified format */
+                switch( this->getCurrentTask() ) {
                 
-                case FTP_TASK_DIR_STAT:
+                    case FTP_TASK_DIR_STAT:
 
-                    /* For STAT, the listing is sent over control connection 
-                    instead of the data connection */
-                    this->sendDirectoryEntry( &_control, &file, nullptr, FTP_LIST_TYPE_UNIX );
-                    break;
+                        /* For STAT, the listing is sent over control connection 
+                        instead of the data connection */
+                        this->sendDirectoryEntry( &_control, &file, nullptr, FTP_LIST_TYPE_UNIX );
+                        break;
 
-                case FTP_TASK_UNIX_LISTING:
-                    this->sendDirectoryEntry( &_data, &file, nullptr, FTP_LIST_TYPE_UNIX );
-                    break;
+                    case FTP_TASK_UNIX_LISTING:
+                        this->sendDirectoryEntry( &_data, &file, nullptr, FTP_LIST_TYPE_UNIX );
+                        break;
 
-                case FTP_TASK_NAME_LISTING:
-                    this->sendDirectoryEntry( &_data, &file, nullptr, FTP_LIST_TYPE_NAMES );
-                    break;
+                    case FTP_TASK_NAME_LISTING:
+                        this->sendDirectoryEntry( &_data, &file, nullptr, FTP_LIST_TYPE_NAMES );
+                        break;
 
-                default:
-                    this->sendDirectoryEntry( &_data, &file, nullptr, FTP_LIST_TYPE_MACHINE );
-                    break;
-            }
+                    default:
+                        this->sendDirectoryEntry( &_data, &file, nullptr, FTP_LIST_TYPE_MACHINE );
+                        break;
+                }
+
+                _nmatches++;
 
-            _nmatches++;
+            } while( this->budgetRemaining() == true );
         }
         break;
 
@@ -1945,39 +2008,43 @@ void FTPServer::runTasks() {
         /* -------------------------------------------------- */
         case FTP_TASK_DOWNLOAD: {
             
-            /* Allocate the buffer for the next block */
-            char* buffer = ( char* )malloc( min( MAX_FTP_TRANSFER_BUFFER, _currentFile.available() ));
-            if( buffer == nullptr ) {
+            /* Send as many blocks as fits in the time slice */
+            do {
+                /* Allocate the buffer for the next block */
+                char* buffer = ( char* )g_pool.alloc( min( MAX_FTP_TRANSFER_BUFFER, _currentFile.available() ), HEAP_SITE_FTP_TRANSFER );
+                if( buffer == nullptr ) {
 
-                this->endDataMode();
-                _currentFile.close();
+                    this->endDataMode();
+                    _currentFile.close();
 
-                this->sendResponse( FTP_REPLY_421_ALLOC_ERROR );
+                    this->sendResponse( FTP_REPLY_421_ALLOC_ERROR );
 
-                this->endTask( ERR_FTP_ALLOCATE_ERROR );
-                return;
-            }
+                    this->endTask( ERR_FTP_ALLOCATE_ERROR );
+                    return;
+                }
 
-            /* Read the file block */
-            size_t nread = _currentFile.read( buffer, min( MAX_FTP_TRANSFER_BUFFER, _currentFile.available() ));
+                /* Read the file block */
+                size_t nread = _currentFile.read( buffer, min( MAX_FTP_TRANSFER_BUFFER, _currentFile.available() ));
 
-            if( nread > 0 ) {
+                if( nread > 0 ) {
 
-                /* Send the file data */
-                _data.write( buffer, nread );
-                free( buffer );
+                    /* Send the file data */
+                    _data.write( buffer, nread );
+                    g_pool.release( buffer );
 
-            } else {
-                free( buffer );
+                } else {
+                    g_pool.release( buffer );
 
-                this->endDataMode();
-                _currentFile.close();
+                    this->endDataMode();
+                    _currentFile.close();
 
-                this->sendResponse( FTP_REPLY_226_XFER_DONE );
+                    this->sendResponse( FTP_REPLY_226_XFER_DONE );
                 
-                this->endTask( TASK_SUCCESS );
-                return;
-            }
+                    this->endTask( TASK_SUCCESS );
+                    return;
+                }
+
+            } while( this->budgetRemaining() == true );
         }
         break;
             
@@ -1986,12 +2053,17 @@ void FTPServer::runTasks() {
         case FTP_TASK_UPLOAD: {
 
             int nbytes;
-            nbytes = min( _data.available(), MAX_FTP_TRANSFER_BUFFER );
 
-            if( nbytes > 0 ) {
+            /* Receive as many blocks as fits in the time slice */
+            do {
+                nbytes = min( _data.available(), MAX_FTP_TRANSFER_BUFFER );
+
+                if( nbytes <= 0 ) {
+                    break;
+                }
 
                 /* Allocate the buffer for the next block */
-                char* buffer = ( char* )malloc( nbytes );
+                char* buffer = ( char* )g_pool.alloc( nbytes, HEAP_SITE_FTP_TRANSFER );
                 if( buffer == nullptr ) {
 
                     this->endDataMode();
@@ -2011,16 +2083,22 @@ void FTPServer::runTasks() {
                     _currentFile.write( buffer, nbytes );
                 }
 
-                free( buffer );
-            }
+                g_pool.release( buffer );
+
+            } while( this->budgetRemaining() == true );
 
             if( _data.connected() == 0 ) {
 
+                char name[ MAX_LENGTH_ALARM_FILENAME + 1 ];
+                _currentFile.getName( name, sizeof( name ));
+
                 this->endDataMode();
                 _currentFile.close();
 
                 this->sendResponse( FTP_REPLY_226_XFER_DONE );
 
+                g_soundIndex.syncFile( name );
+
                 this->endTask( TASK_SUCCESS );
             }
         }
@@ -33,6 +33,7 @@
 
 /* Timing */
 #define FTP_DATA_CONNECT_TIMEOUT            10000       /* Maximum amount of time to wait for a client data connection. */
+#define FTP_IDLE_WAKE                       100         /* Connection check interval while no transfer is running. */
 
 /* Limits */
 #define MAX_FTP_TRANSFER_BUFFER             1024        /* Maximum chunk size when downloading/uploading a file. */
@@ -204,11 +205,12 @@ enum {
  * @brief   Provides access to SD card files via FTP.
  * 
  *******************************************************************************/
-class FTPServer : private ITask {
+class FTPServer : public ITask {
 
   public:
     FTPServer( SDCardManager* sdcard );
     void runTasks();
+    bool hasPendingWork();
     bool startServer();
     void stopServer();
     bool clientConnected();
@@ -217,6 +219,8 @@ class FTPServer : private ITask {
     void printServerStatus( ConsoleBase *console );
 
   private:
+    friend class BenchAccess;               /* Host benchmarks (bench/) */
+
     void handleControlConnState();
     void handleDataConnState();
     bool setWorkingDirectory( const char *dirname );
@@ -230,6 +234,7 @@ class FTPServer : private ITask {
     bool sendResponse( const char *msg, ... );
     void closeSession();
     char* uint64tostr( uint64_t value );
+    const char* getBaseName( const char* path );
     bool parseParamTimestamp( char **buffer, uint16_t *year, uint8_t *month, uint8_t *day, uint8_t *hour, uint8_t *minute, uint8_t *second );
     
     SOCKET _listenerControl;
@@ -22,6 +22,7 @@
 #include "timezone.h"
 #include "ui/ui.h"
 #include "drivers/us2066.h"
+#include <heap_sites.h>
 
 
 
@@ -100,6 +101,16 @@ bool HomeAssistant::updateSensor( uint8_t sensorID, bool force ) {
         return false;
     }
 
+#if HASS_AUDIO_SENSORS == 1
+    /* Audio playback sensors are only published when an alarm ends */
+    if( sensorID >= SENSOR_ID_AUDIO_UNDERRUNS && sensorID <= SENSOR_ID_AUDIO_START_LATENCY ) {
+
+        if( force == false || g_alarm.getAudioStats()->count == 0 ) {
+            return false;
+        }
+    }
+#endif
+
     if( force == false ) {
         switch( sensorID ) {
 
@@ -130,6 +141,16 @@ bool HomeAssistant::updateSensor( uint8_t sensorID, bool force ) {
             }
             break;            
 
+            /* Main loop statistics sensors */
+            case SENSOR_ID_LOOP_TIME_MAX:
+            case SENSOR_ID_LOOP_OVER_BUDGET: {
+
+                if( millis() - _prevTimestampLoopStats < MAX_UPDATE_RATE_LOOP_STATS ) {
+                    return false;
+                }
+            }
+            break;
+
             /* Battery status sensor */
             case SENSOR_ID_BATTERY_STATUS: {
                 
@@ -259,12 +280,53 @@ void HomeAssistant::sendNextSensorConfig() {
             topic_len = strlen_P( S_TOPIC_CMD_LCD_MSG ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
             break;
 
+#if HASS_PERF_SENSORS == 1
+        case SENSOR_ID_LOOP_TIME_MAX:
+            isSubscribeTopic = false;
+            topic_len = strlen_P( S_TOPIC_CONFIG_LOOP_TIME_MAX ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = strlen_P( S_JSON_CONFIG_LOOP_TIME_MAX ) + ( strlen( g_config.network.discovery_prefix ) * 2 ) + ( MAX_HA_DEVICE_ID_LENGTH * 4 ) + 1;
+            break;
+
+        case SENSOR_ID_LOOP_OVER_BUDGET:
+            isSubscribeTopic = false;
+            topic_len = strlen_P( S_TOPIC_CONFIG_LOOP_OVERRUN ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = strlen_P( S_JSON_CONFIG_LOOP_OVERRUN ) + ( strlen( g_config.network.discovery_prefix ) * 2 ) + ( MAX_HA_DEVICE_ID_LENGTH * 4 ) + 1;
+            break;
+#endif
+
+#if HASS_AUDIO_SENSORS == 1
+        case SENSOR_ID_AUDIO_UNDERRUNS:
+            isSubscribeTopic = false;
+            topic_len = strlen_P( S_TOPIC_CONFIG_AUDIO_UNDERRUNS ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = strlen_P( S_JSON_CONFIG_AUDIO_UNDERRUNS ) + ( strlen( g_config.network.discovery_prefix ) * 2 ) + ( MAX_HA_DEVICE_ID_LENGTH * 4 ) + 1;
+            break;
+
+        case SENSOR_ID_AUDIO_DATA_RATE:
+            isSubscribeTopic = false;
+            topic_len = strlen_P( S_TOPIC_CONFIG_AUDIO_DATA_RATE ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = strlen_P( S_JSON_CONFIG_AUDIO_DATA_RATE ) + ( strlen( g_config.network.discovery_prefix ) * 2 ) + ( MAX_HA_DEVICE_ID_LENGTH * 4 ) + 1;
+            break;
+
+        case SENSOR_ID_AUDIO_BITRATE:
+            isSubscribeTopic = false;
+            topic_len = strlen_P( S_TOPIC_CONFIG_AUDIO_BITRATE ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = strlen_P( S_JSON_CONFIG_AUDIO_BITRATE ) + ( strlen( g_config.network.discovery_prefix ) * 2 ) + ( MAX_HA_DEVICE_ID_LENGTH * 4 ) + 1;
+            break;
+
+        case SENSOR_ID_AUDIO_START_LATENCY:
+            isSubscribeTopic = false;
+            topic_len = strlen_P( S_TOPIC_CONFIG_AUDIO_LATENCY ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = strlen_P( S_JSON_CONFIG_AUDIO_LATENCY ) + ( strlen( g_config.network.discovery_prefix ) * 2 ) + ( MAX_HA_DEVICE_ID_LENGTH * 4 ) + 1;
+            break;
+#endif
+
         /* Sendor does not need to send a configuration topic */
         default:
             return;
     }
 
     /* Allocate buffer for topic */
+    g_heap.setSite( HEAP_SITE_HASS );
     topic = ( char* )malloc( topic_len );
     if( topic == nullptr ) {
         return;
@@ -274,6 +336,7 @@ void HomeAssistant::sendNextSensorConfig() {
        topic to subscribe to. */
     if( isSubscribeTopic == false ) {
     
+        g_heap.setSite( HEAP_SITE_HASS );
         payload = ( char* )malloc( payload_len );
 
         if( payload == nullptr ) {
@@ -374,6 +437,82 @@ void HomeAssistant::sendNextSensorConfig() {
             
         }
         break;
+
+#if HASS_PERF_SENSORS == 1
+        /* Main loop maximum time sensor config */
+        case SENSOR_ID_LOOP_TIME_MAX: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_CONFIG_LOOP_TIME_MAX, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_JSON_CONFIG_LOOP_TIME_MAX,
+                _ha_device_id,
+                g_config.network.discovery_prefix, _ha_device_id, 
+                g_config.network.discovery_prefix, _ha_device_id, 
+                _ha_device_id );
+        }
+        break;
+
+        /* Main loop over budget count sensor config */
+        case SENSOR_ID_LOOP_OVER_BUDGET: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_CONFIG_LOOP_OVERRUN, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_JSON_CONFIG_LOOP_OVERRUN,
+                _ha_device_id,
+                g_config.network.discovery_prefix, _ha_device_id, 
+                g_config.network.discovery_prefix, _ha_device_id, 
+                _ha_device_id );
+        }
+        break;
+#endif
+
+#if HASS_AUDIO_SENSORS == 1
+        /* Alarm audio underruns count sensor config */
+        case SENSOR_ID_AUDIO_UNDERRUNS: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_CONFIG_AUDIO_UNDERRUNS, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_JSON_CONFIG_AUDIO_UNDERRUNS,
+                _ha_device_id,
+                g_config.network.discovery_prefix, _ha_device_id, 
+                g_config.network.discovery_prefix, _ha_device_id, 
+                _ha_device_id );
+        }
+        break;
+
+        /* Alarm audio data rate sensor config */
+        case SENSOR_ID_AUDIO_DATA_RATE: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_CONFIG_AUDIO_DATA_RATE, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_JSON_CONFIG_AUDIO_DATA_RATE,
+                _ha_device_id,
+                g_config.network.discovery_prefix, _ha_device_id, 
+                g_config.network.discovery_prefix, _ha_device_id, 
+                _ha_device_id );
+        }
+        break;
+
+        /* Alarm audio stream bitrate sensor config */
+        case SENSOR_ID_AUDIO_BITRATE: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_CONFIG_AUDIO_BITRATE, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_JSON_CONFIG_AUDIO_BITRATE,
+                _ha_device_id,
+                g_config.network.discovery_prefix, _ha_device_id, 
+                g_config.network.discovery_prefix, _ha_device_id, 
+                _ha_device_id );
+        }
+        break;
+
+        /* Alarm audio start latency sensor config */
+        case SENSOR_ID_AUDIO_START_LATENCY: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_CONFIG_AUDIO_LATENCY, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_JSON_CONFIG_AUDIO_LATENCY,
+                _ha_device_id,
+                g_config.network.discovery_prefix, _ha_device_id, 
+                g_config.network.discovery_prefix, _ha_device_id, 
+                _ha_device_id );
+        }
+        break;
+#endif
     }
     
     if( isSubscribeTopic == true ) {
@@ -456,13 +595,49 @@ void HomeAssistant::sendNextSensorState() {
             payload_len = MAX_PAYLOAD_BATTERY_VOLTAGE_LENGTH + 1;
             break;
 
+#if HASS_PERF_SENSORS == 1
+        case SENSOR_ID_LOOP_TIME_MAX:
+            topic_len = strlen_P( S_TOPIC_STATE_LOOP_TIME_MAX ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = MAX_PAYLOAD_LOOP_STATS_LENGTH + 1;
+            break;
+
+        case SENSOR_ID_LOOP_OVER_BUDGET:
+            topic_len = strlen_P( S_TOPIC_STATE_LOOP_OVERRUN ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = MAX_PAYLOAD_LOOP_STATS_LENGTH + 1;
+            break;
+#endif
+
+#if HASS_AUDIO_SENSORS == 1
+        case SENSOR_ID_AUDIO_UNDERRUNS:
+            topic_len = strlen_P( S_TOPIC_STATE_AUDIO_UNDERRUNS ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = MAX_PAYLOAD_AUDIO_STATS_LENGTH + 1;
+            break;
+
+        case SENSOR_ID_AUDIO_DATA_RATE:
+            topic_len = strlen_P( S_TOPIC_STATE_AUDIO_DATA_RATE ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = MAX_PAYLOAD_AUDIO_STATS_LENGTH + 1;
+            break;
+
+        case SENSOR_ID_AUDIO_BITRATE:
+            topic_len = strlen_P( S_TOPIC_STATE_AUDIO_BITRATE ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = MAX_PAYLOAD_AUDIO_STATS_LENGTH + 1;
+            break;
+
+        case SENSOR_ID_AUDIO_START_LATENCY:
+            topic_len = strlen_P( S_TOPIC_STATE_AUDIO_LATENCY ) + strlen( g_config.network.discovery_prefix ) + MAX_HA_DEVICE_ID_LENGTH + 1;
+            payload_len = MAX_PAYLOAD_AUDIO_STATS_LENGTH + 1;
+            break;
+#endif
+
         /* Sensor does not have a state to send */
         default:
             return;
     }
 
+    g_heap.setSite( HEAP_SITE_HASS );
     topic = ( char* )malloc( topic_len );
 
+    g_heap.setSite( HEAP_SITE_HASS );
     payload = ( char* )malloc( payload_len );
     memset( payload, 0, payload_len );
 
@@ -600,6 +775,66 @@ void HomeAssistant::sendNextSensorState() {
             _prevTimestampBatteryStatus = millis();
         }
         break;
+
+#if HASS_PERF_SENSORS == 1
+        /* Main loop maximum time sensor */
+        case SENSOR_ID_LOOP_TIME_MAX: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_STATE_LOOP_TIME_MAX, g_config.network.discovery_prefix, _ha_device_id );
+
+            uint32_t loop_max;
+            loop_max = g_profiler.getLoopSlot()->max;
+
+            snprintf_P( payload, payload_len, S_PAYLOAD_MILLISEC, loop_max / 1000, loop_max % 1000 );
+
+            _prevTimestampLoopStats = millis();
+        }
+        break;
+
+        /* Main loop over budget count sensor */
+        case SENSOR_ID_LOOP_OVER_BUDGET: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_STATE_LOOP_OVERRUN, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_PAYLOAD_ULONG, g_profiler.getOverBudgetCount() );
+
+            _prevTimestampLoopStats = millis();
+        }
+        break;
+#endif
+
+#if HASS_AUDIO_SENSORS == 1
+        /* Alarm audio underruns count sensor */
+        case SENSOR_ID_AUDIO_UNDERRUNS: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_STATE_AUDIO_UNDERRUNS, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_PAYLOAD_ULONG, g_alarm.getAudioStats()->underruns );
+        }
+        break;
+
+        /* Alarm audio data rate sensor */
+        case SENSOR_ID_AUDIO_DATA_RATE: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_STATE_AUDIO_DATA_RATE, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_PAYLOAD_ULONG, g_alarm.getAudioDataRate() );
+        }
+        break;
+
+        /* Alarm audio stream bitrate sensor */
+        case SENSOR_ID_AUDIO_BITRATE: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_STATE_AUDIO_BITRATE, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_PAYLOAD_ULONG, ( g_alarm.getAudioStats()->byteRate * 8UL ) / 1000 );
+        }
+        break;
+
+        /* Alarm audio start latency sensor */
+        case SENSOR_ID_AUDIO_START_LATENCY: {
+
+            snprintf_P( topic, topic_len, S_TOPIC_STATE_AUDIO_LATENCY, g_config.network.discovery_prefix, _ha_device_id );
+            snprintf_P( payload, payload_len, S_PAYLOAD_ULONG, ( uint32_t )g_alarm.getAudioStats()->startLatency );
+        }
+        break;
+#endif
     }
 
     /* Publis state topic */
@@ -610,6 +845,19 @@ void HomeAssistant::sendNextSensorState() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if a task other than waiting for the broker connection
+ *          is running. Sensors are checked for updates on a timer.
+ *
+ * @return  TRUE if the client needs to run, FALSE otherwise.
+ * 
+ */
+bool HomeAssistant::hasPendingWork() {
+    return this->isBusy() && this->getCurrentTask() != TASK_HOMEASSISTANT_WAIT_MQTT_CONNECT;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Execute the current task
@@ -617,6 +865,8 @@ void HomeAssistant::sendNextSensorState() {
  */
 void HomeAssistant::runTasks() {
 
+    this->setNextWake( HASS_IDLE_WAKE );
+
     /* update sensors */
     if( g_mqtt.connected() == true ) {
         
@@ -624,6 +874,12 @@ void HomeAssistant::runTasks() {
         this->updateSensor( SENSOR_ID_BATTERY_CHARGE );
         this->updateSensor( SENSOR_ID_BATTERY_STATUS );
         this->updateSensor( SENSOR_ID_BATTERY_VOLT );
+
+#if HASS_PERF_SENSORS == 1
+        if( this->updateSensor( SENSOR_ID_LOOP_TIME_MAX ) == true ) {
+            this->updateSensor( SENSOR_ID_LOOP_OVER_BUDGET, true );
+        }
+#endif
     }
 
     /* If connection to broker is lost, start wait connect task */
@@ -652,24 +908,28 @@ void HomeAssistant::runTasks() {
         /* Publishing sensor configuration  */
         case TASK_HOMEASSISTANT_SEND_SENSOR_CONFIG: {
 
-            /* Wait for current sensor config publish to complete */
-            if (g_mqtt.isBusy() == true ) {
-                return;
-            }
+            /* Publish as many sensor configurations as fits in the time slice */
+            do {
+                /* Wait for current sensor config publish to complete */
+                if (g_mqtt.isBusy() == true ) {
+                    return;
+                }
 
-            _taskCurrentSensorID++;
+                _taskCurrentSensorID++;
 
-            /* End of sensor list */
-            if( _taskCurrentSensorID > MAX_SENSORS_ID ) {
-                this->endTask( TASK_SUCCESS );
+                /* End of sensor list */
+                if( _taskCurrentSensorID > MAX_SENSORS_ID ) {
+                    this->endTask( TASK_SUCCESS );
 
-                /* Force publish all sensors states */
-                this->updateAllSensors( true );
-                return;
-            }
+                    /* Force publish all sensors states */
+                    this->updateAllSensors( true );
+                    return;
+                }
 
-            /* Publish the configuration of the next sensor in the list */
-            this->sendNextSensorConfig();
+                /* Publish the configuration of the next sensor in the list */
+                this->sendNextSensorConfig();
+
+            } while( this->budgetRemaining() == true );
         }
         break;
 
@@ -677,21 +937,25 @@ void HomeAssistant::runTasks() {
         /* Publishing sensor states  */
         case TASK_HOMEASSISTANT_SEND_SENSOR_STATES: {
 
-            /* Wait for current sensor state publish to complete */
-            if (g_mqtt.isBusy() == true ) {
-                return;
-            }
+            /* Publish as many sensor states as fits in the time slice */
+            do {
+                /* Wait for current sensor state publish to complete */
+                if (g_mqtt.isBusy() == true ) {
+                    return;
+                }
 
-            _taskCurrentSensorID++;
+                _taskCurrentSensorID++;
 
-            /* End of sensor list */
-            if( _taskCurrentSensorID > MAX_SENSORS_ID ) {
-                this->endTask( TASK_SUCCESS );
-                return;
-            }
+                /* End of sensor list */
+                if( _taskCurrentSensorID > MAX_SENSORS_ID ) {
+                    this->endTask( TASK_SUCCESS );
+                    return;
+                }
+
+                /* Publish the state of the next sensor in the list */
+                this->sendNextSensorState();
 
-            /* Publish the state of the next sensor in the list */
-            this->sendNextSensorState();
+            } while( this->budgetRemaining() == true );
 
         }
         break;
@@ -716,6 +980,7 @@ void handleHassTopicCallback( char* topic, size_t topicLength, char* payload, si
     char* topic_cmp;
 
     /* Allocate memory for the topic compare. */
+    g_heap.setSite( HEAP_SITE_HASS );
     topic_cmp = ( char* )malloc( topicLength + 1 );
     if( topic_cmp == nullptr ) {
         return;
@@ -732,7 +997,7 @@ void handleHassTopicCallback( char* topic, size_t topicLength, char* payload, si
         strncpy( g_homeassistant.lcd_message, payload, payloadLength );
 
         if( g_screen.getId() == SCREEN_ID_ROOT ) {
-            g_screen.requestScreenUpdate( false );
+            g_screen.invalidateRegion( ROOT_REGION_MESSAGE );
         }
     }
 
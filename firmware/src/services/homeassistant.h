@@ -27,6 +27,7 @@
 #include "services/mqtt.h"
 #include "config.h"
 #include "alarm.h"
+#include "profiler_slots.h"
 
 
 
@@ -39,6 +40,18 @@
 #define MAX_PAYLOAD_BATTERY_STATUS_LENGTH   11  /* Battery status */
 #define MAX_PAYLOAD_BATTERY_VOLTAGE_LENGTH  5   /* Battery voltage (0.000) */
 #define MAX_PAYLOAD_LCD_MESSAGE_LENGTH      10  
+#define MAX_PAYLOAD_LOOP_STATS_LENGTH       11  /* Loop statistics (max 7 digits + 3 decimals) */
+#define MAX_PAYLOAD_AUDIO_STATS_LENGTH      10  /* Audio playback statistics (32-bit integer) */
+
+/* Publish main loop statistics as diagnostic sensors */
+#ifndef HASS_PERF_SENSORS
+#define HASS_PERF_SENSORS                   1
+#endif
+
+/* Publish the audio playback statistics of the last alarm as diagnostic sensors */
+#ifndef HASS_AUDIO_SENSORS
+#define HASS_AUDIO_SENSORS                  1
+#endif
 
 
 /* Sensor maximum update rate */
@@ -46,6 +59,10 @@
 #define MAX_UPDATE_RATE_BATTERY_CHARGE      60000
 #define MAX_UPDATE_RATE_BATTERY_STATUS      1000
 #define MAX_UPDATE_RATE_BATTERY_VOLTAGE     60000
+#define MAX_UPDATE_RATE_LOOP_STATS          60000
+
+/* Sensors update check interval (ms) */
+#define HASS_IDLE_WAKE                      250
 
 /* Topic name maxmimum length */
 #define MAX_WILL_TOPIC_LENGTH               15 + MAX_HA_DEVICE_ID_LENGTH + MAX_DISCOVERY_PREFIX_LENGTH
@@ -65,6 +82,12 @@ enum HASensorsIDs {
     SENSOR_ID_BATTERY_VOLT,
     SENSOR_ID_LCD_MESSAGE,
     SENSOR_ID_LCD_MESSAGE_SET,
+    SENSOR_ID_LOOP_TIME_MAX,
+    SENSOR_ID_LOOP_OVER_BUDGET,
+    SENSOR_ID_AUDIO_UNDERRUNS,
+    SENSOR_ID_AUDIO_DATA_RATE,
+    SENSOR_ID_AUDIO_BITRATE,
+    SENSOR_ID_AUDIO_START_LATENCY,
     SENSOR_ID_AVAILABILITY
 };
 
@@ -81,6 +104,8 @@ PROG_STR( S_PAYLOAD_AVAIL_OFFLINE,      "offline" );
 PROG_STR( S_PAYLOAD_SWITCH_ON,          "ON" );
 PROG_STR( S_PAYLOAD_SWITCH_OFF,         "OFF" );
 PROG_STR( S_PAYLOAD_INTEGER,            "%d" );
+PROG_STR( S_PAYLOAD_ULONG,              "%lu" );
+PROG_STR( S_PAYLOAD_MILLISEC,           "%lu.%03lu" );
 PROG_STR( S_PAYLOAD_VOLTAGE,            "%1d.%03d" );
 PROG_STR( S_PAYLOAD_TIMESTAMP,          "%4d-%02d-%02dT%02d:%02d:00+00:00" );
 PROG_STR( S_PAYLOAD_BATT_CHARGING,      "charging" );
@@ -110,6 +135,18 @@ PROG_STR( S_TOPIC_CONFIG_BATTERY_VOLT,  "%s/sensor/%s/clock_battery_voltage/conf
 PROG_STR( S_TOPIC_STATE_BATTERY_VOLT,   "%s/sensor/%s/clock_battery_voltage/state" );
 PROG_STR( S_TOPIC_CONFIG_LCD_MSG,       "%s/text/%s/clock_lcd_msg/config" );
 PROG_STR( S_TOPIC_CMD_LCD_MSG,          "%s/text/%s/clock_lcd_msg/set" );
+PROG_STR( S_TOPIC_CONFIG_LOOP_TIME_MAX, "%s/sensor/%s/clock_loop_time_max/config" );
+PROG_STR( S_TOPIC_STATE_LOOP_TIME_MAX,  "%s/sensor/%s/clock_loop_time_max/state" );
+PROG_STR( S_TOPIC_CONFIG_LOOP_OVERRUN,  "%s/sensor/%s/clock_loop_overrun/config" );
+PROG_STR( S_TOPIC_STATE_LOOP_OVERRUN,   "%s/sensor/%s/clock_loop_overrun/state" );
+PROG_STR( S_TOPIC_CONFIG_AUDIO_UNDERRUNS,"%s/sensor/%s/clock_audio_underruns/config" );
+PROG_STR( S_TOPIC_STATE_AUDIO_UNDERRUNS, "%s/sensor/%s/clock_audio_underruns/state" );
+PROG_STR( S_TOPIC_CONFIG_AUDIO_DATA_RATE,"%s/sensor/%s/clock_audio_data_rate/config" );
+PROG_STR( S_TOPIC_STATE_AUDIO_DATA_RATE, "%s/sensor/%s/clock_audio_data_rate/state" );
+PROG_STR( S_TOPIC_CONFIG_AUDIO_BITRATE, "%s/sensor/%s/clock_audio_bitrate/config" );
+PROG_STR( S_TOPIC_STATE_AUDIO_BITRATE,  "%s/sensor/%s/clock_audio_bitrate/state" );
+PROG_STR( S_TOPIC_CONFIG_AUDIO_LATENCY, "%s/sensor/%s/clock_audio_latency/config" );
+PROG_STR( S_TOPIC_STATE_AUDIO_LATENCY,  "%s/sensor/%s/clock_audio_latency/state" );
 PROG_STR( S_TOPIC_AVAILABILITY,         "%s/sensor/%s/status" );
 
 /* Sendor configuration topics payload */
@@ -199,6 +236,76 @@ PROG_STR( S_JSON_CONFIG_LCD_MSG,        "{\"name\":\"LCD message\"," \
                                         "\"ids\":[\"%s\"]" \
                                         "}}" );
 
+PROG_STR( S_JSON_CONFIG_LOOP_TIME_MAX,  "{\"name\":\"Loop time (max)\"," \
+                                        "\"uniq_id\":\"clock_%s_loop_time_max\"," \
+                                        "\"dev_cla\":\"duration\"," \
+                                        "\"unit_of_meas\":\"ms\"," \
+                                        "\"ent_cat\":\"diagnostic\", " \
+                                        "\"stat_t\":\"%s/sensor/%s/clock_loop_time_max/state\"," \
+                                        "\"avty_t\": \"%s/sensor/%s/status\"," \
+                                        "\"ic\":\"mdi:timer-outline\"," \
+                                        "\"dev\":{" \
+                                        "\"ids\":[\"%s\"]" \
+                                        "}}" );
+
+PROG_STR( S_JSON_CONFIG_LOOP_OVERRUN,   "{\"name\":\"Loop overruns\"," \
+                                        "\"uniq_id\":\"clock_%s_loop_overrun\"," \
+                                        "\"stat_cla\":\"total_increasing\"," \
+                                        "\"ent_cat\":\"diagnostic\", " \
+                                        "\"stat_t\":\"%s/sensor/%s/clock_loop_overrun/state\"," \
+                                        "\"avty_t\": \"%s/sensor/%s/status\"," \
+                                        "\"ic\":\"mdi:timer-alert-outline\"," \
+                                        "\"dev\":{" \
+                                        "\"ids\":[\"%s\"]" \
+                                        "}}" );
+
+PROG_STR( S_JSON_CONFIG_AUDIO_UNDERRUNS, "{\"name\":\"Alarm audio underruns\"," \
+                                        "\"uniq_id\":\"clock_%s_audio_underruns\"," \
+                                        "\"stat_cla\":\"measurement\"," \
+                                        "\"ent_cat\":\"diagnostic\", " \
+                                        "\"stat_t\":\"%s/sensor/%s/clock_audio_underruns/state\"," \
+                                        "\"avty_t\": \"%s/sensor/%s/status\"," \
+                                        "\"ic\":\"mdi:speaker-off\"," \
+                                        "\"dev\":{" \
+                                        "\"ids\":[\"%s\"]" \
+                                        "}}" );
+
+PROG_STR( S_JSON_CONFIG_AUDIO_DATA_RATE, "{\"name\":\"Alarm audio data rate\"," \
+                                        "\"uniq_id\":\"clock_%s_audio_data_rate\"," \
+                                        "\"dev_cla\":\"data_rate\"," \
+                                        "\"unit_of_meas\":\"B/s\"," \
+                                        "\"ent_cat\":\"diagnostic\", " \
+                                        "\"stat_t\":\"%s/sensor/%s/clock_audio_data_rate/state\"," \
+                                        "\"avty_t\": \"%s/sensor/%s/status\"," \
+                                        "\"ic\":\"mdi:speaker-wireless\"," \
+                                        "\"dev\":{" \
+                                        "\"ids\":[\"%s\"]" \
+                                        "}}" );
+
+PROG_STR( S_JSON_CONFIG_AUDIO_BITRATE, "{\"name\":\"Alarm audio bitrate\"," \
+                                        "\"uniq_id\":\"clock_%s_audio_bitrate\"," \
+                                        "\"dev_cla\":\"data_rate\"," \
+                                        "\"unit_of_meas\":\"kbit/s\"," \
+                                        "\"ent_cat\":\"diagnostic\", " \
+                                        "\"stat_t\":\"%s/sensor/%s/clock_audio_bitrate/state\"," \
+                                        "\"avty_t\": \"%s/sensor/%s/status\"," \
+                                        "\"ic\":\"mdi:music-note\"," \
+                                        "\"dev\":{" \
+                                        "\"ids\":[\"%s\"]" \
+                                        "}}" );
+
+PROG_STR( S_JSON_CONFIG_AUDIO_LATENCY, "{\"name\":\"Alarm audio start latency\"," \
+                                        "\"uniq_id\":\"clock_%s_audio_latency\"," \
+                                        "\"dev_cla\":\"duration\"," \
+                                        "\"unit_of_meas\":\"ms\"," \
+                                        "\"ent_cat\":\"diagnostic\", " \
+                                        "\"stat_t\":\"%s/sensor/%s/clock_audio_latency/state\"," \
+                                        "\"avty_t\": \"%s/sensor/%s/status\"," \
+                                        "\"ic\":\"mdi:timer-music-outline\"," \
+                                        "\"dev\":{" \
+                                        "\"ids\":[\"%s\"]" \
+                                        "}}" );
+
 
 
 /*******************************************************************************
@@ -216,6 +323,7 @@ class HomeAssistant : public ITask {
 
     void begin();    
     void runTasks();
+    bool hasPendingWork();
     bool updateSensor( uint8_t sensorID, bool force = false );
     bool updateAllSensors( bool force = false );
     
@@ -224,6 +332,7 @@ class HomeAssistant : public ITask {
     char lcd_message[ MAX_PAYLOAD_LCD_MESSAGE_LENGTH + 1 ];
 
   private:
+    friend class BenchAccess;               /* Host benchmarks (bench/) */
 
     void beginSendSensorConfig();
     void sendNextSensorConfig();
@@ -239,6 +348,7 @@ class HomeAssistant : public ITask {
     unsigned long _prevTimestampBatteryCharge;                  /* Battery charge last update timestamp */
     unsigned long _prevTimestampBatteryStatus;                  /* Battery status last update timestamp */
     unsigned long _prevTimestampBatteryVoltage;                 /* Battery voltage last update timestamp */
+    unsigned long _prevTimestampLoopStats;                      /* Loop statistics last update timestamp */
     uint8_t _prevBatteryStatus;                                 /* Previous battery status sent */
 };
 
@@ -425,6 +425,16 @@ void Logger::printLogEntryMessage( IPrint *output, uint8_t type, uint32_t flags
 
         output->print_P( S_LOGMSG_SD_REMOVED );
 
+    /* Alarm sound started (flags: start latency) */
+    } else if( type == EVENT_ALARM_AUDIO_START ) {
+
+        output->printf_P( S_LOGMSG_ALARM_AUDIO_START, ( uint16_t )flags );
+
+    /* Alarm sound ended (flags: underruns, data rate) */
+    } else if( type == EVENT_ALARM_AUDIO_END ) {
+
+        output->printf_P( S_LOGMSG_ALARM_AUDIO_END, ( uint16_t )( flags & 0xFFFF ), ( uint16_t )( flags >> 16 ));
+
     /* Unknown log entry */
     } else {
         output->printf_P( S_LOGMSG_UNKNOWN, type, flags );
@@ -70,6 +70,8 @@ enum {
     EVENT_SD_INIT_FAIL,
     EVENT_SD_REMOVED,
     EVENT_SD_READY,
+    EVENT_ALARM_AUDIO_START,
+    EVENT_ALARM_AUDIO_END,
 };
 
 struct LogEntry {
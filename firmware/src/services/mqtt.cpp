@@ -19,6 +19,7 @@
 #include "mqtt.h"
 #include "logger.h"
 #include "drivers/power.h"
+#include <heap_sites.h>
 
 
 
@@ -67,6 +68,7 @@ void MqttClient::begin() {
     _clientEnabled = g_config.network.mqtt_enabled;
 
     this->resetRxState();
+    this->wakeUp();
 
     if( _clientEnabled ) {
 
@@ -138,7 +140,7 @@ void* MqttClient::allocBuffer( size_t size ) {
         return nullptr;
     }
 
-    _buffer = malloc( size );
+    _buffer = g_pool.alloc( size, HEAP_SITE_MQTT_BUFFER );
 
     if( _buffer != nullptr ) {
         _bufferSize = size;
@@ -159,7 +161,7 @@ void MqttClient::freeBuffer() {
         return;
     }
 
-    free( _buffer );
+    g_pool.release( _buffer );
     _buffer = nullptr;
     _bufferPos = 0;
     _bufferSize = 0;
@@ -656,7 +658,7 @@ bool MqttClient::sendPacket() {
  * 
  */
 void MqttClient::poll() {
-    size_t byteRead;
+    size_t byteRead = 0;
 
     if( _tcp.connected() == 0 ) {
         return;
@@ -1314,6 +1316,24 @@ bool MqttClient::checkForSubscribeAck() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if a task is running or if packets were received from
+ *          the broker. Keep-alive and reconnect attempts are checked on a
+ *          timer.
+ *
+ * @return  TRUE if the client needs to run, FALSE otherwise.
+ * 
+ */
+bool MqttClient::hasPendingWork() {
+    if( _init == false ) {
+        return false;
+    }
+
+    return this->isBusy() || _tcp.buffered() > 0;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Execute the current task
@@ -1325,6 +1345,8 @@ void MqttClient::runTasks() {
         return;
     }
 
+    this->setNextWake( MQTT_IDLE_WAKE );
+
     /* If tcp connection lost while connected to the broker, reset connection flags */
     if( _connected == true && _tcp.connected() == 0 ) {
         this->disconnect( true );
@@ -45,6 +45,7 @@
 #define MQTT_BROKER_CONNECT_TIMEOUT     5000
 #define MQTT_RECONNECT_ATTEMPT_DELAY    15000
 #define MQTT_DISCONNECT_DELAY           250
+#define MQTT_IDLE_WAKE                  100     /* Connection check interval while idle */
 #define MQTT_DEFAULT_KEEP_ALIVE         60
 
 /* Connect flags */
@@ -148,9 +149,12 @@ class MqttClient : public ITask {
     bool subscribe( char* topic );
     void setWillMessage( char* topic, char *payload, bool retain = false, bool publishBeforeDisconnect = false );
     void runTasks();
+    bool hasPendingWork();
     void setPublishReceiveCallback( mqttPubRxFunc func );
 
   private:
+    friend class BenchAccess;               /* Host benchmarks (bench/) */
+
     bool connect();
     void disconnect( bool immediate = false );
     bool sendPacket();
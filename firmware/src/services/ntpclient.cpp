@@ -437,6 +437,8 @@ void NtpClient::runTasks() {
 
         /* No Task running */
         default: {
+            this->setNextWake( NTPCLIENT_IDLE_WAKE );
+
             if( g_wifi.connected() == true && _nextSyncDelay > 0 ) {
         
                 DateTime now;
@@ -462,6 +464,19 @@ void NtpClient::runTasks() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if a synchronization is in progress. When idle, the auto
+ *          sync schedule is checked on a timer.
+ *
+ * @return  TRUE if the client needs to run, FALSE otherwise.
+ * 
+ */
+bool NtpClient::hasPendingWork() {
+    return this->isBusy();
+}
+
+
 /*******************************************************************************
  *
  * @brief   Prints NTP client status on the console.
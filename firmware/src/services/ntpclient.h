@@ -29,6 +29,7 @@
 #define NTPCLIENT_NTP_PORT      123
 #define NTPCLIENT_REQ_TIMEOUT   5000
 #define NTPCLIENT_BIND_TIMEOUT  2000
+#define NTPCLIENT_IDLE_WAKE     1000    /* Auto sync check interval (ms) */
 
 #define NTPCLIENT_RETRY_DELAY   120     /* 2 minutes */
 #define NTPCLIENT_SYNC_SCHD_MIN 36000   /* 10 hours */
@@ -94,6 +95,7 @@ class NtpClient : public ITask {
     NtpClient();
     bool sync( ConsoleBase *console = NULL );
     void runTasks();
+    bool hasPendingWork();
     void getPreviousSync( DateTime &dt );
     void getPreviousSyncOffset( int32_t seconds, int16_t milliseconds );
     void setAutoSync( bool enabled, ConsoleBase *console = NULL );
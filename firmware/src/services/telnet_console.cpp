@@ -49,6 +49,16 @@ TelnetConsole::TelnetConsole() {
  * @return  Number of bytes written.
  */
 size_t TelnetConsole::_print( char c ) {
+
+    /* Data bytes equal to IAC must be doubled (eg. binary trace dump) */
+    if(( uint8_t )c == TELNET_IAC ) {
+        _sendBuffer[ _sendBufSize++ ] = c;
+
+        if( _sendBufSize >= TELNET_SEND_BUFFER_SIZE ) {
+            this->flushSendBuffer();
+        }
+    }
+
     _sendBuffer[ _sendBufSize++ ] = c;
 
     if( c == '\n' ) {
@@ -63,6 +73,54 @@ size_t TelnetConsole::_print( char c ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   IPrint interface callback for writing a block of characters. 
+ *          Copies the characters to the send buffer up to the next EOL or
+ *          IAC character, which are handled by _print().
+ * 
+ * @param   buffer    Characters to write
+ * @param   length    Number of characters
+ *
+ * @return  Number of bytes written.
+ */
+size_t TelnetConsole::_write( const char *buffer, size_t length ) {
+    size_t remaining = length;
+
+    while( remaining > 0 ) {
+
+        if( *buffer == '\n' || ( uint8_t )*buffer == TELNET_IAC ) {
+            this->_print( *buffer++ );
+            remaining--;
+            continue;
+        }
+
+        size_t count = TELNET_SEND_BUFFER_SIZE - _sendBufSize;
+        if( count > remaining ) {
+            count = remaining;
+        }
+
+        size_t i;
+        for( i = 1; i < count; i++ ) {
+            if( buffer[ i ] == '\n' || ( uint8_t )buffer[ i ] == TELNET_IAC ) {
+                break;
+            }
+        }
+
+        memcpy( &_sendBuffer[ _sendBufSize ], buffer, i );
+        _sendBufSize += i;
+        buffer += i;
+        remaining -= i;
+
+        if( _sendBufSize >= TELNET_SEND_BUFFER_SIZE ) {
+            this->flushSendBuffer();
+        }
+    }
+
+    return length;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Send the content of the transmit buffer. 
@@ -260,6 +318,7 @@ void TelnetConsole::enableServer( bool enabled ) {
 
     if( enabled ) {
         _state = TELNET_STATE_WAIT_WIFI_CONNECTION;
+        this->wakeUp();
 
     } else {
         stopServer();
@@ -457,6 +516,35 @@ void TelnetConsole::resetConsole() {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Checks if the server has work to do. While waiting for WiFi, 
+ *          listening or serving an idle client, the connection state is 
+ *          checked on a timer.
+ *
+ * @return  TRUE if the server needs to run, FALSE otherwise.
+ * 
+ */
+bool TelnetConsole::hasPendingWork() {
+
+    if( _serverEnabled == false ) {
+        return false;
+    }
+
+    switch( _state ) {
+        case TELNET_STATE_WAIT_WIFI_CONNECTION:
+        case TELNET_STATE_SERVER_LISTENING:
+            return false;
+
+        case TELNET_STATE_CLIENT_CONNECTED:
+            return this->isBusy() || _client.buffered() > 0;
+
+        default:
+            return true;
+    }
+}
+
+
 /*******************************************************************************
  *
  * @brief   Run server tasks.
@@ -468,6 +556,8 @@ void TelnetConsole::runTasks() {
         return;
     }
 
+    this->setNextWake( TELNET_IDLE_WAKE );
+
     /* Stop server if WiFi connection is lost. */
     if( g_wifi.connected() == false && _state != TELNET_STATE_WAIT_WIFI_CONNECTION ) {
         
@@ -28,6 +28,7 @@
 #define TELNET_SEND_BUFFER_SIZE     64
 
 #define TELNET_SESSION_TIMEOUT      300
+#define TELNET_IDLE_WAKE            100     /* Connection check interval while idle (ms) */
 
 
 /* Server states */
@@ -68,6 +69,7 @@ class TelnetConsole : public ConsoleBase {
   public:
     TelnetConsole();
     void runTasks();
+    bool hasPendingWork();
     bool startServer();
     void stopServer();
     bool clientConnected();
@@ -95,6 +97,7 @@ class TelnetConsole : public ConsoleBase {
     char _sendBuffer[ TELNET_SEND_BUFFER_SIZE + 1 ];
     size_t _sendBufSize;
     size_t _print( char c );
+    size_t _write( const char *buffer, size_t length );
 
 };
 
@@ -0,0 +1,1010 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : soundindex.cpp
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+
+#include <heap_sites.h>
+#include "soundindex.h"
+
+
+
+/*******************************************************************************
+ *
+ * @brief   Class constructor
+ *
+ * @param   sdcard    Pointer to the SD card manager
+ *
+ */
+SoundIndex::SoundIndex( SDCardManager* sdcard ) {
+    _sdcard = sdcard;
+
+    memset( &_header, 0, sizeof( _header ));
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Open the index file on the SD card and start the validation task.
+ *          The root directory is scanned to validate the index, which is
+ *          only rebuilt if the sound files changed since it was last written.
+ *
+ * @return  TRUE if the index file is opened, FALSE otherwise.
+ *
+ */
+bool SoundIndex::begin() {
+
+    if( _file.isOpen() == true ) {
+        return true;
+    }
+
+    if( _rootDir.open( "/" ) == false ) {
+        return false;
+    }
+
+    if( _file.open( &_rootDir, SOUND_INDEX_FILENAME, O_RDWR | O_CREAT ) == false ) {
+        _rootDir.close();
+        return false;
+    }
+
+    _ready = false;
+    _rescan = false;
+
+    bool valid = ( _file.read( &_header, sizeof( _header )) == sizeof( _header ));
+
+    if( valid == true ) {
+        valid = ( _header.magic == SOUND_INDEX_MAGIC
+                  && _header.version == SOUND_INDEX_VERSION
+                  && _header.entrySize == sizeof( SoundIndexEntry )
+                  && _file.fileSize() == sizeof( SoundIndexHeader ) + (uint32_t)_header.count * sizeof( SoundIndexEntry ));
+    }
+
+    if( valid == false ) {
+        this->rebuild();
+        return _file.isOpen();
+    }
+
+    /* The index on the card stays usable while it is being validated. */
+    _ready = true;
+    _scanCount = 0;
+    _scanSignature = 0;
+    _rootDir.rewindDirectory();
+
+    this->startTask( TASK_SOUND_INDEX_CHECK );
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Close the index file, called when the card is removed.
+ *
+ */
+void SoundIndex::end() {
+
+    if( this->isBusy() == true ) {
+        this->endTask( ERR_TASK_FAIL );
+    }
+
+    if( _sortHeads != nullptr ) {
+        g_pool.release( _sortHeads );
+        _sortHeads = nullptr;
+    }
+
+    _ready = false;
+    _header.count = 0;
+
+    if( _file.isOpen() == true ) {
+        _file.close();
+    }
+
+    if( _rootDir.isOpen() == true ) {
+        _rootDir.close();
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Start rebuilding the index from the content of the root directory.
+ *
+ */
+void SoundIndex::rebuild() {
+
+    _ready = false;
+
+    _header.magic = SOUND_INDEX_MAGIC;
+    _header.version = SOUND_INDEX_VERSION;
+    _header.entrySize = sizeof( SoundIndexEntry );
+    _header.count = 0;
+    _header.signature = 0;
+
+    /* The header is only written once the entries are sorted, an interrupted
+       rebuild leaves an invalid index which is rebuilt on the next start. */
+    if( _file.truncate( 0 ) == false ) {
+        this->end();
+        return;
+    }
+
+    _rootDir.rewindDirectory();
+    this->startTask( TASK_SOUND_INDEX_SCAN );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Run the index validation and rebuild tasks.
+ *
+ */
+void SoundIndex::runTasks() {
+
+    switch( this->getCurrentTask() ) {
+
+        case TASK_SOUND_INDEX_CHECK:
+            do {
+                if( this->checkNextFile() == false ) {
+                    break;
+                }
+
+            } while( this->budgetRemaining() == true );
+
+            break;
+
+        case TASK_SOUND_INDEX_SCAN:
+            do {
+                if( this->scanNextFile() == false ) {
+                    break;
+                }
+
+            } while( this->budgetRemaining() == true );
+
+            break;
+
+        case TASK_SOUND_INDEX_SORT:
+            do {
+                if( this->sortNextEntry() == false ) {
+                    break;
+                }
+
+            } while( this->budgetRemaining() == true );
+
+            break;
+
+        case TASK_SOUND_INDEX_COPY:
+            do {
+                if( this->copyNextEntry() == false ) {
+                    break;
+                }
+
+            } while( this->budgetRemaining() == true );
+
+            break;
+
+        default:
+
+            /* Nothing to do here */
+            return;
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Checks if the index is being validated or rebuilt.
+ *
+ * @return  TRUE if the index needs to run, FALSE otherwise.
+ *
+ */
+bool SoundIndex::hasPendingWork() {
+    return this->isBusy();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Update the index entry of a file in the root directory after it
+ *          was created, modified, renamed or deleted.
+ *
+ * @param   name    Name of the file
+ *
+ */
+void SoundIndex::syncFile( const char* name ) {
+
+    /* The directory is validated again once the running task completes. */
+    if( this->isBusy() == true ) {
+        _rescan = true;
+        return;
+    }
+
+    if( _ready == false ) {
+        return;
+    }
+
+    /* The index file itself was modified, reopen and validate it. */
+    if( strcasecmp( name, SOUND_INDEX_FILENAME ) == 0 ) {
+        this->end();
+        this->begin();
+
+        return;
+    }
+
+    SoundIndexEntry entry;
+    bool found;
+
+    if( this->readFileInfo( name, &entry ) == true ) {
+        this->addEntry( &entry );
+        return;
+    }
+
+    /* File no longer exists or is not a sound file */
+    uint16_t index = this->search( name, &found, &entry );
+    if( found == true ) {
+        this->removeEntry( index );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Search the index for a sound file.
+ *
+ * @param   name    Name of the file
+ *
+ * @return  Position of the file in the index, -1 if not found.
+ *
+ */
+int16_t SoundIndex::find( const char* name ) {
+
+    SoundIndexEntry entry;
+    bool found;
+
+    if( _ready == false ) {
+        return -1;
+    }
+
+    uint16_t index = this->search( name, &found, &entry );
+
+    return ( found == true ) ? index : -1;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Read an entry from the index.
+ *
+ * @param   index    Position of the entry
+ * @param   entry    Pointer to the structure receiving the entry
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::readEntry( uint16_t index, SoundIndexEntry* entry ) {
+
+    if( _ready == false || index >= _header.count ) {
+        return false;
+    }
+
+    return this->readRegion( 0, index, entry );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Open the sound file of an index entry. The file is opened from
+ *          its position in the directory, which avoids searching the
+ *          directory for its name.
+ *
+ * @param   entry    Index entry
+ * @param   file     File to open
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::openSound( SoundIndexEntry* entry, FsFile* file ) {
+
+    char name[ MAX_LENGTH_ALARM_FILENAME + 1 ];
+
+    if( file->isOpen() == true ) {
+        file->close();
+    }
+
+    /* Opening a file moves the directory position, restore it for the 
+       validation task which reads the directory while the index is used. */
+    uint64_t position = _rootDir.curPosition();
+    bool opened = file->open( &_rootDir, entry->dirIndex, O_READ );
+    _rootDir.seekSet( position );
+
+    if( opened == true ) {
+
+        file->getName( name, sizeof( name ));
+        if( strcmp( name, entry->name ) == 0 ) {
+            return true;
+        }
+
+        file->close();
+    }
+
+    /* The directory changed since the entry was written, open it by name. */
+    return this->openSound( entry->name, file );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Open a sound file by its name in the root directory. Used when 
+ *          the index is not available.
+ *
+ * @param   name    Name of the file
+ * @param   file    File to open
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::openSound( const char* name, FsFile* file ) {
+
+    if( file->isOpen() == true ) {
+        file->close();
+    }
+
+    if( _rootDir.isOpen() == false || this->getFormat( name ) == SOUND_FORMAT_NONE ) {
+        return false;
+    }
+
+    uint64_t position = _rootDir.curPosition();
+    bool opened = file->open( &_rootDir, name, O_READ );
+    _rootDir.seekSet( position );
+
+    if( opened == true && file->isFile() == false ) {
+        file->close();
+        return false;
+    }
+
+    return opened;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Read the next directory entry and update the signature of the
+ *          sound files. Only the directory entries are read. Once the end
+ *          of the directory is reached, the index is either marked as ready
+ *          or rebuilt.
+ *
+ * @return  TRUE if more entries need to be read, FALSE otherwise.
+ *
+ */
+bool SoundIndex::checkNextFile() {
+
+    SoundIndexEntry entry;
+    FsFile file;
+
+    if( file.openNext( &_rootDir, O_READ ) == false ) {
+
+        if( _scanCount == _header.count && _scanSignature == _header.signature ) {
+            this->endRebuild();
+        } else {
+            this->rebuild();
+        }
+
+        return false;
+    }
+
+    if( file.isFile() == true && _scanCount < MAX_SOUND_INDEX_ENTRIES ) {
+
+        file.getName( entry.name, sizeof( entry.name ));
+
+        if( this->getFormat( entry.name ) != SOUND_FORMAT_NONE ) {
+            entry.size = file.fileSize();
+            entry.dirIndex = file.dirIndex();
+
+            _scanSignature ^= this->getEntrySignature( &entry );
+            _scanCount++;
+        }
+    }
+
+    file.close();
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Read the next directory entry and append it to the index if it
+ *          is a sound file. The entries are sorted once the end of the
+ *          directory is reached.
+ *
+ * @return  TRUE if more entries need to be read, FALSE otherwise.
+ *
+ */
+bool SoundIndex::scanNextFile() {
+
+    SoundIndexEntry entry;
+    FsFile file;
+
+    if( file.openNext( &_rootDir, O_READ ) == false ) {
+        this->startSort();
+        return false;
+    }
+
+    bool valid = this->readFileInfo( &file, &entry );
+    file.close();
+
+    if( valid == false ) {
+        return true;
+    }
+
+    if( _header.count >= MAX_SOUND_INDEX_ENTRIES ) {
+        this->startSort();
+        return false;
+    }
+
+    if( this->writeRegion( 0, _header.count, &entry ) == false ) {
+        this->endRebuild( ERR_TASK_FAIL );
+        return false;
+    }
+
+    _header.count++;
+    _header.signature ^= this->getEntrySignature( &entry );
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Start sorting the entries appended by the scan task.
+ *
+ */
+void SoundIndex::startSort() {
+
+    if( _header.count < 2 ) {
+        this->endRebuild();
+        return;
+    }
+
+    _sortHeads = (SoundIndexEntry*)g_pool.alloc( 2 * sizeof( SoundIndexEntry ), HEAP_SITE_SOUND_INDEX );
+    if( _sortHeads == nullptr ) {
+        this->endRebuild( ERR_TASK_FAIL );
+        return;
+    }
+
+    _sortRegion = 0;
+    _sortWidth = 1;
+    _sortLeft = 0;
+    _sortA = 0;
+    _sortB = 1;
+    _sortLoaded = 0;
+
+    this->startTask( TASK_SOUND_INDEX_SORT );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Write the next entry of a bottom-up merge sort. Each pass merges
+ *          pairs of sorted runs from one region of the index file to the
+ *          other, doubling the length of the runs. Only the head entry of
+ *          each run is kept in memory.
+ *
+ * @return  TRUE if more entries need to be written, FALSE otherwise.
+ *
+ */
+bool SoundIndex::sortNextEntry() {
+
+    uint16_t count = _header.count;
+    uint16_t middle = min( _sortLeft + _sortWidth, count );
+    uint16_t right = min( middle + _sortWidth, count );
+
+    if( _sortA >= middle && _sortB >= right ) {
+
+        /* Both runs are merged, move to the next pair */
+        _sortLeft = right;
+
+        if( _sortLeft >= count ) {
+
+            /* End of the pass, the runs are now twice as long */
+            _sortRegion ^= 1;
+            _sortLeft = 0;
+            _sortWidth *= 2;
+
+            if( _sortWidth >= count ) {
+
+                if( _sortRegion == 0 ) {
+                    this->endRebuild();
+                } else {
+                    _sortA = 0;
+                    this->startTask( TASK_SOUND_INDEX_COPY );
+                }
+
+                return false;
+            }
+        }
+
+        _sortA = _sortLeft;
+        _sortB = min( _sortLeft + _sortWidth, count );
+        _sortLoaded = 0;
+
+        return true;
+    }
+
+    SoundIndexEntry* left = &_sortHeads[ 0 ];
+    SoundIndexEntry* next = &_sortHeads[ 1 ];
+
+    if( _sortA < middle && ( _sortLoaded & 0x01 ) == 0 ) {
+        if( this->readRegion( _sortRegion, _sortA, left ) == false ) {
+            this->endRebuild( ERR_TASK_FAIL );
+            return false;
+        }
+
+        _sortLoaded |= 0x01;
+    }
+
+    if( _sortB < right && ( _sortLoaded & 0x02 ) == 0 ) {
+        if( this->readRegion( _sortRegion, _sortB, next ) == false ) {
+            this->endRebuild( ERR_TASK_FAIL );
+            return false;
+        }
+
+        _sortLoaded |= 0x02;
+    }
+
+    bool fromLeft = ( _sortB >= right || ( _sortA < middle && strcasecmp( left->name, next->name ) <= 0 ));
+
+    if( this->writeRegion( _sortRegion ^ 1, _sortA + _sortB - middle, fromLeft ? left : next ) == false ) {
+        this->endRebuild( ERR_TASK_FAIL );
+        return false;
+    }
+
+    if( fromLeft == true ) {
+        _sortA++;
+        _sortLoaded &= ~0x01;
+    } else {
+        _sortB++;
+        _sortLoaded &= ~0x02;
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Copy the next sorted entry from the second region of the index
+ *          file to the first one, when the last pass of the merge sort
+ *          ended in the second region.
+ *
+ * @return  TRUE if more entries need to be copied, FALSE otherwise.
+ *
+ */
+bool SoundIndex::copyNextEntry() {
+
+    if( _sortA >= _header.count ) {
+        this->endRebuild();
+        return false;
+    }
+
+    if( this->readRegion( 1, _sortA, _sortHeads ) == false
+        || this->writeRegion( 0, _sortA, _sortHeads ) == false ) {
+
+        this->endRebuild( ERR_TASK_FAIL );
+        return false;
+    }
+
+    _sortA++;
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Ends the validation or rebuild task. After a rebuild, the second
+ *          region used by the merge sort is discarded and the header is
+ *          written, which flushes the index file.
+ *
+ * @param   error    Error code
+ *
+ */
+void SoundIndex::endRebuild( int error ) {
+
+    if( _sortHeads != nullptr ) {
+        g_pool.release( _sortHeads );
+        _sortHeads = nullptr;
+    }
+
+    if( error == TASK_SUCCESS && this->getCurrentTask() != TASK_SOUND_INDEX_CHECK ) {
+
+        if( _file.truncate( sizeof( SoundIndexHeader ) + (uint32_t)_header.count * sizeof( SoundIndexEntry )) == false
+            || this->writeHeader() == false ) {
+
+            error = ERR_TASK_FAIL;
+        }
+    }
+
+    this->endTask( error );
+    _ready = ( error == TASK_SUCCESS );
+
+    /* A file changed while the task was running, validate the index again.
+       It stays usable meanwhile, the entry of the changed file may be stale. */
+    if( _ready == true && _rescan == true ) {
+        _rescan = false;
+        _scanCount = 0;
+        _scanSignature = 0;
+        _rootDir.rewindDirectory();
+
+        this->startTask( TASK_SOUND_INDEX_CHECK );
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Fill an index entry from an opened file.
+ *
+ * @param   file     Opened file
+ * @param   entry    Pointer to the structure receiving the entry
+ *
+ * @return  TRUE if the file is a sound file, FALSE otherwise.
+ *
+ */
+bool SoundIndex::readFileInfo( FsFile* file, SoundIndexEntry* entry ) {
+
+    if( file->isFile() == false ) {
+        return false;
+    }
+
+    memset( entry, 0, sizeof( SoundIndexEntry ));
+    file->getName( entry->name, sizeof( entry->name ));
+
+    entry->format = this->getFormat( entry->name );
+    if( entry->format == SOUND_FORMAT_NONE ) {
+        return false;
+    }
+
+    entry->size = file->fileSize();
+    entry->dirIndex = file->dirIndex();
+
+    /* Skip the ID3v2 tag of mp3 files, it may contain large pictures. */
+    if( entry->format == SOUND_FORMAT_MP3 ) {
+        uint8_t tag[ 10 ];
+
+        if( file->read( tag, sizeof( tag )) == sizeof( tag ) && memcmp_P( tag, PSTR( "ID3" ), 3 ) == 0 ) {
+
+            /* Tag size is a 28 bits 'syncsafe' integer, excluding the header and footer */
+            uint32_t length = ((uint32_t)( tag[ 6 ] & 0x7F ) << 21 ) | ((uint32_t)( tag[ 7 ] & 0x7F ) << 14 )
+                              | ((uint32_t)( tag[ 8 ] & 0x7F ) << 7 ) | ( tag[ 9 ] & 0x7F );
+
+            length += sizeof( tag );
+            if( tag[ 5 ] & 0x10 ) {
+                length += sizeof( tag );
+            }
+
+            if( length < entry->size ) {
+                entry->dataOffset = length;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Fill an index entry from a file in the root directory. The file
+ *          is only opened for the duration of this call, it doesn't take
+ *          room on the stack of the caller.
+ *
+ * @param   name     Name of the file
+ * @param   entry    Pointer to the structure receiving the entry
+ *
+ * @return  TRUE if the file exists and is a sound file, FALSE otherwise.
+ *
+ */
+bool SoundIndex::readFileInfo( const char* name, SoundIndexEntry* entry ) {
+
+    FsFile file;
+
+    if( file.open( &_rootDir, name, O_READ ) == false ) {
+        return false;
+    }
+
+    bool valid = this->readFileInfo( &file, entry );
+    file.close();
+
+    return valid;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Binary search of a file name in the index.
+ *
+ * @param   name     Name of the file
+ * @param   found    Set to TRUE if the name is in the index
+ * @param   entry    Buffer used to read the entries, provided by the caller
+ *                   so nested calls don't each hold one on the stack.
+ *
+ * @return  Position of the file, or the position where it should be inserted.
+ *
+ */
+uint16_t SoundIndex::search( const char* name, bool* found, SoundIndexEntry* entry ) {
+
+    uint16_t low = 0;
+    uint16_t high = _header.count;
+
+    *found = false;
+
+    while( low < high ) {
+        uint16_t mid = ( low + high ) / 2;
+
+        if( this->readEntry( mid, entry ) == false ) {
+            break;
+        }
+
+        int cmp = strcasecmp( name, entry->name );
+        if( cmp == 0 ) {
+            *found = true;
+            return mid;
+        }
+
+        if( cmp < 0 ) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Add or update an entry, keeping the index sorted.
+ *
+ * @param   entry    Entry to add
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::addEntry( SoundIndexEntry* entry ) {
+
+    SoundIndexEntry current;
+    bool found;
+
+    uint16_t index = this->search( entry->name, &found, &current );
+
+    if( found == true ) {
+
+        /* Replace the existing entry */
+        if( this->readEntry( index, &current ) == false ) {
+            return false;
+        }
+
+        _header.signature ^= this->getEntrySignature( &current );
+
+    } else {
+
+        if( _header.count >= MAX_SOUND_INDEX_ENTRIES ) {
+            return false;
+        }
+
+        /* Shift the following entries to make room for the new one */
+        for( uint16_t i = _header.count; i > index; i-- ) {
+
+            if( this->readEntry( i - 1, &current ) == false || this->writeEntry( i, &current ) == false ) {
+                return false;
+            }
+        }
+
+        _header.count++;
+    }
+
+    if( this->writeEntry( index, entry ) == false ) {
+        return false;
+    }
+
+    _header.signature ^= this->getEntrySignature( entry );
+    return this->writeHeader();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Remove an entry from the index.
+ *
+ * @param   index    Position of the entry
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::removeEntry( uint16_t index ) {
+
+    SoundIndexEntry entry;
+
+    if( this->readEntry( index, &entry ) == false ) {
+        return false;
+    }
+
+    _header.signature ^= this->getEntrySignature( &entry );
+
+    for( uint16_t i = index + 1; i < _header.count; i++ ) {
+
+        if( this->readEntry( i, &entry ) == false || this->writeEntry( i - 1, &entry ) == false ) {
+            return false;
+        }
+    }
+
+    _header.count--;
+    _file.truncate( sizeof( SoundIndexHeader ) + (uint32_t)_header.count * sizeof( SoundIndexEntry ));
+
+    return this->writeHeader();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Write an entry to the index file.
+ *
+ * @param   index    Position of the entry
+ * @param   entry    Entry to write
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::writeEntry( uint16_t index, SoundIndexEntry* entry ) {
+
+    if( index > _header.count ) {
+        return false;
+    }
+
+    return this->writeRegion( 0, index, entry );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Read an entry from a region of the index file. The first region
+ *          holds the index, the second one is only used while sorting.
+ *
+ * @param   region   Region of the index file (0 or 1)
+ * @param   index    Position of the entry in the region
+ * @param   entry    Pointer to the structure receiving the entry
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::readRegion( uint8_t region, uint16_t index, SoundIndexEntry* entry ) {
+
+    uint32_t position = (uint32_t)region * _header.count + index;
+
+    if( _file.seekSet( sizeof( SoundIndexHeader ) + position * sizeof( SoundIndexEntry )) == false ) {
+        return false;
+    }
+
+    return _file.read( entry, sizeof( SoundIndexEntry )) == sizeof( SoundIndexEntry );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Write an entry to a region of the index file.
+ *
+ * @param   region   Region of the index file (0 or 1)
+ * @param   index    Position of the entry in the region
+ * @param   entry    Entry to write
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::writeRegion( uint8_t region, uint16_t index, SoundIndexEntry* entry ) {
+
+    uint32_t position = (uint32_t)region * _header.count + index;
+
+    if( _file.seekSet( sizeof( SoundIndexHeader ) + position * sizeof( SoundIndexEntry )) == false ) {
+        return false;
+    }
+
+    return _file.write( entry, sizeof( SoundIndexEntry )) == sizeof( SoundIndexEntry );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Write the index header and flush the index file.
+ *
+ * @return  TRUE if successful, FALSE otherwise.
+ *
+ */
+bool SoundIndex::writeHeader() {
+
+    if( _file.seekSet( 0 ) == false ) {
+        return false;
+    }
+
+    if( _file.write( &_header, sizeof( _header )) != sizeof( _header )) {
+        return false;
+    }
+
+    return _file.sync();
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Calculate the signature of an entry (FNV-1a hash of the name,
+ *          size and position in the directory).
+ *
+ * @param   entry    Index entry
+ *
+ * @return  Signature of the entry.
+ *
+ */
+uint32_t SoundIndex::getEntrySignature( SoundIndexEntry* entry ) {
+
+    uint32_t hash = 2166136261UL;
+
+    for( const char* c = entry->name; *c != '\0'; c++ ) {
+        hash = ( hash ^ (uint8_t)*c ) * 16777619UL;
+    }
+
+    for( uint8_t i = 0; i < 4; i++ ) {
+        hash = ( hash ^ (uint8_t)( entry->size >> ( i * 8 ))) * 16777619UL;
+        hash = ( hash ^ (uint8_t)( entry->dirIndex >> ( i * 8 ))) * 16777619UL;
+    }
+
+    return hash;
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the sound format from the file extension.
+ *
+ * @param   name    Name of the file
+ *
+ * @return  Sound format (SOUND_FORMAT_*)
+ *
+ */
+uint8_t SoundIndex::getFormat( const char* name ) {
+
+    const char* ext = strrchr( name, '.' );
+
+    if( ext == nullptr ) {
+        return SOUND_FORMAT_NONE;
+    }
+
+    if( strcasecmp_P( ext, PSTR( ".mp3" )) == 0 ) {
+        return SOUND_FORMAT_MP3;
+    }
+
+    if( strcasecmp_P( ext, PSTR( ".mid" )) == 0 ) {
+        return SOUND_FORMAT_MIDI;
+    }
+
+    if( strcasecmp_P( ext, PSTR( ".ogg" )) == 0 ) {
+        return SOUND_FORMAT_OGG;
+    }
+
+    if( strcasecmp_P( ext, PSTR( ".aac" )) == 0 ) {
+        return SOUND_FORMAT_AAC;
+    }
+
+    if( strcasecmp_P( ext, PSTR( ".wav" )) == 0 ) {
+        return SOUND_FORMAT_WAV;
+    }
+
+    return SOUND_FORMAT_NONE;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+//******************************************************************************
+//
+// Project : Alarm Clock V3
+// File    : soundindex.h
+// Author  : Benoit Frigon <www.bfrigon.com>
+//
+// -----------------------------------------------------------------------------
+//
+// This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+// International License. To view a copy of this license, visit
+//
+// http://creativecommons.org/licenses/by-sa/4.0/
+//
+// or send a letter to Creative Commons,
+// PO Box 1866, Mountain View, CA 94042, USA.
+//
+//******************************************************************************
+#ifndef SOUNDINDEX_H
+#define SOUNDINDEX_H
+
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <itask.h>
+#include "drivers/sdcard.h"
+#include "config.h"
+
+
+
+/* Index of the alarm sounds in the root directory of the SD card */
+#define SOUND_INDEX_FILENAME        "sounds.idx"
+#define SOUND_INDEX_MAGIC           0x5853
+#define SOUND_INDEX_VERSION         1
+
+/* Maximum number of sounds in the index */
+#define MAX_SOUND_INDEX_ENTRIES     1000
+
+/* Sound index tasks */
+enum SoundIndexTasks {
+    TASK_SOUND_INDEX_CHECK = 1,             /* Validate the index against the root directory */
+    TASK_SOUND_INDEX_SCAN,                  /* Write the entries in directory order */
+    TASK_SOUND_INDEX_SORT,                  /* Merge sort the entries */
+    TASK_SOUND_INDEX_COPY,                  /* Copy the sorted entries back to the first region */
+};
+
+/* Sound file formats */
+enum SoundFormats {
+    SOUND_FORMAT_NONE = 0,
+    SOUND_FORMAT_MP3,
+    SOUND_FORMAT_MIDI,
+    SOUND_FORMAT_OGG,
+    SOUND_FORMAT_AAC,
+    SOUND_FORMAT_WAV,
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Header of the index file
+ *
+ *******************************************************************************/
+struct SoundIndexHeader {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t entrySize;          /* Size of an entry, detects a build with a different layout */
+    uint16_t count;             /* Number of entries */
+    uint32_t signature;         /* XOR of the signatures of the entries */
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Index entry, the entries are sorted by name (case insensitive)
+ *
+ *******************************************************************************/
+struct SoundIndexEntry {
+    char name[ MAX_LENGTH_ALARM_FILENAME + 1 ];
+    uint8_t format;             /* Sound file format (SOUND_FORMAT_*) */
+    uint32_t size;              /* File size (bytes) */
+    uint32_t dataOffset;        /* Offset of the first audio frame (after the ID3v2 tag) */
+    uint32_t dirIndex;          /* Position of the file in the root directory */
+};
+
+
+/*******************************************************************************
+ *
+ * @brief   Sorted index of the alarm sounds stored on the SD card. Selecting
+ *          the next sound or opening the sound of a profile doesn't require
+ *          to scan the root directory.
+ *
+ *          The index is validated and rebuilt by a time-sliced task. While
+ *          rebuilding, the entries are appended in directory order then
+ *          sorted with a bottom-up merge sort between two regions of the
+ *          index file, and the file is only flushed once at the end.
+ *
+ *******************************************************************************/
+class SoundIndex : public ITask {
+
+  public:
+    SoundIndex( SDCardManager* sdcard );
+
+    bool begin();
+    void end();
+    void rebuild();
+    void runTasks();
+    bool hasPendingWork();
+    void syncFile( const char* path );
+    int16_t find( const char* name );
+    bool readEntry( uint16_t index, SoundIndexEntry* entry );
+    bool openSound( SoundIndexEntry* entry, FsFile* file );
+    bool openSound( const char* name, FsFile* file );
+
+    /* Returns whether or not the index is available. */
+    bool isReady()                          { return _ready; }
+
+    /* Gets the number of sounds in the index. */
+    uint16_t getCount()                     { return ( _ready == true ) ? _header.count : 0; }
+
+
+  private:
+    bool checkNextFile();
+    bool scanNextFile();
+    bool sortNextEntry();
+    bool copyNextEntry();
+    void startSort();
+    void endRebuild( int error = TASK_SUCCESS );
+    bool readFileInfo( FsFile* file, SoundIndexEntry* entry );
+    bool readFileInfo( const char* name, SoundIndexEntry* entry );
+    uint16_t search( const char* name, bool* found, SoundIndexEntry* entry );
+    bool addEntry( SoundIndexEntry* entry );
+    bool removeEntry( uint16_t index );
+    bool readRegion( uint8_t region, uint16_t index, SoundIndexEntry* entry );
+    bool writeRegion( uint8_t region, uint16_t index, SoundIndexEntry* entry );
+    bool writeEntry( uint16_t index, SoundIndexEntry* entry );
+    bool writeHeader();
+    uint32_t getEntrySignature( SoundIndexEntry* entry );
+    uint8_t getFormat( const char* name );
+
+    SDCardManager* _sdcard;
+    FsFile _rootDir;
+    FsFile _file;                           /* Index file, kept open while the card is present */
+    SoundIndexHeader _header;
+    bool _ready = false;
+    bool _rescan = false;                   /* A file changed while the task was running */
+
+    uint16_t _scanCount = 0;                /* Sounds found by the validation scan */
+    uint32_t _scanSignature = 0;            /* Signature of the sounds found by the validation scan */
+
+    SoundIndexEntry* _sortHeads = nullptr;  /* Head entries of the two merged runs (pool) */
+    uint8_t _sortLoaded = 0;                /* Head entries read from the runs (bit 0: left, bit 1: right) */
+    uint8_t _sortRegion = 0;                /* Region holding the runs being merged */
+    uint16_t _sortWidth = 0;                /* Length of the runs in the current pass */
+    uint16_t _sortLeft = 0;                 /* Start of the left run */
+    uint16_t _sortA = 0;                    /* Next entry of the left run */
+    uint16_t _sortB = 0;                    /* Next entry of the right run */
+};
+
+/* Alarm sounds index */
+extern SoundIndex g_soundIndex;
+
+#endif /* SOUNDINDEX_H */
\ No newline at end of file
@@ -42,6 +42,13 @@ Screen::Screen() {
     _fieldPos = 0;
     _scroll = 0;
     _timeout = 0;
+
+#if SCREEN_KEY_LATENCY == 1
+    _keyLatencyPending = false;
+    _keyLatencyQueued = false;
+
+    this->resetKeyLatency();
+#endif
 }
 
 
@@ -57,7 +64,23 @@ void Screen::processEvents() {
     key = g_keypad.processEvents();
 
     if( key != KEY_NONE ) {
+
+#if SCREEN_KEY_LATENCY == 1
+        /* Measure the latency from the key change interrupt up to the end
+           of the LCD transfers of the screen update. Keys which don't change the screen are 
+           not recorded. */
+        _keyTime = g_keypad.getKeyTime();
+        _keyLatencyPending = true;
+        _keyLatencyQueued = false;
+#endif
+
         this->processKeypadEvent( key );
+
+#if SCREEN_KEY_LATENCY == 1
+        if( _updateRequested == false && _invalidItems == 0 && _invalidRegions == 0 ) {
+            _keyLatencyPending = false;
+        }
+#endif
     }
 
     /* Exit the screen if the timeout timer has elapsed. */
@@ -81,16 +104,70 @@ void Screen::processEvents() {
  */
 void Screen::update() {
 
-    if( _updateRequested == false ) {
+#if SCREEN_KEY_LATENCY == 1
+    /* The key latency ends when the last run of the frame is sent. */
+    if( _keyLatencyQueued == true && g_lcd.isFrameSent() == true ) {
+        _keyLatencyQueued = false;
+
+        this->recordKeyLatency( g_lcd.getFrameSentTime() - _keyTime );
+    }
+#endif
+
+    if( _updateRequested == false && _invalidItems == 0 && _invalidRegions == 0 ) {
         return;
     }
 
+    this->drawScreen();
+
+    /* Queue the changes to the LCD, they are sent by the TWI interrupt 
+       within the next few milliseconds. */
+    g_lcd.flush();
+
+#if SCREEN_KEY_LATENCY == 1
+    if( _keyLatencyPending == true ) {
+        _keyLatencyPending = false;
+
+        if( g_lcd.isFrameSent() == true ) {
+
+            /* Nothing changed on the LCD */
+            this->recordKeyLatency( micros() - _keyTime );
+
+        } else {
+            _keyLatencyQueued = true;
+        }
+    }
+#endif
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Draw the screen contents on the LCD.
+ * 
+ */
+void Screen::drawScreen() {
+
+    /* Draw the whole screen if requested, otherwise only the invalidated 
+       items and regions. */
+    bool fullUpdate = ( _updateRequested == true || _clearScreenRequested == true || _isShowConfirmDialog == true );
+
+    if( fullUpdate == true ) {
+        _drawItems = UINT32_MAX;
+        _drawRegions = SCREEN_REGION_ALL;
+
+    } else {
+        _drawItems = _invalidItems;
+        _drawRegions = _invalidRegions;
+    }
+
     if( _clearScreenRequested == true )  {
         g_lcd.clear();
     }
 
     _updateRequested = false;
     _clearScreenRequested = false;
+    _invalidItems = 0;
+    _invalidRegions = 0;
 
     /* Disable blinking cursor. */
     g_lcd.setCursor( false, false );
@@ -129,8 +206,11 @@ void Screen::update() {
     /* If the current selected item is full screen, only draw this item. */
     if( _itemFullscreen == true ) {
 
-        item.loadFromProgmem( &_currentScreen.items[ _selected ] );
-        this->drawItem( &item, true, 0, 0 );
+        if( fullUpdate == true || ( _selected < SCREEN_MAX_INVALID_ITEMS && ( _drawItems & ( 1UL << _selected )))) {
+
+            item.loadFromProgmem( &_currentScreen.items[ _selected ] );
+            this->drawItem( &item, true, 0, 0 );
+        }
 
 
     } else {
@@ -138,6 +218,18 @@ void Screen::update() {
         /* Draw all visible items on the screen. */
         for( uint8_t i = 0; true; i++ ) {
 
+            if( fullUpdate == false ) {
+
+                /* No more invalidated items to draw. */
+                if( i >= SCREEN_MAX_INVALID_ITEMS || ( _drawItems >> i ) == 0 ) {
+                    break;
+                }
+
+                if(( _drawItems & ( 1UL << i )) == 0 ) {
+                    continue;
+                }
+            }
+
             item.loadFromProgmem( &_currentScreen.items[ i ] );
 
             bool isSelected = ( _selected == i );
@@ -180,6 +272,82 @@ void Screen::update() {
 }
 
 
+#if SCREEN_KEY_LATENCY == 1
+/*******************************************************************************
+ *
+ * @brief   Add a keypress latency sample to the statistics of the 
+ *          current screen.
+ *
+ * @param   latency    Time from the key change to the end of the screen
+ *                     update (us).
+ * 
+ */
+void Screen::recordKeyLatency( uint32_t latency ) {
+    uint8_t id = this->getId();
+    uint8_t slot;
+
+    for( slot = 0; slot < _keyLatencyCount; slot++ ) {
+        if( _keyLatencyScreen[ slot ] == id ) {
+            break;
+        }
+    }
+
+    if( slot == _keyLatencyCount ) {
+
+        if( _keyLatencyCount < SCREEN_LATENCY_SLOTS ) {
+            _keyLatencyCount++;
+
+        } else {
+
+            /* No free slot, use the shared one */
+            slot = SCREEN_LATENCY_SLOTS - 1;
+            id = SCREEN_LATENCY_ID_OTHER;
+        }
+
+        _keyLatencyScreen[ slot ] = id;
+    }
+
+    LoopProfiler::record( &_keyLatency[ slot ], latency, SCREEN_LATENCY_HIST_SHIFT );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Get the keypress latency statistics of a screen.
+ *
+ * @param   index       Slot index
+ * @param   screenId    Receives the screen ID or SCREEN_LATENCY_ID_OTHER.
+ *
+ * @return  Pointer to the statistics or nullptr if the slot is not used.
+ * 
+ */
+const ProfilerSlot* Screen::getKeyLatency( uint8_t index, uint8_t* screenId ) {
+    if( index >= _keyLatencyCount ) {
+        return nullptr;
+    }
+
+    *screenId = _keyLatencyScreen[ index ];
+    return &_keyLatency[ index ];
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Clear the keypress latency statistics.
+ * 
+ */
+void Screen::resetKeyLatency() {
+    memset( _keyLatency, 0, sizeof( _keyLatency ));
+
+    for( uint8_t i = 0; i < SCREEN_LATENCY_SLOTS; i++ ) {
+        _keyLatency[ i ].min = UINT32_MAX;
+    }
+
+    _keyLatencyCount = 0;
+}
+#endif
+
+
 /*******************************************************************************
  *
  * @brief   Exit item fullscreen edit mode.
@@ -334,10 +502,20 @@ void Screen::processKeypadEvent( uint8_t key ) {
 
                 if( _itemFullscreen == false ) {
 
+                    uint8_t prevSelected = _selected;
+                    uint8_t prevScroll = _scroll;
+
                     this->selectItem( _selected + 1 );
-                }
 
-                _updateRequested = true;
+                    /* Redraw the previous and the new selected items, or
+                       the whole screen if it scrolled. */
+                    if( _scroll != prevScroll ) {
+                        _updateRequested = true;
+
+                    } else {
+                        this->invalidateItemIndex( prevSelected );
+                    }
+                }
             }
 
 
@@ -345,7 +523,7 @@ void Screen::processKeypadEvent( uint8_t key ) {
                 _currentScreen.eventSelectionChanged( this, &_currentItem, _fieldPos, _itemFullscreen );
             }
 
-            _updateRequested = true;
+            this->invalidateItemIndex( _selected );
             break;
     }
 
@@ -517,6 +695,66 @@ void Screen::requestScreenUpdate( bool clear ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Request the redraw of a single item on the next update.
+ *
+ * @param   id    ID of the item.
+ *
+ */
+void Screen::invalidateItem( uint8_t id ) {
+
+    if( _currentScreen.items == NULL ) {
+        return;
+    }
+
+    for( uint8_t i = 0; true; i++ ) {
+
+        uint8_t type = pgm_read_byte( &_currentScreen.items[ i ]._type );
+
+        if( type == ITEM_TYPE_NULL ) {
+            return;
+        }
+
+        if( pgm_read_byte( &_currentScreen.items[ i ]._id ) == id ) {
+            this->invalidateItemIndex( i );
+        }
+    }
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Request the redraw of an item on the next update.
+ *
+ * @param   index    Index of the item in the screen item list.
+ *
+ */
+void Screen::invalidateItemIndex( uint8_t index ) {
+
+    if( index >= SCREEN_MAX_INVALID_ITEMS ) {
+        _updateRequested = true;
+        return;
+    }
+
+    _invalidItems |= ( 1UL << index );
+}
+
+
+/*******************************************************************************
+ *
+ * @brief   Request the redraw of regions drawn by the draw screen callback
+ *          on the next update.
+ *
+ * @param   regions    Regions to redraw (screen specific bit mask).
+ *
+ */
+void Screen::invalidateRegion( uint8_t regions ) {
+
+    _invalidRegions |= regions;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Print a list item value from the selected index.
@@ -1338,7 +1576,9 @@ void Screen::clearItemValue( ScreenItem* item ) {
         _itemChanged = true;
     }
 
-    _updateRequested = true;
+    /* Only the item changed, the value change callback invalidates the 
+       items which depend on it. */
+    this->invalidateItemIndex( _selected );
 
     if( _currentScreen.eventValueChange != NULL ) {
         _currentScreen.eventValueChange( this, item );
@@ -1621,7 +1861,9 @@ void Screen::incrementItemValue( ScreenItem* item, bool shift ) {
         _itemChanged = true;
     }
 
-    _updateRequested = true;
+    /* Only the item changed, the value change callback invalidates the 
+       items which depend on it. */
+    this->invalidateItemIndex( _selected );
 
     if( _currentScreen.eventValueChange != NULL ) {
         _currentScreen.eventValueChange( this, item );
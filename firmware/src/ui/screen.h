@@ -19,6 +19,7 @@
 #define SCREEN_H
 
 #include <Arduino.h>
+#include <profiler.h>
 
 #include "screen_item.h"
 
@@ -28,6 +29,27 @@
 
 #define SCREEN_MAX_BREADCRUMB_ITEMS     10
 
+/* Number of items which can be invalidated individually, the items past
+   this index are only redrawn by a full screen update. */
+#define SCREEN_MAX_INVALID_ITEMS        32
+
+/* Regions of the screen drawn by the draw screen callback. Their meaning 
+   is defined by each screen. */
+#define SCREEN_REGION_ALL               0xFF
+
+/* Record the keypress to display latency of each screen ('perf ui') */
+#ifndef SCREEN_KEY_LATENCY
+#define SCREEN_KEY_LATENCY              1
+#endif
+
+/* Number of screens for which the keypress latency is recorded. Once 
+   full, the other screens share the last slot. */
+#define SCREEN_LATENCY_SLOTS            8
+#define SCREEN_LATENCY_ID_OTHER         0xFF
+
+/* Keypress latency histogram (<1ms, <4ms, <16ms, <64ms, <256ms, >=256ms) */
+#define SCREEN_LATENCY_HIST_SHIFT       10
+
 #define DISPLAY_HEIGHT                  2
 #define DISPLAY_WIDTH                   16
 
@@ -126,8 +148,18 @@ class Screen {
     void exitScreen();
     bool activate( const ScreenData* screen, bool selectFirstItem = true );
     void requestScreenUpdate( bool clear );
+    void invalidateItem( uint8_t id );
+    void invalidateRegion( uint8_t regions );
     void processEvents();
 
+#if SCREEN_KEY_LATENCY == 1
+    const ProfilerSlot* getKeyLatency( uint8_t index, uint8_t* screenId );
+    void resetKeyLatency();
+#else
+    const ProfilerSlot* getKeyLatency( uint8_t index, uint8_t* screenId )    { return nullptr; }
+    void resetKeyLatency()                                                  { }
+#endif
+
 
     /* Gets the screen ID. */
     uint8_t getId()                                     { return _currentScreen.id; }
@@ -141,6 +173,9 @@ class Screen {
      /* Gets the ID of the currently selected item. */
     uint8_t getSelectedItemId()                         { return _currentItem.getId(); }
 
+    /* Gets the currently selected item. */
+    ScreenItem* getSelectedItem()                       { return &_currentItem; }
+
     /* Gets the current cursor position within the item. */
     uint8_t getCurrentFieldPos()                        { return _fieldPos; }
 
@@ -171,9 +206,17 @@ class Screen {
     /* Enable/disable confirm changes dialog when exiting the screen. */
     void setConfirmChanges( bool confirm )              { _confirmChanges = confirm; }
 
+    /* Returns whether any of the regions must be drawn (draw screen callback). */
+    bool isRegionInvalid( uint8_t regions )             { return ( _drawRegions & regions ) != 0; }
+
 
   private:
+    void drawScreen();
+#if SCREEN_KEY_LATENCY == 1
+    void recordKeyLatency( uint32_t latency );
+#endif
     void drawItem( ScreenItem* item, bool isSelected, uint8_t row, uint8_t col );
+    void invalidateItemIndex( uint8_t index );
     void printListItemValue( ScreenItem* item, uint16_t index, bool isSelected, uint8_t row, uint8_t col );
     uint8_t printItemCaption( ScreenItem* item );
     void incrementItemValue( ScreenItem* item, bool shift );
@@ -208,6 +251,19 @@ class Screen {
     ScreenData _currentScreen;
     bool _updateRequested;
     bool _clearScreenRequested;
+    uint32_t _invalidItems = 0;             /* Items to redraw (bit per item index) */
+    uint8_t _invalidRegions = 0;            /* Regions to redraw */
+    uint32_t _drawItems = 0;                /* Items drawn by the current update */
+    uint8_t _drawRegions = 0;               /* Regions drawn by the current update */
+
+#if SCREEN_KEY_LATENCY == 1
+    bool _keyLatencyPending;                /* A key was processed, waiting for the screen update */
+    bool _keyLatencyQueued;                 /* Screen updated, waiting for the LCD transfers */
+    uint32_t _keyTime;
+    ProfilerSlot _keyLatency[ SCREEN_LATENCY_SLOTS ];
+    uint8_t _keyLatencyScreen[ SCREEN_LATENCY_SLOTS ];
+    uint8_t _keyLatencyCount;
+#endif
 };
 
 
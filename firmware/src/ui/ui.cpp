@@ -98,6 +98,7 @@ bool onDrawItem( Screen* screen, ScreenItem* item, uint16_t index, bool isSelect
 
         case ID_LAMP_DELAY:
         case ID_PROFILE_SNOOZE:
+        case ID_PROFILE_GRADUAL_TIME:
 
             uint8_t minutes;
             minutes = item->getValue();
@@ -286,6 +287,8 @@ void onValueChange( Screen* screen, ScreenItem* item ) {
                 } else {
                     adjDate.day = month_days;
                 }
+
+                screen->invalidateItem( ID_SET_DATE_DAY );
             }
 
             break;
@@ -97,6 +97,7 @@ enum {
     ID_PROFILE_DOW,
     ID_PROFILE_VOLUME,
     ID_PROFILE_GRADUAL,
+    ID_PROFILE_GRADUAL_TIME,
     ID_PROFILE_VISUAL,
     ID_PROFILE_LAMP,
     ID_PROFILE_MSG,
@@ -159,6 +160,21 @@ enum {
 };
 
 
+// ----------------------------------------
+// Screen regions (draw screen callbacks)
+// ----------------------------------------
+
+/* Root screen */
+#define ROOT_REGION_NETWORK             0x01    /* Wifi and telnet icons */
+#define ROOT_REGION_MESSAGE             0x02    /* Home Assistant message */
+#define ROOT_REGION_STATUS              0x04    /* SD card and battery icons */
+#define ROOT_REGION_DATE                0x08    /* Date line */
+
+/* Alarm screen */
+#define ALARM_REGION_TITLE              0x01    /* Snooze title */
+#define ALARM_REGION_COUNTDOWN          0x02    /* Snooze time remaining */
+
+
 void enableNightLamp();
 void disableNightLamp();
 
@@ -186,6 +202,7 @@ bool showAlarmScreen_onDrawScreen( Screen* screen );
 
 /* Select timezone screen */
 void selectTimezone_onEnterScreen( Screen* screen, uint8_t prevScreenID );
+bool selectTimezone_onKeypress( Screen* screen, uint8_t key );
 bool selectTimezone_onExitScreen( Screen* screen  );
 bool selectTimezone_onDrawItem( Screen* screen, ScreenItem* item, uint16_t index, bool isSelected, uint8_t row, uint8_t col );
 void selectTimezone_onSelectionChange( Screen* screen, ScreenItem* item, uint8_t fieldPos, bool fullscreen );
@@ -330,7 +347,7 @@ PROGMEM const ScreenData screen_select_timezone {
     eventExitScreen       : &selectTimezone_onExitScreen,
     eventValueChange      : NULL,
     eventDrawScreen       : NULL,
-    eventKeypress         : NULL,
+    eventKeypress         : &selectTimezone_onKeypress,
     eventDrawItem         : &selectTimezone_onDrawItem,
     eventSelectionChanged : &selectTimezone_onSelectionChange,
     eventTimeout          : NULL,
@@ -537,14 +554,18 @@ PROGMEM const struct ScreenItemBase ITEMS_EDIT_PROFILE[] = {
 
     ITEM_TOGGLE( ID_PROFILE_GRADUAL, 3, 0, S_EDIT_PROFILE_GRADUAL, &g_alarm.profile.gradual, ITEM_NORMAL ),
 
-    ITEM_LINK( ID_PROFILE_VISUAL, 4, 0, S_EDIT_PROFILE_VISUAL, &screen_edit_alarm_visual, ITEM_NORMAL ),
+    ITEM_NUMBER( ID_PROFILE_GRADUAL_TIME, 4, 0, S_EDIT_PROFILE_GRADUAL_TIME, &g_alarm.profile.gradualTime,
+                 MIN_ALARM_GRADUAL_TIME, MAX_ALARM_GRADUAL_TIME,
+                 ITEM_NUMBER_INC_WHOLE | ITEM_EDIT_FULLSCREEN | ITEM_NOCURSOR ),
+
+    ITEM_LINK( ID_PROFILE_VISUAL, 5, 0, S_EDIT_PROFILE_VISUAL, &screen_edit_alarm_visual, ITEM_NORMAL ),
 
-    ITEM_LINK( ID_PROFILE_LAMP, 5, 0, S_EDIT_PROFILE_LAMP, &screen_edit_alarm_lamp, ITEM_NORMAL ),
+    ITEM_LINK( ID_PROFILE_LAMP, 6, 0, S_EDIT_PROFILE_LAMP, &screen_edit_alarm_lamp, ITEM_NORMAL ),
 
-    ITEM_TEXT( ID_PROFILE_MSG, 6, 0, S_EDIT_PROFILE_MESSAGE, &g_alarm.profile.message,
+    ITEM_TEXT( ID_PROFILE_MSG, 7, 0, S_EDIT_PROFILE_MESSAGE, &g_alarm.profile.message,
                MAX_LENGTH_ALARM_MESSAGE, ITEM_EDIT_FULLSCREEN ),
 
-    ITEM_LINK( ID_PROFILE_TEST, 7, 0, S_EDIT_PROFILE_TEST, NULL, ITEM_NORMAL ),
+    ITEM_LINK( ID_PROFILE_TEST, 8, 0, S_EDIT_PROFILE_TEST, NULL, ITEM_NORMAL ),
     ITEM_END()
 };
 
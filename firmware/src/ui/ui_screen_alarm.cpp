@@ -109,8 +109,14 @@ bool alarmScreen_onDrawScreen( Screen *screen ) {
             return true;
         }
 
-        g_lcd.setPosition( 0, 0 );
-        g_lcd.print_P( S_SNOOZE, 16, TEXT_ALIGN_CENTER );
+        if( screen->isRegionInvalid( ALARM_REGION_TITLE ) == true ) {
+            g_lcd.setPosition( 0, 0 );
+            g_lcd.print_P( S_SNOOZE, 16, TEXT_ALIGN_CENTER );
+        }
+
+        if( screen->isRegionInvalid( ALARM_REGION_COUNTDOWN ) == false ) {
+            return true;
+        }
 
         uint16_t remaining;
         remaining = g_alarm.getSnoozeTimeRemaining();
@@ -136,6 +142,10 @@ bool alarmScreen_onDrawScreen( Screen *screen ) {
         return true;
     }
 
+    /* The alarm message does not change while the alarm plays */
+    if( screen->isRegionInvalid( ALARM_REGION_TITLE ) == false ) {
+        return true;
+    }
 
     g_lcd.setPosition( 1, 0 );
 
@@ -174,6 +184,8 @@ void alarmScreen_onTimeout( Screen *screen ) {
 
         g_screen.requestScreenUpdate( true );
     } else {
-        g_screen.requestScreenUpdate( false );
+
+        /* Refresh the snooze time remaining */
+        g_screen.invalidateRegion( ALARM_REGION_COUNTDOWN );
     }
 }
\ No newline at end of file
@@ -82,53 +82,63 @@ bool rootScreen_onDrawScreen( Screen* screen ) {
 
     char buffer[16];
 
-    g_lcd.setPosition( 0, 0 );
-    g_lcd.print( ( g_wifi.connected() == true ) ? CHAR_WIFI_ON : CHAR_SPACE );
+    if( screen->isRegionInvalid( ROOT_REGION_NETWORK ) == true ) {
 
-    if( g_telnetConsole.serverEnabled() == true ) {
-        g_lcd.print( ( g_telnetConsole.clientConnected() == true ) ? CHAR_TELNET_SESSION_ACTIVE : CHAR_TELNET_SESSION_INNACTIVE );
-    } else {
-        g_lcd.print( CHAR_SPACE );
+        g_lcd.setPosition( 0, 0 );
+        g_lcd.print( ( g_wifi.connected() == true ) ? CHAR_WIFI_ON : CHAR_SPACE );
+
+        if( g_telnetConsole.serverEnabled() == true ) {
+            g_lcd.print( ( g_telnetConsole.clientConnected() == true ) ? CHAR_TELNET_SESSION_ACTIVE : CHAR_TELNET_SESSION_INNACTIVE );
+        } else {
+            g_lcd.print( CHAR_SPACE );
+        }
     }
 
     /* Print LCD message from home-assistant */
-    g_lcd.setPosition( 0, 3 );
-    g_lcd.print( g_homeassistant.lcd_message, MAX_PAYLOAD_LCD_MESSAGE_LENGTH, TEXT_ALIGN_CENTER );
-
-    /* Print status icons */
-    g_lcd.setPosition( 0, 14 );
-    g_lcd.print( ( g_sdcard.isCardPresent() == false ) ? CHAR_NO_SD : CHAR_SPACE );
-
-
-    switch( g_battery.getBatteryState() ) {
-        case BATTERY_STATE_NOT_PRESENT:
-            g_lcd.print( CHAR_NO_BATTERY );
-            break;
-
-        case BATTERY_STATE_DISCHARGE_FULL:
-            g_lcd.print( CHAR_BATTERY_FULL );
-            break;
+    if( screen->isRegionInvalid( ROOT_REGION_MESSAGE ) == true ) {
 
-        case BATTERY_STATE_DISCHARGE_HALF:
-            g_lcd.print( CHAR_BATTERY_HALF );
-            break;
-        
-        case BATTERY_STATE_DISCHARGE_LOW:
-            g_lcd.print( CHAR_BATTERY_LOW );
-            break;
+        g_lcd.setPosition( 0, 3 );
+        g_lcd.print( g_homeassistant.lcd_message, MAX_PAYLOAD_LCD_MESSAGE_LENGTH, TEXT_ALIGN_CENTER );
+    }
 
-        default:
-            g_lcd.print( CHAR_SPACE );
+    /* Print status icons */
+    if( screen->isRegionInvalid( ROOT_REGION_STATUS ) == true ) {
+
+        g_lcd.setPosition( 0, 14 );
+        g_lcd.print( ( g_sdcard.isCardPresent() == false ) ? CHAR_NO_SD : CHAR_SPACE );
+
+        switch( g_battery.getBatteryState() ) {
+            case BATTERY_STATE_NOT_PRESENT:
+                g_lcd.print( CHAR_NO_BATTERY );
+                break;
+
+            case BATTERY_STATE_DISCHARGE_FULL:
+                g_lcd.print( CHAR_BATTERY_FULL );
+                break;
+
+            case BATTERY_STATE_DISCHARGE_HALF:
+                g_lcd.print( CHAR_BATTERY_HALF );
+                break;
+            
+            case BATTERY_STATE_DISCHARGE_LOW:
+                g_lcd.print( CHAR_BATTERY_LOW );
+                break;
+
+            default:
+                g_lcd.print( CHAR_SPACE );
+        }
     }
 
-    DateTime now = g_rtc.now();
-    g_timezone.toLocal( &now );
+    if( screen->isRegionInvalid( ROOT_REGION_DATE ) == true ) {
 
+        DateTime now = g_rtc.now();
+        g_timezone.toLocal( &now );
 
-    g_lcd.setPosition( 1, 0 );
+        g_lcd.setPosition( 1, 0 );
 
-    dateToBuf( buffer, g_config.clock.date_format, &now );
-    g_lcd.print( buffer, DISPLAY_WIDTH, TEXT_ALIGN_CENTER );
+        dateToBuf( buffer, g_config.clock.date_format, &now );
+        g_lcd.print( buffer, DISPLAY_WIDTH, TEXT_ALIGN_CENTER );
+    }
 
     return false;
 }
\ No newline at end of file
@@ -26,6 +26,20 @@ uint16_t g_selectedTimezone;
 
 
 
+/*******************************************************************************
+ *
+ * @brief   Gets the caption of a timezone shown on the selection screen.
+ *
+ * @param   id    Timezone ID
+ *
+ * @return  Pointer to the caption (program memory).
+ * 
+ */
+static const char* tzCaption( uint16_t id ) {
+    return TimeZoneCaptions + pgm_read_word( &TimeZoneCaptionOffsets[ id ] );
+}
+
+
 /*******************************************************************************
  *
  * @brief   Event raised when entering the screen.
@@ -39,6 +53,48 @@ void selectTimezone_onEnterScreen( Screen* screen, uint8_t prevScreenID ) {
 }
 
 
+/*******************************************************************************
+ *
+ * @brief   Event raised when a key press occurs. SHIFT + NEXT jumps to the 
+ *          next timezone starting with a different letter in the region 
+ *          list being edited.
+ *
+ * @param   screen    Pointer to the screen where the event occured.
+ * @param   key       Detected key press.
+ *
+ * @return  TRUE to allow default key press processing, FALSE to override.
+ * 
+ */
+bool selectTimezone_onKeypress( Screen* screen, uint8_t key ) {
+
+    if( key != ( KEY_NEXT | KEY_SHIFT ) || screen->isItemFullScreen() == false ) {
+        return true;
+    }
+
+    uint16_t first = screen->getSelectedItem()->getMin();
+    uint16_t last = screen->getSelectedItem()->getMax();
+
+    if( g_selectedTimezone < first || g_selectedTimezone > last ) {
+        return true;
+    }
+
+    char letter = pgm_read_byte( tzCaption( g_selectedTimezone ));
+    uint16_t id = g_selectedTimezone;
+
+    /* Captions are sorted within a region, go back to the first one 
+       after the last letter. */
+    do {
+        id = ( id < last ) ? id + 1 : first;
+
+    } while( id != g_selectedTimezone && pgm_read_byte( tzCaption( id )) == letter );
+
+    g_selectedTimezone = id;
+    screen->invalidateItem( screen->getSelectedItemId() );
+
+    return false;
+}
+
+
 /*******************************************************************************
  *
  * @brief   Event raised when the cursor on the currently selected 
@@ -108,49 +164,8 @@ bool selectTimezone_onDrawItem( Screen* screen, ScreenItem* item, uint16_t index
         return true;
     }
 
-    TimeZone tz;
-    if( tz.setTimezoneByID( index ) == false ) {
-        return true;
-    }
-
-    char buffer[40];
-    strcpy_P( buffer, tz.getName() );
-
-    /* Convert underscore character to spaces. */
-    char* ptr;
-    while(( ptr = strchr( buffer, '_' )) != NULL )  {
-        *ptr = '\x20';
-    }
-
-    /* Get only the last segment of the timezone name. */
-    char* caption = strrchr( buffer, '/' );
-    if( caption == NULL ) {
-        return true;
-    }
-    caption++;
-
-    
-    if( strlen( caption ) < DISPLAY_WIDTH - 5 ) {
-
-        if( strcasestr_P( buffer, PSTR("North Dakota/")) != NULL ) {
-            strcat_P( buffer, PSTR( ", ND" ));
-        }
-
-        if( strcasestr_P( buffer, PSTR("Indiana/")) != NULL ) {
-            strcat_P( buffer, PSTR( ", IN" ));
-        }
-
-        if( strcasestr_P( buffer, PSTR("Kentucky/")) != NULL ) {
-            strcat_P( buffer, PSTR( ", KY" ));
-        }
-    }
-
-    if( strcasecmp_P( caption, PSTR( "DumontDUrville" )) == 0 ) {
-        strcpy_P( caption, PSTR( "D'Urville" ));
-    }
-
-
-    g_lcd.print( caption, DISPLAY_WIDTH - 2, TEXT_ALIGN_LEFT );
+    /* Captions are generated with the timezone table */
+    g_lcd.print_P( tzCaption( index ), DISPLAY_WIDTH - 2, TEXT_ALIGN_LEFT );
 
     return false;
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+#!/usr/bin/python3
+################################################################################
+##
+## Project : Alarm Clock V3
+## File    : tools/trace/trace2json.py
+## Author  : Benoit Frigon <www.bfrigon.com>
+##
+## -----------------------------------------------------------------------------
+##
+## This work is licensed under the Creative Commons Attribution-ShareAlike 4.0
+## International License. To view a copy of this license, visit
+##
+## http://creativecommons.org/licenses/by-sa/4.0/
+##
+## or send a letter to Creative Commons,
+## PO Box 1866, Mountain View, CA 94042, USA.
+##
+################################################################################
+##
+## Converts the output of the 'trace dump' console command to the Chrome
+## trace event format (open with chrome://tracing or ui.perfetto.dev).
+##
+## Capture example :
+##
+##   (sleep 1; printf 'trace dump\r\n'; sleep 2) | nc clock-v3 23 > trace.bin
+##   ./trace2json.py --telnet trace.bin trace.json
+##
+################################################################################
+
+import sys
+import json
+import struct
+import argparse
+
+
+TRACE_DUMP_MAGIC = b"TRCE"
+TRACE_DUMP_VERSION = 1
+TELNET_IAC = 0xFF
+
+## Task manager events (lib/tracer/tracer.h)
+TRACE_EVENT_DISPATCH_BEGIN = 1
+TRACE_EVENT_DISPATCH_END = 2
+TRACE_EVENT_TASK_START = 3
+TRACE_EVENT_TASK_END = 4
+
+## Application events (include/trace_events.h)
+TRACE_EVENT_USER = 16
+ISR_NAMES = {
+    TRACE_EVENT_USER + 0: "isr rtc",
+    TRACE_EVENT_USER + 1: "isr keypad",
+    TRACE_EVENT_USER + 2: "isr wifi",
+}
+
+## Service trace IDs, same as the profiler slots (include/profiler_slots.h)
+SERVICE_NAMES = [
+    "power", "sdcard", "rtc", "clock", "alarm", "screen evt", "screen upd",
+    "lamp", "config", "als", "wifi", "console", "ntp", "telnet", "ftp",
+    "mqtt", "hass", "icons",
+]
+
+PID = 1
+TID_ISR = 100
+
+
+def serviceName(traceId):
+    if traceId < len(SERVICE_NAMES):
+        return SERVICE_NAMES[traceId]
+
+    return "service %d" % traceId
+
+
+def unescapeTelnet(data):
+    out = bytearray()
+    i = 0
+
+    while i < len(data):
+        out.append(data[i])
+
+        if data[i] == TELNET_IAC and i + 1 < len(data) and data[i + 1] == TELNET_IAC:
+            i += 1
+
+        i += 1
+
+    return bytes(out)
+
+
+def readEvents(data):
+    start = data.find(TRACE_DUMP_MAGIC)
+    if start < 0:
+        sys.exit("error: trace header not found")
+
+    version, count, overwritten = struct.unpack_from("<BBI", data, start + 4)
+    if version != TRACE_DUMP_VERSION:
+        sys.exit("error: unsupported trace version %d" % version)
+
+    offset = start + 10
+    if len(data) < offset + count * 7:
+        sys.exit("error: truncated trace (%d events expected)" % count)
+
+    events = []
+    for i in range(count):
+        events.append(struct.unpack_from("<IBH", data, offset + i * 7))
+
+    return events, overwritten
+
+
+def convert(events):
+    out = []
+    tasks = {}
+    dispatched = set()
+    base = None
+    prev = 0
+    wraps = 0
+
+    for time, eventId, arg in events:
+
+        # micros() rolls over every ~71 minutes. Only a large backward jump
+        # is a roll over, small ones are events recorded out of order.
+        if base is not None and time < prev and prev - time > (1 << 31):
+            wraps += 1
+        prev = time
+
+        ts = time + wraps * (1 << 32)
+        if base is None:
+            base = ts
+        ts -= base
+
+        if eventId == TRACE_EVENT_DISPATCH_BEGIN:
+            dispatched.add(arg)
+            out.append({"name": serviceName(arg), "ph": "B", "ts": ts, "pid": PID, "tid": arg})
+
+        elif eventId == TRACE_EVENT_DISPATCH_END:
+
+            # Dispatch started before the first recorded event
+            if arg not in dispatched:
+                continue
+
+            dispatched.discard(arg)
+            out.append({"name": serviceName(arg), "ph": "E", "ts": ts, "pid": PID, "tid": arg})
+
+        elif eventId == TRACE_EVENT_TASK_START:
+            tasks[arg >> 8] = (ts, arg & 0xFF)
+
+        elif eventId == TRACE_EVENT_TASK_END:
+            traceId = arg >> 8
+            error = struct.unpack("b", bytes([arg & 0xFF]))[0]
+
+            # Task started before the first recorded event
+            if traceId not in tasks:
+                continue
+
+            startTs, task = tasks.pop(traceId)
+            out.append({
+                "name": "%s task %d" % (serviceName(traceId), task),
+                "cat": "task", "ph": "X", "ts": startTs, "dur": ts - startTs,
+                "pid": PID, "tid": 1000 + traceId,
+                "args": {"error": error},
+            })
+
+        else:
+            out.append({
+                "name": ISR_NAMES.get(eventId, "event %d" % eventId),
+                "cat": "isr", "ph": "i", "s": "t", "ts": ts,
+                "pid": PID, "tid": TID_ISR, "args": {"arg": arg},
+            })
+
+    # Tasks still running at the end of the trace
+    for traceId, (startTs, task) in tasks.items():
+        out.append({
+            "name": "%s task %d" % (serviceName(traceId), task),
+            "cat": "task", "ph": "B", "ts": startTs, "pid": PID, "tid": 1000 + traceId,
+        })
+
+    # Thread names
+    tids = set(e["tid"] for e in out)
+    for tid in tids:
+        if tid == TID_ISR:
+            name = "interrupts"
+        elif tid >= 1000:
+            name = "%s tasks" % serviceName(tid - 1000)
+        else:
+            name = serviceName(tid)
+
+        out.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": tid, "args": {"name": name}})
+
+    return out
+
+
+parser = argparse.ArgumentParser(description="Convert a 'trace dump' capture to Chrome trace JSON")
+parser.add_argument("input", help="Captured output of the 'trace dump' command")
+parser.add_argument("output", nargs="?", help="JSON file (default: stdout)")
+parser.add_argument("--telnet", action="store_true", help="Capture made on the telnet console (doubled IAC bytes)")
+args = parser.parse_args()
+
+data = open(args.input, "rb").read()
+if args.telnet:
+    data = unescapeTelnet(data)
+
+events, overwritten = readEvents(data)
+
+trace = {
+    "traceEvents": convert(events),
+    "displayTimeUnit": "ms",
+    "otherData": {"events": len(events), "overwritten": overwritten},
+}
+
+if args.output:
+    json.dump(trace, open(args.output, "w"), indent=1)
+else:
+    json.dump(trace, sys.stdout, indent=1)
@@ -46,6 +46,9 @@ ZONES_BLACKLIST="EST;MST;HST;EST5EDT;CST6CDT;MST7MDT;PST8PDT;CET;EET;WET;MET;Etc
 
 PADDING=40
 
+## Maximum length of the captions shown by the timezone selection screen
+CAPTION_LENGTH=14
+
 ################################################################################
 function parseTime() {
 
@@ -311,6 +314,27 @@ for zone_name in "${!zone[@]}"; do
     [[ "$std_letter" == "-" ]] && std_letter=""
 
 
+    ##--------------------------------------------------------------
+    ## Short caption shown by the timezone selection screen. Last
+    ## segment of the zone name, with the state of the US sub-zones.
+    ##--------------------------------------------------------------
+    caption=${zone_name##*'/'}
+    caption=${caption//'_'/' '}
+
+    if [[ ${#caption} -lt $(( CAPTION_LENGTH - 3 )) ]]; then
+        [[ "$zone_name" == *"North_Dakota/"* ]] && caption="${caption}, ND"
+        [[ "$zone_name" == *"Indiana/"* ]] && caption="${caption}, IN"
+        [[ "$zone_name" == *"Kentucky/"* ]] && caption="${caption}, KY"
+    fi
+
+    [[ "$caption" == "DumontDUrville" ]] && caption="D'Urville"
+
+    if [[ ${#caption} -gt $CAPTION_LENGTH ]]; then
+        echo "Zone '$zone_name' caption is truncated!"
+        caption=${caption:0:$CAPTION_LENGTH}
+    fi
+
+
     ##--------------------------------------------------------------
     ## Write the zone name string declaration to the output
     ##--------------------------------------------------------------
@@ -456,7 +480,7 @@ for zone_name in "${!zone[@]}"; do
         fi
     fi
 
-    echo "${var_zone_region}~${zone_name##*'/'}~    { $var_zone_name, $std_def, $dst_def }," >> $filename_tz_table
+    echo "${var_zone_region}~${zone_name##*'/'}~    { $var_zone_name, $std_def, $dst_def },~${caption}" >> $filename_tz_table
 
 
     if [[ "$var_zone_region" == "UNKNOWN" ]]; then
@@ -475,7 +499,7 @@ done
 
 echo "const char TZ_UTC[] PROGMEM = { \"UTC\" };" >> $filename_abbrev_list
 echo "const char TZ_ETC_UTC[] PROGMEM = { \"Etc/UTC\" };" >> $filename_tz_names
-echo "ETCETERA~UTC~    { TZ_ETC_UTC, 0, 0, 0, 0, 0, 0, TZ_UTC, 0, 0, 0, 0, 0, 0, TZ_UTC }," >> $filename_tz_table
+echo "ETCETERA~UTC~    { TZ_ETC_UTC, 0, 0, 0, 0, 0, 0, TZ_UTC, 0, 0, 0, 0, 0, 0, TZ_UTC },~UTC" >> $filename_tz_table
 
 echo "Sorting table entries..."
 sort -o $filename_tz_names $filename_tz_names
@@ -557,6 +581,7 @@ echo "//************************************************************************
 
 printf "%-${PADDING}s %s\r\n" "#define MAX_TIMEZONE_ID" "$(( ${#zone[@]} + 1 ))" >> $output
 printf "%-${PADDING}s %s\r\n" "#define TZ_DB_VERSION" "\"$tzdb_version\"" >> $output
+printf "%-${PADDING}s %s\r\n" "#define TZ_CAPTION_LENGTH" "$CAPTION_LENGTH" >> $output
 echo >> $output
 cat $filename_tz_table_indexes >> $output
 echo >> $output
@@ -576,6 +601,26 @@ echo "/* Timezone rules table */" >> $output
 echo "const TimeZoneRules TimeZonesTable[] PROGMEM = {" >> $output
 cut -d'~' -f3  $filename_tz_table >> $output
 echo "};" >> $output
+echo >> $output
+echo >> $output
+
+echo "/* Timezone captions shown by the selection screen, in table order */" >> $output
+echo "const char TimeZoneCaptions[] PROGMEM = {" >> $output
+cut -d'~' -f4  $filename_tz_table | while read -r caption; do
+    echo "    \"${caption}\\0\""
+done >> $output
+echo "};" >> $output
+echo >> $output
+echo >> $output
+
+echo "/* Offset of each caption in TimeZoneCaptions */" >> $output
+echo "const uint16_t TimeZoneCaptionOffsets[] PROGMEM = {" >> $output
+offset=0
+cut -d'~' -f4  $filename_tz_table | while read -r caption; do
+    echo "    ${offset},"
+    offset=$(( offset + ${#caption} + 1 ))
+done >> $output
+echo "};" >> $output
 
 echo >> $output
 echo "#endif /* $header_name */" >> $output